@@ -36,6 +36,21 @@ namespace {
     constexpr int const MAX_CHAR_LEN = 1024;
     constexpr int const MAX_INFO_LEN = 5 * 1024 * 1024;
     constexpr const char *EMPTY_NAME = "";
+
+    // the callbacks of asynchronous renders may call the functions taking the lock, so wait for them without it.
+    void LockWithoutPendingAsync(OH_ImageEffect *imageEffect, std::unique_lock<std::mutex> &lock)
+    {
+        while (true) {
+            if (imageEffect != nullptr) {
+                imageEffect->imageEffect_->WaitAsyncFinished();
+            }
+            lock.lock();
+            if (imageEffect == nullptr || !imageEffect->imageEffect_->IsAsyncPending()) {
+                return;
+            }
+            lock.unlock(); // queued by another thread in between
+        }
+    }
 }
 
 #ifdef __cplusplus
@@ -84,7 +99,8 @@ OH_EffectFilter *OH_ImageEffect_AddFilter(OH_ImageEffect *imageEffect, const cha
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_AddFilterByFilter(OH_ImageEffect *imageEffect, OH_EffectFilter *filter)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "AddFilter: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(filter != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -131,7 +147,8 @@ EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_InsertFilterByFilter(OH_ImageEffect *imageEffect, uint32_t index,
     OH_EffectFilter *filter)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "InsertFilter: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(imageEffect->filters_.size() < MAX_EFILTER_NUMS,
@@ -164,7 +181,8 @@ ImageEffect_ErrorCode OH_ImageEffect_InsertFilterByFilter(OH_ImageEffect *imageE
 EFFECT_EXPORT
 int32_t OH_ImageEffect_RemoveFilter(OH_ImageEffect *imageEffect, const char *filterName)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, 0, "RemoveFilter: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(filterName != nullptr, 0, "RemoveFilter: input parameter nativeEffect is null!");
     CHECK_AND_RETURN_RET_LOG(strlen(filterName) < MAX_CHAR_LEN, 0,
@@ -197,7 +215,8 @@ int32_t OH_ImageEffect_RemoveFilter(OH_ImageEffect *imageEffect, const char *fil
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_RemoveFilterByIndex(OH_ImageEffect *imageEffect, uint32_t index)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "RemoveFilterByIndex: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(index < static_cast<uint32_t>(imageEffect->filters_.size()),
@@ -264,7 +283,8 @@ EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_ReplaceFilterByFilter(OH_ImageEffect *imageEffect, uint32_t index,
     OH_EffectFilter *filter)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "ReplaceFilter: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(index < static_cast<uint32_t>(imageEffect->filters_.size()),
@@ -367,7 +387,8 @@ ImageEffect_ErrorCode OH_ImageEffect_GetInputSurface(OH_ImageEffect *imageEffect
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetInputPixelmap(OH_ImageEffect *imageEffect, OH_PixelmapNative *pixelmap)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetInputPixelmap: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(pixelmap != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -388,7 +409,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetInputPixelmap(OH_ImageEffect *imageEffec
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetOutputPixelmap(OH_ImageEffect *imageEffect, OH_PixelmapNative *pixelmap)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetOutputPixelmap: input parameter imageEffect is null!");
 
@@ -407,7 +429,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetOutputPixelmap(OH_ImageEffect *imageEffe
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetInputNativeBuffer(OH_ImageEffect *imageEffect, OH_NativeBuffer *nativeBuffer)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetInputNativeBuffer: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(nativeBuffer != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -430,7 +453,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetInputNativeBuffer(OH_ImageEffect *imageE
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetOutputNativeBuffer(OH_ImageEffect *imageEffect, OH_NativeBuffer *nativeBuffer)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetOutputNativeBuffer: input parameter imageEffect is null!");
 
@@ -450,7 +474,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetOutputNativeBuffer(OH_ImageEffect *image
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetInputUri(OH_ImageEffect *imageEffect, const char *uri)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     EFFECT_LOGD("Set input uri");
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetInputUri: input parameter imageEffect is null!");
@@ -475,7 +500,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetInputUri(OH_ImageEffect *imageEffect, co
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetOutputUri(OH_ImageEffect *imageEffect, const char *uri)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     EFFECT_LOGD("Set output uri.");
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetOutputUri: input parameter imageEffect is null!");
@@ -504,7 +530,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetOutputUri(OH_ImageEffect *imageEffect, c
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetInputPicture(OH_ImageEffect *imageEffect, OH_PictureNative *picture)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetInputPicture: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(picture != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -525,7 +552,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetInputPicture(OH_ImageEffect *imageEffect
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetOutputPicture(OH_ImageEffect *imageEffect, OH_PictureNative *picture)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetOutputPicture: input parameter imageEffect is null!");
 
@@ -545,7 +573,8 @@ EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetInputTextureId(OH_ImageEffect *imageEffect, int32_t textureId,
     int32_t colorSpace)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetInputTextureId: input parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(textureId > 0, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -565,7 +594,8 @@ ImageEffect_ErrorCode OH_ImageEffect_SetInputTextureId(OH_ImageEffect *imageEffe
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_SetOutputTextureId(OH_ImageEffect *imageEffect, int32_t textureId)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
     CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
         "SetOutputTextureId: output parameter imageEffect is null!");
     CHECK_AND_RETURN_RET_LOG(textureId > 0, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
@@ -583,7 +613,6 @@ ImageEffect_ErrorCode OH_ImageEffect_SetOutputTextureId(OH_ImageEffect *imageEff
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_Start(OH_ImageEffect *imageEffect)
 {
-    std::unique_lock<std::mutex> lock(effectMutex_);
     if (imageEffect == nullptr) {
         ImageEffect_ErrorCode errorCode = ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID;
         NativeCommonUtils::ReportEventStartFailed(errorCode, "OH_ImageEffect_Start: imageEffect is null");
@@ -591,6 +620,9 @@ ImageEffect_ErrorCode OH_ImageEffect_Start(OH_ImageEffect *imageEffect)
         return errorCode;
     }
 
+    std::unique_lock<std::mutex> lock(effectMutex_, std::defer_lock);
+    LockWithoutPendingAsync(imageEffect, lock);
+
     ErrorCode errorCode = imageEffect->imageEffect_->Start();
     if (errorCode != ErrorCode::SUCCESS) {
         ImageEffect_ErrorCode res = NativeCommonUtils::ConvertStartResult(errorCode);
@@ -602,6 +634,88 @@ ImageEffect_ErrorCode OH_ImageEffect_Start(OH_ImageEffect *imageEffect)
     return ImageEffect_ErrorCode::EFFECT_SUCCESS;
 }
 
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_StartAsync(OH_ImageEffect *imageEffect, OH_ImageEffect_StartAsyncCallback callback,
+    void *userData)
+{
+    std::unique_lock<std::mutex> lock(effectMutex_);
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "StartAsync: input parameter imageEffect is null!");
+    CHECK_AND_RETURN_RET_LOG(callback != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "StartAsync: input parameter callback is null!");
+
+    ErrorCode errorCode = imageEffect->imageEffect_->RenderAsync([imageEffect, callback, userData](ErrorCode res) {
+        ImageEffect_ErrorCode result = ImageEffect_ErrorCode::EFFECT_SUCCESS;
+        if (res != ErrorCode::SUCCESS) {
+            result = NativeCommonUtils::ConvertStartResult(res);
+            if (res != ErrorCode::ERR_CANCELED) {
+                NativeCommonUtils::ReportEventStartFailed(result, "OH_ImageEffect_StartAsync fail!");
+                EFFECT_LOGE("StartAsync: render fail! errorCode=%{public}d", res);
+            }
+        }
+        callback(imageEffect, result, userData);
+    });
+    if (errorCode != ErrorCode::SUCCESS) {
+        ImageEffect_ErrorCode res = NativeCommonUtils::ConvertStartResult(errorCode);
+        NativeCommonUtils::ReportEventStartFailed(res, "OH_ImageEffect_StartAsync fail!");
+        EFFECT_LOGE("StartAsync: start fail! errorCode=%{public}d", errorCode);
+        return res;
+    }
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_CancelAsync(OH_ImageEffect *imageEffect)
+{
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "CancelAsync: input parameter imageEffect is null!");
+    imageEffect->imageEffect_->CancelAsync();
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
+EFFECT_EXPORT
+ImageEffect_ErrorCode OH_ImageEffect_StartBatch(OH_ImageEffect *imageEffect, const char **inputPaths,
+    const char **outputPaths, uint32_t count, uint32_t maxConcurrency, ImageEffect_ErrorCode *results)
+{
+    std::unique_lock<std::mutex> lock(effectMutex_);
+    CHECK_AND_RETURN_RET_LOG(imageEffect != nullptr, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "StartBatch: input parameter imageEffect is null!");
+    CHECK_AND_RETURN_RET_LOG(inputPaths != nullptr && outputPaths != nullptr && results != nullptr,
+        ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID, "StartBatch: input parameter paths or results is null!");
+    CHECK_AND_RETURN_RET_LOG(count > 0, ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "StartBatch: input parameter count is zero!");
+    CHECK_AND_RETURN_RET_LOG(maxConcurrency >= 1 && maxConcurrency <= MAX_BATCH_CONCURRENCY,
+        ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID,
+        "StartBatch: input parameter maxConcurrency out of range! maxConcurrency=%{public}u", maxConcurrency);
+
+    std::vector<BatchRenderItem> items;
+    items.reserve(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        CHECK_AND_RETURN_RET_LOG(inputPaths[i] != nullptr && outputPaths[i] != nullptr,
+            ImageEffect_ErrorCode::EFFECT_ERROR_PARAM_INVALID, "StartBatch: path is null! index=%{public}u", i);
+        items.push_back({ inputPaths[i], outputPaths[i] });
+    }
+
+    // the batch runs for long and waits for the asynchronous renders, whose callbacks may call the functions
+    // taking the lock. RenderBatch works on copies of the items and on execution contexts of its own, it neither
+    // reads nor restores the input and output of the effect, so the calls made meanwhile are not overwritten.
+    lock.unlock();
+    std::vector<ErrorCode> itemResults;
+    ErrorCode errorCode = imageEffect->imageEffect_->RenderBatch(items, maxConcurrency, itemResults);
+    if (errorCode != ErrorCode::SUCCESS) {
+        ImageEffect_ErrorCode res = NativeCommonUtils::ConvertStartResult(errorCode);
+        NativeCommonUtils::ReportEventStartFailed(res, "OH_ImageEffect_StartBatch fail!");
+        EFFECT_LOGE("StartBatch: start fail! errorCode=%{public}d", errorCode);
+        return res;
+    }
+
+    for (uint32_t i = 0; i < count; ++i) {
+        results[i] = itemResults[i] == ErrorCode::SUCCESS ? ImageEffect_ErrorCode::EFFECT_SUCCESS :
+            NativeCommonUtils::ConvertStartResult(itemResults[i]);
+    }
+    return ImageEffect_ErrorCode::EFFECT_SUCCESS;
+}
+
 EFFECT_EXPORT
 ImageEffect_ErrorCode OH_ImageEffect_Stop(OH_ImageEffect *imageEffect)
 {
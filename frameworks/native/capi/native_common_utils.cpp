@@ -57,6 +57,7 @@ static const std::map<ErrorCode, ImageEffect_ErrorCode> ERRORCODE_TABLE = {
     { ErrorCode::ERR_NOT_SUPPORT_DIFF_DATATYPE, ImageEffect_ErrorCode::EFFECT_INPUT_OUTPUT_NOT_MATCH },
     { ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE, ImageEffect_ErrorCode ::EFFECT_INPUT_OUTPUT_NOT_SUPPORTED },
     { ErrorCode::ERR_NOT_SUPPORT_INPUT_OUTPUT_COLORSPACE, ImageEffect_ErrorCode::EFFECT_COLOR_SPACE_NOT_MATCH },
+    { ErrorCode::ERR_CANCELED, ImageEffect_ErrorCode::EFFECT_RENDER_CANCELED },
 };
 
 static const std::map<ErrorCode, ImageEffect_ErrorCode> ERRORCODE_TABLE_RENDER = {
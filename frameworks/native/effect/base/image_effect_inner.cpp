@@ -18,6 +18,7 @@
 #include <cassert>
 #include <securec.h>
 #include <algorithm>
+#include <iterator>
 #include <sync_fence.h>
 #include <sys/syscall.h>
 #include <sys/resource.h>
@@ -34,9 +35,11 @@
 #include "effect_json_helper.h"
 #include "efilter_factory.h"
 #include "external_loader.h"
+#include "lut_fusion_efilter.h"
 #include "effect_context.h"
 #include "colorspace_helper.h"
 #include "memcpy_helper.h"
+#include "format_helper.h"
 
 #include "v1_1/buffer_handle_meta_key_type.h"
 #include "effect_log.h"
@@ -49,6 +52,10 @@
 
 #define RENDER_QUEUE_SIZE 8
 #define COMMON_TASK_TAG 0
+#define ASYNC_TASK_TAG 2
+#define SURFACE_FRAME_DEADLINE_MS 33
+#define MIN_FRAMES_IN_FLIGHT 1
+#define MAX_FRAMES_IN_FLIGHT 3
 namespace OHOS {
 namespace Media {
 namespace Effect {
@@ -63,6 +70,8 @@ enum class EffectState {
 const int QUALITY_MAX_CONSTANT = 100;
 const int WATCH_RENDER_FUNNY_PRIORITY = -20;
 const std::string FUNCTION_FLUSH_SURFACE_BUFFER = "flushSurfaceBuffer";
+const int32_t YUV_PLANE_COUNT = 2;
+const uint32_t YUV_HALF = 2;
 
 class ImageEffect::Impl {
 public:
@@ -74,6 +83,8 @@ public:
 
     void CreatePipeline(std::vector<std::shared_ptr<EFilter>> &efilters);
 
+    void UpdatePipelineIfNeed(std::vector<std::shared_ptr<EFilter>> &efilters);
+
     bool CheckEffectSurface() const;
     sptr<IConsumerSurface> GetConsumerSurface() const;
     GSError AcquireConsumerSurfaceBuffer(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& syncFence,
@@ -93,6 +104,11 @@ public:
     std::shared_ptr<EffectContext> effectContext_;
     EffectState effectState_ = EffectState::IDLE;
     bool isQosEnabled_ = false;
+    bool isLutFusionEnabled_ = true;
+    bool isPlanLutFusionEnabled_ = true; // isLutFusionEnabled_ when the lut fusion plan was made
+    std::vector<uint32_t> lutFusionPlan_;
+    std::vector<CacheStatus> planCacheStatus_; // cache status of each efilter when the lut fusion plan was made
+    std::vector<std::shared_ptr<EFilter>> pipelineEFilters_; // efilters linked in pipeline, owns the fused filters
 };
 
 void ImageEffect::Impl::InitPipeline()
@@ -121,9 +137,29 @@ void ImageEffect::Impl::CreatePipeline(std::vector<std::shared_ptr<EFilter>> &ef
     pipeline_->Init(nullptr);
 
     CHECK_AND_RETURN_LOG(srcFilter_ != nullptr, "srcFilter is null");
+    lutFusionPlan_ = isLutFusionEnabled_ ? LutFusionEFilter::GetFusionPlan(efilters) :
+        std::vector<uint32_t>(efilters.size(), 1);
+    isPlanLutFusionEnabled_ = isLutFusionEnabled_;
+    planCacheStatus_.clear();
+    for (const auto &eFilter : efilters) {
+        planCacheStatus_.emplace_back(eFilter != nullptr ? eFilter->GetCacheStatus() : CacheStatus::NO_CACHE);
+    }
+    pipelineEFilters_ = LutFusionEFilter::FuseEFilters(efilters, lutFusionPlan_);
+    for (const auto &eFilter : efilters) {
+        if (eFilter != nullptr) {
+            eFilter->SetStripFollowers({});
+        }
+    }
+    for (size_t idx = 0; idx < pipelineEFilters_.size(); idx++) {
+        if (pipelineEFilters_[idx] != nullptr) {
+            pipelineEFilters_[idx]->SetStripFollowers(std::vector<std::shared_ptr<EFilter>>(
+                pipelineEFilters_.begin() + static_cast<std::ptrdiff_t>(idx) + 1, pipelineEFilters_.end()));
+        }
+    }
+
     std::vector<Filter *> filtersToPipeline; // Note: Filters must be inserted in sequence.
     filtersToPipeline.push_back(srcFilter_.get());
-    for (const auto &eFilter : efilters) {
+    for (const auto &eFilter : pipelineEFilters_) {
         CHECK_AND_RETURN_LOG(eFilter != nullptr, "CreatePipeline: eFilter is null");
         filtersToPipeline.push_back(eFilter.get());
     }
@@ -137,6 +173,25 @@ void ImageEffect::Impl::CreatePipeline(std::vector<std::shared_ptr<EFilter>> &ef
     CHECK_AND_RETURN_LOG(res == ErrorCode::SUCCESS, "pipeline link filter fail! res=%{public}d", res);
 }
 
+void ImageEffect::Impl::UpdatePipelineIfNeed(std::vector<std::shared_ptr<EFilter>> &efilters)
+{
+    // The lut fusion switch and the cache configs may change after the pipeline is built, which changes the filters
+    // that can be fused. Only these inputs of the plan are compared here, so a render does not fetch any lut.
+    bool isPlanValid = isPlanLutFusionEnabled_ == isLutFusionEnabled_;
+    if (isPlanValid && isLutFusionEnabled_) {
+        isPlanValid = planCacheStatus_.size() == efilters.size();
+        for (size_t idx = 0; idx < efilters.size() && isPlanValid; idx++) {
+            CacheStatus status = efilters[idx] != nullptr ? efilters[idx]->GetCacheStatus() : CacheStatus::NO_CACHE;
+            isPlanValid = status == planCacheStatus_[idx];
+        }
+    }
+    if (isPlanValid) {
+        return;
+    }
+    EFFECT_LOGI("UpdatePipelineIfNeed: lut fusion plan changed, recreate pipeline");
+    CreatePipeline(efilters);
+}
+
 bool ImageEffect::Impl::CheckEffectSurface() const
 {
     CHECK_AND_RETURN_RET_LOG(surfaceAdapter_ != nullptr, false, "Impl::CheckEffectSurface: surfaceAdapter is nullptr");
@@ -214,6 +269,12 @@ const std::vector<std::string> priorityEFilter_ = {
 };
 const std::unordered_map<std::string, ConfigType> configTypeTab_ = {
     { "runningType", ConfigType::IPTYPE },
+    { "lutFusion", ConfigType::LUT_FUSION },
+    { "stripRender", ConfigType::STRIP_RENDER },
+    { "hugePage", ConfigType::HUGE_PAGE },
+    { "prefault", ConfigType::PREFAULT },
+    { "framesInFlight", ConfigType::FRAMES_IN_FLIGHT },
+    { "overloadPolicy", ConfigType::OVERLOAD_POLICY },
 };
 const std::unordered_map<int32_t, std::vector<IPType>> runningTypeTab_{
     { std::underlying_type<RunningType>::type(RunningType::FOREGROUND), { IPType::CPU, IPType::GPU } },
@@ -224,6 +285,7 @@ ImageEffect::ImageEffect(const char *name)
 {
     imageEffectFlag_.store(STRUCT_IMAGE_EFFECT_CONSTANT, std::memory_order_release);
     impl_ = std::make_shared<Impl>();
+    executionContextPool_ = std::make_shared<ExecutionContextPool>();
     if (name != nullptr) {
         name_ = name;
     }
@@ -231,12 +293,10 @@ ImageEffect::ImageEffect(const char *name)
     ExtInitModule();
 
     if (m_renderThread == nullptr) {
-        auto func = [this]() {
-            EFFECT_LOGD("ImageEffect has no render work to do!");
-        };
-        m_renderThread = new RenderThread<>(RENDER_QUEUE_SIZE, func);
-        m_renderThread->Start();
-        if (name != nullptr && strcmp(name, "Photo") == 0) {
+        // with a shared worker the strand rebinds this instance's EGL context whenever the worker switches to it.
+        m_renderThread = RenderExecutor::Instance().CreateStrand([this]() { this->BindEGLEnv(); });
+        // a shared strand creates the EGL environment lazily on the first gpu render, keeping creation cheap.
+        if (!m_renderThread->IsShared() && name != nullptr && strcmp(name, "Photo") == 0) {
             auto task = std::make_shared<RenderTask<>>([this]() { this->InitEGLEnv(); }, COMMON_TASK_TAG,
                 RequestTaskId());
             m_renderThread->AddTask(task);
@@ -255,6 +315,9 @@ ImageEffect::~ImageEffect()
     if (impl_->surfaceAdapter_) {
         impl_->surfaceAdapter_->Destroy();
     }
+    // queued asynchronous renders complete as canceled, so that every callback has run before the teardown.
+    CancelAsync();
+    WaitAsyncFinished();
     m_renderThread->ClearTask();
     auto task = std::make_shared<RenderTask<>>([this]() { this->DestroyEGLEnv(); }, COMMON_TASK_TAG,
         RequestTaskId());
@@ -262,8 +325,11 @@ ImageEffect::~ImageEffect()
     task->Wait();
     EFFECT_LOGI("ImageEffect destruct destroy egl env!");
     ExtDeinitModule();
-    m_renderThread->Stop();
-    delete m_renderThread;
+    m_renderThread = nullptr;
+    if (m_presentThread != nullptr) {
+        m_presentThread->WaitTaskFinished();
+        m_presentThread = nullptr;
+    }
 
     impl_->effectContext_->renderEnvironment_ = nullptr;
     if (toProducerSurface_) {
@@ -279,6 +345,7 @@ ImageEffect::~ImageEffect()
 
 void ImageEffect::AddEFilter(const std::shared_ptr<EFilter> &efilter)
 {
+    WaitAsyncFinished();
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
     auto priorityEFilter = std::find_if(priorityEFilter_.begin(), priorityEFilter_.end(),
         [&efilter](const std::string &name) { return name.compare(efilter->GetName()) == 0; });
@@ -297,39 +364,50 @@ void ImageEffect::AddEFilter(const std::shared_ptr<EFilter> &efilter)
     }
 
     impl_->CreatePipeline(efilters_);
+    configGeneration_++;
 }
 
 ErrorCode ImageEffect::InsertEFilter(const std::shared_ptr<EFilter> &efilter, uint32_t index)
 {
+    WaitAsyncFinished();
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
     ErrorCode res = Effect::InsertEFilter(efilter, index);
     if (res == ErrorCode::SUCCESS) {
         impl_->CreatePipeline(efilters_);
+        configGeneration_++;
     }
     return res;
 }
 
 void ImageEffect::RemoveEFilter(const std::shared_ptr<EFilter> &efilter)
 {
+    WaitAsyncFinished();
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
     Effect::RemoveEFilter(efilter);
     impl_->CreatePipeline(efilters_);
+    configGeneration_++;
 }
 
 ErrorCode ImageEffect::RemoveEFilter(uint32_t index)
 {
+    WaitAsyncFinished();
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
     ErrorCode res = Effect::RemoveEFilter(index);
     if (res == ErrorCode::SUCCESS) {
         impl_->CreatePipeline(efilters_);
+        configGeneration_++;
     }
     return res;
 }
 
 ErrorCode ImageEffect::ReplaceEFilter(const std::shared_ptr<EFilter> &efilter, uint32_t index)
 {
+    WaitAsyncFinished();
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
     ErrorCode res = Effect::ReplaceEFilter(efilter, index);
     if (res == ErrorCode::SUCCESS) {
         impl_->CreatePipeline(efilters_);
+        configGeneration_++;
     }
     return res;
 }
@@ -341,6 +419,7 @@ unsigned long int ImageEffect::RequestTaskId()
 
 ErrorCode ImageEffect::SetInputPixelMap(PixelMap* pixelMap)
 {
+    WaitAsyncFinished();
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
     EFFECT_LOGD("ImageEffect::SetInputPixelMap");
     CHECK_AND_RETURN_RET_LOG(pixelMap != nullptr, ErrorCode::ERR_INVALID_SRC_PIXELMAP, "invalid source pixelMap");
@@ -499,7 +578,7 @@ void SetRenderPriority()
 
 
 ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const EffectParameters &effectParameters,
-    unsigned long int taskId, RenderThread<> *thread, RenderMode &mode)
+    unsigned long int taskId, RenderStrand *thread, RenderMode &mode)
 {
     if (thread == nullptr) {
         EFFECT_LOGE("pipeline Prepare fail! render thread is nullptr");
@@ -529,6 +608,7 @@ ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const Effe
             }
             return;
         }, 0, taskId);
+        task->SetPriority(mode.isNeedPriority ? RenderTaskPriority::INTERACTIVE : RenderTaskPriority::STILL);
         thread->AddTask(task);
         task->Wait();
         ErrorCode res = fut.get();
@@ -538,7 +618,7 @@ ErrorCode StartPipelineInner(std::shared_ptr<PipelineCore> &pipeline, const Effe
 }
 
 ErrorCode StartPipeline(std::shared_ptr<PipelineCore> &pipeline, const EffectParameters &effectParameters,
-    unsigned long int taskId, RenderThread<> *thread, RenderMode &mode)
+    unsigned long int taskId, RenderStrand *thread, RenderMode &mode)
 {
     effectParameters.effectContext_->renderStrategy_->Init(effectParameters.srcEffectBuffer_,
         effectParameters.dstEffectBuffer_);
@@ -563,6 +643,7 @@ ErrorCode ImageEffect::Start()
         case DataType::PATH:
         case DataType::PICTURE:
         case DataType::TEX: {
+            WaitAsyncFinished();
             impl_->effectState_ = EffectState::RUNNING;
             ErrorCode res = this->Render();
             Stop();
@@ -581,6 +662,350 @@ ErrorCode ImageEffect::Start()
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode ImageEffect::RenderAsync(const RenderAsyncCallback &callback)
+{
+    CHECK_AND_RETURN_RET_LOG(callback != nullptr, ErrorCode::ERR_INPUT_NULL, "RenderAsync: callback is null!");
+    switch (inDateInfo_.dataType_) {
+        case DataType::PIXEL_MAP:
+        case DataType::SURFACE_BUFFER:
+        case DataType::URI:
+        case DataType::PATH:
+        case DataType::PICTURE:
+            break;
+        case DataType::SURFACE:
+        case DataType::TEX:
+            // surfaces render per frame and textures belong to the gl context of the caller.
+            EFFECT_LOGE("RenderAsync: not support data type! dataType=%{public}d", inDateInfo_.dataType_);
+            return ErrorCode::ERR_UNSUPPORTED_DATA_TYPE;
+        default:
+            EFFECT_LOGE("Not set input data!");
+            return ErrorCode::ERR_NOT_SET_INPUT_DATA;
+    }
+
+    uint64_t asyncGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex_);
+        asyncGeneration = asyncGeneration_;
+        pendingAsyncCount_++;
+    }
+    // the render uses what is set now, a callback of an earlier render may change it before this one starts.
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
+    auto task = std::make_shared<RenderTask<>>([this, callback, asyncGeneration, inDateInfo = inDateInfo_,
+        outDateInfo = outDateInfo_, efilters = efilters_]() {
+        ErrorCode res = ErrorCode::ERR_CANCELED;
+        if (!IsAsyncCanceled(asyncGeneration)) {
+            res = RenderSubmitted(inDateInfo, outDateInfo, efilters);
+        }
+        callback(res);
+        {
+            std::lock_guard<std::mutex> lock(asyncMutex_);
+            pendingAsyncCount_--;
+        }
+        asyncCond_.notify_all();
+    }, ASYNC_TASK_TAG, RequestTaskId());
+    lock.unlock();
+    task->SetPriority(renderPriorityFlag_ ? RenderTaskPriority::INTERACTIVE : RenderTaskPriority::STILL);
+    m_renderThread->AddTask(task);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode ImageEffect::RenderSubmitted(const DataInfo &inDateInfo, const DataInfo &outDateInfo,
+    const std::vector<std::shared_ptr<EFilter>> &efilters)
+{
+    // runs on the render thread, where only the callbacks of earlier renders change the effect. What they set is
+    // put back after the render, so it applies to the renders queued after them.
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
+    DataInfo currentInDateInfo = inDateInfo_;
+    DataInfo currentOutDateInfo = outDateInfo_;
+    std::vector<std::shared_ptr<EFilter>> currentEFilters = efilters_;
+    bool isEFiltersChanged = efilters != efilters_;
+    inDateInfo_ = inDateInfo;
+    outDateInfo_ = outDateInfo;
+    if (isEFiltersChanged) {
+        efilters_ = efilters;
+        impl_->CreatePipeline(efilters_);
+    }
+    lock.unlock();
+
+    impl_->effectState_ = EffectState::RUNNING;
+    ErrorCode res = Render();
+    Stop();
+
+    lock.lock();
+    inDateInfo_ = currentInDateInfo;
+    outDateInfo_ = currentOutDateInfo;
+    if (isEFiltersChanged) {
+        efilters_ = currentEFilters;
+        impl_->CreatePipeline(efilters_);
+    }
+    return res;
+}
+
+void ImageEffect::CancelAsync()
+{
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    asyncGeneration_++;
+}
+
+bool ImageEffect::IsAsyncCanceled(uint64_t asyncGeneration)
+{
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    return asyncGeneration != asyncGeneration_;
+}
+
+void ImageEffect::WaitAsyncFinished()
+{
+    if (m_renderThread->IsRunningTask()) {
+        return; // called from a callback, the renders still queued run after it returns.
+    }
+    std::unique_lock<std::mutex> lock(asyncMutex_);
+    asyncCond_.wait(lock, [this]() { return pendingAsyncCount_ == 0; });
+}
+
+bool ImageEffect::IsAsyncPending()
+{
+    if (m_renderThread->IsRunningTask()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(asyncMutex_);
+    return pendingAsyncCount_ > 0;
+}
+
+struct ImageEffect::BatchRenderState {
+    BatchRenderState(const std::vector<BatchRenderItem> &items, const BatchRenderCallback &callback)
+        : items(items), callback(callback), results(items.size(), ErrorCode::ERR_UNKNOWN) {}
+
+    bool Next(size_t &index)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (nextIndex >= items.size()) {
+            return false;
+        }
+        index = nextIndex++;
+        return true;
+    }
+
+    void Finish(size_t index, ErrorCode result)
+    {
+        if (callback != nullptr) {
+            callback(static_cast<uint32_t>(index), result);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            results[index] = result;
+            finishedCount++;
+        }
+        cond.notify_all();
+    }
+
+    std::vector<ErrorCode> Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return finishedCount == items.size(); });
+        return results;
+    }
+
+    // copies, the last lane may still be looking for work after the caller has returned.
+    const std::vector<BatchRenderItem> items;
+    const BatchRenderCallback callback;
+    std::vector<ErrorCode> results;
+    std::mutex mutex;
+    std::condition_variable cond;
+    size_t nextIndex = 0;
+    size_t finishedCount = 0;
+};
+
+ErrorCode ImageEffect::RenderBatch(const std::vector<BatchRenderItem> &items, uint32_t maxConcurrency,
+    std::vector<ErrorCode> &results, const BatchRenderCallback &callback)
+{
+    CHECK_AND_RETURN_RET_LOG(!items.empty(), ErrorCode::ERR_INPUT_NULL, "RenderBatch: items is empty!");
+    CHECK_AND_RETURN_RET_LOG(maxConcurrency >= 1 && maxConcurrency <= MAX_BATCH_CONCURRENCY,
+        ErrorCode::ERR_VALUE_OUT_OF_RANGE, "RenderBatch: maxConcurrency out of range! maxConcurrency=%{public}u",
+        maxConcurrency);
+    CHECK_AND_RETURN_RET_LOG(!efilters_.empty(), ErrorCode::ERR_NOT_FILTERS_WITH_RENDER,
+        "RenderBatch: efilters is empty");
+    CHECK_AND_RETURN_RET_LOG(inDateInfo_.dataType_ != DataType::SURFACE, ErrorCode::ERR_UNSUPPORTED_DATA_TYPE,
+        "RenderBatch: not support while the input is a surface!");
+    // waiting for the lanes would hold up the render thread, whose worker the lanes may share.
+    CHECK_AND_RETURN_RET_LOG(!m_renderThread->IsRunningTask(), ErrorCode::ERR_INVALID_OPERATION,
+        "RenderBatch: not support on the render thread, e.g. from an asynchronous render callback!");
+
+    // every lane runs on an execution context that is handed back after the batch, the input, output and render
+    // state of this effect are left untouched.
+    std::vector<std::shared_ptr<ImageEffect>> lanes;
+    size_t laneCount = std::min(static_cast<size_t>(maxConcurrency), items.size());
+    for (size_t i = 0; i < laneCount; ++i) {
+        std::shared_ptr<ImageEffect> lane = AcquireExecutionContext();
+        if (lane == nullptr) {
+            EFFECT_LOGW("RenderBatch: create lane fail, render with %{public}zu lanes", lanes.size());
+            break;
+        }
+        lanes.emplace_back(lane);
+    }
+    CHECK_AND_RETURN_RET_LOG(!lanes.empty(), ErrorCode::ERR_INVALID_OPERATION, "RenderBatch: no lane to render!");
+    EFFECT_LOGI("RenderBatch: itemCount=%{public}zu, laneCount=%{public}zu", items.size(), lanes.size());
+
+    auto state = std::make_shared<BatchRenderState>(items, callback);
+    for (auto &lane : lanes) {
+        RunBatchLane(lane.get(), state);
+    }
+    results = state->Wait();
+    return ErrorCode::SUCCESS;
+}
+
+void ImageEffect::ExecutionContextPool::TrimLocked(Clock::time_point now, std::chrono::milliseconds idleTimeout,
+    std::vector<IdleContext> &evicted)
+{
+    auto it = idle.begin();
+    while (it != idle.end() && now - it->idleSince >= idleTimeout) {
+        ++it;
+    }
+    std::move(idle.begin(), it, std::back_inserter(evicted));
+    idle.erase(idle.begin(), it);
+}
+
+std::shared_ptr<ImageEffect> ImageEffect::AcquireExecutionContext()
+{
+    std::shared_ptr<const ConfigSnapshot> snapshot = GetConfigSnapshot();
+    CHECK_AND_RETURN_RET_LOG(snapshot != nullptr, nullptr, "AcquireExecutionContext: snapshot fail!");
+    std::unique_ptr<ImageEffect> context = nullptr;
+    std::vector<ExecutionContextPool::IdleContext> evicted;
+    {
+        std::lock_guard<std::mutex> lock(executionContextPool_->mutex);
+        if (executionContextPool_->snapshot != snapshot) {
+            // copied from an older configuration, they are torn down below, outside of the lock.
+            evicted.swap(executionContextPool_->idle);
+            executionContextPool_->snapshot = snapshot;
+        } else {
+            executionContextPool_->TrimLocked(ExecutionContextPool::Clock::now(),
+                std::chrono::milliseconds(EXECUTION_CONTEXT_IDLE_TIMEOUT_MS), evicted);
+            if (!executionContextPool_->idle.empty()) {
+                context = std::move(executionContextPool_->idle.back().context);
+                executionContextPool_->idle.pop_back();
+            }
+        }
+    }
+    evicted.clear();
+
+    if (context == nullptr) {
+        context = CreateExecutionContext(*snapshot);
+        CHECK_AND_RETURN_RET_LOG(context != nullptr, nullptr, "AcquireExecutionContext: create context fail!");
+    }
+    std::weak_ptr<ExecutionContextPool> pool = executionContextPool_;
+    return std::shared_ptr<ImageEffect>(context.release(), [pool, snapshot](ImageEffect *effect) {
+        RecycleExecutionContext(pool, snapshot, effect);
+    });
+}
+
+void ImageEffect::TrimExecutionContexts(std::chrono::milliseconds idleTimeout)
+{
+    std::vector<ExecutionContextPool::IdleContext> evicted;
+    std::lock_guard<std::mutex> lock(executionContextPool_->mutex);
+    executionContextPool_->TrimLocked(ExecutionContextPool::Clock::now(), idleTimeout, evicted);
+    EFFECT_LOGD("TrimExecutionContexts: evictedCount=%{public}zu, idleCount=%{public}zu", evicted.size(),
+        executionContextPool_->idle.size());
+}
+
+void ImageEffect::RecycleExecutionContext(const std::weak_ptr<ExecutionContextPool> &pool,
+    const std::shared_ptr<const ConfigSnapshot> &snapshot, ImageEffect *context)
+{
+    // declared before the lock, a context that is not kept is torn down after the lock is released.
+    std::unique_ptr<ImageEffect> owner(context);
+    std::vector<ExecutionContextPool::IdleContext> evicted;
+    owner->WaitAsyncFinished();
+    ClearDataInfo(owner->inDateInfo_);
+    ClearDataInfo(owner->outDateInfo_);
+
+    std::shared_ptr<ExecutionContextPool> contextPool = pool.lock();
+    if (contextPool == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(contextPool->mutex);
+    ExecutionContextPool::Clock::time_point now = ExecutionContextPool::Clock::now();
+    contextPool->TrimLocked(now, std::chrono::milliseconds(EXECUTION_CONTEXT_IDLE_TIMEOUT_MS), evicted);
+    if (contextPool->snapshot != snapshot || contextPool->idle.size() >= MAX_BATCH_CONCURRENCY) {
+        return;
+    }
+    contextPool->idle.push_back({ std::move(owner), now });
+}
+
+std::shared_ptr<const ImageEffect::ConfigSnapshot> ImageEffect::GetConfigSnapshot()
+{
+    // filter values may be set on the filters directly, so their value generations are part of the key. The filters
+    // are saved only when one of the generations moved, not on every acquire.
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
+    std::vector<uint32_t> generations = { configGeneration_.load() };
+    for (const auto &efilter : efilters_) {
+        generations.emplace_back(efilter->GetValueGeneration());
+    }
+    if (configSnapshot_ != nullptr && configSnapshot_->generations == generations) {
+        return configSnapshot_;
+    }
+
+    auto snapshot = std::make_shared<ConfigSnapshot>();
+    snapshot->generations = std::move(generations);
+    for (const auto &efilter : efilters_) {
+        EffectJsonPtr info = EffectJsonHelper::CreateObject();
+        ErrorCode res = efilter->Save(info);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr,
+            "GetConfigSnapshot: efilter save fail! name=%{public}s, res=%{public}d", efilter->GetName().c_str(), res);
+        snapshot->efilters.emplace_back(efilter->GetName(), info);
+    }
+    configSnapshot_ = snapshot;
+    return configSnapshot_;
+}
+
+std::unique_ptr<ImageEffect> ImageEffect::CreateExecutionContext(const ConfigSnapshot &snapshot)
+{
+    // the filter parameters are copied, the render state is the context's own. LUTs and pooled buffers come from the
+    // process wide LutCache and EffectMemoryPool, so they are shared with this effect and the other contexts.
+    std::unique_ptr<ImageEffect> context = std::make_unique<ImageEffect>(name_.c_str());
+    for (const auto &efilter : snapshot.efilters) {
+        std::shared_ptr<EFilter> copy = EFilterFactory::Instance()->Restore(efilter.first, efilter.second, nullptr);
+        CHECK_AND_RETURN_RET_LOG(copy != nullptr, nullptr,
+            "CreateExecutionContext: efilter restore fail! name=%{public}s", efilter.first.c_str());
+        context->efilters_.emplace_back(copy);
+    }
+
+    std::unique_lock<std::mutex> lock(innerEffectMutex_);
+    context->config_ = config_;
+    context->configIpType_ = configIpType_;
+    context->defaultQuality_ = defaultQuality_;
+    context->needsDecodeDfxData_ = needsDecodeDfxData_;
+    context->needsPackDfxData_ = needsPackDfxData_;
+    context->impl_->isLutFusionEnabled_ = impl_->isLutFusionEnabled_;
+    context->impl_->effectContext_->isStripRenderEnabled_ = impl_->effectContext_->isStripRenderEnabled_;
+    context->impl_->effectContext_->memoryManager_->SetLargeHeapPolicy(
+        impl_->effectContext_->memoryManager_->GetLargeHeapPolicy());
+    lock.unlock();
+    context->impl_->CreatePipeline(context->efilters_);
+    return context;
+}
+
+void ImageEffect::RunBatchLane(ImageEffect *lane, const std::shared_ptr<BatchRenderState> &state)
+{
+    // an item is rendered asynchronously on the render thread of the lane, which picks up the next one when done.
+    size_t index = 0;
+    while (state->Next(index)) {
+        const BatchRenderItem &item = state->items[index];
+        ErrorCode res = lane->SetInputPath(item.inputPath);
+        if (res == ErrorCode::SUCCESS) {
+            res = lane->SetOutputPath(item.outputPath);
+        }
+        if (res == ErrorCode::SUCCESS) {
+            res = lane->RenderAsync([lane, state, index](ErrorCode result) {
+                state->Finish(index, result);
+                RunBatchLane(lane, state);
+            });
+        }
+        if (res == ErrorCode::SUCCESS) {
+            return;
+        }
+        EFFECT_LOGE("RunBatchLane: item fail! index=%{public}zu, res=%{public}d", index, res);
+        state->Finish(index, res);
+    }
+}
+
 void ImageEffect::Stop()
 {
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
@@ -591,9 +1016,13 @@ void ImageEffect::Stop()
     impl_->effectContext_->logStrategy_ = LOG_STRATEGY::NORMAL;
     if (inDateInfo_.dataType_ == DataType::SURFACE && IncludeCameraColorFilter()) {
         EFFECT_LOGD("ImageEffect::Stop in wait tasks.");
+        std::shared_ptr<PresentThread> presentThread = m_presentThread;
         lock.unlock();
 
         m_renderThread->WaitTaskFinished();
+        if (presentThread != nullptr) {
+            presentThread->WaitTaskFinished();
+        }
     }
     impl_->effectContext_->memoryManager_->ClearMemory();
 
@@ -602,6 +1031,7 @@ void ImageEffect::Stop()
 
 ErrorCode ImageEffect::SetInputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer)
 {
+    WaitAsyncFinished();
     CHECK_AND_RETURN_RET_LOG(surfaceBuffer != nullptr, ErrorCode::ERR_INVALID_SRC_SURFACEBUFFER,
         "invalid source surface buffer");
     if (needPreFlush_) {
@@ -617,6 +1047,7 @@ ErrorCode ImageEffect::SetInputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer)
 
 ErrorCode ImageEffect::SetOutputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer)
 {
+    WaitAsyncFinished();
     ClearDataInfo(outDateInfo_);
     if (surfaceBuffer == nullptr) {
         EFFECT_LOGI("SetOutputSurfaceBuffer: surfaceBuffer set to null!");
@@ -631,6 +1062,7 @@ ErrorCode ImageEffect::SetOutputSurfaceBuffer(OHOS::SurfaceBuffer *surfaceBuffer
 
 ErrorCode ImageEffect::SetInputUri(const std::string &uri)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetInputUri");
     if (!CommonUtils::EndsWithJPG(uri) && !CommonUtils::EndsWithHEIF(uri)) {
         EFFECT_LOGE("SetInputUri: file type is not support! only support jpg/jpeg and heif.");
@@ -645,6 +1077,7 @@ ErrorCode ImageEffect::SetInputUri(const std::string &uri)
 
 ErrorCode ImageEffect::SetOutputUri(const std::string &uri)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetOutputUri");
     if (uri.empty()) {
         EFFECT_LOGI("SetOutputUri: uri set to null!");
@@ -670,11 +1103,13 @@ ErrorCode ImageEffect::SetDefaultQuality(int32_t quality)
         "quality out of range. quality=%{public}d", quality);
     
     defaultQuality_ = quality;
+    configGeneration_++;
     return ErrorCode::SUCCESS;
 }
 
 ErrorCode ImageEffect::SetInputPath(const std::string &path)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetInputPath");
     if (!CommonUtils::EndsWithJPG(path) && !CommonUtils::EndsWithHEIF(path)) {
         EFFECT_LOGE("SetInputPath: file type is not support! only support jpg/jpeg and heif.");
@@ -690,6 +1125,7 @@ ErrorCode ImageEffect::SetInputPath(const std::string &path)
 
 ErrorCode ImageEffect::SetOutputPath(const std::string &path)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetOutputPath");
     if (path.empty()) {
         EFFECT_LOGI("SetOutputPath: path set to null!");
@@ -975,6 +1411,7 @@ ErrorCode ImageEffect::Render()
     std::shared_ptr<ImageSourceFilter> &sourceFilter = impl_->srcFilter_;
     sourceFilter->SetNegotiateParameter(width, height, format, impl_->effectContext_);
 
+    impl_->UpdatePipelineIfNeed(efilters_);
     res = impl_->pipeline_->Prepare();
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "pipeline prepare fail! res=%{public}d", res);
 
@@ -998,11 +1435,13 @@ ErrorCode ImageEffect::Render()
     std::shared_ptr<EffectBuffer> outBuffer = dstEffectBuffer != nullptr ? dstEffectBuffer : srcEffectBuffer;
     impl_->effectContext_->renderEnvironment_->SetOutputType(outBuffer->extraInfo_->dataType);
     EffectParameters effectParameters(srcEffectBuffer, dstEffectBuffer, config_, impl_->effectContext_);
-    bool isNeedCreateThread = !impl_->isQosEnabled_ && srcEffectBuffer->extraInfo_->dataType != DataType::TEX;
+    // already on the render thread, e.g. for an asynchronous render, the pipeline runs inline.
+    bool isNeedCreateThread = !impl_->isQosEnabled_ && srcEffectBuffer->extraInfo_->dataType != DataType::TEX &&
+        !m_renderThread->IsRunningTask();
     RenderMode renderMode;
     renderMode.isNeedCreateThread = isNeedCreateThread;
     renderMode.isNeedPriority = renderPriorityFlag_;
-    res = StartPipeline(impl_->pipeline_, effectParameters, RequestTaskId(), m_renderThread, renderMode);
+    res = StartPipeline(impl_->pipeline_, effectParameters, RequestTaskId(), m_renderThread.get(), renderMode);
     renderPriorityFlag_ = false;
     if (res != ErrorCode::SUCCESS) {
         EFFECT_LOGE("StartPipeline fail! res=%{public}d", res);
@@ -1100,6 +1539,7 @@ ErrorCode ImageEffect::Load(std::string &info)
 
 ErrorCode ImageEffect::SetOutputPixelMap(PixelMap* pixelMap)
 {
+    WaitAsyncFinished();
     std::unique_lock<std::mutex> lock(innerEffectMutex_);
     EFFECT_LOGD("ImageEffect::SetOutputPixelMap");
     ClearDataInfo(outDateInfo_);
@@ -1154,8 +1594,55 @@ void ImageEffect::UpdateProducerSurfaceInfo()
     toProducerSurface_->SetTransform(transform);
 }
 
+bool IsYuvFormat(IEffectFormat format)
+{
+    return format == IEffectFormat::YUVNV12 || format == IEffectFormat::YUVNV21 ||
+        format == IEffectFormat::YCBCR_P010 || format == IEffectFormat::YCRCB_P010;
+}
+
+// Luma and chroma planes of a yuv surface buffer as laid out by the allocator, which may pad or move the chroma plane.
+bool GetSurfaceBufferPlanes(sptr<SurfaceBuffer> &buffer, IEffectFormat format, std::vector<CopyPlane> &planes)
+{
+    OH_NativeBuffer_Planes *planesInfo = nullptr;
+    GSError retVal = buffer->GetPlanesInfo(reinterpret_cast<void **>(&planesInfo));
+    if (retVal != OHOS::GSERROR_OK || planesInfo == nullptr || planesInfo->planeCount < YUV_PLANE_COUNT) {
+        return false;
+    }
+    uint32_t uvPlaneIndex = (format == IEffectFormat::YUVNV12 || format == IEffectFormat::YCBCR_P010) ? 1 : 2;
+    if (uvPlaneIndex >= planesInfo->planeCount) {
+        return false;
+    }
+    uint32_t height = static_cast<uint32_t>(buffer->GetHeight());
+    uint32_t rowBytes = FormatHelper::CalculateRowStride(static_cast<uint32_t>(buffer->GetWidth()), format);
+    const OH_NativeBuffer_Plane &yPlane = planesInfo->planes[0];
+    const OH_NativeBuffer_Plane &uvPlane = planesInfo->planes[uvPlaneIndex];
+    uint32_t uvHeight = (height + 1) / YUV_HALF;
+    uint64_t yEnd = yPlane.offset + static_cast<uint64_t>(yPlane.columnStride) * height;
+    uint64_t uvEnd = uvPlane.offset + static_cast<uint64_t>(uvPlane.columnStride) * uvHeight;
+    if (height == 0 || yPlane.columnStride < rowBytes || uvPlane.columnStride < rowBytes ||
+        std::max(yEnd, uvEnd) > buffer->GetSize()) {
+        return false;
+    }
+    auto *data = static_cast<uint8_t *>(buffer->GetVirAddr());
+    planes = {
+        { data + yPlane.offset, static_cast<uint32_t>(yPlane.columnStride), rowBytes, height },
+        { data + uvPlane.offset, static_cast<uint32_t>(uvPlane.columnStride), rowBytes, uvHeight },
+    };
+    return true;
+}
+
 void MemoryCopyForSurfaceBuffer(sptr<SurfaceBuffer> &buffer, OHOS::sptr<SurfaceBuffer> &outBuffer)
 {
+    IEffectFormat format = CommonUtils::SwitchToEffectFormat((GraphicPixelFormat)buffer->GetFormat());
+    IEffectFormat outFormat = CommonUtils::SwitchToEffectFormat((GraphicPixelFormat)outBuffer->GetFormat());
+    std::vector<CopyPlane> srcPlanes;
+    std::vector<CopyPlane> dstPlanes;
+    if (IsYuvFormat(format) && format == outFormat && GetSurfaceBufferPlanes(buffer, format, srcPlanes) &&
+        GetSurfaceBufferPlanes(outBuffer, outFormat, dstPlanes) &&
+        MemcpyHelper::CopyPlanes(srcPlanes, dstPlanes) == ErrorCode::SUCCESS) {
+        return;
+    }
+
     CopyInfo src = {
         .bufferInfo = {
             .width_ = static_cast<uint32_t>(buffer->GetWidth()),
@@ -1235,13 +1722,61 @@ void ImageEffect::RenderBuffer()
         .timestamp_ = entry->timestamp_,
     };
     impl_->effectContext_->renderEnvironment_->NotifyInputChanged();
-    this->Render();
+    ErrorCode res = this->Render();
     if (impl_->effectContext_->logStrategy_ == LOG_STRATEGY::NORMAL) {
         impl_->effectContext_->logStrategy_ = LOG_STRATEGY::LIMITED;
     }
+    if (res != ErrorCode::SUCCESS) {
+        // the buffer holds the unfiltered input, it must not be shown as the output.
+        EFFECT_LOGE("RenderBuffer: render fail! frame=%{public}d, res=%{public}d", entry->buffer_->GetSeqNum(), res);
+        DropBufferEntry(*entry);
+        return;
+    }
+    renderedFrameCount_++;
+
+    // at most framesInFlight - 1 rendered frames wait for the present stage, a full stage holds the render strand
+    // back. Presenting inline still waits for the frames handed over before, so that frames are flushed in order.
+    // The output surface is taken under the lock, SetOutputSurface may replace it while the frame is presented,
+    // and the lock is released before the wait and the flush, which do not touch the render state.
+    int32_t maxPresentingCount = framesInFlight_ - 1;
+    sptr<Surface> surface = toProducerSurface_;
+    lock.unlock();
+    {
+        std::unique_lock<std::mutex> presentLock(presentMutex_);
+        presentCond_.wait(presentLock,
+            [this, maxPresentingCount]() { return presentingCount_ < std::max(maxPresentingCount, 1); });
+        if (maxPresentingCount <= 0) {
+            presentLock.unlock();
+            PresentBuffer(*entry, surface);
+            return;
+        }
+        presentingCount_++;
+    }
+
+    auto presentThread = GetPresentThread();
+    auto task = std::make_shared<RenderTask<>>([this, presentEntry = std::move(*entry), surface]() mutable {
+        PresentBuffer(presentEntry, surface);
+        std::unique_lock<std::mutex> presentLock(presentMutex_);
+        presentingCount_--;
+        presentLock.unlock();
+        presentCond_.notify_all();
+    }, COMMON_TASK_TAG, RequestTaskId());
+    presentThread->AddTask(task);
+}
+
+std::shared_ptr<ImageEffect::PresentThread> ImageEffect::GetPresentThread()
+{
+    if (m_presentThread == nullptr) {
+        m_presentThread = std::make_shared<PresentThread>(MAX_FRAMES_IN_FLIGHT);
+        m_presentThread->Start();
+    }
+    return m_presentThread;
+}
 
-    EFFECT_LOGD("ProcessRender: FlushBuffer: %{public}d", entry->buffer_->GetSeqNum());
-    auto ret = FlushBuffer(entry->buffer_, entry->syncFence_, true, true, entry->timestamp_);
+void ImageEffect::PresentBuffer(BufferEntry &entry, const sptr<Surface> &surface)
+{
+    EFFECT_LOGD("ProcessRender: FlushBuffer: %{public}d", entry.buffer_->GetSeqNum());
+    auto ret = FlushBuffer(surface, entry.buffer_, entry.syncFence_, true, true, entry.timestamp_);
     CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "ProcessRender: FlushBuffer fail! ret=%{public}d", ret);
 }
 
@@ -1261,6 +1796,12 @@ BufferRequestConfig ImageEffect::GetBufferRequestConfig(const sptr<SurfaceBuffer
 
 GSError ImageEffect::FlushBuffer(sptr<SurfaceBuffer>& flushBuffer, sptr<SyncFence>& syncFence, bool isNeedAttach,
     bool isSendFence, int64_t& timestamp)
+{
+    return FlushBuffer(toProducerSurface_, flushBuffer, syncFence, isNeedAttach, isSendFence, timestamp);
+}
+
+GSError ImageEffect::FlushBuffer(const sptr<Surface> &surface, sptr<SurfaceBuffer>& flushBuffer,
+    sptr<SyncFence>& syncFence, bool isNeedAttach, bool isSendFence, int64_t& timestamp)
 {
     BufferFlushConfig flushConfig = {
         .damage = {
@@ -1272,19 +1813,19 @@ GSError ImageEffect::FlushBuffer(sptr<SurfaceBuffer>& flushBuffer, sptr<SyncFenc
 
     CHECK_AND_RETURN_RET_LOG(imageEffectFlag_.load(std::memory_order_acquire) == STRUCT_IMAGE_EFFECT_CONSTANT,
         GSERROR_NOT_INIT, "FlushBuffer: ImageEffect not exist.");
-    CHECK_AND_RETURN_RET_LOG(toProducerSurface_ != nullptr, GSERROR_NOT_INIT,
+    CHECK_AND_RETURN_RET_LOG(surface != nullptr, GSERROR_NOT_INIT,
         "FlushBuffer: toProducerSurface is nullptr.");
 
     auto ret = GSError::GSERROR_OK;
     const sptr<SyncFence> invalidFence = SyncFence::InvalidFence();
     if (isNeedAttach) {
-        ret = toProducerSurface_->AttachAndFlushBuffer(flushBuffer, isSendFence ? syncFence : invalidFence,
+        ret = surface->AttachAndFlushBuffer(flushBuffer, isSendFence ? syncFence : invalidFence,
             flushConfig, false);
         if (ret != GSError::GSERROR_OK) {
             EFFECT_LOGE("AttachAndFlushBuffer: attach and flush buffer failed. %{public}d", ret);
         }
     } else {
-        ret = toProducerSurface_->FlushBuffer(flushBuffer, isSendFence ? syncFence : invalidFence, flushConfig);
+        ret = surface->FlushBuffer(flushBuffer, isSendFence ? syncFence : invalidFence, flushConfig);
         if (ret != GSError::GSERROR_OK) {
             EFFECT_LOGE("FlushBuffer: flush buffer failed. %{public}d", ret);
         }
@@ -1302,20 +1843,77 @@ GSError ImageEffect::ReleaseBuffer(sptr<OHOS::SurfaceBuffer> &buffer, sptr<OHOS:
     return ret;
 }
 
+bool ImageEffect::AdmitSurfaceFrame(BufferProcessInfo &bufferProcessInfo, bool &isNeedSwap)
+{
+    SurfaceOverloadPolicy policy = overloadPolicy_.load(std::memory_order_relaxed);
+    if (bufferPool_ == nullptr || policy == SurfaceOverloadPolicy::LATEST_FRAME_WINS) {
+        // the stale frames make room for this one when it is submitted.
+        return true;
+    }
+    if (policy == SurfaceOverloadPolicy::PASSTHROUGH) {
+        if (!bufferPool_->IsFull()) {
+            return true;
+        }
+        passedThroughFrameCount_++;
+        return false;
+    }
+
+    // only this thread pushes to the buffer pool, the slot stays free until the frame is submitted.
+    if (bufferPool_->WaitNotFull()) {
+        return true;
+    }
+    EFFECT_LOGW("AdmitSurfaceFrame: bufferPool is full, drop frame %{public}d",
+        bufferProcessInfo.inBuffer_->GetSeqNum());
+    ReleaseBuffer(bufferProcessInfo.inBuffer_, bufferProcessInfo.inBufferSyncFence_);
+    droppedFrameCount_++;
+    isNeedSwap = false;
+    return false;
+}
+
 bool ImageEffect::SubmitRenderTask(BufferEntry &&entry)
 {
-    bool success = bufferPool_->TryPush(std::move(entry));
+    bool success = true;
+    bool isNeedTask = true;
+    if (overloadPolicy_.load(std::memory_order_relaxed) == SurfaceOverloadPolicy::LATEST_FRAME_WINS) {
+        std::vector<BufferEntry> staleEntries = bufferPool_->ReplaceAll(std::move(entry));
+        for (auto &staleEntry : staleEntries) {
+            DropBufferEntry(staleEntry);
+        }
+        // the render task queued for a replaced frame renders this one instead.
+        isNeedTask = staleEntries.empty();
+    } else {
+        success = bufferPool_->TryPush(std::move(entry), false);
+    }
     EFFECT_LOGD("SubmitRenderTask: bufferPool size: %{public}d", (int)bufferPool_->Size());
     CHECK_AND_RETURN_RET_LOG(m_renderThread, true, "SubmitRenderTask: m_renderThread is null!");
     CHECK_AND_RETURN_RET_LOG(success, true, "SubmitRenderTask: bufferPool push failed!");
+    if (!isNeedTask) {
+        return false;
+    }
 
     auto task = std::make_shared<RenderTask<>>([this]() {
         RenderBuffer();
     }, COMMON_TASK_TAG + 1, m_currentTaskId.fetch_add(1));
+    // frames go ahead of queued still renders. They are never dropped when late, each one owns an entry of the
+    // buffer pool that has to be rendered and flushed.
+    task->SetPriority(RenderTaskPriority::INTERACTIVE);
+    task->SetDeadline(RenderTaskClock::now() + std::chrono::milliseconds(SURFACE_FRAME_DEADLINE_MS));
     m_renderThread->AddTask(task);
     return false;
 }
 
+void ImageEffect::DropBufferEntry(BufferEntry &entry)
+{
+    droppedFrameCount_++;
+    EFFECT_LOGD("DropBufferEntry: drop frame %{public}d", entry.buffer_->GetSeqNum());
+    CHECK_AND_RETURN_LOG(toProducerSurface_ != nullptr, "DropBufferEntry: toProducerSurface is nullptr.");
+    // the frame took the place of an output buffer in the swap, it goes back to the output queue without being shown.
+    auto ret = toProducerSurface_->AttachBufferToQueue(entry.buffer_);
+    CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "DropBufferEntry: AttachBufferToQueue fail! ret=%{public}d", ret);
+    ret = toProducerSurface_->CancelBuffer(entry.buffer_);
+    CHECK_AND_RETURN_LOG(ret == GSError::GSERROR_OK, "DropBufferEntry: CancelBuffer fail! ret=%{public}d", ret);
+}
+
 void ImageEffect::ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNeedSwap, int64_t& timestamp)
 {
     auto& [inBuffer, outBuffer, inBufferSyncFence, outBufferSyncFence, isSrcHebcData] = bufferProcessInfo;
@@ -1454,6 +2052,9 @@ void ImageEffect::OnBufferAvailableWithCPU()
         .isSrcHebcData_ = isSrcHebcData,
     };
 
+    if (isNeedRender) {
+        isNeedRender = AdmitSurfaceFrame(bufferProcessInfo, isNeedSwap);
+    }
     if (isNeedRender) {
         EFFECT_TRACE_BEGIN("ProcessRender");
         ProcessRender(bufferProcessInfo, isNeedSwap, timestamp);
@@ -1525,6 +2126,16 @@ sptr<Surface> ImageEffect::GetInputSurface()
     return fromProducerSurface_;
 }
 
+SurfaceStreamStats ImageEffect::GetSurfaceStreamStats() const
+{
+    SurfaceStreamStats stats;
+    stats.policy = overloadPolicy_.load();
+    stats.renderedCount = renderedFrameCount_.load();
+    stats.droppedCount = droppedFrameCount_.load();
+    stats.passedThroughCount = passedThroughFrameCount_.load();
+    return stats;
+}
+
 void ImageEffect::SetRenderPriorityFlag(bool renderPriorityFlag)
 {
     renderPriorityFlag_ = renderPriorityFlag;
@@ -1550,6 +2161,7 @@ ErrorCode ImageEffect::SetOutNativeWindow(OHNativeWindow *nativeWindow)
 
 ErrorCode ImageEffect::Configure(const std::string &key, const Any &value)
 {
+    WaitAsyncFinished();
     if (FUNCTION_FLUSH_SURFACE_BUFFER.compare(key) == 0) {
         EFFECT_LOGI("ImageEffect Configure FlushCache");
         needPreFlush_ = true;
@@ -1568,20 +2180,90 @@ ErrorCode ImageEffect::Configure(const std::string &key, const Any &value)
             ErrorCode result = CommonUtils::ParseAny(value, runningType);
             CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
                 "parse any fail! expect type is uint32_t! key=%{public}s", key.c_str());
-            configIpType_ = runningType;
             auto it = std::find_if(runningTypeTab_.begin(), runningTypeTab_.end(),
                 [&runningType](const std::pair<int32_t, std::vector<IPType>> &item) {
                     return item.first == runningType;
                 });
+            std::unique_lock<std::mutex> lock(innerEffectMutex_);
+            configIpType_ = runningType;
             CHECK_AND_RETURN_RET_LOG(it != runningTypeTab_.end(), ErrorCode::ERR_UNSUPPORTED_RUNNINGTYPE,
                 "not support runningType! key=%{public}s, runningType=%{public}d", key.c_str(), runningType);
             config_[configType] = it->second;
             break;
         }
+        case ConfigType::LUT_FUSION: {
+            bool isLutFusionEnabled;
+            ErrorCode result = CommonUtils::ParseAny(value, isLutFusionEnabled);
+            CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+                "parse any fail! expect type is bool! key=%{public}s", key.c_str());
+            EFFECT_LOGI("ImageEffect Configure lutFusion=%{public}d", isLutFusionEnabled);
+            std::unique_lock<std::mutex> lock(innerEffectMutex_);
+            // the pipeline is rebuilt by the next render, see UpdatePipelineIfNeed.
+            impl_->isLutFusionEnabled_ = isLutFusionEnabled;
+            break;
+        }
+        case ConfigType::STRIP_RENDER: {
+            bool isStripRenderEnabled;
+            ErrorCode result = CommonUtils::ParseAny(value, isStripRenderEnabled);
+            CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+                "parse any fail! expect type is bool! key=%{public}s", key.c_str());
+            EFFECT_LOGI("ImageEffect Configure stripRender=%{public}d", isStripRenderEnabled);
+            std::unique_lock<std::mutex> lock(innerEffectMutex_);
+            impl_->effectContext_->isStripRenderEnabled_ = isStripRenderEnabled;
+            break;
+        }
+        case ConfigType::HUGE_PAGE:
+        case ConfigType::PREFAULT: {
+            bool isEnabled;
+            ErrorCode result = CommonUtils::ParseAny(value, isEnabled);
+            CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+                "parse any fail! expect type is bool! key=%{public}s", key.c_str());
+            EFFECT_LOGI("ImageEffect Configure %{public}s=%{public}d", key.c_str(), isEnabled);
+            std::unique_lock<std::mutex> lock(innerEffectMutex_);
+            std::shared_ptr<EffectMemoryManager> &memoryManager = impl_->effectContext_->memoryManager_;
+            LargeHeapPolicy policy = memoryManager->GetLargeHeapPolicy();
+            if (configType == ConfigType::HUGE_PAGE) {
+                policy.isHugePageEnabled = isEnabled;
+            } else {
+                policy.isPrefaultEnabled = isEnabled;
+            }
+            memoryManager->SetLargeHeapPolicy(policy);
+            break;
+        }
+        case ConfigType::FRAMES_IN_FLIGHT: {
+            int32_t framesInFlight;
+            ErrorCode result = CommonUtils::ParseAny(value, framesInFlight);
+            CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+                "parse any fail! expect type is int32_t! key=%{public}s", key.c_str());
+            CHECK_AND_RETURN_RET_LOG(framesInFlight >= MIN_FRAMES_IN_FLIGHT && framesInFlight <= MAX_FRAMES_IN_FLIGHT,
+                ErrorCode::ERR_VALUE_OUT_OF_RANGE, "framesInFlight out of range! framesInFlight=%{public}d",
+                framesInFlight);
+            EFFECT_LOGI("ImageEffect Configure framesInFlight=%{public}d", framesInFlight);
+            std::unique_lock<std::mutex> lock(innerEffectMutex_);
+            framesInFlight_ = framesInFlight;
+            break;
+        }
+        case ConfigType::OVERLOAD_POLICY: {
+            int32_t overloadPolicy;
+            ErrorCode result = CommonUtils::ParseAny(value, overloadPolicy);
+            CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result,
+                "parse any fail! expect type is int32_t! key=%{public}s", key.c_str());
+            CHECK_AND_RETURN_RET_LOG(overloadPolicy >= static_cast<int32_t>(SurfaceOverloadPolicy::BLOCK) &&
+                overloadPolicy <= static_cast<int32_t>(SurfaceOverloadPolicy::PASSTHROUGH),
+                ErrorCode::ERR_VALUE_OUT_OF_RANGE, "overloadPolicy out of range! overloadPolicy=%{public}d",
+                overloadPolicy);
+            EFFECT_LOGI("ImageEffect Configure overloadPolicy=%{public}d", overloadPolicy);
+            overloadPolicy_ = static_cast<SurfaceOverloadPolicy>(overloadPolicy);
+            renderedFrameCount_ = 0;
+            droppedFrameCount_ = 0;
+            passedThroughFrameCount_ = 0;
+            break;
+        }
         default:
             EFFECT_LOGE("config type is not support! configType=%{public}d", configType);
             return ErrorCode::ERR_UNSUPPORTED_CONFIG_TYPE;
     }
+    configGeneration_++;
     return ErrorCode::SUCCESS;
 }
 
@@ -1723,6 +2405,17 @@ void ImageEffect::InitEGLEnv()
     impl_->effectContext_->renderEnvironment_->Prepare();
 }
 
+void ImageEffect::BindEGLEnv()
+{
+    std::shared_ptr<RenderEnvironment> &renderEnvironment = impl_->effectContext_->renderEnvironment_;
+    if (renderEnvironment == nullptr || renderEnvironment->GetEGLStatus() != EGLStatus::READY) {
+        return;
+    }
+    if (!renderEnvironment->BeginFrame()) {
+        EFFECT_LOGE("ImageEffect BindEGLEnv: make current fail!");
+    }
+}
+
 void ImageEffect::DestroyEGLEnv()
 {
     EFFECT_LOGI("ImageEffect DestroyEGLEnv enter!");
@@ -1750,6 +2443,7 @@ void ImageEffect::ExtDeinitModule()
 
 ErrorCode ImageEffect::SetInputPicture(Picture *picture)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetInputPicture");
     CHECK_AND_RETURN_RET_LOG(picture != nullptr, ErrorCode::ERR_INPUT_NULL,
         "ImageEffect::SetInputPicture: picture is null!");
@@ -1764,6 +2458,7 @@ ErrorCode ImageEffect::SetInputPicture(Picture *picture)
 
 ErrorCode ImageEffect::SetOutputPicture(Picture *picture)
 {
+    WaitAsyncFinished();
     EFFECT_LOGD("ImageEffect::SetOutputPicture");
     ClearDataInfo(outDateInfo_);
 
@@ -1780,6 +2475,7 @@ ErrorCode ImageEffect::SetOutputPicture(Picture *picture)
 
 ErrorCode ImageEffect::SetInputTexture(int32_t textureId, int32_t colorSpace)
 {
+    WaitAsyncFinished();
     ClearDataInfo(inDateInfo_);
     inDateInfo_.dataType_ = DataType::TEX;
     CHECK_AND_RETURN_RET_LOG(textureId > 0, ErrorCode::ERR_INPUT_NULL,
@@ -1791,6 +2487,7 @@ ErrorCode ImageEffect::SetInputTexture(int32_t textureId, int32_t colorSpace)
 
 ErrorCode ImageEffect::SetOutputTexture(int32_t textureId)
 {
+    WaitAsyncFinished();
     ClearDataInfo(outDateInfo_);
     outDateInfo_.dataType_ = DataType::TEX;
     CHECK_AND_RETURN_RET_LOG(textureId > 0, ErrorCode::ERR_INPUT_NULL,
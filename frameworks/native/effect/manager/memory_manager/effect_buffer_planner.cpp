@@ -0,0 +1,94 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_buffer_planner.h"
+
+#include <algorithm>
+
+#include "effect_log.h"
+#include "format_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+uint64_t BufferPlan::GetPlannedBytes() const
+{
+    uint64_t bytes = 0;
+    for (uint64_t capacity : slotCapacities) {
+        bytes += capacity;
+    }
+    return bytes;
+}
+
+uint64_t BufferPlanner::CalculateBytes(uint32_t width, uint32_t height, IEffectFormat format)
+{
+    return static_cast<uint64_t>(FormatHelper::CalculatePaddedRowStride(width, format)) *
+        FormatHelper::CalculateDataRowCount(height, format);
+}
+
+namespace {
+int32_t ChooseSlot(const std::vector<uint64_t> &slotCapacities, int32_t liveSlot, uint64_t bytes)
+{
+    // every slot but the one being read is dead at this point, prefer the smallest that fits and grow the largest
+    // one otherwise, so that the total stays close to the two largest outputs.
+    int32_t bestFit = -1;
+    int32_t largest = -1;
+    for (int32_t slot = 0; slot < static_cast<int32_t>(slotCapacities.size()); slot++) {
+        if (slot == liveSlot) {
+            continue;
+        }
+        uint64_t capacity = slotCapacities[slot];
+        if (capacity >= bytes && (bestFit < 0 || capacity < slotCapacities[bestFit])) {
+            bestFit = slot;
+        }
+        if (largest < 0 || capacity > slotCapacities[largest]) {
+            largest = slot;
+        }
+    }
+    return bestFit >= 0 ? bestFit : largest;
+}
+} // namespace
+
+BufferPlan BufferPlanner::Plan(const BufferPlanStep &source, const std::vector<BufferPlanStep> &steps)
+{
+    BufferPlan plan;
+    plan.steps = steps;
+    const BufferPlanStep *input = &source;
+    int32_t liveSlot = -1;
+    for (BufferPlanStep &step : plan.steps) {
+        step.isInPlace = step.width == input->width && step.height == input->height && step.format == input->format;
+        if (step.isInPlace) {
+            step.slot = liveSlot;
+            continue;
+        }
+
+        uint64_t bytes = CalculateBytes(step.width, step.height, step.format);
+        int32_t slot = ChooseSlot(plan.slotCapacities, liveSlot, bytes);
+        if (slot < 0) {
+            slot = static_cast<int32_t>(plan.slotCapacities.size());
+            plan.slotCapacities.emplace_back(0);
+        }
+        plan.slotCapacities[slot] = std::max(plan.slotCapacities[slot], bytes);
+        step.slot = slot;
+        liveSlot = slot;
+        input = &step;
+    }
+    EFFECT_LOGD("BufferPlanner::Plan steps=%{public}zu, slots=%{public}zu", plan.steps.size(),
+        plan.slotCapacities.size());
+    return plan;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
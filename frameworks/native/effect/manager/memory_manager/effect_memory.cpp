@@ -15,6 +15,9 @@
 
 #include "effect_memory.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -22,18 +25,58 @@
 #include "common_utils.h"
 #include "effect_log.h"
 #include "format_helper.h"
+#include "memcpy_helper.h"
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
 constexpr int32_t MAX_RAM_SIZE = 600 * 1024 * 1024;
+constexpr size_t HEAP_MEMORY_ALIGNMENT = 64; // cache line, rows of padded strides start on it as well
 
-void ReleaseHeapMemory(void* &data)
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024; // transparent huge pages are pmd sized
+
+void ReleaseHeapMemory(void* &data, size_t &mappedSize)
 {
-    if (data != nullptr) {
+    if (data == nullptr) {
+        return;
+    }
+    if (mappedSize != 0) {
+        munmap(data, mappedSize);
+        mappedSize = 0;
+    } else {
         free(data);
-        data = nullptr;
     }
+    data = nullptr;
+}
+
+// An anonymous mapping aligned to the huge page size and advised for transparent huge pages, so that a large buffer
+// is backed by a few hundred pmd mappings instead of tens of thousands of 4KB pages. The kernel falls back to small
+// pages by itself when no huge page is available.
+void *MapHugePages(size_t size, size_t &mappedSize)
+{
+    size_t alignedSize = (size + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    size_t reserveSize = alignedSize + HUGE_PAGE_SIZE;
+    void *reserved = mmap(nullptr, reserveSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    CHECK_AND_RETURN_RET_LOG(reserved != MAP_FAILED, nullptr, "mmap fail! size=%{public}zu", reserveSize);
+
+    uintptr_t start = reinterpret_cast<uintptr_t>(reserved);
+    uintptr_t alignedStart = (start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    size_t head = alignedStart - start;
+    size_t tail = reserveSize - head - alignedSize;
+    if (head > 0) {
+        munmap(reserved, head);
+    }
+    if (tail > 0) {
+        munmap(reinterpret_cast<void *>(alignedStart + alignedSize), tail);
+    }
+    void *buffer = reinterpret_cast<void *>(alignedStart);
+#ifdef MADV_HUGEPAGE
+    if (madvise(buffer, alignedSize, MADV_HUGEPAGE) != 0) {
+        EFFECT_LOGW("madvise MADV_HUGEPAGE fail! size=%{public}zu", alignedSize);
+    }
+#endif
+    mappedSize = alignedSize;
+    return buffer;
 }
 
 HeapMemoryData::~HeapMemoryData()
@@ -42,26 +85,56 @@ HeapMemoryData::~HeapMemoryData()
         return;
     }
     EFFECT_LOGI("HeapMemoryData destructor!");
-    ReleaseHeapMemory(heapData);
+    ReleaseHeapMemory(heapData, mappedSize);
 }
 
-std::shared_ptr<MemoryData> HeapMemory::Alloc(MemoryInfo &memoryInfo)
+uint32_t HeapMemory::CalculateRowStride(const MemoryInfo &memoryInfo)
 {
-    uint32_t size = memoryInfo.bufferInfo.len_;
-    EFFECT_LOGI("HeapMemory::Alloc size=%{public}d", size);
-    CHECK_AND_RETURN_RET_LOG(size <= MAX_RAM_SIZE && size > 0, nullptr, "size out of range! size=%{public}d", size);
+    const BufferInfo &bufferInfo = memoryInfo.bufferInfo;
+    return memoryInfo.rowStridePolicy == RowStridePolicy::SIMD_ALIGNED ?
+        FormatHelper::CalculatePaddedRowStride(bufferInfo.width_, bufferInfo.formatType_) :
+        FormatHelper::CalculateRowStride(bufferInfo.width_, bufferInfo.formatType_);
+}
 
-    auto *buffer = malloc(size);
-    CHECK_AND_RETURN_RET_LOG(buffer != nullptr, nullptr, "malloc fail!");
-    EFFECT_LOGI("HeapMemory::Alloc alloc buffer success!");
+std::shared_ptr<MemoryData> HeapMemory::Alloc(MemoryInfo &memoryInfo)
+{
+    const BufferInfo &bufferInfo = memoryInfo.bufferInfo;
+    uint32_t rowStride = CalculateRowStride(memoryInfo);
+    uint32_t rowCount = FormatHelper::CalculateDataRowCount(bufferInfo.height_, bufferInfo.formatType_);
+    size_t paddedSize = static_cast<size_t>(rowStride) * rowCount;
+    size_t size = std::max(static_cast<size_t>(bufferInfo.len_), paddedSize);
+    EFFECT_LOGI("HeapMemory::Alloc size=%{public}zu, rowStride=%{public}u", size, rowStride);
+    CHECK_AND_RETURN_RET_LOG(size <= MAX_RAM_SIZE && size > 0, nullptr, "size out of range! size=%{public}zu", size);
+    MemoryReservation reservation;
+    CHECK_AND_RETURN_RET_LOG(reservation.Acquire(size), nullptr, "memory budget exhausted! size=%{public}zu", size);
+
+    void *buffer = nullptr;
+    size_t mappedSize = 0;
+    const LargeHeapPolicy &policy = memoryInfo.largeHeapPolicy;
+    bool isLarge = size >= policy.threshold;
+    // a pixel map frees the buffer it takes over with free(), which a mapping can not go through.
+    if (isLarge && policy.isHugePageEnabled && memoryInfo.isAutoRelease) {
+        buffer = MapHugePages(size, mappedSize);
+    }
+    if (buffer == nullptr) {
+        int ret = posix_memalign(&buffer, HEAP_MEMORY_ALIGNMENT, size);
+        CHECK_AND_RETURN_RET_LOG(ret == 0 && buffer != nullptr, nullptr, "malloc fail! ret=%{public}d", ret);
+    }
+    if (isLarge && policy.isPrefaultEnabled) {
+        MemcpyHelper::PrefaultPages(buffer, size);
+    }
+    EFFECT_LOGI("HeapMemory::Alloc alloc buffer success! mappedSize=%{public}zu", mappedSize);
 
     std::shared_ptr<HeapMemoryData> memoryData = std::make_unique<HeapMemoryData>();
     memoryData->data = buffer;
     memoryData->memoryInfo = memoryInfo;
-    memoryData->memoryInfo.bufferInfo.rowStride_ =
-        FormatHelper::CalculateRowStride(memoryInfo.bufferInfo.width_, memoryInfo.bufferInfo.formatType_);
+    memoryData->memoryInfo.bufferInfo.rowStride_ = rowStride;
+    memoryData->memoryInfo.bufferInfo.len_ = static_cast<uint32_t>(size);
     memoryData->memoryInfo.bufferType = BufferType::HEAP_MEMORY;
+    memoryData->memoryInfo.isMapped = mappedSize != 0;
     memoryData->heapData = buffer;
+    memoryData->mappedSize = mappedSize;
+    memoryData->reservation = std::move(reservation);
     memoryData_ = memoryData;
 
     return memoryData;
@@ -75,7 +148,8 @@ ErrorCode HeapMemory::Release()
         return ErrorCode::ERR_MEMORY_DATA_ABNORMAL;
     }
 
-    ReleaseHeapMemory(memoryData_->heapData);
+    ReleaseHeapMemory(memoryData_->heapData, memoryData_->mappedSize);
+    memoryData_->reservation.Reset();
     memoryData_ = nullptr;
     return ErrorCode::SUCCESS;
 }
@@ -123,6 +197,8 @@ std::shared_ptr<MemoryData> DmaMemory::Alloc(MemoryInfo &memoryInfo)
     CHECK_AND_RETURN_RET_LOG(bufferInfo.width_ > 0 && bufferInfo.height_ > 0,
         nullptr, "para calculated over alloc size! h=%{public}d, w=%{public}d, format=%{public}d, size=%{public}d",
         bufferInfo.height_, bufferInfo.width_, bufferInfo.formatType_, bufferInfo.len_);
+    MemoryReservation reservation;
+    CHECK_AND_RETURN_RET_LOG(reservation.Acquire(size), nullptr, "memory budget exhausted! size=%{public}d", size);
     auto *src = reinterpret_cast<SurfaceBuffer *>(memoryInfo.extra);
 
     BufferRequestConfig requestConfig = {
@@ -155,6 +231,7 @@ std::shared_ptr<MemoryData> DmaMemory::Alloc(MemoryInfo &memoryInfo)
     memoryData->memoryInfo.extra = sb;
     memoryData->memoryInfo.bufferType = BufferType::DMA_BUFFER;
     memoryData->surfaceBuffer = sb;
+    memoryData->reservation = std::move(reservation);
     memoryData_ = memoryData;
 
     return memoryData;
@@ -168,10 +245,37 @@ ErrorCode DmaMemory::Release()
         return ErrorCode::ERR_MEMORY_DATA_ABNORMAL;
     }
     ReleaseDmaMemory(memoryData_->surfaceBuffer);
+    memoryData_->reservation.Reset();
     memoryData_ = nullptr;
     return ErrorCode::SUCCESS;
 }
 
+std::atomic<uint64_t> g_sharedMapCount = 0;
+
+// ashmem where the kernel has it, a memfd otherwise, e.g. on a plain linux host.
+int CreateSharedRegion(const char *name, size_t size)
+{
+    int fd = AshmemCreate(name, size);
+    if (fd >= 0) {
+        if (AshmemSetProt(fd, PROT_READ | PROT_WRITE) < 0) {
+            EFFECT_LOGE("CreateSharedRegion AshmemSetProt errno %{public}d.", errno);
+            ::close(fd);
+            return -1;
+        }
+        return fd;
+    }
+#ifdef MFD_CLOEXEC
+    fd = memfd_create(name, MFD_CLOEXEC);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, -1, "CreateSharedRegion memfd_create errno %{public}d.", errno);
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        EFFECT_LOGE("CreateSharedRegion ftruncate errno %{public}d.", errno);
+        ::close(fd);
+        return -1;
+    }
+#endif
+    return fd;
+}
+
 void ReleaseSharedMemory(void* &data, int* &fdPtr, size_t len)
 {
     if (data != nullptr && data != MAP_FAILED) {
@@ -199,16 +303,14 @@ std::shared_ptr<MemoryData> SharedMemory::Alloc(MemoryInfo &memoryInfo)
     size_t size = memoryInfo.bufferInfo.len_;
     EFFECT_LOGI("SharedMemory::Alloc size=%{public}zu", size);
     CHECK_AND_RETURN_RET_LOG(size <= MAX_RAM_SIZE && size > 0, nullptr, "size out of range! size=%{public}zu", size);
+    MemoryReservation reservation;
+    CHECK_AND_RETURN_RET_LOG(reservation.Acquire(size), nullptr, "memory budget exhausted! size=%{public}zu", size);
 
-    int fd = AshmemCreate("ImageEffectAlloc Data", size);
-    CHECK_AND_RETURN_RET_LOG(fd >= 0, nullptr, "SharedMemory::Alloc AshmemCreate fd:[%{public}d].", fd);
+    int fd = CreateSharedRegion("ImageEffectAlloc Data", size);
+    CHECK_AND_RETURN_RET_LOG(fd >= 0, nullptr, "SharedMemory::Alloc CreateSharedRegion fd:[%{public}d].", fd);
 
-    if (AshmemSetProt(fd, PROT_READ | PROT_WRITE) < 0) {
-        EFFECT_LOGE("SharedMemory::Alloc AshmemSetProt errno %{public}d.", errno);
-        ::close(fd);
-        return nullptr;
-    }
     void *data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    g_sharedMapCount++;
     if (data == MAP_FAILED) {
         EFFECT_LOGE("SharedMemory::Alloc mmap failed, errno:%{public}d", errno);
         ::close(fd);
@@ -224,11 +326,17 @@ std::shared_ptr<MemoryData> SharedMemory::Alloc(MemoryInfo &memoryInfo)
     memoryData->memoryInfo.extra = memoryData->fdPtr;
     memoryData->memoryInfo.bufferType = BufferType::SHARED_MEMORY;
     memoryData->len = size;
+    memoryData->reservation = std::move(reservation);
     memoryData_ = memoryData;
 
     return memoryData;
 }
 
+uint64_t SharedMemory::GetMapCount()
+{
+    return g_sharedMapCount.load();
+}
+
 ErrorCode SharedMemory::Release()
 {
     EFFECT_LOGI("SharedMemory::Release");
@@ -238,6 +346,7 @@ ErrorCode SharedMemory::Release()
     }
 
     ReleaseSharedMemory(memoryData_->data, memoryData_->fdPtr, memoryData_->len);
+    memoryData_->reservation.Reset();
     memoryData_ = nullptr;
     return ErrorCode::SUCCESS;
 }
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_memory_accountant.h"
+
+#include <algorithm>
+
+#include "effect_log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+EffectMemoryAccountant &EffectMemoryAccountant::Instance()
+{
+    // Never destroyed: memories and textures may be released from static destructors of other modules.
+    static EffectMemoryAccountant *instance = new EffectMemoryAccountant();
+    return *instance;
+}
+
+bool EffectMemoryAccountant::TryChargeLocked(uint64_t bytes)
+{
+    if (stats_.currentBytes + bytes > config_.budgetBytes) {
+        return false;
+    }
+    stats_.currentBytes += bytes;
+    stats_.peakBytes = std::max(stats_.peakBytes, stats_.currentBytes);
+    return true;
+}
+
+bool EffectMemoryAccountant::Reserve(uint64_t bytes)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (TryChargeLocked(bytes)) {
+        return true;
+    }
+    if (bytes > config_.budgetBytes) {
+        stats_.rejectCount++;
+        EFFECT_LOGE("EffectMemoryAccountant::Reserve size over budget! size=%{public}zu, budget=%{public}zu",
+            static_cast<size_t>(bytes), static_cast<size_t>(config_.budgetBytes));
+        return false;
+    }
+
+    // reclaimers free retained buffers, which comes back to Release, so they run without mutex_.
+    uint64_t needBytes = stats_.currentBytes + bytes - config_.budgetBytes;
+    lock.unlock();
+    Reclaim(needBytes);
+    lock.lock();
+    if (TryChargeLocked(bytes)) {
+        return true;
+    }
+
+    if (config_.policy == MemoryBudgetPolicy::BLOCK) {
+        stats_.waitCount++;
+        EFFECT_LOGW("EffectMemoryAccountant::Reserve wait for memory. size=%{public}zu, current=%{public}zu",
+            static_cast<size_t>(bytes), static_cast<size_t>(stats_.currentBytes));
+        auto deadline = std::chrono::steady_clock::now() + config_.waitTimeout;
+        if (releaseCond_.wait_until(lock, deadline, [this, bytes]() { return TryChargeLocked(bytes); })) {
+            return true;
+        }
+        stats_.rejectCount++;
+        EFFECT_LOGE("EffectMemoryAccountant::Reserve wait timeout! size=%{public}zu, current=%{public}zu",
+            static_cast<size_t>(bytes), static_cast<size_t>(stats_.currentBytes));
+        return false;
+    }
+
+    stats_.rejectCount++;
+    EFFECT_LOGE("EffectMemoryAccountant::Reserve budget exhausted! size=%{public}zu, current=%{public}zu, "
+        "budget=%{public}zu", static_cast<size_t>(bytes), static_cast<size_t>(stats_.currentBytes),
+        static_cast<size_t>(config_.budgetBytes));
+    return false;
+}
+
+void EffectMemoryAccountant::Charge(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.currentBytes += bytes;
+    stats_.peakBytes = std::max(stats_.peakBytes, stats_.currentBytes);
+}
+
+void EffectMemoryAccountant::Release(uint64_t bytes)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.currentBytes = bytes > stats_.currentBytes ? 0 : stats_.currentBytes - bytes;
+    }
+    releaseCond_.notify_all();
+}
+
+void EffectMemoryAccountant::Reclaim(uint64_t bytes)
+{
+    std::lock_guard<std::mutex> reclaimLock(reclaimMutex_);
+    uint64_t reclaimedBytes = 0;
+    for (auto &reclaimer : reclaimers_) {
+        if (reclaimedBytes >= bytes) {
+            break;
+        }
+        reclaimedBytes += reclaimer.second(bytes - reclaimedBytes);
+    }
+    EFFECT_LOGI("EffectMemoryAccountant::Reclaim need=%{public}zu, reclaimed=%{public}zu",
+        static_cast<size_t>(bytes), static_cast<size_t>(reclaimedBytes));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.reclaimedBytes += reclaimedBytes;
+}
+
+uint32_t EffectMemoryAccountant::AddReclaimer(MemoryReclaimer reclaimer)
+{
+    std::lock_guard<std::mutex> reclaimLock(reclaimMutex_);
+    uint32_t id = nextReclaimerId_++;
+    reclaimers_.emplace(id, std::move(reclaimer));
+    return id;
+}
+
+void EffectMemoryAccountant::RemoveReclaimer(uint32_t id)
+{
+    std::lock_guard<std::mutex> reclaimLock(reclaimMutex_);
+    reclaimers_.erase(id);
+}
+
+void EffectMemoryAccountant::SetConfig(const MemoryBudgetConfig &config)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_ = config;
+    }
+    // a larger budget or a different policy may let waiting reservations through.
+    releaseCond_.notify_all();
+}
+
+MemoryBudgetConfig EffectMemoryAccountant::GetConfig()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+MemoryBudgetStats EffectMemoryAccountant::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryBudgetStats stats = stats_;
+    stats.budgetBytes = config_.budgetBytes;
+    return stats;
+}
+
+void EffectMemoryAccountant::ResetPeak()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.peakBytes = stats_.currentBytes;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
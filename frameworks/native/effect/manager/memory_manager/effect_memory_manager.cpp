@@ -15,9 +15,13 @@
 
 #include "effect_memory_manager.h"
 
+#include <algorithm>
+
 #include "effect_log.h"
 #include "effect_buffer.h"
+#include "effect_memory_pool.h"
 #include "colorspace_helper.h"
+#include "format_helper.h"
 
 using namespace OHOS::ColorManager;
 using namespace OHOS::HDI::Display::Graphic::Common::V1_0;
@@ -25,6 +29,23 @@ using namespace OHOS::HDI::Display::Graphic::Common::V1_0;
 namespace OHOS {
 namespace Media {
 namespace Effect {
+namespace {
+constexpr size_t KEY_HASH_PRIME = 31;
+}
+
+size_t EffectMemoryManager::MemoryKeyHash::operator()(const MemoryKey &key) const
+{
+    size_t hash = key.width;
+    hash = hash * KEY_HASH_PRIME + key.height;
+    hash = hash * KEY_HASH_PRIME + static_cast<size_t>(key.formatType);
+    return hash * KEY_HASH_PRIME + static_cast<size_t>(key.colorSpace);
+}
+
+EffectMemoryManager::MemoryKey EffectMemoryManager::MakeKey(const BufferInfo &bufferInfo)
+{
+    return { bufferInfo.width_, bufferInfo.height_, bufferInfo.formatType_, bufferInfo.colorSpace_ };
+}
+
 ErrorCode EffectMemoryManager::Init(const std::shared_ptr<EffectBuffer> &srcEffectBuffer,
     const std::shared_ptr<EffectBuffer> &dstEffectBuffer)
 {
@@ -40,6 +61,16 @@ void EffectMemoryManager::SetIPType(IPType ipType)
     runningIPType_ = ipType;
 }
 
+void EffectMemoryManager::SetLargeHeapPolicy(const LargeHeapPolicy &policy)
+{
+    largeHeapPolicy_ = policy;
+}
+
+LargeHeapPolicy EffectMemoryManager::GetLargeHeapPolicy() const
+{
+    return largeHeapPolicy_;
+}
+
 void EffectMemoryManager::AddFilterMemory(const std::shared_ptr<EffectBuffer> &effectBuffer, MemDataType memDataType,
     bool isAllowModify)
 {
@@ -74,13 +105,14 @@ void UpdateColorSpaceIfNeed(std::shared_ptr<MemoryData> &memoryData)
     ColorSpaceHelper::SetSurfaceBufferColorSpaceType(sb, CM_ColorSpaceType::CM_BT2020_HLG_FULL);
 }
 
-std::shared_ptr<Memory> AllocMemoryInner(MemoryInfo &allocMemInfo, BufferType allocBufferType)
+std::shared_ptr<Memory> AllocMemoryInner(const MemoryInfo &allocMemInfo, BufferType allocBufferType,
+    const LargeHeapPolicy &largeHeapPolicy)
 {
     EFFECT_LOGI("Alloc Memory! bufferType=%{public}d", allocBufferType);
-    std::unique_ptr<AbsMemory> absMemory = EffectMemory::CreateMemory(allocBufferType);
-    CHECK_AND_RETURN_RET_LOG(absMemory != nullptr, nullptr,
-        "absMemory is null! bufferType=%{public}d", allocBufferType);
-    std::shared_ptr<MemoryData> memoryData = absMemory->Alloc(allocMemInfo);
+    MemoryInfo memoryInfo = allocMemInfo;
+    memoryInfo.largeHeapPolicy = largeHeapPolicy;
+    // buffers come from the process wide pool and go back to it once the last reference is dropped.
+    std::shared_ptr<MemoryData> memoryData = EffectMemoryPool::Instance().Alloc(memoryInfo, allocBufferType);
     CHECK_AND_RETURN_RET_LOG(memoryData != nullptr, nullptr,
         "memoryData is null! bufferType=%{public}d", allocBufferType);
 
@@ -93,37 +125,151 @@ std::shared_ptr<Memory> AllocMemoryInner(MemoryInfo &allocMemInfo, BufferType al
     return memory;
 }
 
-MemoryData *EffectMemoryManager::AllocMemory(void *srcAddr, MemoryInfo &allocMemInfo)
+bool IsAddrInMemory(const std::shared_ptr<MemoryData> &memoryData, void *addr)
+{
+    // srcAddr may be a crop view pointing into the middle of a memory, which must not be handed out either.
+    auto *start = static_cast<uint8_t *>(memoryData->data);
+    auto *target = static_cast<uint8_t *>(addr);
+    return start == target || (target > start && target < start + memoryData->memoryInfo.bufferInfo.len_);
+}
+
+bool EffectMemoryManager::IsMemoryMatched(const std::shared_ptr<Memory> &memory, const MemoryKey &key,
+    const MemoryInfo &allocMemInfo)
+{
+    // memories whose ownership has been moved out, e.g. into a pixel map, must not be written again.
+    const MemoryInfo &memInfo = memory->memoryData_->memoryInfo;
+    const BufferInfo &bufferInfo = memInfo.bufferInfo;
+    BufferType bufferType = allocMemInfo.bufferType;
+    if ((bufferType != BufferType::DEFAULT && bufferType != memInfo.bufferType) || !memInfo.isAutoRelease ||
+        !(MakeKey(bufferInfo) == key)) {
+        return false;
+    }
+    // a packed request may end up in a pixel map, padded cpu memories only serve stride aware consumers.
+    return allocMemInfo.rowStridePolicy != RowStridePolicy::PACKED || memInfo.bufferType == BufferType::DMA_BUFFER ||
+        bufferInfo.rowStride_ == FormatHelper::CalculateRowStride(bufferInfo.width_, bufferInfo.formatType_);
+}
+
+MemoryData *EffectMemoryManager::ReleaseInUseMemory(void *srcAddr, const MemoryKey &key,
+    const MemoryInfo &allocMemInfo)
+{
+    // a memory handed out earlier is done once the pipeline no longer reads from it. A matching one is kept in use
+    // and handed out again, which is the common ping-pong between two memories of a filter chain.
+    MemoryData *reuseMemoryData = nullptr;
+    for (auto it = inUseMemorys_.begin(); it != inUseMemorys_.end();) {
+        if (IsAddrInMemory((*it)->memoryData_, srcAddr)) {
+            ++it;
+        } else if (reuseMemoryData == nullptr && IsMemoryMatched(*it, key, allocMemInfo)) {
+            reuseMemoryData = (*it)->memoryData_.get();
+            ++it;
+        } else {
+            MemoryKey freeKey = MakeKey((*it)->memoryData_->memoryInfo.bufferInfo);
+            freeMemorys_[freeKey].emplace_back(std::move(*it));
+            it = inUseMemorys_.erase(it);
+        }
+    }
+    return reuseMemoryData;
+}
+
+MemoryData *EffectMemoryManager::AcquireFreeMemory(void *srcAddr, const MemoryKey &key,
+    const MemoryInfo &allocMemInfo)
+{
+    auto bucketIt = freeMemorys_.find(key);
+    if (bucketIt == freeMemorys_.end()) {
+        return nullptr;
+    }
+
+    std::vector<std::shared_ptr<Memory>> &bucket = bucketIt->second;
+    for (size_t idx = bucket.size(); idx > 0; idx--) {
+        if (!IsMemoryMatched(bucket[idx - 1], key, allocMemInfo) ||
+            IsAddrInMemory(bucket[idx - 1]->memoryData_, srcAddr)) {
+            continue;
+        }
+        MemoryData *memoryData = bucket[idx - 1]->memoryData_.get();
+        inUseMemorys_.emplace_back(std::move(bucket[idx - 1]));
+        bucket[idx - 1] = std::move(bucket.back());
+        bucket.pop_back();
+        return memoryData;
+    }
+    return nullptr;
+}
+
+BufferType EffectMemoryManager::GetAllocBufferType(const MemoryInfo &allocMemInfo) const
+{
+    if (allocMemInfo.bufferType != BufferType::DEFAULT) {
+        return allocMemInfo.bufferType;
+    }
+    // default alloc heap buffer on running with cpu filter, dma buffer otherwise
+    return runningIPType_ == IPType::CPU ? BufferType::HEAP_MEMORY : BufferType::DMA_BUFFER;
+}
+
+MemoryData *EffectMemoryManager::AllocPlannedMemory(void *srcAddr, const MemoryInfo &allocMemInfo)
 {
-    for (const auto &memory : memorys_) {
-        if (!memory->isAllowModify_ || memory->memoryData_->data == srcAddr) {
+    const BufferInfo &bufferInfo = allocMemInfo.bufferInfo;
+    uint32_t rowStride = HeapMemory::CalculateRowStride(allocMemInfo);
+    uint64_t needBytes = std::max(static_cast<uint64_t>(bufferInfo.len_), static_cast<uint64_t>(rowStride) *
+        FormatHelper::CalculateDataRowCount(bufferInfo.height_, bufferInfo.formatType_));
+    for (size_t slot = 0; slot < slotMemorys_.size(); slot++) {
+        std::shared_ptr<Memory> &memory = slotMemorys_[slot];
+        uint64_t capacity = bufferPlan_.slotCapacities[slot];
+        if (capacity < needBytes || (memory != nullptr && IsAddrInMemory(memory->memoryData_, srcAddr))) {
             continue;
         }
 
-        const MemoryInfo &memInfo = memory->memoryData_->memoryInfo;
-        const BufferInfo &bufferInfo = memInfo.bufferInfo;
-        const BufferInfo &allocBufInfo = allocMemInfo.bufferInfo;
-        if (bufferInfo.width_ == allocBufInfo.width_ && bufferInfo.height_ == allocBufInfo.height_ &&
-            (allocMemInfo.bufferType == BufferType::DEFAULT || allocMemInfo.bufferType == memInfo.bufferType) &&
-            bufferInfo.formatType_ == allocBufInfo.formatType_ && bufferInfo.colorSpace_ == allocBufInfo.colorSpace_) {
-            EFFECT_LOGD("reuse memory. width=%{public}d, height=%{public}d, format=%{public}d, "
-                "bufferType=%{public}d, allocBufType=%{public}d", bufferInfo.width_, bufferInfo.height_,
-                bufferInfo.formatType_, memInfo.bufferType, allocMemInfo.bufferType);
-            return memory->memoryData_.get();
+        // allocated on first use, or again once the previous one has been moved out, e.g. into a pixel map.
+        if (memory == nullptr || !memory->memoryData_->memoryInfo.isAutoRelease) {
+            if (memory != nullptr) {
+                memorys_.erase(std::remove(memorys_.begin(), memorys_.end(), memory), memorys_.end());
+            }
+            MemoryInfo slotMemInfo = allocMemInfo;
+            slotMemInfo.bufferInfo.len_ = static_cast<uint32_t>(capacity);
+            slotMemInfo.rowStridePolicy = RowStridePolicy::SIMD_ALIGNED;
+            memory = AllocMemoryInner(slotMemInfo, BufferType::HEAP_MEMORY, largeHeapPolicy_);
+            CHECK_AND_RETURN_RET_LOG(memory != nullptr, nullptr, "AllocPlannedMemory fail! slot=%{public}zu", slot);
+            memorys_.emplace_back(memory);
         }
+
+        MemoryInfo &memInfo = memory->memoryData_->memoryInfo;
+        uint32_t len = memInfo.bufferInfo.len_;
+        memInfo.isAutoRelease = allocMemInfo.isAutoRelease;
+        memInfo.bufferInfo = bufferInfo;
+        memInfo.bufferInfo.rowStride_ = rowStride;
+        memInfo.bufferInfo.len_ = len;
+        memInfo.rowStridePolicy = allocMemInfo.rowStridePolicy;
+        EFFECT_LOGD("planned memory. slot=%{public}zu, width=%{public}d, height=%{public}d, format=%{public}d",
+            slot, bufferInfo.width_, bufferInfo.height_, bufferInfo.formatType_);
+        return memory->memoryData_.get();
     }
+    return nullptr;
+}
 
-    BufferType allocBufferType = BufferType::DMA_BUFFER; // default alloc dma buffer
-    if (runningIPType_ == IPType::CPU) {
-        allocBufferType = BufferType::HEAP_MEMORY; // default alloc heap buffer on running with cpu filter
+MemoryData *EffectMemoryManager::AllocMemory(void *srcAddr, MemoryInfo &allocMemInfo)
+{
+    BufferType allocBufferType = GetAllocBufferType(allocMemInfo);
+    if (allocBufferType == BufferType::HEAP_MEMORY && !slotMemorys_.empty()) {
+        MemoryData *plannedMemoryData = AllocPlannedMemory(srcAddr, allocMemInfo);
+        if (plannedMemoryData != nullptr) {
+            return plannedMemoryData;
+        }
     }
-    if (allocMemInfo.bufferType != BufferType::DEFAULT) {
-        allocBufferType = allocMemInfo.bufferType;
+
+    MemoryKey key = MakeKey(allocMemInfo.bufferInfo);
+    MemoryData *memoryData = ReleaseInUseMemory(srcAddr, key, allocMemInfo);
+    if (memoryData == nullptr) {
+        memoryData = AcquireFreeMemory(srcAddr, key, allocMemInfo);
+    }
+    if (memoryData != nullptr) {
+        const MemoryInfo &memInfo = memoryData->memoryInfo;
+        EFFECT_LOGD("reuse memory. width=%{public}d, height=%{public}d, format=%{public}d, "
+            "bufferType=%{public}d, allocBufType=%{public}d", memInfo.bufferInfo.width_, memInfo.bufferInfo.height_,
+            memInfo.bufferInfo.formatType_, memInfo.bufferType, allocMemInfo.bufferType);
+        return memoryData;
     }
-    std::shared_ptr<Memory> memory = AllocMemoryInner(allocMemInfo, allocBufferType);
+
+    std::shared_ptr<Memory> memory = AllocMemoryInner(allocMemInfo, allocBufferType, largeHeapPolicy_);
     CHECK_AND_RETURN_RET_LOG(memory != nullptr, nullptr,
         "AllocMemory fail! bufferType=%{public}d", allocBufferType);
-    AddMemory(memory);
+    memorys_.emplace_back(memory);
+    inUseMemorys_.emplace_back(memory);
     EFFECT_LOGD("alloc new memory. memorys size=%{public}zu", memorys_.size());
     return memory->memoryData_.get();
 }
@@ -135,11 +281,40 @@ void EffectMemoryManager::AddMemory(std::shared_ptr<Memory> &memory)
         "memory data is null!");
     if (std::find(memorys_.begin(), memorys_.end(), memory) == memorys_.end()) {
         memorys_.emplace_back(memory);
+        if (memory->isAllowModify_) {
+            freeMemorys_[MakeKey(memory->memoryData_->memoryInfo.bufferInfo)].emplace_back(memory);
+        }
     } else {
         EFFECT_LOGW("memory is already add!");
     }
 }
 
+void EffectMemoryManager::UnindexMemory(const std::shared_ptr<Memory> &memory)
+{
+    auto slotIt = std::find(slotMemorys_.begin(), slotMemorys_.end(), memory);
+    if (slotIt != slotMemorys_.end()) {
+        *slotIt = nullptr;
+        return;
+    }
+
+    auto inUseIt = std::find(inUseMemorys_.begin(), inUseMemorys_.end(), memory);
+    if (inUseIt != inUseMemorys_.end()) {
+        inUseMemorys_.erase(inUseIt);
+        return;
+    }
+
+    auto bucketIt = freeMemorys_.find(MakeKey(memory->memoryData_->memoryInfo.bufferInfo));
+    if (bucketIt == freeMemorys_.end()) {
+        return;
+    }
+    std::vector<std::shared_ptr<Memory>> &bucket = bucketIt->second;
+    auto it = std::find(bucket.begin(), bucket.end(), memory);
+    if (it != bucket.end()) {
+        *it = std::move(bucket.back());
+        bucket.pop_back();
+    }
+}
+
 std::shared_ptr<Memory> EffectMemoryManager::GetAllocMemoryByAddr(void *addr)
 {
     for (auto &memory : memorys_) {
@@ -170,14 +345,46 @@ void EffectMemoryManager::RemoveMemory(std::shared_ptr<Memory> &memory)
     auto it = std::find(memorys_.begin(), memorys_.end(), memory);
     if (it != memorys_.end()) {
         EFFECT_LOGD("EffectMemoryManager::RemoveMemory success!");
+        UnindexMemory(memory);
         memorys_.erase(it);
     }
 }
 
+void EffectMemoryManager::ClearSlotMemorys()
+{
+    for (auto &memory : slotMemorys_) {
+        if (memory != nullptr) {
+            memorys_.erase(std::remove(memorys_.begin(), memorys_.end(), memory), memorys_.end());
+            memory = nullptr;
+        }
+    }
+}
+
+void EffectMemoryManager::SetBufferPlan(const BufferPlan &bufferPlan)
+{
+    if (bufferPlan == bufferPlan_) {
+        return;
+    }
+    EFFECT_LOGD("EffectMemoryManager::SetBufferPlan slots=%{public}zu, plannedBytes=%{public}zu",
+        bufferPlan.slotCapacities.size(), static_cast<size_t>(bufferPlan.GetPlannedBytes()));
+    ClearSlotMemorys();
+    bufferPlan_ = bufferPlan;
+    slotMemorys_.resize(bufferPlan_.slotCapacities.size());
+}
+
+const BufferPlan &EffectMemoryManager::GetBufferPlan() const
+{
+    return bufferPlan_;
+}
+
 void EffectMemoryManager::ClearMemory()
 {
     EFFECT_LOGD("EffectMemoryManager::ClearMemory");
+    ClearSlotMemorys();
     memorys_.clear();
+    freeMemorys_.clear();
+    inUseMemorys_.clear();
+    EffectMemoryPool::Instance().TrimIdle();
 }
 
 void EffectMemoryManager::Deinit()
@@ -185,6 +392,7 @@ void EffectMemoryManager::Deinit()
     for (auto it = memorys_.begin(); it != memorys_.end();) {
         const MemDataType &memDataType_ = (*it)->memDataType_;
         if (memDataType_ == MemDataType::INPUT || memDataType_ == MemDataType::OUTPUT) {
+            UnindexMemory(*it);
             it = memorys_.erase(it);
         } else {
             ++it;
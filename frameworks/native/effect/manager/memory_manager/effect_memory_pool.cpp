@@ -0,0 +1,265 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "effect_memory_pool.h"
+
+#include "effect_log.h"
+#include "effect_memory_accountant.h"
+#include "format_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t MIN_SIZE_CLASS = 64 * 1024;
+constexpr uint32_t SIZE_CLASSES_PER_POWER_OF_TWO = 4;
+
+void ResetMemoryInfo(MemoryData &memoryData, const MemoryInfo &memoryInfo)
+{
+    MemoryInfo &info = memoryData.memoryInfo;
+    if (info.bufferType == BufferType::DMA_BUFFER) {
+        // geometry, stride and extra come from the surface buffer, which is matched exactly by the key.
+        info.isAutoRelease = memoryInfo.isAutoRelease;
+        info.bufferInfo.colorSpace_ = memoryInfo.bufferInfo.colorSpace_;
+        return;
+    }
+
+    uint32_t rowStride = info.bufferInfo.rowStride_;
+    uint32_t len = info.bufferInfo.len_;
+    BufferType bufferType = info.bufferType;
+    void *extra = bufferType == BufferType::SHARED_MEMORY ? info.extra : memoryInfo.extra;
+    bool isMapped = info.isMapped;
+    info = memoryInfo;
+    info.bufferInfo.rowStride_ = rowStride;
+    info.bufferInfo.len_ = len;
+    info.bufferType = bufferType;
+    info.extra = extra;
+    info.isMapped = isMapped;
+}
+} // namespace
+
+bool MemoryPoolKey::operator == (const MemoryPoolKey &other) const
+{
+    return bufferType == other.bufferType && size == other.size && rowStride == other.rowStride &&
+        formatType == other.formatType && width == other.width && height == other.height && usage == other.usage &&
+        colorGamut == other.colorGamut && transform == other.transform && colorSpace == other.colorSpace;
+}
+
+EffectMemoryPool &EffectMemoryPool::Instance()
+{
+    // Never destroyed: pooled buffers may be handed back from static destructors of other modules.
+    static EffectMemoryPool *instance = new EffectMemoryPool();
+    return *instance;
+}
+
+EffectMemoryPool::EffectMemoryPool()
+{
+    EffectMemoryAccountant::Instance().AddReclaimer([this](uint64_t bytes) { return Reclaim(bytes); });
+}
+
+MemoryPoolKey EffectMemoryPool::MakeKey(const MemoryInfo &memoryInfo, BufferType bufferType)
+{
+    const BufferInfo &bufferInfo = memoryInfo.bufferInfo;
+    MemoryPoolKey key;
+    key.bufferType = bufferType;
+    key.size = bufferType == BufferType::SHARED_MEMORY ? RoundToSizeClass(bufferInfo.len_) : bufferInfo.len_;
+    key.rowStride = bufferType == BufferType::HEAP_MEMORY ? HeapMemory::CalculateRowStride(memoryInfo) :
+        FormatHelper::CalculateRowStride(bufferInfo.width_, bufferInfo.formatType_);
+    if (bufferType != BufferType::DMA_BUFFER) {
+        return key;
+    }
+
+    key.formatType = bufferInfo.formatType_;
+    key.width = bufferInfo.width_;
+    key.height = bufferInfo.height_;
+    key.colorSpace = bufferInfo.colorSpace_;
+    auto *src = static_cast<SurfaceBuffer *>(memoryInfo.extra);
+    if (src != nullptr) {
+        key.usage = src->GetUsage();
+        key.colorGamut = static_cast<int32_t>(src->GetSurfaceBufferColorGamut());
+        key.transform = static_cast<int32_t>(src->GetSurfaceBufferTransform());
+    }
+    return key;
+}
+
+uint32_t EffectMemoryPool::RoundToSizeClass(uint32_t size)
+{
+    if (size <= MIN_SIZE_CLASS) {
+        return MIN_SIZE_CLASS;
+    }
+    uint32_t powerOfTwo = 1u << (31 - __builtin_clz(size - 1)); // 31: highest bit index of uint32_t
+    uint64_t step = powerOfTwo / SIZE_CLASSES_PER_POWER_OF_TWO;
+    return static_cast<uint32_t>((size + step - 1) / step * step);
+}
+
+std::shared_ptr<MemoryData> EffectMemoryPool::Alloc(MemoryInfo &memoryInfo, BufferType bufferType)
+{
+    MemoryPoolKey key = MakeKey(memoryInfo, bufferType);
+    std::shared_ptr<MemoryData> memoryData = Acquire(key, memoryInfo);
+    if (memoryData != nullptr) {
+        hitCount_++;
+        EFFECT_LOGD("EffectMemoryPool::Alloc reuse pooled memory. bufferType=%{public}d, size=%{public}u",
+            bufferType, key.size);
+        return Track(key, memoryData);
+    }
+
+    missCount_++;
+    std::unique_ptr<AbsMemory> absMemory = EffectMemory::CreateMemory(bufferType);
+    CHECK_AND_RETURN_RET_LOG(absMemory != nullptr, nullptr,
+        "absMemory is null! bufferType=%{public}d", bufferType);
+    if (bufferType == BufferType::SHARED_MEMORY) {
+        // the region is created at the size of its class, which is what the key promises to later requests.
+        MemoryInfo regionInfo = memoryInfo;
+        regionInfo.bufferInfo.len_ = key.size;
+        memoryData = absMemory->Alloc(regionInfo);
+    } else {
+        memoryData = absMemory->Alloc(memoryInfo);
+    }
+    CHECK_AND_RETURN_RET_LOG(memoryData != nullptr, nullptr,
+        "memoryData is null! bufferType=%{public}d", bufferType);
+    return Track(key, memoryData);
+}
+
+std::shared_ptr<MemoryData> EffectMemoryPool::Acquire(const MemoryPoolKey &key, MemoryInfo &memoryInfo)
+{
+    std::shared_ptr<MemoryData> memoryData = nullptr;
+    IdleList evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        TrimLocked(Clock::now(), evicted);
+        // newest first, the most recently released buffer is the most likely to still be cache resident.
+        for (auto it = idle_.rbegin(); it != idle_.rend(); ++it) {
+            if (it->key == key) {
+                memoryData = std::move(it->memoryData);
+                retainedBytes_ -= it->size;
+                idle_.erase(std::next(it).base());
+                break;
+            }
+        }
+    }
+
+    if (memoryData != nullptr) {
+        ResetMemoryInfo(*memoryData, memoryInfo);
+    }
+    return memoryData;
+}
+
+std::shared_ptr<MemoryData> EffectMemoryPool::Track(const MemoryPoolKey &key, std::shared_ptr<MemoryData> &memoryData)
+{
+    // The handed out pointer aliases the owner, dropping its last reference hands the owner back to the pool.
+    MemoryData *data = memoryData.get();
+    return std::shared_ptr<MemoryData>(data, [key, owner = memoryData](MemoryData *) mutable {
+        EffectMemoryPool::Instance().Recycle(key, owner);
+    });
+}
+
+void EffectMemoryPool::Recycle(const MemoryPoolKey &key, std::shared_ptr<MemoryData> &memoryData)
+{
+    // Take the owner out of the deleter so that it is released here and not when the control block goes away.
+    std::shared_ptr<MemoryData> owner = std::move(memoryData);
+    if (owner == nullptr || owner->data == nullptr || !owner->memoryInfo.isAutoRelease) {
+        // ownership of the buffer has been moved out, e.g. into a pixel map.
+        return;
+    }
+
+    uint64_t size = owner->memoryInfo.bufferInfo.len_;
+    IdleList evicted;
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (size == 0 || size > config_.maxRetainedBytes) {
+        return;
+    }
+    uint32_t sameKeyCount = 0;
+    for (const auto &idle : idle_) {
+        sameKeyCount += idle.key == key ? 1 : 0;
+    }
+    if (sameKeyCount >= config_.maxBuffersPerKey) {
+        return;
+    }
+
+    Clock::time_point now = Clock::now();
+    idle_.push_back({ key, std::move(owner), size, now });
+    retainedBytes_ += size;
+    TrimLocked(now, evicted);
+}
+
+void EffectMemoryPool::TrimLocked(Clock::time_point now, IdleList &evicted)
+{
+    while (!idle_.empty() &&
+        (retainedBytes_ > config_.maxRetainedBytes || now - idle_.front().idleSince >= config_.idleTimeout)) {
+        retainedBytes_ -= idle_.front().size;
+        evicted.splice(evicted.end(), idle_, idle_.begin());
+    }
+}
+
+uint64_t EffectMemoryPool::Reclaim(uint64_t bytes)
+{
+    uint64_t reclaimedBytes = 0;
+    IdleList evicted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        while (!idle_.empty() && reclaimedBytes < bytes) {
+            reclaimedBytes += idle_.front().size;
+            retainedBytes_ -= idle_.front().size;
+            evicted.splice(evicted.end(), idle_, idle_.begin());
+        }
+    }
+    // the evicted buffers are freed here, after the lock, handing their reservations back to the accountant.
+    return reclaimedBytes;
+}
+
+void EffectMemoryPool::SetConfig(const MemoryPoolConfig &config)
+{
+    IdleList evicted;
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    TrimLocked(Clock::now(), evicted);
+}
+
+MemoryPoolConfig EffectMemoryPool::GetConfig()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+MemoryPoolStats EffectMemoryPool::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    MemoryPoolStats stats;
+    stats.hitCount = hitCount_.load();
+    stats.missCount = missCount_.load();
+    stats.retainedBytes = retainedBytes_;
+    stats.retainedCount = static_cast<uint32_t>(idle_.size());
+    return stats;
+}
+
+void EffectMemoryPool::TrimIdle()
+{
+    IdleList evicted;
+    std::lock_guard<std::mutex> lock(mutex_);
+    TrimLocked(Clock::now(), evicted);
+}
+
+void EffectMemoryPool::Clear()
+{
+    IdleList evicted;
+    std::lock_guard<std::mutex> lock(mutex_);
+    evicted.swap(idle_);
+    retainedBytes_ = 0;
+    hitCount_ = 0;
+    missCount_ = 0;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -451,6 +451,50 @@ ErrorCode ModifyDataInfo(EffectBuffer *src, const std::shared_ptr<EffectBuffer>
     }
 }
 
+bool IsNeedPackedBuffer(const std::shared_ptr<EffectBuffer> &outputBuffer)
+{
+    // FillOutputData copies row by row with the input stride, every other output takes the buffer as a whole.
+    if (outputBuffer == nullptr || outputBuffer->extraInfo_ == nullptr) {
+        return true;
+    }
+    DataType dataType = outputBuffer->extraInfo_->dataType;
+    return dataType != DataType::PIXEL_MAP && dataType != DataType::SURFACE && dataType != DataType::SURFACE_BUFFER;
+}
+
+ErrorCode PackViewBuffer(const std::shared_ptr<EffectBuffer> &view, const std::shared_ptr<EffectContext> &context,
+    std::shared_ptr<EffectBuffer> &packed)
+{
+    const std::shared_ptr<BufferInfo> &viewInfo = view->bufferInfo_;
+    MemoryInfo allocMemInfo = {
+        .bufferInfo = {
+            .width_ = viewInfo->width_,
+            .height_ = viewInfo->height_,
+            .len_ = FormatHelper::CalculateSize(viewInfo->width_, viewInfo->height_, viewInfo->formatType_),
+            .formatType_ = viewInfo->formatType_,
+            .colorSpace_ = viewInfo->colorSpace_,
+        },
+        .bufferType = viewInfo->bufferType_,
+    };
+    MemoryData *memData = context->memoryManager_->AllocMemory(view->buffer_, allocMemInfo);
+    CHECK_AND_RETURN_RET_LOG(memData != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL, "PackViewBuffer: alloc fail!");
+
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>();
+    *bufferInfo = memData->memoryInfo.bufferInfo;
+    bufferInfo->hdrFormat_ = viewInfo->hdrFormat_;
+    bufferInfo->pixelmapType_ = viewInfo->pixelmapType_;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    *extraInfo = *view->extraInfo_;
+    extraInfo->bufferType = memData->memoryInfo.bufferType;
+    bufferInfo->surfaceBuffer_ = (memData->memoryInfo.bufferType == BufferType::DMA_BUFFER) ?
+        static_cast<SurfaceBuffer *>(memData->memoryInfo.extra) : nullptr;
+    packed = std::make_shared<EffectBuffer>(bufferInfo, memData->data, extraInfo);
+    packed->auxiliaryBufferInfos = view->auxiliaryBufferInfos;
+    MemcpyHelper::CopyData(view.get(), packed.get());
+    EFFECT_LOGD("PackViewBuffer: w=%{public}d, h=%{public}d, viewStride=%{public}d, stride=%{public}d",
+        viewInfo->width_, viewInfo->height_, viewInfo->rowStride_, bufferInfo->rowStride_);
+    return ErrorCode::SUCCESS;
+}
+
 ErrorCode FillOutputData(const std::shared_ptr<EffectBuffer> &inputBuffer, std::shared_ptr<EffectBuffer> &outputBuffer,
     const std::shared_ptr<EffectContext> &context)
 {
@@ -1170,10 +1214,16 @@ ErrorCode ImageSinkFilter::PushData(const std::string &inPort, const std::shared
         return ErrorCode::SUCCESS;
     }
 
+    std::shared_ptr<EffectBuffer> data = buffer;
+    if (buffer->isView_ && IsNeedPackedBuffer(sinkBuffer_)) {
+        ErrorCode res = PackViewBuffer(buffer, context, data);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "PackViewBuffer fail! res=%{public}d", res);
+    }
+
     EFFECT_LOGD("ImageSinkFilter::PushData SaveData");
-    ErrorCode result = SaveData(buffer, sinkBuffer_, context);
+    ErrorCode result = SaveData(data, sinkBuffer_, context);
     CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result, "SaveData fail! result=%{public}d", result);
-    eventReceiver_->OnEvent(Event{ name_, EventType::EVENT_COMPLETE, { buffer } });
+    eventReceiver_->OnEvent(Event{ name_, EventType::EVENT_COMPLETE, { data } });
     return ErrorCode::SUCCESS;
 }
 } // namespace Effect
@@ -15,6 +15,7 @@
 
 #include "image_source_filter.h"
 
+#include "effect_buffer_planner.h"
 #include "effect_log.h"
 #include "effect_trace.h"
 #include "filter_factory.h"
@@ -27,6 +28,23 @@ namespace Media {
 namespace Effect {
 REGISTER_FILTER_FACTORY(ImageSourceFilter);
 
+namespace {
+BufferPlan PlanChainBuffers(const std::shared_ptr<MemNegotiatedCap> &sourceCap,
+    const std::vector<std::shared_ptr<Capability>> &capabilities)
+{
+    // the efilters of the chain are the capabilities carrying a pixel format cap, in chain order.
+    std::vector<BufferPlanStep> steps;
+    for (const auto &capability : capabilities) {
+        if (capability->pixelFormatCap_ == nullptr || capability->memNegotiatedCap_ == nullptr) {
+            continue;
+        }
+        const std::shared_ptr<MemNegotiatedCap> &cap = capability->memNegotiatedCap_;
+        steps.push_back({ cap->width, cap->height, cap->format });
+    }
+    return BufferPlanner::Plan({ sourceCap->width, sourceCap->height, sourceCap->format }, steps);
+}
+} // namespace
+
 ErrorCode ImageSourceFilter::SetSource(const std::shared_ptr<EffectBuffer> &source,
     std::shared_ptr<EffectContext> &context)
 {
@@ -157,6 +175,8 @@ ErrorCode ImageSourceFilter::DoNegotiate()
         return ErrorCode::ERR_PIPELINE_INVALID_FILTER_PORT;
     }
     outPorts_[0]->Negotiate(capability, context_);
+    context_->memoryManager_->SetBufferPlan(PlanChainBuffers(memNegotiatedCap,
+        context_->capNegotiate_->GetCapabilityList()));
     if (context_->renderEnvironment_->GetEGLStatus() != EGLStatus::READY && context_->ipType_ == IPType::GPU) {
         context_->renderEnvironment_->Init();
         context_->renderEnvironment_->Prepare();
@@ -26,6 +26,7 @@
 #include "render_thread.h"
 #include "render_task.h"
 #include "render_environment.h"
+#include "strip_renderer.h"
 
 namespace OHOS {
 namespace Media {
@@ -60,6 +61,7 @@ ErrorCode EFilter::SetValue(const std::string &key, Any &value)
     } else {
         values_[key] = value;
     }
+    valueGeneration_++;
     return ErrorCode::SUCCESS;
 }
 
@@ -83,6 +85,38 @@ bool EFilter::IsTextureInput()
     return false;
 }
 
+LutTablePtr EFilter::GetPointwiseLut()
+{
+    return nullptr;
+}
+
+CacheStatus EFilter::GetCacheStatus() const
+{
+    return cacheConfig_->GetStatus();
+}
+
+bool EFilter::IsStripSupported(EffectBuffer *input)
+{
+    return input != nullptr && input->bufferInfo_ != nullptr &&
+        input->bufferInfo_->formatType_ == IEffectFormat::RGBA8888 && GetPointwiseLut() != nullptr;
+}
+
+StripRange EFilter::MapStripToInput(const StripRange &output, uint32_t inputWidth, uint32_t inputHeight)
+{
+    return output;
+}
+
+ErrorCode EFilter::RenderStrip(EffectBuffer *src, EffectBuffer *dst, const StripInfo &strip,
+    std::shared_ptr<EffectContext> &context)
+{
+    return Render(src, dst, context);
+}
+
+void EFilter::SetStripFollowers(const std::vector<std::shared_ptr<EFilter>> &followers)
+{
+    stripFollowers_.assign(followers.begin(), followers.end());
+}
+
 ErrorCode EFilter::Save(EffectJsonPtr &res)
 {
     res->Put("name", name_);
@@ -408,6 +442,10 @@ ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<Eff
         return res;
     }
     CHECK_AND_RETURN_RET_LOG(outputCap_ != nullptr, ErrorCode::ERR_INPUT_NULL, "outputCap is null.");
+    std::shared_ptr<StripRenderer> stripRenderer = CreateStripRenderer(source.get(), context);
+    if (stripRenderer != nullptr) {
+        return RenderStripChain(stripRenderer, source, preIPType != runningIPType, context);
+    }
     std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap = outputCap_->memNegotiatedCap_;
     EffectBuffer *output = preIPType != runningIPType ? source.get()
         : context->renderStrategy_->ChooseBestOutput(source.get(), memNegotiatedCap);
@@ -432,6 +470,80 @@ ErrorCode EFilter::PushData(const std::string &inPort, const std::shared_ptr<Eff
     return PushData(output, context);
 }
 
+// The strip renderer runs the followers of a chain without their PushData, so a filter only joins a chain when the
+// PushData hooks would do nothing for it: HandleCacheStart and the cache branches act on filters that take part in
+// caching, and IpTypeConvert keeps the buffer only if the filter runs the source format on the running ip type.
+// Any other filter ends the chain and is rendered through its own PushData.
+static bool IsStripCandidate(EFilter *filter, EffectBuffer *source, IPType runningIPType)
+{
+    if (filter == nullptr || filter->GetCacheStatus() != CacheStatus::NO_CACHE || !filter->IsStripSupported(source)) {
+        return false;
+    }
+    std::string name = filter->GetName();
+    std::shared_ptr<PixelFormatCap> pixelFormatCap = GetPixelFormatCap(name);
+    auto it = pixelFormatCap->formats.find(source->bufferInfo_->formatType_);
+    return it != pixelFormatCap->formats.end() &&
+        std::find(it->second.begin(), it->second.end(), runningIPType) != it->second.end();
+}
+
+std::shared_ptr<StripRenderer> EFilter::CreateStripRenderer(EffectBuffer *source,
+    std::shared_ptr<EffectContext> &context)
+{
+    if (!context->isStripRenderEnabled_ || context->ipType_ != IPType::CPU || context->cacheNegotiate_->needCache() ||
+        stripFollowers_.empty() || source == nullptr || source->buffer_ == nullptr || source->bufferInfo_ == nullptr ||
+        !IsStripCandidate(this, source, context->ipType_) || outputCap_->memNegotiatedCap_ == nullptr) {
+        return nullptr;
+    }
+    std::vector<StripStage> stages = {
+        { this, outputCap_->memNegotiatedCap_->width, outputCap_->memNegotiatedCap_->height }
+    };
+    for (const auto &follower : stripFollowers_) {
+        std::shared_ptr<EFilter> filter = follower.lock();
+        if (!IsStripCandidate(filter.get(), source, context->ipType_) || filter->outputCap_ == nullptr ||
+            filter->outputCap_->memNegotiatedCap_ == nullptr) {
+            break;
+        }
+        std::shared_ptr<MemNegotiatedCap> &cap = filter->outputCap_->memNegotiatedCap_;
+        stages.push_back({ filter.get(), cap->width, cap->height });
+    }
+    if (stages.size() < 2) { // a single filter gains nothing from strips
+        return nullptr;
+    }
+
+    std::shared_ptr<StripRenderer> renderer =
+        std::make_shared<StripRenderer>(stages, source->bufferInfo_->formatType_);
+    ErrorCode res = renderer->Plan(source->bufferInfo_->width_, source->bufferInfo_->height_);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, nullptr,
+        "CreateStripRenderer: plan fail, render filters one by one! res=%{public}d", res);
+    return renderer;
+}
+
+ErrorCode EFilter::RenderStripChain(const std::shared_ptr<StripRenderer> &renderer,
+    std::shared_ptr<EffectBuffer> &source, bool isIpTypeChanged, std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("EFilter::RenderStripChain");
+    EFilter *tail = renderer->GetTail();
+    std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap = tail->outputCap_->memNegotiatedCap_;
+    EffectBuffer *output = isIpTypeChanged ? source.get()
+        : context->renderStrategy_->ChooseBestOutput(source.get(), memNegotiatedCap);
+    if (output == source.get() && !renderer->IsInPlaceSafe()) {
+        output = nullptr;
+    }
+    std::shared_ptr<EffectBuffer> effectBuffer = nullptr;
+    if (output == nullptr) {
+        ErrorCode res = AllocBuffer(context, memNegotiatedCap, source, effectBuffer);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS && effectBuffer != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL,
+            "RenderStripChain: alloc buffer fail! filterName=%{public}s", name_.c_str());
+        output = effectBuffer.get();
+    }
+    EFFECT_LOGD("RenderStripChain: strips=%{public}u, inPlace=%{public}d, head=%{public}s, tail=%{public}s",
+        renderer->GetStripCount(), output == source.get(), name_.c_str(), tail->GetName().c_str());
+    ErrorCode res = renderer->Render(source.get(), output, context);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "RenderStripChain: render fail! filterName=%{public}s",
+        name_.c_str());
+    return tail->PushData(output, context);
+}
+
 ErrorCode EFilter::AllocBuffer(std::shared_ptr<EffectContext> &context,
     const std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap, std::shared_ptr<EffectBuffer> &source,
     std::shared_ptr<EffectBuffer> &effectBuffer) const
@@ -445,7 +557,8 @@ ErrorCode EFilter::AllocBuffer(std::shared_ptr<EffectContext> &context,
                 memNegotiatedCap->width, memNegotiatedCap->height, source->bufferInfo_->formatType_),
             .formatType_ = source->bufferInfo_->formatType_,
             .colorSpace_ = source->bufferInfo_->colorSpace_,
-        }
+        },
+        .rowStridePolicy = RowStridePolicy::SIMD_ALIGNED, // filter outputs are only read through rowStride_
     };
     MemoryData *memoryData = context->memoryManager_->AllocMemory(source->buffer_, memInfo);
     CHECK_AND_RETURN_RET_LOG(memoryData != nullptr, ErrorCode::ERR_ALLOC_MEMORY_FAIL, "Alloc new memory fail!");
@@ -533,6 +646,7 @@ ErrorCode EFilter::PushData(EffectBuffer *buffer, std::shared_ptr<EffectContext>
         std::make_shared<EffectBuffer>(buffer->bufferInfo_, buffer->buffer_, buffer->extraInfo_);
     effectBuffer->bufferInfo_->tex_ = buffer->bufferInfo_->tex_;
     effectBuffer->auxiliaryBufferInfos = buffer->auxiliaryBufferInfos;
+    effectBuffer->isView_ = buffer->isView_;
     if (outPorts_.empty()) {
         return OnPushDataPortsEmpty(effectBuffer, context, name_);
     }
@@ -36,7 +36,7 @@ public:
         status_ = status;
     }
 
-    CacheStatus GetStatus()
+    CacheStatus GetStatus() const
     {
         return status_;
     }
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lut_fusion_efilter.h"
+
+#include "effect_log.h"
+#include "effect_trace.h"
+#include "efilter_factory.h"
+#include "lut_helper.h"
+#include "memcpy_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t MIN_FUSION_SIZE = 2;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+
+const std::string &GetFusionName(const std::vector<std::shared_ptr<EFilter>> &members)
+{
+    static const std::string emptyName;
+    return members.empty() || members.front() == nullptr ? emptyName : members.front()->GetName();
+}
+
+bool CheckRGBA8888Buffer(EffectBuffer *buffer, uint32_t width, uint32_t height)
+{
+    const std::shared_ptr<BufferInfo> &info = buffer->bufferInfo_;
+    uint64_t rowBytes = static_cast<uint64_t>(width) * RGBA_BYTES_PER_PIXEL;
+    return buffer->buffer_ != nullptr && info->formatType_ == IEffectFormat::RGBA8888 &&
+        info->width_ >= width && info->height_ >= height && info->rowStride_ >= rowBytes &&
+        static_cast<uint64_t>(info->rowStride_) * (height - 1) + rowBytes <= info->len_;
+}
+} // namespace
+
+// The fused filter takes the name of its first member so that capability lookups resolve to the member effect info,
+// FuseEFilters only groups members whose effect infos are identical.
+LutFusionEFilter::LutFusionEFilter(const std::vector<std::shared_ptr<EFilter>> &members)
+    : EFilter(GetFusionName(members)), members_(members)
+{
+}
+
+LutFusionEFilter::~LutFusionEFilter() = default;
+
+const std::vector<std::shared_ptr<EFilter>> &LutFusionEFilter::GetMembers() const
+{
+    return members_;
+}
+
+bool LutFusionEFilter::IsFusible(const std::shared_ptr<EFilter> &efilter)
+{
+    // Filters that take part in caching keep their own pipeline slot, the cache hooks work on single filters.
+    return efilter != nullptr && efilter->GetCacheStatus() == CacheStatus::NO_CACHE &&
+        efilter->GetPointwiseLut() != nullptr;
+}
+
+bool LutFusionEFilter::IsSameCapability(const std::shared_ptr<EFilter> &left, const std::shared_ptr<EFilter> &right)
+{
+    std::shared_ptr<EffectInfo> leftInfo = EFilterFactory::Instance()->GetEffectInfo(left->GetName());
+    std::shared_ptr<EffectInfo> rightInfo = EFilterFactory::Instance()->GetEffectInfo(right->GetName());
+    CHECK_AND_RETURN_RET(leftInfo != nullptr && rightInfo != nullptr, false);
+    return leftInfo->formats_ == rightInfo->formats_ && leftInfo->colorSpaces_ == rightInfo->colorSpaces_ &&
+        leftInfo->hdrFormats_ == rightInfo->hdrFormats_;
+}
+
+std::vector<uint32_t> LutFusionEFilter::GetFusionPlan(const std::vector<std::shared_ptr<EFilter>> &efilters)
+{
+    std::vector<uint32_t> plan;
+    size_t index = 0;
+    while (index < efilters.size()) {
+        size_t end = index + 1;
+        if (IsFusible(efilters[index])) {
+            while (end < efilters.size() && IsFusible(efilters[end]) &&
+                IsSameCapability(efilters[index], efilters[end])) {
+                end++;
+            }
+        }
+        plan.emplace_back(static_cast<uint32_t>(end - index));
+        index = end;
+    }
+    return plan;
+}
+
+std::vector<std::shared_ptr<EFilter>> LutFusionEFilter::FuseEFilters(
+    const std::vector<std::shared_ptr<EFilter>> &efilters, const std::vector<uint32_t> &plan)
+{
+    std::vector<std::shared_ptr<EFilter>> result;
+    size_t index = 0;
+    for (uint32_t size : plan) {
+        if (size == 0 || index + size > efilters.size()) {
+            EFFECT_LOGE("FuseEFilters: plan does not match efilters! index=%{public}zu, size=%{public}u", index, size);
+            break;
+        }
+        if (size < MIN_FUSION_SIZE) {
+            result.emplace_back(efilters[index]);
+        } else {
+            std::vector<std::shared_ptr<EFilter>> members(efilters.begin() + index, efilters.begin() + index + size);
+            EFFECT_LOGI("FuseEFilters: fuse %{public}u lut filters from %{public}s", size,
+                members.front()->GetName().c_str());
+            result.emplace_back(std::make_shared<LutFusionEFilter>(members));
+        }
+        index += size;
+    }
+    for (; index < efilters.size(); index++) {
+        result.emplace_back(efilters[index]);
+    }
+    return result;
+}
+
+ErrorCode LutFusionEFilter::Render(EffectBuffer *buffer, std::shared_ptr<EffectContext> &context)
+{
+    if (context->ipType_ == IPType::GPU) {
+        std::shared_ptr<BufferInfo> bufferInfo = std::make_unique<BufferInfo>();
+        std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+        extraInfo->dataType = DataType::TEX;
+        std::shared_ptr<EffectBuffer> effectBuffer = std::make_shared<EffectBuffer>(bufferInfo, nullptr, extraInfo);
+        ErrorCode res = Render(buffer, effectBuffer.get(), context);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "filter(%{public}s) render fail", name_.c_str());
+        return PushData(effectBuffer.get(), context);
+    }
+    ErrorCode res = Render(buffer, buffer, context);
+    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "filter(%{public}s) render fail", name_.c_str());
+    return PushData(buffer, context);
+}
+
+ErrorCode LutFusionEFilter::Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
+    CHECK_AND_RETURN_RET_LOG(!members_.empty(), ErrorCode::ERR_INPUT_NULL, "fusion members is empty!");
+    if (context->ipType_ == IPType::CPU && src->bufferInfo_->formatType_ == IEffectFormat::RGBA8888) {
+        return RenderFusedLut(src, dst);
+    }
+    return RenderMembers(src, dst, context);
+}
+
+LutTablePtr LutFusionEFilter::GetPointwiseLut()
+{
+    std::vector<uint32_t> generations;
+    for (const auto &member : members_) {
+        generations.emplace_back(member->GetValueGeneration());
+    }
+    std::lock_guard<std::mutex> lock(fusedLutMutex_);
+    if (fusedLut_ != nullptr && fusedLutGenerations_ == generations) {
+        return fusedLut_;
+    }
+
+    std::shared_ptr<LutTable> fused = std::make_shared<LutTable>();
+    fused->type = LutType::IDENTITY;
+    fused->bitDepth = LutCache::BIT_DEPTH_8;
+    fused->lut8.resize(LUT_8BIT_SIZE);
+    for (uint32_t idx = 0; idx < LUT_8BIT_SIZE; idx++) {
+        fused->lut8[idx] = static_cast<uint8_t>(idx);
+    }
+    for (const auto &member : members_) {
+        LutTablePtr table = member->GetPointwiseLut();
+        CHECK_AND_RETURN_RET_LOG(table != nullptr && table->lut8.size() == LUT_8BIT_SIZE, nullptr,
+            "get lut fail! filter=%{public}s", member->GetName().c_str());
+        for (uint32_t idx = 0; idx < LUT_8BIT_SIZE; idx++) {
+            fused->lut8[idx] = table->lut8[fused->lut8[idx]];
+        }
+        if (table->type != LutType::IDENTITY) {
+            fused->type = table->type;
+        }
+    }
+    fusedLut_ = fused;
+    fusedLutGenerations_ = std::move(generations);
+    return fusedLut_;
+}
+
+ErrorCode LutFusionEFilter::RenderFusedLut(EffectBuffer *src, EffectBuffer *dst)
+{
+    EFFECT_TRACE_NAME("LutFusionEFilter::RenderFusedLut");
+    LutTablePtr fused = GetPointwiseLut();
+    CHECK_AND_RETURN_RET_LOG(fused != nullptr, ErrorCode::ERR_INVALID_PARAMETER_VALUE, "compose lut fail! "
+        "filter=%{public}s", name_.c_str());
+    const uint8_t *lut = fused->lut8.data();
+
+    uint32_t width = src->bufferInfo_->width_;
+    uint32_t height = src->bufferInfo_->height_;
+    CHECK_AND_RETURN_RET_LOG(width > 0 && height > 0 && CheckRGBA8888Buffer(src, width, height) &&
+        CheckRGBA8888Buffer(dst, width, height), ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+        "invalid buffer! width=%{public}d, height=%{public}d, filter=%{public}s", width, height, name_.c_str());
+
+    bool isIdentity = true;
+    for (uint32_t idx = 0; idx < LUT_8BIT_SIZE && isIdentity; idx++) {
+        isIdentity = lut[idx] == idx;
+    }
+    if (isIdentity) {
+        return MemcpyHelper::CopyData(src, dst);
+    }
+
+    LutPlaneInfo srcPlane = { static_cast<uint8_t *>(src->buffer_), src->bufferInfo_->rowStride_ };
+    LutPlaneInfo dstPlane = { static_cast<uint8_t *>(dst->buffer_), dst->bufferInfo_->rowStride_ };
+    LutHelper::ApplyRGBA8888(srcPlane, dstPlane, width, height, lut);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode LutFusionEFilter::RenderMembers(EffectBuffer *src, EffectBuffer *dst,
+    std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("LutFusionEFilter::RenderMembers");
+    // Gpu members output textures, so every member but the last renders into its own texture buffer.
+    std::vector<std::shared_ptr<EffectBuffer>> intermediates;
+    EffectBuffer *input = src;
+    for (size_t idx = 0; idx < members_.size(); idx++) {
+        EffectBuffer *output = dst;
+        if (context->ipType_ == IPType::GPU && idx + 1 < members_.size()) {
+            std::shared_ptr<BufferInfo> bufferInfo = std::make_unique<BufferInfo>();
+            std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+            extraInfo->dataType = DataType::TEX;
+            intermediates.emplace_back(std::make_shared<EffectBuffer>(bufferInfo, nullptr, extraInfo));
+            output = intermediates.back().get();
+        }
+        ErrorCode res = members_[idx]->Render(input, output, context);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "member render fail! filter=%{public}s",
+            members_[idx]->GetName().c_str());
+        input = output;
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode LutFusionEFilter::Restore(const EffectJsonPtr &values)
+{
+    // Parameters live in the member efilters, the fused filter is rebuilt from them and never restored itself.
+    return ErrorCode::SUCCESS;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_LUT_FUSION_EFILTER_H
+#define IMAGE_EFFECT_LUT_FUSION_EFILTER_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "efilter.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+/**
+ * Runs a run of adjacent pointwise lut efilters as one pipeline filter. On cpu rgba8888 the member luts are composed
+ * into a single table and the frame is processed in one pass, every other path renders the members one by one.
+ */
+class LutFusionEFilter : public EFilter {
+public:
+    IMAGE_EFFECT_EXPORT explicit LutFusionEFilter(const std::vector<std::shared_ptr<EFilter>> &members);
+
+    IMAGE_EFFECT_EXPORT ~LutFusionEFilter() override;
+
+    IMAGE_EFFECT_EXPORT ErrorCode Render(EffectBuffer *buffer, std::shared_ptr<EffectContext> &context) override;
+
+    IMAGE_EFFECT_EXPORT
+    ErrorCode Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context) override;
+
+    IMAGE_EFFECT_EXPORT ErrorCode Restore(const EffectJsonPtr &values) override;
+
+    // The member luts composed in order, so a fused filter can still join a strip chain as one pointwise stage. The
+    // table is composed once and reused until a member value changes.
+    IMAGE_EFFECT_EXPORT LutTablePtr GetPointwiseLut() override;
+
+    IMAGE_EFFECT_EXPORT const std::vector<std::shared_ptr<EFilter>> &GetMembers() const;
+
+    // Length of each run of efilters that share one pipeline filter, 1 for efilters that are not fused.
+    IMAGE_EFFECT_EXPORT
+    static std::vector<uint32_t> GetFusionPlan(const std::vector<std::shared_ptr<EFilter>> &efilters);
+
+    IMAGE_EFFECT_EXPORT static std::vector<std::shared_ptr<EFilter>> FuseEFilters(
+        const std::vector<std::shared_ptr<EFilter>> &efilters, const std::vector<uint32_t> &plan);
+
+private:
+    static bool IsFusible(const std::shared_ptr<EFilter> &efilter);
+
+    static bool IsSameCapability(const std::shared_ptr<EFilter> &left, const std::shared_ptr<EFilter> &right);
+
+    ErrorCode RenderFusedLut(EffectBuffer *src, EffectBuffer *dst);
+
+    ErrorCode RenderMembers(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context);
+
+    std::vector<std::shared_ptr<EFilter>> members_;
+
+    std::mutex fusedLutMutex_;
+    LutTablePtr fusedLut_ = nullptr;
+    std::vector<uint32_t> fusedLutGenerations_; // value generation of every member when fusedLut_ was composed
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_LUT_FUSION_EFILTER_H
@@ -32,6 +32,20 @@ EffectBuffer *ChooseBufOnSetInput(EffectBuffer *buffer, EffectBuffer *src,
     return buffer;
 }
 
+bool IsInSrcBuffer(EffectBuffer *buffer, EffectBuffer *src)
+{
+    // a crop view shares the memory of src without sharing its start address.
+    if (src->buffer_ == buffer->buffer_) {
+        return true;
+    }
+    if (src->bufferInfo_ == nullptr || buffer->buffer_ == nullptr || src->buffer_ == nullptr) {
+        return false;
+    }
+    auto *addr = static_cast<uint8_t *>(buffer->buffer_);
+    auto *srcStart = static_cast<uint8_t *>(src->buffer_);
+    return addr >= srcStart && addr < srcStart + src->bufferInfo_->len_;
+}
+
 EffectBuffer *ChooseBufOnSetInOutput(EffectBuffer *buffer, EffectBuffer *src, EffectBuffer *dst,
     std::shared_ptr<MemNegotiatedCap> &memNegotiatedCap)
 {
@@ -53,7 +67,7 @@ EffectBuffer *ChooseBufOnSetInOutput(EffectBuffer *buffer, EffectBuffer *src, Ef
     }
 
     // not allow to modify src while set input and output
-    if (src->buffer_ == buffer->buffer_) {
+    if (IsInSrcBuffer(buffer, src)) {
         return nullptr;
     }
 
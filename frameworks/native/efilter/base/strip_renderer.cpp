@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "strip_renderer.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "cpu_feature_helper.h"
+#include "effect_log.h"
+#include "effect_trace.h"
+#include "format_helper.h"
+#include "lut_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t L2_CACHE_LEVEL = 2;
+constexpr uint32_t STRIP_BUFFER_COUNT = 2; // the strip being read and the strip being written
+constexpr uint32_t MIN_STRIP_ROWS = 4;
+constexpr uint32_t SCRATCH_BUFFER_COUNT = 2;
+
+std::shared_ptr<EffectBuffer> CreateStripView(EffectBuffer *buffer, uint8_t *data, uint32_t width, uint32_t rows,
+    uint32_t rowStride, uint32_t len)
+{
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>();
+    *bufferInfo = *buffer->bufferInfo_;
+    bufferInfo->width_ = width;
+    bufferInfo->height_ = rows;
+    bufferInfo->rowStride_ = rowStride;
+    bufferInfo->len_ = len;
+    bufferInfo->surfaceBuffer_ = nullptr;
+    return std::make_shared<EffectBuffer>(bufferInfo, data, buffer->extraInfo_);
+}
+
+std::shared_ptr<EffectBuffer> CreateImageView(EffectBuffer *buffer, const StripRange &range)
+{
+    uint32_t rowStride = buffer->bufferInfo_->rowStride_;
+    size_t offset = static_cast<size_t>(range.row) * rowStride;
+    size_t len = std::min(static_cast<size_t>(range.rows) * rowStride,
+        static_cast<size_t>(buffer->bufferInfo_->len_) - offset);
+    return CreateStripView(buffer, static_cast<uint8_t *>(buffer->buffer_) + offset, buffer->bufferInfo_->width_,
+        range.rows, rowStride, static_cast<uint32_t>(len));
+}
+} // namespace
+
+StripRenderer::StripRenderer(const std::vector<StripStage> &stages, IEffectFormat format)
+    : stages_(stages), format_(format)
+{
+}
+
+uint32_t StripRenderer::CalculateStripRows(uint32_t rowBytes, uint32_t height)
+{
+    uint32_t rows = CpuFeatureHelper::GetCacheSize(L2_CACHE_LEVEL) / (STRIP_BUFFER_COUNT * std::max(rowBytes, 1u));
+    rows = std::max(rows, MIN_STRIP_ROWS);
+    return std::min(rows, std::max(height, 1u));
+}
+
+ErrorCode StripRenderer::Plan(uint32_t inputWidth, uint32_t inputHeight)
+{
+    EFFECT_TRACE_NAME("StripRenderer::Plan");
+    CHECK_AND_RETURN_RET_LOG(!stages_.empty(), ErrorCode::ERR_INPUT_NULL, "Plan: stages is empty!");
+    size_t stageCount = stages_.size();
+    inputWidths_.resize(stageCount);
+    inputHeights_.resize(stageCount);
+    luts_.resize(stageCount);
+    plans_.clear();
+    scratchRowStride_ = 0;
+    scratchRows_ = 0;
+    isInPlaceSafe_ = true;
+
+    uint32_t width = inputWidth;
+    uint32_t height = inputHeight;
+    uint32_t maxRowBytes = FormatHelper::CalculateRowStride(width, format_);
+    for (size_t idx = 0; idx < stageCount; idx++) {
+        const StripStage &stage = stages_[idx];
+        CHECK_AND_RETURN_RET_LOG(stage.filter != nullptr && stage.outputWidth > 0 && stage.outputHeight > 0,
+            ErrorCode::ERR_INVALID_PARAMETER_VALUE, "Plan: invalid stage! index=%{public}zu", idx);
+        inputWidths_[idx] = width;
+        inputHeights_[idx] = height;
+
+        // Pointwise luts are applied here directly, which keeps per strip work free of parameter parsing and logs.
+        LutTablePtr lut = stage.filter->GetPointwiseLut();
+        bool isLutStage = lut != nullptr && lut->lut8.size() == LUT_8BIT_SIZE &&
+            format_ == IEffectFormat::RGBA8888 && stage.outputWidth == width && stage.outputHeight == height;
+        luts_[idx] = isLutStage ? lut : nullptr;
+
+        uint32_t outputRowBytes = FormatHelper::CalculateRowStride(stage.outputWidth, format_);
+        maxRowBytes = std::max(maxRowBytes, outputRowBytes);
+        if (idx + 1 < stageCount) {
+            scratchRowStride_ = std::max(scratchRowStride_, outputRowBytes);
+        }
+        width = stage.outputWidth;
+        height = stage.outputHeight;
+    }
+
+    uint32_t stripRows = CalculateStripRows(maxRowBytes, height);
+    for (uint32_t row = 0; row < height; row += stripRows) {
+        StripRange output = { row, std::min(stripRows, height - row) };
+        StripPlan plan;
+        ErrorCode res = PlanStrip(output, plan);
+        CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+        plans_.emplace_back(std::move(plan));
+    }
+    isInPlaceSafe_ = isInPlaceSafe_ && width == inputWidth && height == inputHeight;
+    EFFECT_LOGD("StripRenderer::Plan: stages=%{public}zu, strips=%{public}zu, stripRows=%{public}u, "
+        "scratchRows=%{public}u", stageCount, plans_.size(), stripRows, scratchRows_);
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode StripRenderer::PlanStrip(const StripRange &output, StripPlan &plan)
+{
+    size_t stageCount = stages_.size();
+    plan.inputs.resize(stageCount);
+    plan.outputs.resize(stageCount);
+    StripRange current = output;
+    for (size_t idx = stageCount; idx > 0; idx--) {
+        size_t stage = idx - 1;
+        plan.outputs[stage] = current;
+        StripRange input = stages_[stage].filter->MapStripToInput(current, inputWidths_[stage], inputHeights_[stage]);
+        CHECK_AND_RETURN_RET_LOG(input.rows > 0 && input.row < inputHeights_[stage] &&
+            input.rows <= inputHeights_[stage] - input.row, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+            "PlanStrip: invalid input strip! row=%{public}u, rows=%{public}u, filter=%{public}s", input.row,
+            input.rows, stages_[stage].filter->GetName().c_str());
+        plan.inputs[stage] = input;
+        current = input;
+        if (stage + 1 < stageCount) {
+            scratchRows_ = std::max(scratchRows_, plan.outputs[stage].rows);
+        }
+    }
+    const StripRange &first = plan.inputs.front();
+    isInPlaceSafe_ = isInPlaceSafe_ && first.row == output.row && first.rows == output.rows;
+    return ErrorCode::SUCCESS;
+}
+
+bool StripRenderer::IsInPlaceSafe() const
+{
+    return isInPlaceSafe_;
+}
+
+uint32_t StripRenderer::GetStripCount() const
+{
+    return static_cast<uint32_t>(plans_.size());
+}
+
+EFilter *StripRenderer::GetTail() const
+{
+    return stages_.empty() ? nullptr : stages_.back().filter;
+}
+
+ErrorCode StripRenderer::Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("StripRenderer::Render");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr && src->buffer_ != nullptr && dst->buffer_ != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "Render: src or dst is null!");
+    CHECK_AND_RETURN_RET_LOG(!plans_.empty(), ErrorCode::ERR_INVALID_PARAMETER_VALUE, "Render: not planned!");
+    const StripStage &tail = stages_.back();
+    CHECK_AND_RETURN_RET_LOG(dst->bufferInfo_->width_ >= tail.outputWidth &&
+        dst->bufferInfo_->height_ >= tail.outputHeight && src->bufferInfo_->width_ >= inputWidths_.front() &&
+        src->bufferInfo_->height_ >= inputHeights_.front(), ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+        "Render: buffer size mismatch the plan!");
+
+    // Strips are independent, workers take contiguous runs of strips and reuse one pair of scratch buffers each.
+    uint32_t stripCount = GetStripCount();
+    uint32_t workerCount = std::max(std::min(stripCount, std::thread::hardware_concurrency()), 1u);
+    size_t scratchSize = static_cast<size_t>(scratchRowStride_) * scratchRows_;
+    std::vector<ErrorCode> results(workerCount, ErrorCode::SUCCESS);
+#pragma omp parallel for default(none) shared(workerCount, stripCount, scratchSize, results, src, dst, context)
+    for (uint32_t worker = 0; worker < workerCount; worker++) {
+        std::vector<std::vector<uint8_t>> scratches(SCRATCH_BUFFER_COUNT, std::vector<uint8_t>(scratchSize));
+        uint32_t begin = static_cast<uint32_t>(static_cast<uint64_t>(stripCount) * worker / workerCount);
+        uint32_t end = static_cast<uint32_t>(static_cast<uint64_t>(stripCount) * (worker + 1) / workerCount);
+        for (uint32_t strip = begin; strip < end && results[worker] == ErrorCode::SUCCESS; strip++) {
+            results[worker] = RenderStrip(plans_[strip], src, dst, scratches, context);
+        }
+    }
+    for (ErrorCode result : results) {
+        CHECK_AND_RETURN_RET_LOG(result == ErrorCode::SUCCESS, result, "Render: render strip fail! res=%{public}d",
+            result);
+    }
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode StripRenderer::RenderStrip(const StripPlan &plan, EffectBuffer *src, EffectBuffer *dst,
+    std::vector<std::vector<uint8_t>> &scratches, std::shared_ptr<EffectContext> &context)
+{
+    std::shared_ptr<EffectBuffer> input = CreateImageView(src, plan.inputs.front());
+    for (size_t idx = 0; idx < stages_.size(); idx++) {
+        const StripStage &stage = stages_[idx];
+        const StripRange &outputRange = plan.outputs[idx];
+        std::shared_ptr<EffectBuffer> output = nullptr;
+        if (idx + 1 == stages_.size()) {
+            output = CreateImageView(dst, outputRange);
+        } else {
+            std::vector<uint8_t> &scratch = scratches[idx % SCRATCH_BUFFER_COUNT];
+            output = CreateStripView(src, scratch.data(), stage.outputWidth, outputRange.rows, scratchRowStride_,
+                scratchRowStride_ * outputRange.rows);
+        }
+
+        if (luts_[idx] != nullptr) {
+            LutPlaneInfo srcPlane = { static_cast<uint8_t *>(input->buffer_), input->bufferInfo_->rowStride_ };
+            LutPlaneInfo dstPlane = { static_cast<uint8_t *>(output->buffer_), output->bufferInfo_->rowStride_ };
+            LutHelper::ApplyRGBA8888(srcPlane, dstPlane, stage.outputWidth, outputRange.rows, luts_[idx]->lut8.data());
+        } else {
+            StripInfo strip = { outputRange, plan.inputs[idx], inputWidths_[idx], inputHeights_[idx] };
+            ErrorCode res = stage.filter->RenderStrip(input.get(), output.get(), strip, context);
+            CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "RenderStrip fail! filter=%{public}s, "
+                "row=%{public}u", stage.filter->GetName().c_str(), outputRange.row);
+        }
+        input = output;
+    }
+    return ErrorCode::SUCCESS;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
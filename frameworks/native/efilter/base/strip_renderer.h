@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_STRIP_RENDERER_H
+#define IMAGE_EFFECT_STRIP_RENDERER_H
+
+#include <memory>
+#include <vector>
+
+#include "efilter.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+struct StripStage {
+    EFilter *filter = nullptr;
+    uint32_t outputWidth = 0;
+    uint32_t outputHeight = 0;
+};
+
+/**
+ * Renders a chain of cpu efilters strip by strip. Output rows are split into strips sized so that a strip and the
+ * buffer it renders into fit in the l2 cache, each strip is mapped back through the chain and then
+ * pushed through every stage using small scratch buffers instead of full frame intermediates.
+ */
+class StripRenderer {
+public:
+    StripRenderer(const std::vector<StripStage> &stages, IEffectFormat format);
+    ~StripRenderer() = default;
+
+    ErrorCode Plan(uint32_t inputWidth, uint32_t inputHeight);
+
+    // Whether every strip reads exactly the rows it writes, which lets the chain render into its own input.
+    bool IsInPlaceSafe() const;
+
+    uint32_t GetStripCount() const;
+
+    EFilter *GetTail() const;
+
+    ErrorCode Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context);
+
+    static uint32_t CalculateStripRows(uint32_t rowBytes, uint32_t height);
+
+private:
+    struct StripPlan {
+        std::vector<StripRange> inputs;
+        std::vector<StripRange> outputs;
+    };
+
+    ErrorCode PlanStrip(const StripRange &output, StripPlan &plan);
+
+    ErrorCode RenderStrip(const StripPlan &plan, EffectBuffer *src, EffectBuffer *dst,
+        std::vector<std::vector<uint8_t>> &scratches, std::shared_ptr<EffectContext> &context);
+
+    std::vector<StripStage> stages_;
+    IEffectFormat format_ = IEffectFormat::DEFAULT;
+    std::vector<uint32_t> inputWidths_;
+    std::vector<uint32_t> inputHeights_;
+    std::vector<LutTablePtr> luts_;
+    std::vector<StripPlan> plans_;
+    uint32_t scratchRowStride_ = 0;
+    uint32_t scratchRows_ = 0;
+    bool isInPlaceSafe_ = true;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_STRIP_RENDERER_H
@@ -41,6 +41,9 @@ BrightnessEFilter::BrightnessEFilter(const std::string &name) : EFilter(name)
                 { IEffectFormat::RGBA8888, CpuBrightnessAlgo::OnApplyRGBA8888 },
                 { IEffectFormat::YUVNV12, CpuBrightnessAlgo::OnApplyYUVNV12 },
                 { IEffectFormat::YUVNV21, CpuBrightnessAlgo::OnApplyYUVNV21 },
+                { IEffectFormat::RGBA_1010102, CpuBrightnessAlgo::OnApplyRGBA1010102 },
+                { IEffectFormat::YCBCR_P010, CpuBrightnessAlgo::OnApplyYCBCRP010 },
+                { IEffectFormat::YCRCB_P010, CpuBrightnessAlgo::OnApplyYCRCBP010 },
             }
         },
         {
@@ -144,12 +147,23 @@ std::shared_ptr<EffectInfo> BrightnessEFilter::GetEffectInfo(const std::string &
     info_->formats_.emplace(IEffectFormat::RGBA8888, std::vector<IPType>{ IPType::CPU, IPType::GPU });
     info_->formats_.emplace(IEffectFormat::YUVNV21, std::vector<IPType>{ IPType::CPU });
     info_->formats_.emplace(IEffectFormat::YUVNV12, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::RGBA_1010102, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCBCR_P010, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCRCB_P010, std::vector<IPType>{ IPType::CPU });
     info_->category_ = Category::COLOR_ADJUST;
     info_->colorSpaces_ = {
         EffectColorSpace::SRGB,
         EffectColorSpace::SRGB_LIMIT,
         EffectColorSpace::DISPLAY_P3,
-        EffectColorSpace::DISPLAY_P3_LIMIT
+        EffectColorSpace::DISPLAY_P3_LIMIT,
+        EffectColorSpace::BT2020_HLG,
+        EffectColorSpace::BT2020_HLG_LIMIT,
+        EffectColorSpace::BT2020_PQ,
+        EffectColorSpace::BT2020_PQ_LIMIT
+    };
+    info_->hdrFormats_ = {
+        HdrFormat::SDR,
+        HdrFormat::HDR10,
     };
     return info_;
 }
@@ -158,6 +172,11 @@ ErrorCode BrightnessEFilter::PreRender(IEffectFormat &format)
 {
     return ErrorCode::SUCCESS;
 }
+
+LutTablePtr BrightnessEFilter::GetPointwiseLut()
+{
+    return CpuBrightnessAlgo::GetPointwiseLut(values_);
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
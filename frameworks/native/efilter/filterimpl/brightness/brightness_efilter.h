@@ -46,6 +46,8 @@ public:
     IMAGE_EFFECT_EXPORT static std::shared_ptr<EffectInfo> GetEffectInfo(const std::string &name);
 
     ErrorCode PreRender(IEffectFormat &format) override;
+
+    LutTablePtr GetPointwiseLut() override;
 private:
     using ApplyFunc =
         std::function<ErrorCode(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
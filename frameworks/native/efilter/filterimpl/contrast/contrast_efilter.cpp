@@ -40,6 +40,9 @@ ContrastEFilter::ContrastEFilter(const std::string &name) : EFilter(name)
                 { IEffectFormat::RGBA8888, CpuContrastAlgo::OnApplyRGBA8888 },
                 { IEffectFormat::YUVNV12, CpuContrastAlgo::OnApplyYUVNV12 },
                 { IEffectFormat::YUVNV21, CpuContrastAlgo::OnApplyYUVNV21 },
+                { IEffectFormat::RGBA_1010102, CpuContrastAlgo::OnApplyRGBA1010102 },
+                { IEffectFormat::YCBCR_P010, CpuContrastAlgo::OnApplyYCBCRP010 },
+                { IEffectFormat::YCRCB_P010, CpuContrastAlgo::OnApplyYCRCBP010 },
             }
         },
         {
@@ -141,12 +144,23 @@ std::shared_ptr<EffectInfo> ContrastEFilter::GetEffectInfo(const std::string &na
     info_->formats_.emplace(IEffectFormat::RGBA8888, std::vector<IPType>{ IPType::CPU, IPType::GPU });
     info_->formats_.emplace(IEffectFormat::YUVNV21, std::vector<IPType>{ IPType::CPU });
     info_->formats_.emplace(IEffectFormat::YUVNV12, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::RGBA_1010102, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCBCR_P010, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCRCB_P010, std::vector<IPType>{ IPType::CPU });
     info_->category_ = Category::COLOR_ADJUST;
     info_->colorSpaces_ = {
         EffectColorSpace::SRGB,
         EffectColorSpace::SRGB_LIMIT,
         EffectColorSpace::DISPLAY_P3,
-        EffectColorSpace::DISPLAY_P3_LIMIT
+        EffectColorSpace::DISPLAY_P3_LIMIT,
+        EffectColorSpace::BT2020_HLG,
+        EffectColorSpace::BT2020_HLG_LIMIT,
+        EffectColorSpace::BT2020_PQ,
+        EffectColorSpace::BT2020_PQ_LIMIT
+    };
+    info_->hdrFormats_ = {
+        HdrFormat::SDR,
+        HdrFormat::HDR10,
     };
     return info_;
 }
@@ -155,6 +169,11 @@ ErrorCode ContrastEFilter::PreRender(IEffectFormat &format)
 {
     return ErrorCode::SUCCESS;
 }
+
+LutTablePtr ContrastEFilter::GetPointwiseLut()
+{
+    return CpuContrastAlgo::GetPointwiseLut(values_);
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
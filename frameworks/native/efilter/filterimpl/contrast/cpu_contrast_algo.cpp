@@ -19,7 +19,9 @@
 
 #include "common_utils.h"
 #include "effect_log.h"
-#include "format_helper.h"
+#include "lut_cache.h"
+#include "lut_helper.h"
+#include "memcpy_helper.h"
 #include "securec.h"
 #include "effect_trace.h"
 
@@ -28,12 +30,7 @@ namespace Media {
 namespace Effect {
 
 constexpr float ESP = 1e-5;
-constexpr uint32_t SCALE_FACTOR = 100;
-constexpr uint32_t UNSIGHED_CHAR_DATA_RECORDS = 256;
 constexpr uint32_t BYTES_PER_INT = 4;
-constexpr uint32_t RGBA_ALPHA_INDEX = 3;
-constexpr double PI = 3.14159265;
-constexpr uint32_t ALGORITHM_PARAMTER_FACTOR = 2;
 const int RGBA_SIZE = 4;
 
 ErrorCode ContrastCheckBufferInfolen(EffectBuffer *src, EffectBuffer *dst, uint32_t src_width, uint32_t src_height)
@@ -43,7 +40,8 @@ ErrorCode ContrastCheckBufferInfolen(EffectBuffer *src, EffectBuffer *dst, uint3
     
     if (dst->bufferInfo_->len_ < dst_width*dst_height*RGBA_SIZE ||
         src->bufferInfo_->len_ < src_width*src_height*RGBA_SIZE ||
-        dst->bufferInfo_->len_ < src->bufferInfo_->len_ ||
+        (dst->bufferInfo_->rowStride_ == src->bufferInfo_->rowStride_ &&
+        dst->bufferInfo_->len_ < src->bufferInfo_->len_) ||
         src->bufferInfo_->len_ < static_cast<uint32_t>(src->bufferInfo_->rowStride_) * src_height ||
         dst->bufferInfo_->len_ < static_cast<uint32_t>(dst->bufferInfo_->rowStride_) * src_height) {
         return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
@@ -69,40 +67,22 @@ ErrorCode CpuContrastAlgo::OnApplyRGBA8888(EffectBuffer *src, EffectBuffer *dst,
 
     float eps = ESP;
     if (fabs(contrast) < eps) {
-        if (src != dst) {
-            errno_t result = memcpy_s(dstRgb, dst->bufferInfo_->len_, srcRgb, src->bufferInfo_->len_);
-            CHECK_AND_RETURN_RET_LOG(result == 0, ErrorCode::ERR_MEMCPY_FAIL, "memory copy failed: %{public}d", result);
-        }
-        return ErrorCode::SUCCESS;
-    }
-    float scale = contrast / SCALE_FACTOR;
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t idx = 0; idx < UNSIGHED_CHAR_DATA_RECORDS; idx++) {
-        float current = (float)idx / UNSIGHED_CHAR_MAX;
-        current = current - scale * 0.1f * sin(ALGORITHM_PARAMTER_FACTOR * PI * current);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[idx] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+        return MemcpyHelper::CopyData(src, dst);
     }
+    LutTablePtr lutTable = LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_8);
+    CHECK_AND_RETURN_RET_LOG(lutTable != nullptr, ErrorCode::ERR_INVALID_PARAMETER_VALUE, "get lut fail!");
+    const uint8_t *lut = lutTable->lut8.data();
 
     uint32_t srcRowStride = src->bufferInfo_->rowStride_;
     uint32_t dstRowStride = dst->bufferInfo_->rowStride_;
     
-    if (srcRowStride * (height - 1) + (width - 1) * BYTES_PER_INT + BYTES_PER_INT >  dst->bufferInfo_->len_ ||
-    dstRowStride * (height - 1) + (width - 1) * BYTES_PER_INT + BYTES_PER_INT > src->bufferInfo_->len_) {
+    if (srcRowStride * (height - 1) + (width - 1) * BYTES_PER_INT + BYTES_PER_INT >  src->bufferInfo_->len_ ||
+    dstRowStride * (height - 1) + (width - 1) * BYTES_PER_INT + BYTES_PER_INT > dst->bufferInfo_->len_) {
         return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
     }
-#pragma omp parallel for default(none) shared(height, width, dstRgb, srcRgb, lut, srcRowStride, dstRowStride)
-    for (uint32_t y = 0; y < height; ++y) {
-        for (uint32_t x = 0; x < width; ++x) {
-            for (uint32_t i = 0; i < BYTES_PER_INT; ++i) {
-                uint32_t srcIndex = srcRowStride * y + x * BYTES_PER_INT + i;
-                uint32_t dstIndex = dstRowStride * y + x * BYTES_PER_INT + i;
-                dstRgb[dstIndex] = (i == RGBA_ALPHA_INDEX) ? srcRgb[srcIndex] : lut[srcRgb[srcIndex]];
-            }
-        }
-    }
-
+    LutPlaneInfo srcPlane = { srcRgb, srcRowStride };
+    LutPlaneInfo dstPlane = { dstRgb, dstRowStride };
+    LutHelper::ApplyRGBA8888(srcPlane, dstPlane, width, height, lut);
     return ErrorCode::SUCCESS;
 }
 
@@ -115,9 +95,6 @@ ErrorCode CpuContrastAlgo::OnApplyYUVNV21(EffectBuffer *src, EffectBuffer *dst,
     auto *srcNV21 = static_cast<unsigned char *>(src->buffer_);
     auto *dstNV21 = static_cast<unsigned char *>(dst->buffer_);
 
-    uint32_t width = src->bufferInfo_->width_;
-    uint32_t height = src->bufferInfo_->height_;
-
     float eps = ESP;
     if (fabs(contrast) < eps) {
         if (src != dst) {
@@ -126,40 +103,11 @@ ErrorCode CpuContrastAlgo::OnApplyYUVNV21(EffectBuffer *src, EffectBuffer *dst,
         }
         return ErrorCode::SUCCESS;
     }
-    float scale = contrast / SCALE_FACTOR;
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t i = 0; i < UNSIGHED_CHAR_DATA_RECORDS; i++) {
-        float current = (float)(i) / UNSIGHED_CHAR_MAX;
-        current = current - scale * 0.1f * sin(ALGORITHM_PARAMTER_FACTOR * PI * current);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[i] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
-    }
+    LutTablePtr lutTable = LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_8);
+    CHECK_AND_RETURN_RET_LOG(lutTable != nullptr, ErrorCode::ERR_INVALID_PARAMETER_VALUE, "get lut fail!");
+    const uint8_t *lut = lutTable->lut8.data();
 
-    uint8_t *srcNV21UV = srcNV21 + width * height;
-    uint8_t *dstNV21UV = dstNV21 + width * height;
-
-#pragma omp parallel for default(none) shared(height, width, srcNV21, dstNV21, lut)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * width + j;
-            uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
-
-            uint8_t y = srcNV21[y_index];
-            uint8_t v = srcNV21UV[nv_index];
-            uint8_t u = srcNV21UV[nv_index + 1];
-            uint8_t r = FormatHelper::YuvToR(y, u, v);
-            uint8_t g = FormatHelper::YuvToG(y, u, v);
-            uint8_t b = FormatHelper::YuvToB(y, u, v);
-            r = lut[r];
-            g = lut[g];
-            b = lut[b];
-            dstNV21[y_index] = FormatHelper::RGBToY(r, g, b);
-            dstNV21UV[nv_index] = FormatHelper::RGBToV(r, g, b);
-            dstNV21UV[nv_index + 1] = FormatHelper::RGBToU(r, g, b);
-        }
-    }
-    return ErrorCode::SUCCESS;
+    return LutHelper::ApplyYUV420SP(src, dst, lut, IEffectFormat::YUVNV21);
 }
 
 ErrorCode CpuContrastAlgo::OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst,
@@ -172,9 +120,6 @@ ErrorCode CpuContrastAlgo::OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst,
     auto *srcNV12 = static_cast<unsigned char *>(src->buffer_);
     auto *dstNV12 = static_cast<unsigned char *>(dst->buffer_);
 
-    uint32_t width = src->bufferInfo_->width_;
-    uint32_t height = src->bufferInfo_->height_;
-
     float eps = ESP;
     if (fabs(contrast) < eps) {
         if (src != dst) {
@@ -183,43 +128,76 @@ ErrorCode CpuContrastAlgo::OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst,
         }
         return ErrorCode::SUCCESS;
     }
-    float scale = contrast / SCALE_FACTOR;
-
-    unsigned char lut[UNSIGHED_CHAR_DATA_RECORDS] = {0};
-    for (uint32_t idx = 0; idx < UNSIGHED_CHAR_DATA_RECORDS; idx++) {
-        float current = (float)(idx) / UNSIGHED_CHAR_MAX;
-        current = current - scale * 0.1f * sin(ALGORITHM_PARAMTER_FACTOR * PI * current);
-        current = CommonUtils::Clip(current, 0, 1);
-        lut[idx] = (unsigned char)(current * UNSIGHED_CHAR_MAX);
+    LutTablePtr lutTable = LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_8);
+    CHECK_AND_RETURN_RET_LOG(lutTable != nullptr, ErrorCode::ERR_INVALID_PARAMETER_VALUE, "get lut fail!");
+    const uint8_t *lut = lutTable->lut8.data();
+
+    return LutHelper::ApplyYUV420SP(src, dst, lut, IEffectFormat::YUVNV12);
+}
+
+ErrorCode CpuContrastAlgo::OnApplyRGBA1010102(EffectBuffer *src, EffectBuffer *dst,
+    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("CpuContrastAlgo::OnApplyRGBA1010102");
+    EFFECT_LOGI("CpuContrastAlgo::OnApplyRGBA1010102 enter!");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
+    float contrast = ParseContrast(value);
+    uint32_t width = src->bufferInfo_->width_;
+    uint32_t height = src->bufferInfo_->height_;
+    if (ContrastCheckBufferInfolen(src, dst, width, height) != ErrorCode::SUCCESS) {
+        return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
     }
 
-    uint8_t *srcNV12UV = srcNV12 + width * height;
-    uint8_t *dstNV12UV = dstNV12 + width * height;
-
-#pragma omp parallel for default(none) shared(height, width, srcNV12, dstNV12, lut)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * width + j;
-            uint32_t nv_index = i / 2 * width + j - j % 2; // 2 mean u/v split factor
-
-            uint8_t y = srcNV12[y_index];
-            uint8_t u = srcNV12UV[nv_index];
-            uint8_t v = srcNV12UV[nv_index + 1];
-            uint8_t r = FormatHelper::YuvToR(y, u, v);
-            uint8_t g = FormatHelper::YuvToG(y, u, v);
-            uint8_t b = FormatHelper::YuvToB(y, u, v);
-            r = lut[r];
-            g = lut[g];
-            b = lut[b];
-
-            dstNV12[y_index] = FormatHelper::RGBToY(r, g, b);
-            dstNV12UV[nv_index] = FormatHelper::RGBToU(r, g, b);
-            dstNV12UV[nv_index + 1] = FormatHelper::RGBToV(r, g, b);
-        }
+    if (fabs(contrast) < ESP) {
+        return MemcpyHelper::CopyData(src, dst);
+    }
+    LutTablePtr lutTable = LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_10);
+    CHECK_AND_RETURN_RET_LOG(lutTable != nullptr && lutTable->lut16.size() == LUT_10BIT_SIZE,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "get lut fail!");
+
+    uint32_t srcRowStride = src->bufferInfo_->rowStride_;
+    uint32_t dstRowStride = dst->bufferInfo_->rowStride_;
+    if (srcRowStride * (height - 1) + width * BYTES_PER_INT > src->bufferInfo_->len_ ||
+        dstRowStride * (height - 1) + width * BYTES_PER_INT > dst->bufferInfo_->len_) {
+        return ErrorCode::ERR_INVALID_PARAMETER_VALUE;
     }
+    LutPlaneInfo srcPlane = { static_cast<uint8_t *>(src->buffer_), srcRowStride };
+    LutPlaneInfo dstPlane = { static_cast<uint8_t *>(dst->buffer_), dstRowStride };
+    LutHelper::ApplyRGBA1010102(srcPlane, dstPlane, width, height, lutTable->lut16.data());
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode CpuContrastAlgo::OnApplyYCBCRP010(EffectBuffer *src, EffectBuffer *dst,
+    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("CpuContrastAlgo::OnApplyYCBCRP010");
+    EFFECT_LOGI("CpuContrastAlgo::OnApplyYCBCRP010 enter!");
+    return ApplyP010(src, dst, value, IEffectFormat::YCBCR_P010);
+}
+
+ErrorCode CpuContrastAlgo::OnApplyYCRCBP010(EffectBuffer *src, EffectBuffer *dst,
+    std::map<std::string, Any> &value, std::shared_ptr<EffectContext> &context)
+{
+    EFFECT_TRACE_NAME("CpuContrastAlgo::OnApplyYCRCBP010");
+    EFFECT_LOGI("CpuContrastAlgo::OnApplyYCRCBP010 enter!");
+    return ApplyP010(src, dst, value, IEffectFormat::YCRCB_P010);
+}
+
+ErrorCode CpuContrastAlgo::ApplyP010(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+    IEffectFormat format)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL, "input para is null!");
+    float contrast = ParseContrast(value);
+    if (fabs(contrast) < ESP) {
+        return MemcpyHelper::CopyData(src, dst);
+    }
+    LutTablePtr lutTable = LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_10);
+    CHECK_AND_RETURN_RET_LOG(lutTable != nullptr && lutTable->lut16.size() == LUT_10BIT_SIZE,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "get lut fail!");
+
+    return LutHelper::ApplyP010(src, dst, lutTable->lut16.data(), format);
+}
+
 float CpuContrastAlgo::ParseContrast(std::map<std::string, Any> &value)
 {
     float contrast = 0.f;
@@ -230,6 +208,15 @@ float CpuContrastAlgo::ParseContrast(std::map<std::string, Any> &value)
     EFFECT_LOGI("get value success! contrast=%{public}f", contrast);
     return contrast;
 }
+
+LutTablePtr CpuContrastAlgo::GetPointwiseLut(std::map<std::string, Any> &value)
+{
+    float contrast = ParseContrast(value);
+    if (fabs(contrast) < ESP) {
+        return LutCache::Instance().GetLut(LutType::IDENTITY, 0.f, LutCache::BIT_DEPTH_8);
+    }
+    return LutCache::Instance().GetLut(LutType::CONTRAST, contrast, LutCache::BIT_DEPTH_8);
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "error_code.h"
 #include "any.h"
 #include "effect_context.h"
+#include "lut_cache.h"
 
 namespace OHOS {
 namespace Media {
@@ -37,8 +38,23 @@ public:
     static ErrorCode OnApplyYUVNV12(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
         std::shared_ptr<EffectContext> &context);
 
+    static ErrorCode OnApplyRGBA1010102(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+        std::shared_ptr<EffectContext> &context);
+
+    static ErrorCode OnApplyYCBCRP010(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+        std::shared_ptr<EffectContext> &context);
+
+    static ErrorCode OnApplyYCRCBP010(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+        std::shared_ptr<EffectContext> &context);
+
+    // Per-channel lut applied by the rgba path, an identity lut when the intensity leaves the image untouched.
+    static LutTablePtr GetPointwiseLut(std::map<std::string, Any> &value);
+
 private:
     static float ParseContrast(std::map<std::string, Any> &value);
+
+    static ErrorCode ApplyP010(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+        IEffectFormat format);
 };
 } // namespace Effect
 } // namespace Media
@@ -18,6 +18,7 @@
 #include "common_utils.h"
 #include "efilter_factory.h"
 #include "colorspace_helper.h"
+#include "format_helper.h"
 
 namespace OHOS {
 namespace Media {
@@ -29,6 +30,8 @@ const std::string CropEFilter::Parameter::KEY_REGION = "FilterRegion";
 std::shared_ptr<EffectInfo> CropEFilter::info_ = nullptr;
 namespace {
     constexpr int32_t PIXEL_BYTES = 4;
+    constexpr int32_t P010_SAMPLE_BYTES = 2;
+    constexpr int32_t YUV_ALIGN = 2; // chroma of yuv420 semi-planar covers 2x2 luma
 }
 
 struct AreaInfo {
@@ -46,21 +49,25 @@ struct Region {
 };
 
 void CalculateCropRegion(int32_t srcWidth, int32_t srcHeight, std::map<std::string, Any> &values,
-    Region *region)
+    Region *region, bool isQuiet = false)
 {
     AreaInfo areaInfo = { 0, 0, srcWidth, srcHeight };
     void *area = nullptr;
     ErrorCode res = CommonUtils::GetValue(CropEFilter::Parameter::KEY_REGION, values, area);
     if (res != ErrorCode::SUCCESS || area == nullptr) {
         // allow developer not set para, not execute crop. execute copy.
-        EFFECT_LOGW("CropEFilter::CalculateCropRegion get value fail! res=%{public}d. "
-            "use default value, not execute crop!", res);
+        if (!isQuiet) {
+            EFFECT_LOGW("CropEFilter::CalculateCropRegion get value fail! res=%{public}d. "
+                "use default value, not execute crop!", res);
+        }
     } else {
         areaInfo = *(static_cast<AreaInfo *>(area));
     }
 
-    EFFECT_LOGI("CropEFilter x0=%{public}d, y0=%{public}d, x1=%{public}d, y1=%{public}d",
-        areaInfo.x0, areaInfo.y0, areaInfo.x1, areaInfo.y1);
+    if (!isQuiet) {
+        EFFECT_LOGI("CropEFilter x0=%{public}d, y0=%{public}d, x1=%{public}d, y1=%{public}d",
+            areaInfo.x0, areaInfo.y0, areaInfo.x1, areaInfo.y1);
+    }
 
     int32_t leftTopX = areaInfo.x0 > areaInfo.x1 ? areaInfo.x1 : areaInfo.x0;
     int32_t leftTopY = areaInfo.y0 > areaInfo.y1 ? areaInfo.y1 : areaInfo.y0;
@@ -81,44 +88,117 @@ void CalculateCropRegion(int32_t srcWidth, int32_t srcHeight, std::map<std::stri
     region->height = cropHeight;
 }
 
-void Crop(EffectBuffer *src, EffectBuffer *dst, Region *region)
+bool IsYuvFormat(IEffectFormat format)
 {
-    int32_t cropLeft = region->left;
-    int32_t cropTop = region->top;
-    int32_t cropWidth = region->width;
-    int32_t cropHeight = region->height;
-    int32_t dstWidth = static_cast<int32_t>(dst->bufferInfo_->width_);
-    int32_t dstHeight = static_cast<int32_t>(dst->bufferInfo_->height_);
+    return format == IEffectFormat::YUVNV12 || format == IEffectFormat::YUVNV21 ||
+        format == IEffectFormat::YCBCR_P010 || format == IEffectFormat::YCRCB_P010;
+}
 
-    int32_t rowCount = cropHeight > dstHeight ? dstHeight : cropHeight;
-    int32_t pixelCount = cropWidth > dstWidth ? dstWidth : cropWidth;
-    int32_t count = pixelCount * PIXEL_BYTES;
-    CHECK_AND_RETURN_LOG(rowCount > 0 && pixelCount > 0, "Crop: invalid rowCount or pixelCount");
+bool IsCropSupportedFormat(IEffectFormat format)
+{
+    return format == IEffectFormat::RGBA8888 || format == IEffectFormat::RGBA_1010102 || IsYuvFormat(format);
+}
 
-    auto *srcBuffer = static_cast<char *>(src->buffer_);
-    auto *dstBuffer = static_cast<char *>(dst->buffer_);
-    uint32_t srcRowStride = src->bufferInfo_->rowStride_;
-    uint32_t dstRowStride = dst->bufferInfo_->rowStride_;
+int32_t GetSampleBytes(IEffectFormat format)
+{
+    switch (format) {
+        case IEffectFormat::YUVNV12:
+        case IEffectFormat::YUVNV21:
+            return 1;
+        case IEffectFormat::YCBCR_P010:
+        case IEffectFormat::YCRCB_P010:
+            return P010_SAMPLE_BYTES;
+        default:
+            return PIXEL_BYTES;
+    }
+}
 
-    size_t srcStartOff = static_cast<size_t>(cropTop) * srcRowStride + static_cast<size_t>(cropLeft) * PIXEL_BYTES;
-    size_t srcEnd = srcStartOff + static_cast<size_t>(rowCount - 1) * srcRowStride + static_cast<size_t>(count);
-    size_t dstEnd = static_cast<size_t>(rowCount - 1) * dstRowStride + static_cast<size_t>(count);
+void AlignCropRegion(IEffectFormat format, Region *region)
+{
+    if (!IsYuvFormat(format)) {
+        return;
+    }
+    // move the left top corner to an even position so the chroma samples stay paired with their luma,
+    // and keep the size even so the uv plane has exactly half of the rows.
+    int32_t right = region->left + region->width;
+    int32_t bottom = region->top + region->height;
+    region->left -= region->left % YUV_ALIGN;
+    region->top -= region->top % YUV_ALIGN;
+    region->width = right - region->left;
+    region->height = bottom - region->top;
+    region->width -= region->width % YUV_ALIGN;
+    region->height -= region->height % YUV_ALIGN;
+}
 
-    CHECK_AND_RETURN_LOG(srcEnd <= static_cast<size_t>(src->bufferInfo_->len_) &&
-        dstEnd <= static_cast<size_t>(dst->bufferInfo_->len_), "Crop: buffer overflow");
+struct CropPlane {
+    char *data;
+    size_t len;
+    uint32_t rowStride;
+};
 
-    char *srcStart = srcBuffer + srcStartOff;
+bool CopyPlaneRegion(const CropPlane &src, const CropPlane &dst, size_t srcStartOff, int32_t rowCount, int32_t count)
+{
+    size_t srcEnd = srcStartOff + static_cast<size_t>(rowCount - 1) * src.rowStride + static_cast<size_t>(count);
+    size_t dstEnd = static_cast<size_t>(rowCount - 1) * dst.rowStride + static_cast<size_t>(count);
+    CHECK_AND_RETURN_RET_LOG(srcEnd <= src.len && dstEnd <= dst.len, false, "Crop: buffer overflow");
+
+    char *srcStart = src.data + srcStartOff;
     EFFECT_LOGD("Crop: srcRowStride=%{public}d, dstRowStride=%{public}d, rowCount=%{public}d, count=%{public}d",
-        srcRowStride, dstRowStride, rowCount, count);
+        src.rowStride, dst.rowStride, rowCount, count);
 
     for (int32_t i = 0; i < rowCount; ++i) {
-        errno_t ret = memcpy_s(dstBuffer + static_cast<size_t>(i) * dstRowStride, dstRowStride,
-            srcStart + static_cast<size_t>(i) * srcRowStride, count);
+        errno_t ret = memcpy_s(dst.data + static_cast<size_t>(i) * dst.rowStride, dst.rowStride,
+            srcStart + static_cast<size_t>(i) * src.rowStride, count);
         if (ret != 0) {
             EFFECT_LOGE("CropEFilter::Render memcpy_s failed. ret=%{public}d, i=%{public}d", ret, i);
             continue;
         }
     }
+    return true;
+}
+
+ErrorCode Crop(EffectBuffer *src, EffectBuffer *dst, Region *region)
+{
+    int32_t cropLeft = region->left;
+    int32_t cropTop = region->top;
+    int32_t cropWidth = region->width;
+    int32_t cropHeight = region->height;
+    int32_t dstWidth = static_cast<int32_t>(dst->bufferInfo_->width_);
+    int32_t dstHeight = static_cast<int32_t>(dst->bufferInfo_->height_);
+
+    IEffectFormat format = src->bufferInfo_->formatType_;
+    int32_t sampleBytes = GetSampleBytes(format);
+    int32_t rowCount = cropHeight > dstHeight ? dstHeight : cropHeight;
+    int32_t pixelCount = cropWidth > dstWidth ? dstWidth : cropWidth;
+    int32_t count = pixelCount * sampleBytes;
+    CHECK_AND_RETURN_RET_LOG(rowCount > 0 && pixelCount > 0, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+        "Crop: invalid rowCount or pixelCount! rowCount=%{public}d, pixelCount=%{public}d", rowCount, pixelCount);
+
+    uint32_t srcRowStride = src->bufferInfo_->rowStride_;
+    uint32_t dstRowStride = dst->bufferInfo_->rowStride_;
+    CropPlane srcPlane = { static_cast<char *>(src->buffer_), src->bufferInfo_->len_, srcRowStride };
+    CropPlane dstPlane = { static_cast<char *>(dst->buffer_), dst->bufferInfo_->len_, dstRowStride };
+    size_t srcStartOff = static_cast<size_t>(cropTop) * srcRowStride + static_cast<size_t>(cropLeft) * sampleBytes;
+    CHECK_AND_RETURN_RET_LOG(CopyPlaneRegion(srcPlane, dstPlane, srcStartOff, rowCount, count),
+        ErrorCode::ERR_MEMCPY_FAIL, "Crop: copy y fail!");
+    if (!IsYuvFormat(format)) {
+        return ErrorCode::SUCCESS;
+    }
+
+    // the interleaved uv plane follows the y plane, one uv row and one uv pair per 2x2 luma block.
+    size_t srcYSize = static_cast<size_t>(srcRowStride) * src->bufferInfo_->height_;
+    size_t dstYSize = static_cast<size_t>(dstRowStride) * dst->bufferInfo_->height_;
+    CHECK_AND_RETURN_RET_LOG(srcYSize < srcPlane.len && dstYSize < dstPlane.len, ErrorCode::ERR_MEMCPY_FAIL,
+        "Crop: no uv plane");
+    CropPlane srcUvPlane = { srcPlane.data + srcYSize, srcPlane.len - srcYSize, srcRowStride };
+    CropPlane dstUvPlane = { dstPlane.data + dstYSize, dstPlane.len - dstYSize, dstRowStride };
+    size_t srcUvStartOff = static_cast<size_t>(cropTop / YUV_ALIGN) * srcRowStride +
+        static_cast<size_t>(cropLeft) * sampleBytes;
+    int32_t uvRowCount = (rowCount + 1) / YUV_ALIGN;
+    int32_t uvCount = (pixelCount + 1) / YUV_ALIGN * YUV_ALIGN * sampleBytes;
+    CHECK_AND_RETURN_RET_LOG(CopyPlaneRegion(srcUvPlane, dstUvPlane, srcUvStartOff, uvRowCount, uvCount),
+        ErrorCode::ERR_MEMCPY_FAIL, "Crop: copy uv fail!");
+    return ErrorCode::SUCCESS;
 }
 
 ErrorCode CropEFilter::Render(EffectBuffer *src, EffectBuffer *dst, std::shared_ptr<EffectContext> &context)
@@ -128,16 +208,15 @@ ErrorCode CropEFilter::Render(EffectBuffer *src, EffectBuffer *dst, std::shared_
         "input error! src->bufferInfo_=%{public}d, dst->bufferInfo_=%{public}d",
         src->bufferInfo_ == nullptr, dst->bufferInfo_ == nullptr);
 
-    // only support RGBA for now.
     IEffectFormat format = src->bufferInfo_->formatType_;
-    CHECK_AND_RETURN_RET_LOG(format == IEffectFormat::RGBA8888 || format == IEffectFormat::RGBA_1010102,
-        ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE, "crop not support format! format=%{public}d", format);
+    CHECK_AND_RETURN_RET_LOG(IsCropSupportedFormat(format), ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE,
+        "crop not support format! format=%{public}d", format);
 
     Region region = { 0, 0, 0, 0 };
     CalculateCropRegion(static_cast<int32_t>(src->bufferInfo_->width_), static_cast<int32_t>(src->bufferInfo_->height_),
         values_, &region);
-    Crop(src, dst, &region);
-    return ErrorCode::SUCCESS;
+    AlignCropRegion(format, &region);
+    return Crop(src, dst, &region);
 }
 
 void UpdateDstEffectBufferIfNeed(EffectBuffer *src, EffectBuffer *dst)
@@ -168,6 +247,7 @@ ErrorCode CropEFilter::CropToOutputBuffer(EffectBuffer *src, std::shared_ptr<Eff
     Region region = { 0, 0, 0, 0 };
     CalculateCropRegion(static_cast<int32_t>(src->bufferInfo_->width_), static_cast<int32_t>(src->bufferInfo_->height_),
         values_, &region);
+    AlignCropRegion(src->bufferInfo_->formatType_, &region);
     int32_t cropLeft = region.left;
     int32_t cropTop = region.top;
     int32_t cropWidth = region.width;
@@ -175,16 +255,18 @@ ErrorCode CropEFilter::CropToOutputBuffer(EffectBuffer *src, std::shared_ptr<Eff
 
     EFFECT_LOGI("CropEFilter cropLeft=%{public}d, cropTop=%{public}d, cropWidth=%{public}d, cropHeight=%{public}d",
         cropLeft, cropTop, cropWidth, cropHeight);
-    CHECK_AND_RETURN_RET_LOG(cropWidth >= 0 && cropHeight >= 0, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+    // a yuv region narrower than the chroma block is aligned down to nothing.
+    CHECK_AND_RETURN_RET_LOG(cropWidth > 0 && cropHeight > 0, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
         "invalid cropSize!");
-    CHECK_AND_RETURN_RET_LOG(cropWidth == 0 || static_cast<int64_t>(std::numeric_limits<uint32_t>::max()) / cropWidth >
+    CHECK_AND_RETURN_RET_LOG(static_cast<int64_t>(std::numeric_limits<uint32_t>::max()) / cropWidth >
         cropHeight * PIXEL_BYTES, ErrorCode::ERR_INVALID_PARAMETER_VALUE, "huge cropSize!");
 
     MemoryInfo allocMemInfo = {
         .bufferInfo = {
             .width_ = static_cast<uint32_t>(cropWidth),
             .height_ = static_cast<uint32_t>(cropHeight),
-            .len_ = static_cast<uint32_t>(cropWidth * cropHeight * PIXEL_BYTES),
+            .len_ = FormatHelper::CalculateSize(static_cast<uint32_t>(cropWidth), static_cast<uint32_t>(cropHeight),
+                src->bufferInfo_->formatType_),
             .formatType_ = src->bufferInfo_->formatType_,
             .colorSpace_ = src->bufferInfo_->colorSpace_,
         },
@@ -207,20 +289,68 @@ ErrorCode CropEFilter::CropToOutputBuffer(EffectBuffer *src, std::shared_ptr<Eff
     return Render(src, output.get(), context);
 }
 
+std::shared_ptr<EffectBuffer> CropEFilter::CreateCropView(EffectBuffer *src)
+{
+    // yuv has a second plane that an offset base address can't describe, and hdr output needs the dma copy
+    // carrying the metadata, both of them fall back to CropToOutputBuffer.
+    IEffectFormat format = src->bufferInfo_->formatType_;
+    if (src->buffer_ == nullptr || (format != IEffectFormat::RGBA8888 && format != IEffectFormat::RGBA_1010102) ||
+        ColorSpaceHelper::IsHdrColorSpace(src->bufferInfo_->colorSpace_)) {
+        return nullptr;
+    }
+
+    Region region = { 0, 0, 0, 0 };
+    CalculateCropRegion(static_cast<int32_t>(src->bufferInfo_->width_), static_cast<int32_t>(src->bufferInfo_->height_),
+        values_, &region);
+    CHECK_AND_RETURN_RET_LOG(region.width > 0 && region.height > 0, nullptr, "CreateCropView: invalid cropSize!");
+    if (region.left == 0 && region.top == 0 && static_cast<uint32_t>(region.width) == src->bufferInfo_->width_ &&
+        static_cast<uint32_t>(region.height) == src->bufferInfo_->height_) {
+        return std::make_shared<EffectBuffer>(src->bufferInfo_, src->buffer_, src->extraInfo_);
+    }
+
+    // the view keeps the source row stride, so its last row must still own a whole stride inside the source.
+    uint32_t rowStride = src->bufferInfo_->rowStride_;
+    size_t offset = static_cast<size_t>(region.top) * rowStride + static_cast<size_t>(region.left) * PIXEL_BYTES;
+    size_t len = static_cast<size_t>(region.height) * rowStride;
+    if (rowStride < static_cast<uint32_t>(region.width) * PIXEL_BYTES ||
+        offset + len > static_cast<size_t>(src->bufferInfo_->len_)) {
+        return nullptr;
+    }
+
+    EFFECT_LOGI("CropEFilter view cropLeft=%{public}d, cropTop=%{public}d, cropWidth=%{public}d, "
+        "cropHeight=%{public}d", region.left, region.top, region.width, region.height);
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>();
+    *bufferInfo = *src->bufferInfo_;
+    bufferInfo->width_ = static_cast<uint32_t>(region.width);
+    bufferInfo->height_ = static_cast<uint32_t>(region.height);
+    bufferInfo->len_ = static_cast<uint32_t>(len);
+    bufferInfo->surfaceBuffer_ = nullptr;
+    bufferInfo->tex_ = nullptr;
+    void *data = static_cast<uint8_t *>(src->buffer_) + offset;
+    bufferInfo->addr_ = data;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    *extraInfo = *src->extraInfo_;
+    std::shared_ptr<EffectBuffer> view = std::make_shared<EffectBuffer>(bufferInfo, data, extraInfo);
+    view->auxiliaryBufferInfos = src->auxiliaryBufferInfos;
+    view->isView_ = true;
+    return view;
+}
+
 ErrorCode CropEFilter::Render(EffectBuffer *buffer, std::shared_ptr<EffectContext> &context)
 {
     DataType dataType = buffer->extraInfo_->dataType;
     CHECK_AND_RETURN_RET_LOG(dataType == DataType::PIXEL_MAP || dataType == DataType::URI || dataType == DataType::PATH,
         ErrorCode::ERR_UNSUPPORTED_DATA_TYPE, "crop only support pixelMap uri path! dataType=%{public}d", dataType);
 
-    // only support RGBA for now.
     IEffectFormat format = buffer->bufferInfo_->formatType_;
-    CHECK_AND_RETURN_RET_LOG(format == IEffectFormat::RGBA8888 || format == IEffectFormat::RGBA_1010102,
-        ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE, "crop not support format! format=%{public}d", format);
+    CHECK_AND_RETURN_RET_LOG(IsCropSupportedFormat(format), ErrorCode::ERR_UNSUPPORTED_FORMAT_TYPE,
+        "crop not support format! format=%{public}d", format);
 
-    std::shared_ptr<EffectBuffer> output;
-    ErrorCode res = CropToOutputBuffer(buffer, context, output);
-    CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "filter(%{public}s) render fail", name_.c_str());
+    std::shared_ptr<EffectBuffer> output = CreateCropView(buffer);
+    if (output == nullptr) {
+        ErrorCode res = CropToOutputBuffer(buffer, context, output);
+        CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "filter(%{public}s) render fail", name_.c_str());
+    }
 
     return PushData(output.get(), context);
 }
@@ -230,6 +360,7 @@ std::shared_ptr<MemNegotiatedCap> CropEFilter::Negotiate(const std::shared_ptr<M
 {
     Region region = { 0, 0, 0, 0 };
     CalculateCropRegion(static_cast<int32_t>(input->width), static_cast<int32_t>(input->height), values_, &region);
+    AlignCropRegion(input->format, &region);
 
     std::shared_ptr<MemNegotiatedCap> current = std::make_shared<MemNegotiatedCap>();
     current->width = static_cast<uint32_t>(region.width);
@@ -239,6 +370,43 @@ std::shared_ptr<MemNegotiatedCap> CropEFilter::Negotiate(const std::shared_ptr<M
     return current;
 }
 
+bool CropEFilter::IsStripSupported(EffectBuffer *input)
+{
+    if (input == nullptr || input->bufferInfo_ == nullptr || input->extraInfo_ == nullptr) {
+        return false;
+    }
+    DataType dataType = input->extraInfo_->dataType;
+    IEffectFormat format = input->bufferInfo_->formatType_;
+    // hdr output needs a dma buffer carrying the source metadata, which only CropToOutputBuffer sets up.
+    return (dataType == DataType::PIXEL_MAP || dataType == DataType::URI || dataType == DataType::PATH) &&
+        (format == IEffectFormat::RGBA8888 || format == IEffectFormat::RGBA_1010102) &&
+        !ColorSpaceHelper::IsHdrColorSpace(input->bufferInfo_->colorSpace_);
+}
+
+StripRange CropEFilter::MapStripToInput(const StripRange &output, uint32_t inputWidth, uint32_t inputHeight)
+{
+    Region region = { 0, 0, 0, 0 };
+    CalculateCropRegion(static_cast<int32_t>(inputWidth), static_cast<int32_t>(inputHeight), values_, &region, true);
+    return { output.row + static_cast<uint32_t>(region.top), output.rows };
+}
+
+ErrorCode CropEFilter::RenderStrip(EffectBuffer *src, EffectBuffer *dst, const StripInfo &strip,
+    std::shared_ptr<EffectContext> &context)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr && src->bufferInfo_ != nullptr &&
+        dst->bufferInfo_ != nullptr, ErrorCode::ERR_INPUT_NULL, "RenderStrip: input error!");
+    Region region = { 0, 0, 0, 0 };
+    CalculateCropRegion(static_cast<int32_t>(strip.inputWidth), static_cast<int32_t>(strip.inputHeight), values_,
+        &region, true);
+    // src starts at strip.input.row of the whole input, so the crop top is relative to it.
+    int64_t top = static_cast<int64_t>(strip.output.row) + region.top - strip.input.row;
+    CHECK_AND_RETURN_RET_LOG(top >= 0 && top + strip.output.rows <= strip.input.rows,
+        ErrorCode::ERR_INVALID_PARAMETER_VALUE, "RenderStrip: strip out of range! row=%{public}u", strip.output.row);
+    Region stripRegion = { region.left, static_cast<int32_t>(top), region.width,
+        static_cast<int32_t>(strip.output.rows) };
+    return Crop(src, dst, &stripRegion);
+}
+
 std::shared_ptr<EffectInfo> CropEFilter::GetEffectInfo(const std::string &name)
 {
     if (info_ != nullptr) {
@@ -247,6 +415,10 @@ std::shared_ptr<EffectInfo> CropEFilter::GetEffectInfo(const std::string &name)
     info_ = std::make_unique<EffectInfo>();
     info_->formats_.emplace(IEffectFormat::RGBA8888, std::vector<IPType>{ IPType::CPU });
     info_->formats_.emplace(IEffectFormat::RGBA_1010102, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YUVNV12, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YUVNV21, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCBCR_P010, std::vector<IPType>{ IPType::CPU });
+    info_->formats_.emplace(IEffectFormat::YCRCB_P010, std::vector<IPType>{ IPType::CPU });
     info_->category_ = Category::SHAPE_ADJUST;
     info_->colorSpaces_ = {
         EffectColorSpace::SRGB,
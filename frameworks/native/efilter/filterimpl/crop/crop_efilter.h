@@ -43,7 +43,15 @@ public:
     std::shared_ptr<MemNegotiatedCap> Negotiate(const std::shared_ptr<MemNegotiatedCap> &input,
         std::shared_ptr<EffectContext> &context) override;
 
+    bool IsStripSupported(EffectBuffer *input) override;
+
+    StripRange MapStripToInput(const StripRange &output, uint32_t inputWidth, uint32_t inputHeight) override;
+
+    ErrorCode RenderStrip(EffectBuffer *src, EffectBuffer *dst, const StripInfo &strip,
+        std::shared_ptr<EffectContext> &context) override;
+
 private:
+    std::shared_ptr<EffectBuffer> CreateCropView(EffectBuffer *src);
     ErrorCode CropToOutputBuffer(EffectBuffer *src, std::shared_ptr<EffectContext> &context,
         std::shared_ptr<EffectBuffer> &output);
     static std::shared_ptr<EffectInfo> info_;
@@ -16,8 +16,11 @@
 #ifndef RENDER_RESOURCE_CACHE_H
 #define RENDER_RESOURCE_CACHE_H
 
+#include <atomic>
+
 #include "base/render_base.h"
 #include "base/cache/render_fifo_cache.h"
+#include "effect_memory_accountant.h"
 #include "graphic/render_general_program.h"
 #include "render_mesh.h"
 #include "graphic/render_texture.h"
@@ -43,9 +46,21 @@ public:
     ResourceCache()
     {
         isRelease = false;
+        // textures belong to the egl context they were made in, and shared workers switch between the contexts of
+        // several effects on one thread. A reservation made while that context is current trims at once, it may be
+        // the one that would have to wait for the trim. Others leave a request that the next RequestTexture handles.
+        reclaimerId_ = EffectMemoryAccountant::Instance().AddReclaimer([this](uint64_t bytes) {
+            EGLContext context = eglGetCurrentContext();
+            if (context != EGL_NO_CONTEXT && context == glContext_.load()) {
+                return TrimTexCache(bytes);
+            }
+            texTrimRequest_.fetch_add(bytes);
+            return static_cast<uint64_t>(0);
+        });
     }
     ~ResourceCache()
     {
+        EffectMemoryAccountant::Instance().RemoveReclaimer(reclaimerId_);
         isRelease = true;
         texReleaseFlag = true;
         DeleteAllShader();
@@ -110,6 +125,8 @@ public:
 
     RenderTexturePtr RequestTexture(GLsizei w, GLsizei h, GLenum interFmt)
     {
+        glContext_.store(eglGetCurrentContext());
+        TrimTexCacheIfRequested();
         UINT64 tag = GetTexTag(w, h, interFmt);
         RenderTexture *rawTex;
         RenderTexturePtr tex;
@@ -120,6 +137,7 @@ public:
         } else {
             rawTex = new RenderTexture(w, h, interFmt);
             rawTex->Init();
+            EffectMemoryAccountant::Instance().Charge(GetTexBytes(rawTex));
         }
         return RenderTexturePtr(rawTex, [this](auto *p) {
             if (p) {
@@ -182,12 +200,42 @@ public:
     }
 
 private:
+    static uint64_t GetTexBytes(RenderTexture *tex)
+    {
+        return static_cast<uint64_t>(tex->Width()) * tex->Height() *
+            GLUtils::GetInternalFormatPixelByteSize(tex->Format());
+    }
+
+    static void DestroyTexture(RenderTexture *tex)
+    {
+        uint64_t bytes = GetTexBytes(tex);
+        tex->Release();
+        delete tex;
+        EffectMemoryAccountant::Instance().Release(bytes);
+    }
+
+    void TrimTexCacheIfRequested()
+    {
+        uint64_t trimBytes = texTrimRequest_.exchange(0);
+        if (trimBytes != 0) {
+            TrimTexCache(trimBytes);
+        }
+    }
+
+    uint64_t TrimTexCache(uint64_t bytes)
+    {
+        size_t cacheSize = disuseTexCache_.Size();
+        texReleaseFlag = true;
+        disuseTexCache_.ReSize(cacheSize > bytes ? cacheSize - static_cast<size_t>(bytes) : 0, false);
+        texReleaseFlag = false;
+        return static_cast<uint64_t>(cacheSize - disuseTexCache_.Size());
+    }
+
     void RecycleTexture(RenderTexture *tex)
     {
         if (isRelease) {
             if (tex) {
-                tex->Release();
-                delete tex;
+                DestroyTexture(tex);
             }
             return;
         }
@@ -195,8 +243,7 @@ private:
         UINT64 tag = GetTexTag(tex->Width(), tex->Height(), tex->Format());
         auto func = [this](RenderTexture *p) {
             if (texReleaseFlag && p) {
-                p->Release();
-                delete p;
+                DestroyTexture(p);
             }
         };
         texReleaseFlag = true;
@@ -205,6 +252,9 @@ private:
     }
 
     bool texReleaseFlag{ false };
+    uint32_t reclaimerId_ = 0;
+    std::atomic<uint64_t> texTrimRequest_{ 0 };
+    std::atomic<EGLContext> glContext_{ EGL_NO_CONTEXT };
     std::unordered_map<std::string, RenderGeneralProgram *> shadersMap_;
     std::unordered_map<std::string, RenderMesh *> meshesMap_;
     RenderFifoCache<UINT64, RenderTexturePtr, TextureSizeMeasurer> disuseTexCache_{TEXTURE_CACHE_MAX_CAPACITY};
@@ -418,31 +418,30 @@ void RenderEnvironment::ConvertFromRGBToYUV(RenderTexturePtr input, IEffectForma
 {
     int width = static_cast<int>(input->Width());
     int height = static_cast<int>(input->Height());
-    uint32_t rowStride = (static_cast<uint32_t>(width) + 1) & ~1u; // match FormatHelper::CaculateRowStride
     auto rgbData = std::make_unique<unsigned char[]>(width * height * RGBA_SIZE_PER_PIXEL);
     ReadPixelsFromTex(input, rgbData.get(), width, height, width);
-    auto *srcNV12 = static_cast<unsigned char *>(data);
-    uint8_t *srcNV12UV = srcNV12 + static_cast<uint32_t>(height) * rowStride;
-    for (uint32_t i = 0; i < static_cast<uint32_t>(height); i++) {
-        for (uint32_t j = 0; j < static_cast<uint32_t>(width); j++) {
-            uint32_t yIndex = i * rowStride + j;
-            uint32_t nvIndex =
-                i / UV_PLANE_SIZE * rowStride + j - j % UV_PLANE_SIZE; // 2 mean u/v split factor
-            uint32_t rgbIndex = i * static_cast<uint32_t>(width) * static_cast<uint32_t>(RGBA_SIZE_PER_PIXEL) +
-                j * static_cast<uint32_t>(RGBA_SIZE_PER_PIXEL);
-            uint8_t r = rgbData[rgbIndex];
-            uint8_t g = rgbData[rgbIndex + G_POS];
-            uint8_t b = rgbData[rgbIndex + B_POS];
-            srcNV12[yIndex] = FormatHelper::RGBToY(r, g, b);
-            if (format == IEffectFormat::YUVNV12) {
-                srcNV12UV[nvIndex] = FormatHelper::RGBToU(r, g, b);
-                srcNV12UV[nvIndex + 1] = FormatHelper::RGBToV(r, g, b);
-            } else {
-                srcNV12UV[nvIndex] = FormatHelper::RGBToV(r, g, b);
-                srcNV12UV[nvIndex + 1] = FormatHelper::RGBToU(r, g, b);
-            }
-        }
-    }
+    FormatConverterInfo src = {
+        .bufferInfo = {
+            .width_ = static_cast<uint32_t>(width),
+            .height_ = static_cast<uint32_t>(height),
+            .len_ = FormatHelper::CalculateSize(width, height, IEffectFormat::RGBA8888),
+            .formatType_ = IEffectFormat::RGBA8888,
+            .rowStride_ = FormatHelper::CalculateRowStride(width, IEffectFormat::RGBA8888),
+        },
+        .buffer = rgbData.get(),
+    };
+    FormatConverterInfo dst = {
+        .bufferInfo = {
+            .width_ = static_cast<uint32_t>(width),
+            .height_ = static_cast<uint32_t>(height),
+            .len_ = FormatHelper::CalculateSize(width, height, format),
+            .formatType_ = format,
+            .rowStride_ = FormatHelper::CalculateRowStride(width, format),
+        },
+        .buffer = data,
+    };
+    ErrorCode res = FormatHelper::ConvertFormat(src, dst);
+    CHECK_AND_RETURN_LOG(res == ErrorCode::SUCCESS, "ConvertFromRGBToYUV: convert fail! res=%{public}d", res);
 }
 
 RenderContext *RenderEnvironment::GetContext()
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_PRIORITY_QUEUE_H
+#define IM_RENDER_PRIORITY_QUEUE_H
+
+#include "render_queue_itf.h"
+#include "render_task_itf.h"
+
+#include <chrono>
+#include <iterator>
+#include <list>
+#include <map>
+
+struct RenderPriorityQueueStats {
+    uint64_t droppedCount = 0; // droppable tasks discarded past their deadline
+    uint64_t lateCount = 0; // tasks handed out past their deadline
+};
+
+/**
+ * Render task queue shared by several lanes, e.g. the strands bound to one executor worker. The tasks of a lane are
+ * served in the order they were pushed. Between lanes the first tasks compete by class, interactive frames ahead of
+ * still renders ahead of background work, then by earliest deadline, then by push order. A waiting task is promoted
+ * by one class every AGING_STEP, so a lane gets its turn within about (class + 1) steps even while another lane
+ * streams interactive frames. T is a RenderTaskPtr. Like RenderFifoQueue it is not thread safe, RenderThread guards it.
+ */
+template <typename T> class RenderPriorityQueue : public RenderQueueItf<T> {
+public:
+    static constexpr std::chrono::milliseconds AGING_STEP = std::chrono::milliseconds(100);
+
+    ~RenderPriorityQueue() = default;
+
+    size_t GetSize() override
+    {
+        return m_size;
+    }
+
+    bool Push(const T &data) override
+    {
+        try {
+            m_lanes[data->GetLane()].push_back({ data, m_nextSequence, RenderTaskClock::now() });
+        } catch (std::bad_array_new_length) {
+            return false;
+        }
+        m_nextSequence++;
+        m_size++;
+        return true;
+    }
+
+    bool Pop(T &result) override
+    {
+        RenderTaskClock::time_point now = RenderTaskClock::now();
+        for (auto lane = SelectLane(now); lane != m_lanes.end(); lane = SelectLane(now)) {
+            T task = lane->second.front().task;
+            lane->second.pop_front();
+            if (lane->second.empty()) {
+                m_lanes.erase(lane);
+            }
+            m_size--;
+            if (task->GetDeadline() >= now) {
+                result = task;
+                return true;
+            }
+            if (!task->IsDroppable()) {
+                m_stats.lateCount++;
+                result = task;
+                return true;
+            }
+            m_stats.droppedCount++;
+            task->SetDefaultReturn();
+        }
+        return false; // empty, or every remaining task was stale
+    }
+
+    bool PopWithCallBack(T &result, std::function<void(T &)> &callback) override
+    {
+        if (!Pop(result)) {
+            return false;
+        }
+        callback(result);
+        return true;
+    }
+
+    bool Front(T &result) override
+    {
+        auto lane = SelectLane(RenderTaskClock::now());
+        if (lane == m_lanes.end()) {
+            return false; // empty
+        }
+        result = lane->second.front().task;
+        return true;
+    }
+
+    bool Back(T &result) override
+    {
+        const Entry *last = nullptr;
+        for (auto &lane : m_lanes) {
+            if (last == nullptr || lane.second.back().sequence > last->sequence) {
+                last = &lane.second.back();
+            }
+        }
+        if (last == nullptr) {
+            return false; // empty
+        }
+        result = last->task;
+        return true;
+    }
+
+    void RemoveAll() override
+    {
+        m_lanes.clear();
+        m_size = 0;
+    }
+
+    void Remove(const std::function<bool(T &)> &checkFunc) override
+    {
+        try {
+            for (auto &lane : m_lanes) {
+                lane.second.remove_if([&checkFunc](Entry &entry) { return checkFunc(entry.task); });
+            }
+        } catch (std::bad_function_call) {
+            // keep the size consistent with whatever was removed before the throw.
+        }
+        m_size = 0;
+        for (auto lane = m_lanes.begin(); lane != m_lanes.end();) {
+            m_size += lane->second.size();
+            lane = lane->second.empty() ? m_lanes.erase(lane) : std::next(lane);
+        }
+    }
+
+    RenderPriorityQueueStats GetStats() const
+    {
+        return m_stats;
+    }
+
+private:
+    static constexpr size_t CLASS_NUM = static_cast<size_t>(RenderTaskPriority::BACKGROUND) + 1;
+
+    struct Entry {
+        T task;
+        uint64_t sequence;
+        RenderTaskClock::time_point pushTime;
+    };
+    using LaneMap = std::map<uint64_t, std::list<Entry>>;
+
+    static size_t ClassIndex(const T &data)
+    {
+        size_t index = static_cast<size_t>(data->GetPriority());
+        return index < CLASS_NUM ? index : CLASS_NUM - 1;
+    }
+
+    // the class lowered by the aging steps waited, it goes below INTERACTIVE so that fresh frames can't keep
+    // overtaking a task that waited long enough.
+    static int64_t AgedClass(const Entry &entry, RenderTaskClock::time_point now)
+    {
+        int64_t steps = now > entry.pushTime ? (now - entry.pushTime) / AGING_STEP : 0;
+        return static_cast<int64_t>(ClassIndex(entry.task)) - steps;
+    }
+
+    // the lane whose first task is served next, m_lanes.end() when empty.
+    typename LaneMap::iterator SelectLane(RenderTaskClock::time_point now)
+    {
+        auto selected = m_lanes.end();
+        int64_t selectedClass = 0;
+        for (auto lane = m_lanes.begin(); lane != m_lanes.end(); ++lane) {
+            const Entry &entry = lane->second.front();
+            int64_t agedClass = AgedClass(entry, now);
+            if (selected == m_lanes.end() || IsAhead(entry, agedClass, selected->second.front(), selectedClass)) {
+                selected = lane;
+                selectedClass = agedClass;
+            }
+        }
+        return selected;
+    }
+
+    static bool IsAhead(const Entry &entry, int64_t agedClass, const Entry &other, int64_t otherClass)
+    {
+        if (agedClass != otherClass) {
+            return agedClass < otherClass;
+        }
+        RenderTaskClock::time_point deadline = entry.task->GetDeadline();
+        RenderTaskClock::time_point otherDeadline = other.task->GetDeadline();
+        if (deadline != otherDeadline) {
+            return deadline < otherDeadline;
+        }
+        return entry.sequence < other.sequence;
+    }
+
+    LaneMap m_lanes;
+    size_t m_size = 0;
+    uint64_t m_nextSequence = 0;
+    RenderPriorityQueueStats m_stats;
+};
+#endif // IM_RENDER_PRIORITY_QUEUE_H
\ No newline at end of file
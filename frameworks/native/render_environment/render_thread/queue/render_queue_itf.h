@@ -21,6 +21,9 @@
 template <typename T> class RenderQueueItf {
 public:
     typedef T DataType;
+    // Set to true by queues whose Push, Remove and ReplacePush may run concurrently with a single consumer, so that
+    // RenderThread hands tasks over without its mutex. Queues guarded by RenderThread's mutex keep false.
+    static constexpr bool IS_LOCK_FREE = false;
 
     virtual ~RenderQueueItf() = default;
     virtual size_t GetSize() = 0;
@@ -31,5 +34,12 @@ public:
     virtual bool Back(T &data) = 0;
     virtual void RemoveAll() = 0;
     virtual void Remove(const std::function<bool(T &)> &checkFunc) = 0;
+
+    // Queues data in place of the pending entries checkFunc matches, e.g. an older task with the same tag.
+    virtual bool ReplacePush(const T &data, const std::function<bool(T &)> &checkFunc)
+    {
+        Remove(checkFunc);
+        return Push(data);
+    }
 };
 #endif // IM_RENDER_QUEUE_H
\ No newline at end of file
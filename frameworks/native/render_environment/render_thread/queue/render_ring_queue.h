@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_RING_QUEUE_H
+#define IM_RENDER_RING_QUEUE_H
+
+#include "render_queue_itf.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+/**
+ * Bounded multi-producer single-consumer ring. Push claims a cell with a compare-and-swap on the tail and publishes it
+ * through the per cell sequence, Pop, PopWithCallBack, Front and RemoveAll belong to the single consumer. Nothing is
+ * allocated after construction. Remove and ReplacePush may run on producers: they lock a pending cell for the
+ * moment they inspect it and cancel it in place, the consumer skips cancelled cells, so no entry is ever moved.
+ * GetSize counts the pending entries only, a cancelled cell keeps its slot until the consumer passes it.
+ * CAPACITY is a power of two and must not be smaller than the queue size a RenderThread is created with.
+ */
+template <typename T, size_t CAPACITY = 64> class RenderRingQueue : public RenderQueueItf<T> {
+public:
+    static_assert(CAPACITY >= 2 && (CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY should be a power of two");
+    static constexpr bool IS_LOCK_FREE = true;
+
+    RenderRingQueue()
+    {
+        for (size_t idx = 0; idx < CAPACITY; idx++) {
+            m_cells[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+    }
+
+    ~RenderRingQueue() = default;
+
+    size_t GetSize() override
+    {
+        size_t cancelled = m_cancelled.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t used = tail > head ? tail - head : 0;
+        return used > cancelled ? used - cancelled : 0;
+    }
+
+    bool Push(const T &data) override
+    {
+        size_t pos = m_tail.load(std::memory_order_relaxed);
+        Cell *cell = nullptr;
+        while (true) {
+            cell = &m_cells[pos & MASK];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (sequence < pos) {
+                return false; // full
+            } else {
+                pos = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = data;
+        cell->state.store(PENDING, std::memory_order_relaxed);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Pop(T &result) override
+    {
+        while (true) {
+            size_t pos = m_head.load(std::memory_order_relaxed);
+            Cell &cell = m_cells[pos & MASK];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                return false; // empty
+            }
+            bool isPending = Acquire(cell, TAKEN);
+            if (isPending) {
+                result = std::move(cell.data);
+            } else {
+                m_cancelled.fetch_sub(1, std::memory_order_release); // before the head moves, size may not dip
+            }
+            cell.data = T();
+            cell.state.store(FREE, std::memory_order_relaxed);
+            cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+            m_head.store(pos + 1, std::memory_order_release);
+            if (isPending) {
+                return true;
+            }
+        }
+    }
+
+    bool PopWithCallBack(T &result, std::function<void(T &)> &callback) override
+    {
+        if (!Pop(result)) {
+            return false;
+        }
+        callback(result);
+        return true;
+    }
+
+    bool Front(T &result) override
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        for (size_t pos = head; pos < tail; pos++) {
+            if (Peek(pos, result)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool Back(T &result) override
+    {
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        for (size_t pos = tail; pos > head; pos--) {
+            if (Peek(pos - 1, result)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void RemoveAll() override
+    {
+        T data;
+        while (Pop(data)) {
+            data = T();
+        }
+    }
+
+    void Remove(const std::function<bool(T &)> &checkFunc) override
+    {
+        ForEachPending([this, &checkFunc](Cell &cell) {
+            if (checkFunc(cell.data)) {
+                Cancel(cell);
+            } else {
+                cell.state.store(PENDING, std::memory_order_release);
+            }
+        });
+    }
+
+    bool ReplacePush(const T &data, const std::function<bool(T &)> &checkFunc) override
+    {
+        // the first match takes the new data and keeps its place in the queue, later matches are cancelled.
+        bool isReplaced = false;
+        ForEachPending([this, &data, &checkFunc, &isReplaced](Cell &cell) {
+            if (!checkFunc(cell.data)) {
+                cell.state.store(PENDING, std::memory_order_release);
+            } else if (!isReplaced) {
+                cell.data = data;
+                isReplaced = true;
+                cell.state.store(PENDING, std::memory_order_release);
+            } else {
+                Cancel(cell);
+            }
+        });
+        return isReplaced || Push(data);
+    }
+
+private:
+    static constexpr size_t MASK = CAPACITY - 1;
+    static constexpr uint32_t FREE = 0;
+    static constexpr uint32_t PENDING = 1;
+    static constexpr uint32_t INSPECTING = 2; // locked by Remove, ReplacePush or a peek for a few instructions
+    static constexpr uint32_t TAKEN = 3;
+    static constexpr uint32_t CANCELLED = 4;
+
+    struct alignas(64) Cell { // 64: a cache line per cell, producers and the consumer do not share lines
+        std::atomic<size_t> sequence { 0 };
+        std::atomic<uint32_t> state { FREE };
+        T data {};
+    };
+
+    // Moves a published cell from pending to newState, returns false when it has been cancelled.
+    static bool Acquire(Cell &cell, uint32_t newState)
+    {
+        while (true) {
+            uint32_t expected = PENDING;
+            if (cell.state.compare_exchange_weak(expected, newState, std::memory_order_acquire)) {
+                return true;
+            }
+            if (expected == CANCELLED) {
+                return false;
+            }
+            std::this_thread::yield(); // inspected by another thread right now
+        }
+    }
+
+    // Cancels a cell locked by ForEachPending. It is counted first, so the consumer never skips an uncounted cell.
+    void Cancel(Cell &cell)
+    {
+        m_cancelled.fetch_add(1, std::memory_order_acq_rel);
+        cell.state.store(CANCELLED, std::memory_order_release);
+    }
+
+    // Runs func on every pending cell between head and tail with the cell locked, func unlocks it.
+    template <typename FUNC> void ForEachPending(FUNC func)
+    {
+        size_t head = m_head.load(std::memory_order_acquire);
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        for (size_t pos = head; pos < tail; pos++) {
+            Cell &cell = m_cells[pos & MASK];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                continue; // not published yet, or already consumed
+            }
+            uint32_t expected = PENDING;
+            if (!cell.state.compare_exchange_strong(expected, INSPECTING, std::memory_order_acquire)) {
+                continue;
+            }
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+                cell.state.store(PENDING, std::memory_order_release); // recycled for a later entry meanwhile
+                continue;
+            }
+            func(cell);
+        }
+    }
+
+    bool Peek(size_t pos, T &result)
+    {
+        bool isFound = false;
+        Cell &cell = m_cells[pos & MASK];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return false;
+        }
+        uint32_t expected = PENDING;
+        if (cell.state.compare_exchange_strong(expected, INSPECTING, std::memory_order_acquire)) {
+            if (cell.sequence.load(std::memory_order_acquire) == pos + 1) {
+                result = cell.data;
+                isFound = true;
+            }
+            cell.state.store(PENDING, std::memory_order_release);
+        }
+        return isFound;
+    }
+
+    alignas(64) std::atomic<size_t> m_tail { 0 }; // 64: producers and the consumer touch separate lines
+    alignas(64) std::atomic<size_t> m_head { 0 };
+    std::atomic<size_t> m_cancelled { 0 }; // cancelled cells between head and tail
+    Cell m_cells[CAPACITY];
+};
+#endif // IM_RENDER_RING_QUEUE_H
\ No newline at end of file
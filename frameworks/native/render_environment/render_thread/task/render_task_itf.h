@@ -16,9 +16,19 @@
 #ifndef IM_RENDER_TASK_ITF_H
 #define IM_RENDER_TASK_ITF_H
 
+#include <chrono>
 #include <memory>
 #include <future>
 
+// Scheduling class of a render task, a lower value is served first by RenderPriorityQueue between lanes.
+enum class RenderTaskPriority : uint32_t {
+    INTERACTIVE = 0, // preview and surface frames
+    STILL, // still image render and save
+    BACKGROUND,
+};
+
+using RenderTaskClock = std::chrono::steady_clock;
+
 template <typename RETURNTYPE, typename... ARGSTYPE> class RenderTaskItf {
 public:
     typedef RETURNTYPE ReturnType;
@@ -63,6 +73,46 @@ public:
         return m_sequenceId;
     }
     
+    // Tasks of one lane, e.g. one render strand, keep their push order in RenderPriorityQueue, their priority only
+    // counts against the tasks of other lanes.
+    void SetLane(uint64_t lane)
+    {
+        m_lane = lane;
+    }
+
+    uint64_t GetLane()
+    {
+        return m_lane;
+    }
+
+    void SetPriority(RenderTaskPriority priority)
+    {
+        m_priority = priority;
+    }
+
+    RenderTaskPriority GetPriority()
+    {
+        return m_priority;
+    }
+
+    // A droppable task still waiting past its deadline is discarded instead of run, its waiters get the default
+    // return. Other tasks only use the deadline to order their class.
+    void SetDeadline(RenderTaskClock::time_point deadline, bool isDroppable = false)
+    {
+        m_deadline = deadline;
+        m_isDroppable = isDroppable;
+    }
+
+    RenderTaskClock::time_point GetDeadline()
+    {
+        return m_deadline;
+    }
+
+    bool IsDroppable()
+    {
+        return m_isDroppable;
+    }
+
     virtual void Wait() = 0;
 
     virtual RETURNTYPE GetReturn() = 0;
@@ -75,6 +125,10 @@ protected:
     uint64_t m_id;
     uint64_t m_tag;
     uint64_t m_sequenceId;
+    uint64_t m_lane = 0;
+    RenderTaskPriority m_priority = RenderTaskPriority::STILL;
+    RenderTaskClock::time_point m_deadline = RenderTaskClock::time_point::max();
+    bool m_isDroppable = false;
 };
 
 template <typename RETURNTYPE, typename... ARGSTYPE>
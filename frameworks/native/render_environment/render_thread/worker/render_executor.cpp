@@ -0,0 +1,217 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render_executor.h"
+
+#include <algorithm>
+
+#include "effect_log.h"
+
+namespace {
+constexpr size_t DEDICATED_QUEUE_SIZE = 8;
+constexpr size_t SHARED_QUEUE_SIZE = 64; // a shared worker queues the tasks of all the strands bound to it
+constexpr uint32_t MAX_WORKER_COUNT = 16;
+constexpr uint32_t STRAND_TAG_SHIFT = 32;
+constexpr uint64_t TASK_TAG_MASK = (1ULL << STRAND_TAG_SHIFT) - 1;
+
+thread_local uint64_t g_runningStrand = 0;
+} // namespace
+
+// Runs a task of the strand on its worker, switching the worker over to the strand first.
+class RenderStrand::StrandTask : public RenderTaskItf<void> {
+public:
+    StrandTask(const std::shared_ptr<StrandState> &state, RenderExecutorWorker *worker, bool isShared,
+        const RenderCommonTaskPtr &task) : m_state(state), m_worker(worker), m_isShared(isShared), m_task(task)
+    {
+        SetTag((state->id << STRAND_TAG_SHIFT) | (task->GetTag() & TASK_TAG_MASK));
+        SetId(task->GetId());
+        SetSequenceId(task->GetSequenceId());
+        SetLane(state->id);
+        SetPriority(task->GetPriority());
+        SetDeadline(task->GetDeadline(), task->IsDroppable());
+    }
+    ~StrandTask() override = default;
+
+    void Run() override
+    {
+        if (m_isShared && m_worker->m_activeStrand != m_state->id) {
+            m_worker->m_activeStrand = m_state->id;
+            if (m_state->enterFunc) {
+                m_state->enterFunc();
+            }
+        }
+        uint64_t outerStrand = g_runningStrand;
+        g_runningStrand = m_state->id;
+        m_task->Run();
+        g_runningStrand = outerStrand;
+    }
+
+    void Wait() override
+    {
+        m_task->Wait();
+    }
+
+    void GetReturn() override
+    {
+        m_task->GetReturn();
+    }
+
+    std::shared_future<void> GetFuture() override
+    {
+        return m_task->GetFuture();
+    }
+
+    void SetDefaultReturn() override
+    {
+        m_task->SetDefaultReturn();
+    }
+
+private:
+    std::shared_ptr<StrandState> m_state;
+    RenderExecutorWorker *m_worker = nullptr;
+    bool m_isShared = false;
+    RenderCommonTaskPtr m_task;
+};
+
+RenderExecutorWorker::RenderExecutorWorker(size_t queueSize, std::function<void()> idleTask)
+    : m_thread(queueSize, idleTask)
+{
+}
+
+RenderStrand::RenderStrand(uint64_t id, std::shared_ptr<RenderExecutorWorker> worker, bool isShared,
+    std::function<void()> enterFunc) : m_worker(std::move(worker)), m_isShared(isShared)
+{
+    m_state = std::make_shared<StrandState>();
+    m_state->id = id;
+    m_state->enterFunc = std::move(enterFunc);
+    m_worker->m_strandCount++;
+}
+
+RenderStrand::~RenderStrand()
+{
+    if (m_isShared) {
+        ClearTask();
+    }
+    m_worker->m_strandCount--;
+}
+
+void RenderStrand::AddTask(const RenderCommonTaskPtr &task, bool overwrite)
+{
+    m_worker->m_thread.AddTask(std::make_shared<StrandTask>(m_state, m_worker.get(), m_isShared, task), overwrite);
+}
+
+void RenderStrand::ClearTask()
+{
+    m_worker->m_thread.ClearTask([this](RenderCommonTaskPtr &task) { return IsOwnTask(task); });
+}
+
+void RenderStrand::WaitTaskFinished()
+{
+    if (IsRunningTask()) {
+        return; // the other tasks of the strand cannot run before the calling task returns.
+    }
+    if (!m_isShared) {
+        m_worker->m_thread.WaitTaskFinished();
+        return;
+    }
+
+    // the worker also runs the tasks of other strands, only wait for the ones queued ahead of a barrier. The strand
+    // is a lane of the worker queue, so the barrier runs after every task of the strand added before it.
+    auto barrier = std::make_shared<RenderTask<>>([]() {});
+    AddTask(barrier);
+    barrier->Wait();
+}
+
+bool RenderStrand::IsShared() const
+{
+    return m_isShared;
+}
+
+bool RenderStrand::IsRunningTask() const
+{
+    return g_runningStrand == m_state->id;
+}
+
+bool RenderStrand::IsOwnTask(const RenderCommonTaskPtr &task) const
+{
+    return (GetTag(task) >> STRAND_TAG_SHIFT) == m_state->id;
+}
+
+RenderExecutor &RenderExecutor::Instance()
+{
+    // Never destroyed: strands may be released from static destructors of other modules.
+    static RenderExecutor *instance = new RenderExecutor();
+    return *instance;
+}
+
+void RenderExecutor::SetWorkerCount(uint32_t workerCount)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_workerCount = std::min(workerCount, MAX_WORKER_COUNT);
+    if (m_workers.size() > m_workerCount) {
+        // the dropped workers stop once the last strand bound to them is released.
+        m_workers.resize(m_workerCount);
+    }
+    EFFECT_LOGI("RenderExecutor::SetWorkerCount workerCount=%{public}u", m_workerCount);
+}
+
+uint32_t RenderExecutor::GetWorkerCount()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_workerCount;
+}
+
+std::shared_ptr<RenderStrand> RenderExecutor::CreateStrand(std::function<void()> enterFunc)
+{
+    uint64_t id = m_nextStrandId.fetch_add(1);
+    {
+        // the strand is bound under the lock so that concurrent creations see each other in the strand counts.
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::shared_ptr<RenderExecutorWorker> worker = AcquireSharedWorkerLocked();
+        if (worker != nullptr) {
+            return std::make_shared<RenderStrand>(id, worker, true, std::move(enterFunc));
+        }
+    }
+
+    auto worker = std::make_shared<RenderExecutorWorker>(DEDICATED_QUEUE_SIZE, []() {
+        EFFECT_LOGD("ImageEffect has no render work to do!");
+    });
+    worker->m_thread.Start();
+    return std::make_shared<RenderStrand>(id, worker, false, std::move(enterFunc));
+}
+
+std::shared_ptr<RenderExecutorWorker> RenderExecutor::AcquireSharedWorkerLocked()
+{
+    if (m_workerCount == 0) {
+        return nullptr;
+    }
+
+    auto leastLoaded = std::min_element(m_workers.begin(), m_workers.end(),
+        [](const std::shared_ptr<RenderExecutorWorker> &a, const std::shared_ptr<RenderExecutorWorker> &b) {
+            return a->m_strandCount.load() < b->m_strandCount.load();
+        });
+    if (leastLoaded != m_workers.end() && ((*leastLoaded)->m_strandCount.load() == 0 ||
+        m_workers.size() >= m_workerCount)) {
+        return *leastLoaded;
+    }
+
+    auto worker = std::make_shared<RenderExecutorWorker>(SHARED_QUEUE_SIZE, []() {
+        EFFECT_LOGD("RenderExecutor worker has no render work to do!");
+    });
+    worker->m_thread.Start();
+    m_workers.emplace_back(worker);
+    EFFECT_LOGI("RenderExecutor::AcquireSharedWorkerLocked start worker %{public}zu", m_workers.size());
+    return worker;
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IM_RENDER_EXECUTOR_H
+#define IM_RENDER_EXECUTOR_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "image_effect_marco_define.h"
+#include "render_priority_queue.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+// A thread of the executor together with the strands bound to it.
+struct RenderExecutorWorker {
+    RenderExecutorWorker(size_t queueSize, std::function<void()> idleTask);
+
+    RenderThread<RenderPriorityQueue<RenderCommonTaskPtr>> m_thread;
+    uint64_t m_activeStrand = 0; // strand whose task ran last, only touched on the worker thread
+    std::atomic<uint32_t> m_strandCount = 0;
+};
+
+/**
+ * Ordered lane of render tasks owned by one ImageEffect. The tasks of a strand run one at a time on the worker the
+ * strand is bound to, in the order they were added. Strands sharing a worker take turns by the priority class and
+ * deadline of their next task, with aging so that no strand starves, see RenderPriorityQueue. They interleave
+ * between tasks and the enter function runs whenever the worker switches strands, e.g. to make the strand's EGL
+ * context current again. Task tags are scoped to the strand, so overwriting and clearing never touch the tasks of
+ * another strand.
+ */
+class RenderStrand {
+public:
+    RenderStrand(uint64_t id, std::shared_ptr<RenderExecutorWorker> worker, bool isShared,
+        std::function<void()> enterFunc);
+    ~RenderStrand();
+    RenderStrand(const RenderStrand &) = delete;
+    RenderStrand &operator = (const RenderStrand &) = delete;
+
+    IMAGE_EFFECT_EXPORT void AddTask(const RenderCommonTaskPtr &task, bool overwrite = false);
+
+    // Drops the pending tasks of this strand, their waiters are released with the default return.
+    IMAGE_EFFECT_EXPORT void ClearTask();
+
+    // Blocks until every task added to this strand before the call has run.
+    IMAGE_EFFECT_EXPORT void WaitTaskFinished();
+
+    IMAGE_EFFECT_EXPORT bool IsShared() const;
+
+    // Whether the calling thread is running a task of this strand, waiting on the strand from there would deadlock.
+    IMAGE_EFFECT_EXPORT bool IsRunningTask() const;
+
+private:
+    class StrandTask;
+    struct StrandState {
+        uint64_t id = 0;
+        std::function<void()> enterFunc;
+    };
+
+    bool IsOwnTask(const RenderCommonTaskPtr &task) const;
+
+    std::shared_ptr<StrandState> m_state;
+    std::shared_ptr<RenderExecutorWorker> m_worker;
+    bool m_isShared = false;
+};
+
+/**
+ * Process wide executor the ImageEffect instances take their render strand from. With a worker count of 0, the
+ * default, every strand gets a dedicated thread like before, so the thread and EGL context count per ImageEffect is
+ * unchanged unless the process opts in. Otherwise strands are spread over at most that many shared worker threads,
+ * which bounds the thread count of processes holding many ImageEffect instances. Sharing is opt in because a task
+ * that waits on another strand bound to its own worker, e.g. a synchronous render of one ImageEffect from the
+ * render callback of another, never returns.
+ */
+class RenderExecutor {
+public:
+    IMAGE_EFFECT_EXPORT static RenderExecutor &Instance();
+
+    // Takes effect for the strands created afterwards, existing strands stay on the worker they are bound to.
+    IMAGE_EFFECT_EXPORT void SetWorkerCount(uint32_t workerCount);
+
+    IMAGE_EFFECT_EXPORT uint32_t GetWorkerCount();
+
+    IMAGE_EFFECT_EXPORT std::shared_ptr<RenderStrand> CreateStrand(std::function<void()> enterFunc = nullptr);
+
+private:
+    RenderExecutor() = default;
+    ~RenderExecutor() = default;
+    RenderExecutor(const RenderExecutor &) = delete;
+    RenderExecutor &operator = (const RenderExecutor &) = delete;
+
+    // least loaded shared worker, a new one while below the worker count, nullptr when sharing is off.
+    std::shared_ptr<RenderExecutorWorker> AcquireSharedWorkerLocked();
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<RenderExecutorWorker>> m_workers;
+    uint32_t m_workerCount = 0;
+    std::atomic<uint64_t> m_nextStrandId = 1;
+};
+#endif // IM_RENDER_EXECUTOR_H
\ No newline at end of file
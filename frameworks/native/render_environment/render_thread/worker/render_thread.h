@@ -16,6 +16,7 @@
 #ifndef IM_RENDER_THREAD_H
 #define IM_RENDER_THREAD_H
 
+#include <atomic>
 #include <thread>
 #include <type_traits>
 #include <shared_mutex>
@@ -27,6 +28,7 @@
 
 #define TIME_FOR_STOP 1000
 constexpr const static int TIME_FOR_WAITING_TASK = 2500;
+constexpr const static int SPIN_FOR_WAITING_TASK = 64; // yields before a lock free consumer parks on cvEmpty
 
 template <typename QUEUE = RenderFifoQueue<RenderTaskPtr<void>>>
 class RenderThread : public RenderWorkerItf<typename QUEUE::DataType> {
@@ -38,11 +40,16 @@ public:
     explicit RenderThread(
         size_t, std::function<void()> idleTask = []() {});
     virtual ~RenderThread();
+    // Blocks while qSize tasks are pending, except on the worker thread itself, which cannot wait for its own queue.
+    // A fixed size queue that is out of cells fails the worker's task with its default return.
     virtual void AddTask(const LocalTaskType &, bool overwrite = false) override;
     virtual void ClearTask() override;
+    // Drops the pending tasks checkFunc matches, e.g. those of one strand on a shared worker.
+    void ClearTask(const std::function<bool(LocalTaskType &)> &checkFunc);
     virtual void Start() override;
     virtual void Stop() override;
     void WaitTaskFinished();
+    bool IsWorkerThread() const;
 
 protected:
     virtual void Run() override;
@@ -62,6 +69,19 @@ protected:
 
 private:
     void InternalWait();
+
+    // With a lock free queue producers and the consumer only touch cvMutex to park, and wake the other side only
+    // when it has parked, see the waiter counters.
+    void AddTaskLockFree(const LocalTaskType &task, bool overwrite);
+    void RunLockFree();
+    bool WaitTaskLockFree();
+    void RequestDrain();
+    void NotifyIfWaiting(std::atomic<uint32_t> &waiters, std::condition_variable &cv);
+
+    std::atomic<uint32_t> m_emptyWaiters{ 0 };
+    std::atomic<uint32_t> m_fullWaiters{ 0 };
+    std::atomic<bool> m_isDrainRequested{ false }; // cancelled cells hold slots until the consumer passes them
+    std::atomic<std::thread::id> m_workerId;
 };
 
 template <typename QUEUE>
@@ -81,14 +101,23 @@ template <typename QUEUE> RenderThread<QUEUE>::~RenderThread()
 
 template <typename QUEUE> void RenderThread<QUEUE>::AddTask(const LocalTaskType &task, bool overwrite)
 {
+    if constexpr (QUEUE::IS_LOCK_FREE) {
+        AddTaskLockFree(task, overwrite);
+        return;
+    }
+    bool isWorker = IsWorkerThread();
     std::shared_lock<std::shared_mutex> lock(taskMutex_);
     std::unique_lock<std::mutex> lk(cvMutex);
-    cvFull.wait(lk, [this]() { return (m_localMsgQueue->GetSize() < this->qSize) || (!m_isWorking); });
+    cvFull.wait(lk, [this, isWorker]() {
+        return isWorker || (m_localMsgQueue->GetSize() < this->qSize) || (!m_isWorking);
+    });
     if (m_isWorking) {
         if (overwrite) {
-            m_localMsgQueue->Remove([&task](LocalTaskType &localTask) { return GetTag(task) == GetTag(localTask); });
+            m_localMsgQueue->ReplacePush(task,
+                [&task](LocalTaskType &localTask) { return GetTag(task) == GetTag(localTask); });
+        } else {
+            m_localMsgQueue->Push(task);
         }
-        m_localMsgQueue->Push(task);
         lk.unlock();
         cvEmpty.notify_one();
     }
@@ -96,6 +125,10 @@ template <typename QUEUE> void RenderThread<QUEUE>::AddTask(const LocalTaskType
 
 template <typename QUEUE> void RenderThread<QUEUE>::ClearTask()
 {
+    if constexpr (QUEUE::IS_LOCK_FREE) {
+        ClearTask([](LocalTaskType &) { return true; }); // Pop belongs to the consumer
+        return;
+    }
     std::unique_lock<std::mutex> lk(cvMutex);
     while (m_localMsgQueue->GetSize() > 0) {
         LocalTaskType task;
@@ -107,11 +140,30 @@ template <typename QUEUE> void RenderThread<QUEUE>::ClearTask()
     lk.unlock();
 }
 
+template <typename QUEUE>
+void RenderThread<QUEUE>::ClearTask(const std::function<bool(LocalTaskType &)> &checkFunc)
+{
+    std::unique_lock<std::mutex> lk(cvMutex);
+    m_localMsgQueue->Remove([&checkFunc](LocalTaskType &task) {
+        if (!checkFunc(task)) {
+            return false;
+        }
+        task->SetDefaultReturn();
+        return true;
+    });
+    lk.unlock();
+    cvFull.notify_all();
+    if constexpr (QUEUE::IS_LOCK_FREE) {
+        RequestDrain();
+    }
+}
+
 template <typename QUEUE> void RenderThread<QUEUE>::Start()
 {
     if (m_isStopped) {
         m_isWorking = true;
         t = new std::thread([this]() {
+            this->m_workerId = std::this_thread::get_id();
             this->m_isStopped = false;
             this->Run();
             this->m_isStopped = true;
@@ -135,6 +187,10 @@ template <typename QUEUE> void RenderThread<QUEUE>::Stop()
 
 template <typename QUEUE> void RenderThread<QUEUE>::Run()
 {
+    if constexpr (QUEUE::IS_LOCK_FREE) {
+        RunLockFree();
+        return;
+    }
     while (m_isWorking) {
         std::unique_lock<std::mutex> lk(cvMutex);
         bool cvRet = cvEmpty.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
@@ -166,19 +222,124 @@ void RenderThread<QUEUE>::WaitTaskFinished()
     }
 };
 
+template <typename QUEUE>
+bool RenderThread<QUEUE>::IsWorkerThread() const
+{
+    return m_workerId.load() == std::this_thread::get_id();
+}
+
 template <typename QUEUE>
 void RenderThread<QUEUE>::InternalWait()
 {
     {
+        m_fullWaiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
         std::unique_lock<std::mutex> lk(cvMutex);
         cvFull.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK),
             [this]() {
                 return (m_localMsgQueue->GetSize() == 0);
             });
+        m_fullWaiters.fetch_sub(1);
     }
 
     {
         std::unique_lock<std::shared_mutex> lock(taskMutex_);
     }
 };
+
+template <typename QUEUE>
+void RenderThread<QUEUE>::AddTaskLockFree(const LocalTaskType &task, bool overwrite)
+{
+    bool isWorker = IsWorkerThread();
+    std::shared_lock<std::shared_mutex> lock(taskMutex_);
+    while (m_isWorking) {
+        if (isWorker || m_localMsgQueue->GetSize() < this->qSize) {
+            bool isPushed = overwrite ? m_localMsgQueue->ReplacePush(task,
+                [&task](LocalTaskType &localTask) { return GetTag(task) == GetTag(localTask); }) :
+                m_localMsgQueue->Push(task);
+            if (isPushed) {
+                NotifyIfWaiting(m_emptyWaiters, cvEmpty);
+                return;
+            }
+            if (isWorker) {
+                // out of cells and nobody else pops, fail the task instead of running queued ones re-entrantly.
+                task->SetDefaultReturn();
+                return;
+            }
+            // below qSize but out of cells: cancelled cells still hold them, let the consumer pass them.
+            RequestDrain();
+            std::this_thread::yield();
+            continue;
+        }
+        m_fullWaiters.fetch_add(1);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lk(cvMutex);
+            cvFull.wait(lk, [this]() { return (m_localMsgQueue->GetSize() < this->qSize) || (!m_isWorking); });
+        }
+        m_fullWaiters.fetch_sub(1);
+    }
+}
+
+template <typename QUEUE> void RenderThread<QUEUE>::RunLockFree()
+{
+    while (m_isWorking) {
+        {
+            std::shared_lock<std::shared_mutex> lock(taskMutex_);
+            m_isDrainRequested.store(false);
+            LocalTaskType task;
+            bool ret = m_localMsgQueue->Pop(task);
+            NotifyIfWaiting(m_fullWaiters, cvFull);
+            if (ret) {
+                task->Run();
+                continue;
+            }
+        }
+        if (!WaitTaskLockFree()) {
+            idleTask();
+        }
+    }
+}
+
+template <typename QUEUE> bool RenderThread<QUEUE>::WaitTaskLockFree()
+{
+    auto isReady = [this]() {
+        return (m_localMsgQueue->GetSize() > 0) || m_isDrainRequested.load() || (!m_isWorking);
+    };
+    for (int spin = 0; spin < SPIN_FOR_WAITING_TASK; spin++) {
+        if (isReady()) {
+            return true;
+        }
+        std::this_thread::yield();
+    }
+    m_emptyWaiters.fetch_add(1);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    bool cvRet = false;
+    {
+        std::unique_lock<std::mutex> lk(cvMutex);
+        cvRet = cvEmpty.wait_for(lk, std::chrono::milliseconds(TIME_FOR_WAITING_TASK), isReady);
+    }
+    m_emptyWaiters.fetch_sub(1);
+    return cvRet;
+}
+
+template <typename QUEUE> void RenderThread<QUEUE>::RequestDrain()
+{
+    m_isDrainRequested.store(true);
+    NotifyIfWaiting(m_emptyWaiters, cvEmpty);
+}
+
+template <typename QUEUE>
+void RenderThread<QUEUE>::NotifyIfWaiting(std::atomic<uint32_t> &waiters, std::condition_variable &cv)
+{
+    // pairs with the fence a waiter issues after counting itself: either it sees the queue change or we see it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiters.load() == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lk(cvMutex); // a waiter between its check and its sleep holds cvMutex
+    }
+    cv.notify_all();
+}
 #endif // IM_RENDER_THREAD_H
\ No newline at end of file
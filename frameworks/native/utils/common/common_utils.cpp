@@ -1038,7 +1038,12 @@ ErrorCode CommonUtils::ModifyPixelMapProperty(PixelMap *pixelMap, const std::sha
     EFFECT_LOGD("ModifyPixelMapProperty: allocatorType=%{public}d, bufferType=%{public}d", allocatorType, bufferType);
     std::shared_ptr<Memory> allocMemory = memoryManager->GetAllocMemoryByAddr(buffer->buffer_);
     std::shared_ptr<MemoryData> memoryData;
-    if (allocMemory != nullptr && allocMemory->memoryData_->memoryInfo.bufferType == bufferType) {
+    // pixel maps derive the row stride from the width and free heap buffers with free(), a padded or mapped memory
+    // has to be copied into a packed malloc one.
+    if (allocMemory != nullptr && allocMemory->memoryData_->memoryInfo.bufferType == bufferType &&
+        !allocMemory->memoryData_->memoryInfo.isMapped &&
+        (bufferType == BufferType::DMA_BUFFER || allocMemory->memoryData_->memoryInfo.bufferInfo.rowStride_ ==
+        FormatHelper::CalculateRowStride(buffer->bufferInfo_->width_, buffer->bufferInfo_->formatType_))) {
         EFFECT_LOGD("ModifyPixelMapProperty reuse allocated memory.");
         allocMemory->memoryData_->memoryInfo.isAutoRelease = false;
         memoryData = allocMemory->memoryData_;
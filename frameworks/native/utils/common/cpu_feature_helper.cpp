@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_feature_helper.h"
+
+#include <array>
+#include <fstream>
+#include <string>
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+SimdLevel DetectSimdLevel()
+{
+#if defined(__aarch64__)
+    // Advanced SIMD is mandatory on aarch64.
+    return SimdLevel::NEON;
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SimdLevel::SSE4;
+    }
+    return SimdLevel::SCALAR;
+#else
+    return SimdLevel::SCALAR;
+#endif
+}
+
+constexpr uint32_t MAX_CACHE_LEVEL = 3;
+constexpr uint32_t MAX_CACHE_INDEX = 8;
+constexpr uint32_t KILO = 1024;
+constexpr std::array<uint32_t, MAX_CACHE_LEVEL + 1> DEFAULT_CACHE_SIZES = {
+    0, 64 * KILO, 512 * KILO, 2 * KILO * KILO,
+};
+const std::string CPU_CACHE_PATH = "/sys/devices/system/cpu/cpu0/cache/index";
+
+bool ReadCacheAttr(uint32_t index, const std::string &attr, std::string &value)
+{
+    std::ifstream file(CPU_CACHE_PATH + std::to_string(index) + "/" + attr);
+    return file.is_open() && static_cast<bool>(file >> value);
+}
+
+// Sysfs reports sizes like "512K" or "8M".
+uint32_t ParseCacheSize(const std::string &value)
+{
+    size_t pos = 0;
+    uint32_t size = 0;
+    while (pos < value.size() && value[pos] >= '0' && value[pos] <= '9') {
+        size = size * 10 + static_cast<uint32_t>(value[pos] - '0'); // 10: decimal
+        pos++;
+    }
+    if (pos < value.size() && (value[pos] == 'K' || value[pos] == 'k')) {
+        size *= KILO;
+    } else if (pos < value.size() && (value[pos] == 'M' || value[pos] == 'm')) {
+        size *= KILO * KILO;
+    }
+    return size;
+}
+
+std::array<uint32_t, MAX_CACHE_LEVEL + 1> DetectCacheSizes()
+{
+    std::array<uint32_t, MAX_CACHE_LEVEL + 1> sizes = {};
+    for (uint32_t index = 0; index < MAX_CACHE_INDEX; index++) {
+        std::string level;
+        std::string type;
+        std::string size;
+        if (!ReadCacheAttr(index, "level", level) || !ReadCacheAttr(index, "type", type) ||
+            !ReadCacheAttr(index, "size", size)) {
+            continue;
+        }
+        uint32_t levelValue = ParseCacheSize(level);
+        if (levelValue == 0 || levelValue > MAX_CACHE_LEVEL || type == "Instruction") {
+            continue;
+        }
+        sizes[levelValue] = ParseCacheSize(size);
+    }
+    return sizes;
+}
+
+const std::array<uint32_t, MAX_CACHE_LEVEL + 1> &GetCacheSizes()
+{
+    static const std::array<uint32_t, MAX_CACHE_LEVEL + 1> sizes = DetectCacheSizes();
+    return sizes;
+}
+} // namespace
+
+SimdLevel CpuFeatureHelper::GetSimdLevel()
+{
+    static const SimdLevel level = DetectSimdLevel();
+    return level;
+}
+
+bool CpuFeatureHelper::IsSupported(SimdLevel level)
+{
+    SimdLevel best = GetSimdLevel();
+    switch (level) {
+        case SimdLevel::SCALAR:
+            return true;
+        case SimdLevel::SSE4:
+            return best == SimdLevel::SSE4 || best == SimdLevel::AVX2;
+        case SimdLevel::AVX2:
+            return best == SimdLevel::AVX2;
+        case SimdLevel::NEON:
+            return best == SimdLevel::NEON;
+        default:
+            return false;
+    }
+}
+
+const char *CpuFeatureHelper::GetSimdLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SimdLevel::SSE4:
+            return "SSE4";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::NEON:
+            return "NEON";
+        default:
+            return "SCALAR";
+    }
+}
+
+uint32_t CpuFeatureHelper::GetCacheSize(uint32_t level)
+{
+    if (level == 0 || level > MAX_CACHE_LEVEL) {
+        return 0;
+    }
+    uint32_t size = GetCacheSizes()[level];
+    return size != 0 ? size : DEFAULT_CACHE_SIZES[level];
+}
+
+uint32_t CpuFeatureHelper::GetLastLevelCacheSize()
+{
+    const std::array<uint32_t, MAX_CACHE_LEVEL + 1> &sizes = GetCacheSizes();
+    for (uint32_t level = MAX_CACHE_LEVEL; level > 0; level--) {
+        if (sizes[level] != 0) {
+            return sizes[level];
+        }
+    }
+    return DEFAULT_CACHE_SIZES[MAX_CACHE_LEVEL];
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
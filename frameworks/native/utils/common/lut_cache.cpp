@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lut_cache.h"
+
+#include <cmath>
+
+#include "effect_log.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr float ESP = 1e-5;
+constexpr uint32_t SCALE_FACTOR = 100;
+constexpr double PI = 3.14159265;
+constexpr uint32_t ALGORITHM_PARAMTER_FACTOR = 2;
+constexpr uint32_t MIN_BIT_DEPTH = 8;
+constexpr uint32_t MAX_BIT_DEPTH = 16;
+constexpr uint32_t KEY_TYPE_SHIFT = 48;
+constexpr uint32_t KEY_BIT_DEPTH_SHIFT = 32;
+
+inline float Clip(float a, float aMin, float aMax)
+{
+    return a > aMax ? aMax : (a < aMin ? aMin : a);
+}
+
+// Same curve as the brightness shader: 1 - (1 - x)^(2.4^(brightness / 100)).
+float BrightnessCurve(float value, float scale)
+{
+    float current = Clip(1.f - value, 0, 1) + ESP;
+    current = 1.f - pow(current, scale);
+    return Clip(current, 0, 1);
+}
+
+float ContrastCurve(float value, float scale)
+{
+    float current = value - scale * 0.1f * sin(ALGORITHM_PARAMTER_FACTOR * PI * value);
+    return Clip(current, 0, 1);
+}
+
+template <typename T>
+void FillLut(std::vector<T> &lut, LutType type, float intensity, uint32_t bitDepth)
+{
+    uint32_t size = 1u << bitDepth;
+    uint32_t maxValue = size - 1;
+    float scale = intensity / SCALE_FACTOR;
+    if (type == LutType::BRIGHTNESS) {
+        scale = pow(2.4f, scale); // 2.4 is algorithm parameter.
+    }
+    lut.resize(size);
+    for (uint32_t idx = 0; idx < size; idx++) {
+        float value = static_cast<float>(idx) / maxValue;
+        if (type == LutType::IDENTITY) {
+            lut[idx] = static_cast<T>(idx);
+            continue;
+        }
+        float current = type == LutType::BRIGHTNESS ? BrightnessCurve(value, scale) : ContrastCurve(value, scale);
+        lut[idx] = static_cast<T>(current * maxValue);
+    }
+}
+
+uint64_t MakeKey(LutType type, float quantizedIntensity, uint32_t bitDepth)
+{
+    auto intensity = static_cast<int32_t>(std::lround(quantizedIntensity * LutCache::INTENSITY_QUANTIZE_SCALE));
+    return (static_cast<uint64_t>(type) << KEY_TYPE_SHIFT) | (static_cast<uint64_t>(bitDepth) << KEY_BIT_DEPTH_SHIFT) |
+        static_cast<uint32_t>(intensity);
+}
+} // namespace
+
+LutCache &LutCache::Instance()
+{
+    static LutCache instance;
+    return instance;
+}
+
+float LutCache::QuantizeIntensity(float intensity)
+{
+    return std::round(intensity * INTENSITY_QUANTIZE_SCALE) / INTENSITY_QUANTIZE_SCALE;
+}
+
+LutTablePtr LutCache::CreateLut(LutType type, float intensity, uint32_t bitDepth)
+{
+    CHECK_AND_RETURN_RET_LOG(bitDepth >= MIN_BIT_DEPTH && bitDepth <= MAX_BIT_DEPTH, nullptr,
+        "CreateLut: invalid bitDepth=%{public}d", bitDepth);
+    auto table = std::make_shared<LutTable>();
+    table->type = type;
+    table->intensity = intensity;
+    table->bitDepth = bitDepth;
+    if (bitDepth == MIN_BIT_DEPTH) {
+        FillLut(table->lut8, type, intensity, bitDepth);
+    } else {
+        FillLut(table->lut16, type, intensity, bitDepth);
+    }
+    return table;
+}
+
+LutTablePtr LutCache::GetLut(LutType type, float intensity, uint32_t bitDepth)
+{
+    float quantizedIntensity = QuantizeIntensity(intensity);
+    uint64_t key = MakeKey(type, quantizedIntensity, bitDepth);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = index_.find(key);
+        if (it != index_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second);
+            hitCount_++;
+            return it->second->second;
+        }
+    }
+
+    // Build outside of the lock, a concurrent miss on the same key only costs a duplicated build.
+    missCount_++;
+    LutTablePtr table = CreateLut(type, quantizedIntensity, bitDepth);
+    CHECK_AND_RETURN_RET_LOG(table != nullptr, nullptr, "GetLut: create lut fail! type=%{public}d",
+        static_cast<int32_t>(type));
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return it->second->second;
+    }
+    lru_.emplace_front(key, table);
+    index_[key] = lru_.begin();
+    TrimLocked();
+    return table;
+}
+
+void LutCache::SetCapacity(uint32_t capacity)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    capacity_ = capacity;
+    TrimLocked();
+}
+
+LutCacheStats LutCache::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    LutCacheStats stats;
+    stats.hitCount = hitCount_.load();
+    stats.missCount = missCount_.load();
+    stats.size = static_cast<uint32_t>(lru_.size());
+    stats.capacity = capacity_;
+    return stats;
+}
+
+void LutCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    lru_.clear();
+    index_.clear();
+    hitCount_ = 0;
+    missCount_ = 0;
+}
+
+void LutCache::TrimLocked()
+{
+    while (lru_.size() > capacity_) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,456 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "lut_helper.h"
+
+#include "effect_log.h"
+#include "format_helper.h"
+
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t RGBA_ALPHA_INDEX = 3;
+constexpr uint32_t YUV_BLOCK_SIZE = 2;
+constexpr int UV_OFFSET = 128;
+constexpr uint32_t YUV_TO_RGB_SHIFT = 8;
+constexpr int P10_UV_OFFSET = 512;
+constexpr uint32_t RGBA1010102_ALPHA_SHIFT = 30;
+
+using LutRowFunc = void (*)(const uint8_t *src, uint8_t *dst, uint32_t width, const uint8_t *lut);
+
+void LutRowScalar(const uint8_t *src, uint8_t *dst, uint32_t width, const uint8_t *lut)
+{
+    for (uint32_t x = 0; x < width; ++x) {
+        const uint8_t *s = src + x * RGBA_BYTES_PER_PIXEL;
+        uint8_t *d = dst + x * RGBA_BYTES_PER_PIXEL;
+        d[0] = lut[s[0]];
+        d[1] = lut[s[1]]; // 1 is g channel
+        d[2] = lut[s[2]]; // 2 is b channel
+        d[RGBA_ALPHA_INDEX] = s[RGBA_ALPHA_INDEX];
+    }
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+// A 256 entries lut is split into 16 tables of 16 bytes which pshufb can index by the low nibble. For table t the
+// index is (value - 16 * t) saturating added with 0x70: in range values keep their low nibble with bit 7 clear,
+// every other value gets bit 7 set and pshufb writes zero, so or-ing the 16 lookups gives lut[value].
+constexpr uint32_t LUT_SUB_TABLE_COUNT = 16;
+constexpr uint32_t LUT_SUB_TABLE_SIZE = 16;
+constexpr char LUT_INDEX_BIAS = 0x70;
+constexpr uint32_t SSE4_PIXELS_PER_LOOP = 4;
+constexpr uint32_t AVX2_PIXELS_PER_LOOP = 8;
+
+__attribute__((target("sse4.1"))) void LutRowSse4(const uint8_t *src, uint8_t *dst, uint32_t width,
+    const uint8_t *lut)
+{
+    __m128i tables[LUT_SUB_TABLE_COUNT];
+    for (uint32_t t = 0; t < LUT_SUB_TABLE_COUNT; ++t) {
+        tables[t] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(lut + t * LUT_SUB_TABLE_SIZE));
+    }
+    const __m128i bias = _mm_set1_epi8(LUT_INDEX_BIAS);
+    const __m128i step = _mm_set1_epi8(LUT_SUB_TABLE_SIZE);
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    uint32_t x = 0;
+    for (; x + SSE4_PIXELS_PER_LOOP <= width; x += SSE4_PIXELS_PER_LOOP) {
+        __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + x * RGBA_BYTES_PER_PIXEL));
+        __m128i index = pixels;
+        __m128i result = _mm_setzero_si128();
+        for (uint32_t t = 0; t < LUT_SUB_TABLE_COUNT; ++t) {
+            result = _mm_or_si128(result, _mm_shuffle_epi8(tables[t], _mm_adds_epu8(index, bias)));
+            index = _mm_sub_epi8(index, step);
+        }
+        result = _mm_blendv_epi8(result, pixels, alphaMask);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + x * RGBA_BYTES_PER_PIXEL), result);
+    }
+    LutRowScalar(src + x * RGBA_BYTES_PER_PIXEL, dst + x * RGBA_BYTES_PER_PIXEL, width - x, lut);
+}
+
+__attribute__((target("avx2"))) void LutRowAvx2(const uint8_t *src, uint8_t *dst, uint32_t width,
+    const uint8_t *lut)
+{
+    __m256i tables[LUT_SUB_TABLE_COUNT];
+    for (uint32_t t = 0; t < LUT_SUB_TABLE_COUNT; ++t) {
+        // vpshufb works per 128-bit lane, so each lane gets its own copy of the sub table.
+        tables[t] = _mm256_broadcastsi128_si256(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(lut + t * LUT_SUB_TABLE_SIZE)));
+    }
+    const __m256i bias = _mm256_set1_epi8(LUT_INDEX_BIAS);
+    const __m256i step = _mm256_set1_epi8(LUT_SUB_TABLE_SIZE);
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+
+    uint32_t x = 0;
+    for (; x + AVX2_PIXELS_PER_LOOP <= width; x += AVX2_PIXELS_PER_LOOP) {
+        __m256i pixels = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + x * RGBA_BYTES_PER_PIXEL));
+        __m256i index = pixels;
+        __m256i result = _mm256_setzero_si256();
+        for (uint32_t t = 0; t < LUT_SUB_TABLE_COUNT; ++t) {
+            result = _mm256_or_si256(result, _mm256_shuffle_epi8(tables[t], _mm256_adds_epu8(index, bias)));
+            index = _mm256_sub_epi8(index, step);
+        }
+        result = _mm256_blendv_epi8(result, pixels, alphaMask);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + x * RGBA_BYTES_PER_PIXEL), result);
+    }
+    LutRowScalar(src + x * RGBA_BYTES_PER_PIXEL, dst + x * RGBA_BYTES_PER_PIXEL, width - x, lut);
+}
+#endif
+
+#if defined(__aarch64__)
+constexpr uint32_t NEON_PIXELS_PER_LOOP = 4;
+constexpr uint32_t NEON_TABLE_BYTES = 64;
+constexpr uint32_t NEON_REG_BYTES = 16;
+
+inline uint8x16x4_t LoadNeonTable(const uint8_t *lut)
+{
+    uint8x16x4_t table;
+    table.val[0] = vld1q_u8(lut);
+    table.val[1] = vld1q_u8(lut + NEON_REG_BYTES);
+    table.val[2] = vld1q_u8(lut + NEON_REG_BYTES * 2); // 2 is the third register of the table
+    table.val[3] = vld1q_u8(lut + NEON_REG_BYTES * 3); // 3 is the fourth register of the table
+    return table;
+}
+
+// tbl returns zero and tbx keeps the previous lane for out of range indexes, so four 64 bytes lookups on the
+// shifted value cover the whole 256 entries lut.
+void LutRowNeon(const uint8_t *src, uint8_t *dst, uint32_t width, const uint8_t *lut)
+{
+    const uint8x16x4_t table0 = LoadNeonTable(lut);
+    const uint8x16x4_t table1 = LoadNeonTable(lut + NEON_TABLE_BYTES);
+    const uint8x16x4_t table2 = LoadNeonTable(lut + NEON_TABLE_BYTES * 2); // 2 is the third 64 bytes table
+    const uint8x16x4_t table3 = LoadNeonTable(lut + NEON_TABLE_BYTES * 3); // 3 is the fourth 64 bytes table
+    const uint8x16_t step = vdupq_n_u8(NEON_TABLE_BYTES);
+    const uint8x16_t alphaMask = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+
+    uint32_t x = 0;
+    for (; x + NEON_PIXELS_PER_LOOP <= width; x += NEON_PIXELS_PER_LOOP) {
+        uint8x16_t pixels = vld1q_u8(src + x * RGBA_BYTES_PER_PIXEL);
+        uint8x16_t index = pixels;
+        uint8x16_t result = vqtbl4q_u8(table0, index);
+        index = vsubq_u8(index, step);
+        result = vqtbx4q_u8(result, table1, index);
+        index = vsubq_u8(index, step);
+        result = vqtbx4q_u8(result, table2, index);
+        index = vsubq_u8(index, step);
+        result = vqtbx4q_u8(result, table3, index);
+        result = vbslq_u8(alphaMask, pixels, result);
+        vst1q_u8(dst + x * RGBA_BYTES_PER_PIXEL, result);
+    }
+    LutRowScalar(src + x * RGBA_BYTES_PER_PIXEL, dst + x * RGBA_BYTES_PER_PIXEL, width - x, lut);
+}
+#endif
+
+// Chroma terms of FormatHelper::YuvToR/G/B, shared by the four luma samples of a block.
+struct ChromaDelta {
+    int r = 0;
+    int g = 0;
+    int b = 0;
+};
+
+inline ChromaDelta CalculateChromaDelta(uint8_t u, uint8_t v)
+{
+    int du = u - UV_OFFSET;
+    int dv = v - UV_OFFSET;
+    ChromaDelta delta;
+    delta.r = (403 * dv) >> YUV_TO_RGB_SHIFT; // 403 is the v coefficient of r
+    delta.g = (48 * du + 120 * dv) >> YUV_TO_RGB_SHIFT; // 48 and 120 are the u/v coefficients of g
+    delta.b = (475 * du) >> YUV_TO_RGB_SHIFT; // 475 is the u coefficient of b
+    return delta;
+}
+
+struct RgbSum {
+    uint32_t r = 0;
+    uint32_t g = 0;
+    uint32_t b = 0;
+};
+
+inline uint8_t MapLuma(uint8_t y, const ChromaDelta &delta, const uint8_t *lut, RgbSum &sum)
+{
+    uint8_t r = lut[FormatHelper::Clip(y + delta.r, 0, UNSIGHED_CHAR_MAX)];
+    uint8_t g = lut[FormatHelper::Clip(y - delta.g, 0, UNSIGHED_CHAR_MAX)];
+    uint8_t b = lut[FormatHelper::Clip(y + delta.b, 0, UNSIGHED_CHAR_MAX)];
+    sum.r += r;
+    sum.g += g;
+    sum.b += b;
+    return FormatHelper::RGBToY(r, g, b);
+}
+
+void LutBlockRowYUV420SP(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst, uint32_t width, uint32_t height,
+    uint32_t blockRow, const uint8_t *lut, bool isNV21)
+{
+    uint32_t row = blockRow * YUV_BLOCK_SIZE;
+    uint32_t rowCount = (row + 1 < height) ? YUV_BLOCK_SIZE : 1;
+    const uint8_t *srcUV = src.uv.data + static_cast<size_t>(src.uv.rowStride) * blockRow;
+    uint8_t *dstUV = dst.uv.data + static_cast<size_t>(dst.uv.rowStride) * blockRow;
+    uint32_t uIndex = isNV21 ? 1 : 0;
+    uint32_t vIndex = 1 - uIndex;
+
+    for (uint32_t x = 0; x < width; x += YUV_BLOCK_SIZE) {
+        uint32_t colCount = (x + 1 < width) ? YUV_BLOCK_SIZE : 1;
+        ChromaDelta delta = CalculateChromaDelta(srcUV[x + uIndex], srcUV[x + vIndex]);
+        RgbSum sum;
+        for (uint32_t i = 0; i < rowCount; ++i) {
+            const uint8_t *srcY = src.y.data + static_cast<size_t>(src.y.rowStride) * (row + i) + x;
+            uint8_t *dstY = dst.y.data + static_cast<size_t>(dst.y.rowStride) * (row + i) + x;
+            for (uint32_t j = 0; j < colCount; ++j) {
+                dstY[j] = MapLuma(srcY[j], delta, lut, sum);
+            }
+        }
+        uint32_t count = rowCount * colCount;
+        uint8_t r = static_cast<uint8_t>((sum.r + count / YUV_BLOCK_SIZE) / count);
+        uint8_t g = static_cast<uint8_t>((sum.g + count / YUV_BLOCK_SIZE) / count);
+        uint8_t b = static_cast<uint8_t>((sum.b + count / YUV_BLOCK_SIZE) / count);
+        dstUV[x + uIndex] = FormatHelper::RGBToU(r, g, b);
+        dstUV[x + vIndex] = FormatHelper::RGBToV(r, g, b);
+    }
+}
+
+// 10-bit terms of the same block processing, samples are P010 words and rgba words are RGBA_1010102.
+inline ChromaDelta CalculateChromaDelta10(uint16_t u, uint16_t v)
+{
+    int du = u - P10_UV_OFFSET;
+    int dv = v - P10_UV_OFFSET;
+    ChromaDelta delta;
+    delta.r = (403 * dv) >> YUV_TO_RGB_SHIFT; // 403 is the v coefficient of r
+    delta.g = (48 * du + 120 * dv) >> YUV_TO_RGB_SHIFT; // 48 and 120 are the u/v coefficients of g
+    delta.b = (475 * du) >> YUV_TO_RGB_SHIFT; // 475 is the u coefficient of b
+    return delta;
+}
+
+inline uint16_t MapLuma10(uint16_t y, const ChromaDelta &delta, const uint16_t *lut, RgbSum &sum)
+{
+    uint16_t r = lut[FormatHelper::Clip(y + delta.r, 0, P10_MAX_VALUE)];
+    uint16_t g = lut[FormatHelper::Clip(y - delta.g, 0, P10_MAX_VALUE)];
+    uint16_t b = lut[FormatHelper::Clip(y + delta.b, 0, P10_MAX_VALUE)];
+    sum.r += r;
+    sum.g += g;
+    sum.b += b;
+    return FormatHelper::RGB10ToY(r, g, b);
+}
+
+inline uint16_t *GetP010Row(const LutPlaneInfo &plane, uint32_t row)
+{
+    return reinterpret_cast<uint16_t *>(plane.data + static_cast<size_t>(plane.rowStride) * row);
+}
+
+void LutBlockRowP010(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst, uint32_t width, uint32_t height,
+    uint32_t blockRow, const uint16_t *lut, bool isNV21)
+{
+    uint32_t row = blockRow * YUV_BLOCK_SIZE;
+    uint32_t rowCount = (row + 1 < height) ? YUV_BLOCK_SIZE : 1;
+    const uint16_t *srcUV = GetP010Row(src.uv, blockRow);
+    uint16_t *dstUV = GetP010Row(dst.uv, blockRow);
+    uint32_t uIndex = isNV21 ? 1 : 0;
+    uint32_t vIndex = 1 - uIndex;
+
+    for (uint32_t x = 0; x < width; x += YUV_BLOCK_SIZE) {
+        uint32_t colCount = (x + 1 < width) ? YUV_BLOCK_SIZE : 1;
+        ChromaDelta delta = CalculateChromaDelta10(FormatHelper::GetP010Sample(srcUV[x + uIndex]),
+            FormatHelper::GetP010Sample(srcUV[x + vIndex]));
+        RgbSum sum;
+        for (uint32_t i = 0; i < rowCount; ++i) {
+            const uint16_t *srcY = GetP010Row(src.y, row + i) + x;
+            uint16_t *dstY = GetP010Row(dst.y, row + i) + x;
+            for (uint32_t j = 0; j < colCount; ++j) {
+                dstY[j] = FormatHelper::ToP010Word(MapLuma10(FormatHelper::GetP010Sample(srcY[j]), delta, lut, sum));
+            }
+        }
+        uint32_t count = rowCount * colCount;
+        uint16_t r = static_cast<uint16_t>((sum.r + count / YUV_BLOCK_SIZE) / count);
+        uint16_t g = static_cast<uint16_t>((sum.g + count / YUV_BLOCK_SIZE) / count);
+        uint16_t b = static_cast<uint16_t>((sum.b + count / YUV_BLOCK_SIZE) / count);
+        dstUV[x + uIndex] = FormatHelper::ToP010Word(FormatHelper::RGB10ToU(r, g, b));
+        dstUV[x + vIndex] = FormatHelper::ToP010Word(FormatHelper::RGB10ToV(r, g, b));
+    }
+}
+
+void LutRowRGBA1010102(const uint32_t *src, uint32_t *dst, uint32_t width, const uint16_t *lut)
+{
+    for (uint32_t x = 0; x < width; ++x) {
+        uint32_t pixel = src[x];
+        dst[x] = FormatHelper::PackRGBA1010102(lut[FormatHelper::GetRGBA1010102Channel(pixel, 0)],
+            lut[FormatHelper::GetRGBA1010102Channel(pixel, 1)], // 1 is g channel
+            lut[FormatHelper::GetRGBA1010102Channel(pixel, 2)], // 2 is b channel
+            pixel >> RGBA1010102_ALPHA_SHIFT);
+    }
+}
+
+ErrorCode GetYUV420SPPlaneInfo(EffectBuffer *buffer, uint32_t width, uint32_t height, uint32_t bytesPerSample,
+    LutYuvPlaneInfo &info)
+{
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr && buffer->bufferInfo_ != nullptr && buffer->buffer_ != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "GetYUV420SPPlaneInfo: buffer is null!");
+    const std::shared_ptr<BufferInfo> &bufferInfo = buffer->bufferInfo_;
+    uint32_t rowStride = bufferInfo->rowStride_ == 0 ? bufferInfo->width_ * bytesPerSample : bufferInfo->rowStride_;
+    uint32_t minRowStride = (width + 1) / YUV_BLOCK_SIZE * YUV_BLOCK_SIZE * bytesPerSample;
+    uint64_t minLen = static_cast<uint64_t>(rowStride) * (height + (height + 1) / YUV_BLOCK_SIZE);
+    CHECK_AND_RETURN_RET_LOG(bufferInfo->width_ >= width && bufferInfo->height_ >= height &&
+        rowStride >= minRowStride && bufferInfo->len_ >= minLen, ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+        "GetYUV420SPPlaneInfo: invalid buffer! width=%{public}d, height=%{public}d, rowStride=%{public}d, "
+        "len=%{public}d", bufferInfo->width_, bufferInfo->height_, bufferInfo->rowStride_, bufferInfo->len_);
+
+    auto *data = static_cast<uint8_t *>(buffer->buffer_);
+    info.y = { data, rowStride };
+    info.uv = { data + static_cast<size_t>(rowStride) * bufferInfo->height_, rowStride };
+    return ErrorCode::SUCCESS;
+}
+
+LutRowFunc GetLutRowFunc(SimdLevel level)
+{
+    if (!CpuFeatureHelper::IsSupported(level)) {
+        return LutRowScalar;
+    }
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::AVX2:
+            return LutRowAvx2;
+        case SimdLevel::SSE4:
+            return LutRowSse4;
+#endif
+#if defined(__aarch64__)
+        case SimdLevel::NEON:
+            return LutRowNeon;
+#endif
+        default:
+            return LutRowScalar;
+    }
+}
+} // namespace
+
+void LutHelper::ApplyRowRGBA8888(const uint8_t *src, uint8_t *dst, uint32_t width, const uint8_t *lut,
+    SimdLevel level)
+{
+    if (src == nullptr || dst == nullptr || lut == nullptr) {
+        return;
+    }
+    GetLutRowFunc(level)(src, dst, width, lut);
+}
+
+void LutHelper::ApplyRGBA8888(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width, uint32_t height,
+    const uint8_t *lut)
+{
+    ApplyRGBA8888(src, dst, width, height, lut, CpuFeatureHelper::GetSimdLevel());
+}
+
+void LutHelper::ApplyRGBA8888(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width, uint32_t height,
+    const uint8_t *lut, SimdLevel level)
+{
+    if (src.data == nullptr || dst.data == nullptr || lut == nullptr) {
+        return;
+    }
+    LutRowFunc rowFunc = GetLutRowFunc(level);
+    const uint8_t *srcData = src.data;
+    uint8_t *dstData = dst.data;
+    uint32_t srcRowStride = src.rowStride;
+    uint32_t dstRowStride = dst.rowStride;
+#pragma omp parallel for default(none) shared(height, width, srcData, dstData, srcRowStride, dstRowStride, lut, \
+    rowFunc)
+    for (uint32_t y = 0; y < height; ++y) {
+        rowFunc(srcData + static_cast<size_t>(srcRowStride) * y, dstData + static_cast<size_t>(dstRowStride) * y,
+            width, lut);
+    }
+}
+
+void LutHelper::ApplyYUV420SP(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst, uint32_t width,
+    uint32_t height, const uint8_t *lut, IEffectFormat format)
+{
+    if (src.y.data == nullptr || src.uv.data == nullptr || dst.y.data == nullptr || dst.uv.data == nullptr ||
+        lut == nullptr) {
+        return;
+    }
+    bool isNV21 = format == IEffectFormat::YUVNV21;
+    uint32_t blockRows = (height + 1) / YUV_BLOCK_SIZE;
+    // Each iteration owns two luma rows and one chroma row, so no sample is shared between threads.
+#pragma omp parallel for default(none) shared(src, dst, width, height, blockRows, lut, isNV21)
+    for (uint32_t blockRow = 0; blockRow < blockRows; ++blockRow) {
+        LutBlockRowYUV420SP(src, dst, width, height, blockRow, lut, isNV21);
+    }
+}
+
+ErrorCode LutHelper::ApplyYUV420SP(EffectBuffer *src, EffectBuffer *dst, const uint8_t *lut, IEffectFormat format)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && src->bufferInfo_ != nullptr && lut != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "ApplyYUV420SP: input para is null!");
+    uint32_t width = src->bufferInfo_->width_;
+    uint32_t height = src->bufferInfo_->height_;
+    LutYuvPlaneInfo srcPlanes;
+    LutYuvPlaneInfo dstPlanes;
+    ErrorCode res = GetYUV420SPPlaneInfo(src, width, height, sizeof(uint8_t), srcPlanes);
+    CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+    res = GetYUV420SPPlaneInfo(dst, width, height, sizeof(uint8_t), dstPlanes);
+    CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+
+    ApplyYUV420SP(srcPlanes, dstPlanes, width, height, lut, format);
+    return ErrorCode::SUCCESS;
+}
+
+void LutHelper::ApplyRGBA1010102(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width, uint32_t height,
+    const uint16_t *lut)
+{
+    if (src.data == nullptr || dst.data == nullptr || lut == nullptr) {
+        return;
+    }
+    const uint8_t *srcData = src.data;
+    uint8_t *dstData = dst.data;
+    uint32_t srcRowStride = src.rowStride;
+    uint32_t dstRowStride = dst.rowStride;
+#pragma omp parallel for default(none) shared(height, width, srcData, dstData, srcRowStride, dstRowStride, lut)
+    for (uint32_t y = 0; y < height; ++y) {
+        LutRowRGBA1010102(reinterpret_cast<const uint32_t *>(srcData + static_cast<size_t>(srcRowStride) * y),
+            reinterpret_cast<uint32_t *>(dstData + static_cast<size_t>(dstRowStride) * y), width, lut);
+    }
+}
+
+void LutHelper::ApplyP010(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst, uint32_t width, uint32_t height,
+    const uint16_t *lut, IEffectFormat format)
+{
+    if (src.y.data == nullptr || src.uv.data == nullptr || dst.y.data == nullptr || dst.uv.data == nullptr ||
+        lut == nullptr) {
+        return;
+    }
+    bool isNV21 = format == IEffectFormat::YCRCB_P010;
+    uint32_t blockRows = (height + 1) / YUV_BLOCK_SIZE;
+#pragma omp parallel for default(none) shared(src, dst, width, height, blockRows, lut, isNV21)
+    for (uint32_t blockRow = 0; blockRow < blockRows; ++blockRow) {
+        LutBlockRowP010(src, dst, width, height, blockRow, lut, isNV21);
+    }
+}
+
+ErrorCode LutHelper::ApplyP010(EffectBuffer *src, EffectBuffer *dst, const uint16_t *lut, IEffectFormat format)
+{
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && src->bufferInfo_ != nullptr && lut != nullptr,
+        ErrorCode::ERR_INPUT_NULL, "ApplyP010: input para is null!");
+    uint32_t width = src->bufferInfo_->width_;
+    uint32_t height = src->bufferInfo_->height_;
+    LutYuvPlaneInfo srcPlanes;
+    LutYuvPlaneInfo dstPlanes;
+    ErrorCode res = GetYUV420SPPlaneInfo(src, width, height, sizeof(uint16_t), srcPlanes);
+    CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+    res = GetYUV420SPPlaneInfo(dst, width, height, sizeof(uint16_t), dstPlanes);
+    CHECK_AND_RETURN_RET(res == ErrorCode::SUCCESS, res);
+
+    ApplyP010(srcPlanes, dstPlanes, width, height, lut, format);
+    return ErrorCode::SUCCESS;
+}
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
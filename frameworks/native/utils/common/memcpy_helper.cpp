@@ -15,21 +15,364 @@
 
 #include "memcpy_helper.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
 #include "securec.h"
+#include "cpu_feature_helper.h"
 #include "effect_log.h"
+#include "effect_trace.h"
 #include "format_helper.h"
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace OHOS {
 namespace Media {
 namespace Effect {
-void MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
+namespace {
+constexpr size_t CONTIGUOUS_CHUNK_BYTES = 64 * 1024;
+constexpr uintptr_t NON_TEMPORAL_ALIGN = 16;
+constexpr size_t NON_TEMPORAL_BYTES_PER_LOOP = 64;
+constexpr uint32_t MAX_POOL_THREADS = 7; // helper threads, the calling thread is the last worker
+constexpr size_t PAGE_SIZE_FALLBACK = 4096;
+
+struct RowCopyJob {
+    const uint8_t *src = nullptr;
+    uint8_t *dst = nullptr;
+    size_t srcStride = 0;
+    size_t dstStride = 0;
+    size_t rowBytes = 0;
+    uint32_t rows = 0;
+};
+
+std::mutex &GetPolicyMutex()
+{
+    static std::mutex policyMutex;
+    return policyMutex;
+}
+
+CopyPolicy &GetPolicy()
+{
+    static CopyPolicy policy;
+    return policy;
+}
+
+/**
+ * A few long lived threads shared by every copy. One copy runs at a time: a copy issued while the pool is busy is done
+ * by its caller alone rather than waiting, which also keeps nested or concurrent copies deadlock free.
+ */
+class CopyWorkerPool {
+public:
+    static CopyWorkerPool &Instance()
+    {
+        static CopyWorkerPool pool;
+        return pool;
+    }
+
+    // Runs task(0) .. task(count - 1) on the pool and the calling thread, returns false when the pool is busy.
+    bool Run(uint32_t count, const std::function<void(uint32_t)> &task)
+    {
+        std::unique_lock<std::mutex> runLock(runMutex_, std::try_to_lock);
+        if (!runLock.owns_lock()) {
+            return false;
+        }
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            doneCond_.wait(lock, [this]() { return activeWorkers_ == 0; });
+            task_ = &task;
+            taskCount_ = count;
+            finishedTasks_ = 0;
+            nextTask_.store(0);
+            generation_++;
+        }
+        startCond_.notify_all();
+        Execute();
+        std::unique_lock<std::mutex> lock(mutex_);
+        doneCond_.wait(lock, [this]() { return finishedTasks_ == taskCount_ && activeWorkers_ == 0; });
+        task_ = nullptr;
+        return true;
+    }
+
+    uint32_t GetThreadCount() const
+    {
+        return static_cast<uint32_t>(workers_.size()) + 1;
+    }
+
+private:
+    CopyWorkerPool()
+    {
+        uint32_t hardwareThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        uint32_t threadCount = std::min(hardwareThreads - 1, MAX_POOL_THREADS);
+        for (uint32_t idx = 0; idx < threadCount; idx++) {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~CopyWorkerPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            isStopped_ = true;
+        }
+        startCond_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    void WorkerLoop()
+    {
+        uint64_t seenGeneration = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                startCond_.wait(lock, [this, &seenGeneration]() {
+                    return isStopped_ || generation_ != seenGeneration;
+                });
+                if (isStopped_) {
+                    return;
+                }
+                seenGeneration = generation_;
+                activeWorkers_++;
+            }
+            Execute();
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                activeWorkers_--;
+            }
+            doneCond_.notify_all();
+        }
+    }
+
+    void Execute()
+    {
+        while (true) {
+            uint32_t idx = nextTask_.fetch_add(1);
+            if (idx >= taskCount_) {
+                return;
+            }
+            (*task_)(idx);
+            std::unique_lock<std::mutex> lock(mutex_);
+            finishedTasks_++;
+            if (finishedTasks_ == taskCount_) {
+                doneCond_.notify_all();
+            }
+        }
+    }
+
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable startCond_;
+    std::condition_variable doneCond_;
+    std::vector<std::thread> workers_;
+    const std::function<void(uint32_t)> *task_ = nullptr;
+    uint32_t taskCount_ = 0;
+    std::atomic<uint32_t> nextTask_ { 0 };
+    uint32_t finishedTasks_ = 0;
+    uint32_t activeWorkers_ = 0;
+    uint64_t generation_ = 0;
+    bool isStopped_ = false;
+};
+
+bool CopyHeadOrTail(uint8_t *dst, const uint8_t *src, size_t bytes)
+{
+    if (bytes == 0) {
+        return true;
+    }
+    errno_t ret = memcpy_s(dst, bytes, src, bytes);
+    if (ret != 0) {
+        EFFECT_LOGE("CopyHeadOrTail memcpy_s failed. ret=%{public}d, bytes=%{public}zu", ret, bytes);
+        return false;
+    }
+    return true;
+}
+
+// Streams one row to memory without pulling the destination into the cache. The destination is aligned first so
+// that every store of the main loop is a full aligned store.
+#if defined(__x86_64__) || defined(__i386__)
+__attribute__((target("sse2"))) bool CopyRowNonTemporal(uint8_t *dst, const uint8_t *src, size_t bytes)
+{
+    size_t head = (NON_TEMPORAL_ALIGN - reinterpret_cast<uintptr_t>(dst) % NON_TEMPORAL_ALIGN) % NON_TEMPORAL_ALIGN;
+    head = std::min(head, bytes);
+    if (!CopyHeadOrTail(dst, src, head)) {
+        return false;
+    }
+    size_t x = head;
+    for (; x + NON_TEMPORAL_BYTES_PER_LOOP <= bytes; x += NON_TEMPORAL_BYTES_PER_LOOP) {
+        const __m128i *s = reinterpret_cast<const __m128i *>(src + x);
+        __m128i *d = reinterpret_cast<__m128i *>(dst + x);
+        __m128i v0 = _mm_loadu_si128(s);
+        __m128i v1 = _mm_loadu_si128(s + 1); // 1: second 16 bytes
+        __m128i v2 = _mm_loadu_si128(s + 2); // 2: third 16 bytes
+        __m128i v3 = _mm_loadu_si128(s + 3); // 3: fourth 16 bytes
+        _mm_stream_si128(d, v0);
+        _mm_stream_si128(d + 1, v1); // 1: second 16 bytes
+        _mm_stream_si128(d + 2, v2); // 2: third 16 bytes
+        _mm_stream_si128(d + 3, v3); // 3: fourth 16 bytes
+    }
+    return CopyHeadOrTail(dst + x, src + x, bytes - x);
+}
+
+__attribute__((target("sse2"))) void FinishNonTemporal()
+{
+    _mm_sfence();
+}
+#elif defined(__aarch64__)
+bool CopyRowNonTemporal(uint8_t *dst, const uint8_t *src, size_t bytes)
+{
+    size_t head = (NON_TEMPORAL_ALIGN - reinterpret_cast<uintptr_t>(dst) % NON_TEMPORAL_ALIGN) % NON_TEMPORAL_ALIGN;
+    head = std::min(head, bytes);
+    if (!CopyHeadOrTail(dst, src, head)) {
+        return false;
+    }
+    size_t x = head;
+    for (; x + NON_TEMPORAL_BYTES_PER_LOOP <= bytes; x += NON_TEMPORAL_BYTES_PER_LOOP) {
+        asm volatile(
+            "ldp q0, q1, [%[s]]\n"
+            "ldp q2, q3, [%[s], #32]\n"
+            "stnp q0, q1, [%[d]]\n"
+            "stnp q2, q3, [%[d], #32]\n"
+            :
+            : [s] "r"(src + x), [d] "r"(dst + x)
+            : "v0", "v1", "v2", "v3", "memory");
+    }
+    return CopyHeadOrTail(dst + x, src + x, bytes - x);
+}
+
+void FinishNonTemporal()
+{
+    asm volatile("dmb ishst" : : : "memory");
+}
+#else
+bool CopyRowNonTemporal(uint8_t *dst, const uint8_t *src, size_t bytes)
+{
+    return CopyHeadOrTail(dst, src, bytes);
+}
+
+void FinishNonTemporal() {}
+#endif
+
+bool CopyRows(const RowCopyJob &job, uint32_t beginRow, uint32_t endRow, bool isNonTemporal)
+{
+    bool isSuccess = true;
+    for (uint32_t row = beginRow; row < endRow && isSuccess; row++) {
+        const uint8_t *src = job.src + row * job.srcStride;
+        uint8_t *dst = job.dst + row * job.dstStride;
+        if (isNonTemporal) {
+            isSuccess = CopyRowNonTemporal(dst, src, job.rowBytes);
+            continue;
+        }
+        errno_t ret = memcpy_s(dst, job.dstStride, src, job.rowBytes);
+        if (ret != 0) {
+            EFFECT_LOGE("CopyRows memcpy_s failed. ret=%{public}d, row=%{public}d, dstStride=%{public}zu, "
+                "rowBytes=%{public}zu", ret, row, job.dstStride, job.rowBytes);
+            isSuccess = false;
+        }
+    }
+    if (isNonTemporal) {
+        FinishNonTemporal();
+    }
+    return isSuccess;
+}
+
+// Rows [begin, end) counted across all jobs one after another.
+bool CopyRowRange(const std::vector<RowCopyJob> &jobs, uint64_t begin, uint64_t end, bool isNonTemporal)
+{
+    uint64_t jobBegin = 0;
+    for (const RowCopyJob &job : jobs) {
+        uint64_t jobEnd = jobBegin + job.rows;
+        if (jobEnd > begin && jobBegin < end) {
+            uint32_t beginRow = static_cast<uint32_t>(std::max(begin, jobBegin) - jobBegin);
+            uint32_t endRow = static_cast<uint32_t>(std::min(end, jobEnd) - jobBegin);
+            if (!CopyRows(job, beginRow, endRow, isNonTemporal)) {
+                return false;
+            }
+        }
+        jobBegin = jobEnd;
+    }
+    return true;
+}
+
+ErrorCode RunCopyJobs(const std::vector<RowCopyJob> &jobs)
+{
+    uint64_t totalRows = 0;
+    uint64_t totalBytes = 0;
+    for (const RowCopyJob &job : jobs) {
+        totalRows += job.rows;
+        totalBytes += static_cast<uint64_t>(job.rows) * job.rowBytes;
+    }
+    if (totalRows == 0) {
+        return ErrorCode::SUCCESS;
+    }
+
+    CopyPolicy policy = MemcpyHelper::GetCopyPolicy();
+    size_t nonTemporalThreshold = policy.nonTemporalThreshold != 0 ? policy.nonTemporalThreshold :
+        CpuFeatureHelper::GetLastLevelCacheSize();
+    bool isNonTemporal = totalBytes >= nonTemporalThreshold;
+    if (totalBytes < policy.parallelThreshold || policy.maxWorkers <= 1) {
+        return CopyRowRange(jobs, 0, totalRows, isNonTemporal) ? ErrorCode::SUCCESS : ErrorCode::ERR_MEMCPY_FAIL;
+    }
+
+    EFFECT_TRACE_NAME("MemcpyHelper::ParallelCopy");
+    CopyWorkerPool &pool = CopyWorkerPool::Instance();
+    uint32_t taskCount = static_cast<uint32_t>(std::min<uint64_t>(std::min(policy.maxWorkers,
+        pool.GetThreadCount()), totalRows));
+    std::atomic<bool> isSuccess = true;
+    std::function<void(uint32_t)> task = [&jobs, &isSuccess, totalRows, taskCount, isNonTemporal](uint32_t idx) {
+        if (!CopyRowRange(jobs, totalRows * idx / taskCount, totalRows * (idx + 1) / taskCount, isNonTemporal)) {
+            isSuccess = false;
+        }
+    };
+    if (taskCount <= 1 || !pool.Run(taskCount, task)) {
+        isSuccess = CopyRowRange(jobs, 0, totalRows, isNonTemporal);
+    }
+    return isSuccess ? ErrorCode::SUCCESS : ErrorCode::ERR_MEMCPY_FAIL;
+}
+
+// Writes one byte of every page overlapping [begin, end) of data.
+void TouchPages(uint8_t *data, size_t begin, size_t end, size_t pageSize)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(data);
+    uintptr_t page = (base + begin) / pageSize * pageSize;
+    for (; page < base + end; page += pageSize) {
+        *reinterpret_cast<volatile uint8_t *>(std::max(page, base + begin)) = 0;
+    }
+}
+
+// A contiguous copy is cut into fixed size chunks so that it can be shared between workers like rows.
+std::vector<RowCopyJob> CreateContiguousJobs(const uint8_t *src, uint8_t *dst, size_t len)
+{
+    std::vector<RowCopyJob> jobs;
+    uint32_t chunkCount = static_cast<uint32_t>(len / CONTIGUOUS_CHUNK_BYTES);
+    if (chunkCount > 0) {
+        jobs.push_back({ src, dst, CONTIGUOUS_CHUNK_BYTES, CONTIGUOUS_CHUNK_BYTES, CONTIGUOUS_CHUNK_BYTES,
+            chunkCount });
+    }
+    size_t tail = len - static_cast<size_t>(chunkCount) * CONTIGUOUS_CHUNK_BYTES;
+    if (tail > 0) {
+        size_t offset = len - tail;
+        jobs.push_back({ src + offset, dst + offset, tail, tail, tail, 1 });
+    }
+    return jobs;
+}
+} // namespace
+
+ErrorCode MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
 {
     uint8_t *srcBuffet = src.data;
     uint8_t *dstBuffer = dst.data;
-    CHECK_AND_RETURN_LOG(srcBuffet != nullptr && dstBuffer != nullptr, "Input addr is null!");
+    CHECK_AND_RETURN_RET_LOG(srcBuffet != nullptr && dstBuffer != nullptr, ErrorCode::ERR_INPUT_NULL,
+        "Input addr is null!");
     if (srcBuffet == dstBuffer) {
         EFFECT_LOGD("Buffer is same, not need copy.");
-        return;
+        return ErrorCode::SUCCESS;
     }
 
     BufferInfo &srcInfo = src.bufferInfo;
@@ -45,12 +388,7 @@ void MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
 
     // direct copy the date while the size is same.
     if (srcRowStride == dstRowStride && srcBufferLen == dstBufferLen) {
-        errno_t ret = memcpy_s(dstBuffer, dstBufferLen, srcBuffet, srcBufferLen);
-        if (ret != 0) {
-            EFFECT_LOGE("CopyData memcpy_s failed. ret=%{public}d, dstBufLen=%{public}d,"
-                "srcBufLen=%{public}d", ret, dstBufferLen, srcBufferLen);
-        }
-        return;
+        return RunCopyJobs(CreateContiguousJobs(srcBuffet, dstBuffer, srcBufferLen));
     }
 
     // copy by row
@@ -63,19 +401,9 @@ void MemcpyHelper::CopyData(CopyInfo &src, CopyInfo &dst)
             "srcStride=%{public}d, srcLen=%{public}d, dstH=%{public}d, dstFormat=%{public}d, dstStride=%{public}d, "
             "dstLen=%{public}d", srcInfo.height_, srcInfo.formatType_, srcInfo.rowStride_, srcInfo.len_,
             dstInfo.height_, dstInfo.formatType_, dstInfo.rowStride_, dstInfo.len_);
-        return;
-    }
-    for (uint32_t i = 0; i < rowCount; i++) {
-        errno_t ret = memcpy_s(dstBuffer + i * dstRowStride, dstRowStride, srcBuffet + i * srcRowStride, count);
-        if (ret != 0) {
-            EFFECT_LOGE("CopyData: copy by row memcpy_s failed. ret=%{public}d, row=%{public}d, srcH=%{public}d, "
-                "srcFormat=%{public}d, srcStride=%{public}d, srcLen=%{public}d, dstH=%{public}d, dstFormat=%{public}d, "
-                "dstStride=%{public}d, dstLen=%{public}d", ret, i,
-                srcInfo.height_, srcInfo.formatType_, srcInfo.rowStride_, srcInfo.len_,
-                dstInfo.height_, dstInfo.formatType_, dstInfo.rowStride_, dstInfo.len_);
-            continue;
-        }
+        return ErrorCode::ERR_MEMCPY_FAIL;
     }
+    return RunCopyJobs({ { srcBuffet, dstBuffer, srcRowStride, dstRowStride, count, rowCount } });
 }
 
 void CreateCopyInfoByEffectBuffer(EffectBuffer *buffer, CopyInfo &info)
@@ -86,13 +414,14 @@ void CreateCopyInfoByEffectBuffer(EffectBuffer *buffer, CopyInfo &info)
     };
 }
 
-void MemcpyHelper::CopyData(EffectBuffer *src, EffectBuffer *dst)
+ErrorCode MemcpyHelper::CopyData(EffectBuffer *src, EffectBuffer *dst)
 {
-    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "Input effect buffer is null!");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL,
+        "Input effect buffer is null!");
 
     if (src == dst) {
         EFFECT_LOGD("EffectBuffer is same, not need copy.");
-        return;
+        return ErrorCode::SUCCESS;
     }
 
     CopyInfo srcCopyInfo;
@@ -101,25 +430,25 @@ void MemcpyHelper::CopyData(EffectBuffer *src, EffectBuffer *dst)
     CopyInfo dstCopyInfo;
     CreateCopyInfoByEffectBuffer(dst, dstCopyInfo);
 
-    CopyData(srcCopyInfo, dstCopyInfo);
+    return CopyData(srcCopyInfo, dstCopyInfo);
 }
 
-void MemcpyHelper::CopyData(EffectBuffer *src, CopyInfo &dst)
+ErrorCode MemcpyHelper::CopyData(EffectBuffer *src, CopyInfo &dst)
 {
-    CHECK_AND_RETURN_LOG(src != nullptr, "Input src effect buffer is null!");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr, ErrorCode::ERR_INPUT_NULL, "Input src effect buffer is null!");
     CopyInfo srcCopyInfo;
     CreateCopyInfoByEffectBuffer(src, srcCopyInfo);
 
-    CopyData(srcCopyInfo, dst);
+    return CopyData(srcCopyInfo, dst);
 }
 
-void MemcpyHelper::CopyData(CopyInfo &src, EffectBuffer *dst)
+ErrorCode MemcpyHelper::CopyData(CopyInfo &src, EffectBuffer *dst)
 {
-    CHECK_AND_RETURN_LOG(dst != nullptr, "Input dst effect buffer is null!");
+    CHECK_AND_RETURN_RET_LOG(dst != nullptr, ErrorCode::ERR_INPUT_NULL, "Input dst effect buffer is null!");
     CopyInfo dstCopyInfo;
     CreateCopyInfoByEffectBuffer(dst, dstCopyInfo);
 
-    CopyData(src, dstCopyInfo);
+    return CopyData(src, dstCopyInfo);
 }
 
 void CreateCopyInfoByMemoryData(MemoryData *memoryData, CopyInfo &info)
@@ -130,21 +459,22 @@ void CreateCopyInfoByMemoryData(MemoryData *memoryData, CopyInfo &info)
     };
 }
 
-void MemcpyHelper::CopyData(EffectBuffer *buffer, MemoryData *memoryData)
+ErrorCode MemcpyHelper::CopyData(EffectBuffer *buffer, MemoryData *memoryData)
 {
-    CHECK_AND_RETURN_LOG(buffer != nullptr && memoryData != nullptr, "Input is null!");
+    CHECK_AND_RETURN_RET_LOG(buffer != nullptr && memoryData != nullptr, ErrorCode::ERR_INPUT_NULL, "Input is null!");
     CopyInfo dstCopyInfo;
     CreateCopyInfoByMemoryData(memoryData, dstCopyInfo);
 
-    MemcpyHelper::CopyData(buffer, dstCopyInfo);
+    return MemcpyHelper::CopyData(buffer, dstCopyInfo);
 }
 
-void MemcpyHelper::CopyData(MemoryData *src, MemoryData *dst)
+ErrorCode MemcpyHelper::CopyData(MemoryData *src, MemoryData *dst)
 {
-    CHECK_AND_RETURN_LOG(src != nullptr && dst != nullptr, "Input memory data is null!");
+    CHECK_AND_RETURN_RET_LOG(src != nullptr && dst != nullptr, ErrorCode::ERR_INPUT_NULL,
+        "Input memory data is null!");
     if (src == dst) {
         EFFECT_LOGD("MemoryData is same, not need copy.");
-        return;
+        return ErrorCode::SUCCESS;
     }
 
     CopyInfo srcCopyInfo;
@@ -153,7 +483,69 @@ void MemcpyHelper::CopyData(MemoryData *src, MemoryData *dst)
     CopyInfo dstCopyInfo;
     CreateCopyInfoByMemoryData(dst, dstCopyInfo);
 
-    CopyData(srcCopyInfo, dstCopyInfo);
+    return CopyData(srcCopyInfo, dstCopyInfo);
+}
+void MemcpyHelper::PrefaultPages(void *data, size_t len)
+{
+    CHECK_AND_RETURN_LOG(data != nullptr, "Input addr is null!");
+    long sysPageSize = sysconf(_SC_PAGESIZE);
+    size_t pageSize = sysPageSize > 0 ? static_cast<size_t>(sysPageSize) : PAGE_SIZE_FALLBACK;
+    uint8_t *buffer = static_cast<uint8_t *>(data);
+    uint64_t pageCount = (len + pageSize - 1) / pageSize;
+    CopyPolicy policy = GetCopyPolicy();
+    if (pageCount == 0 || len < policy.parallelThreshold || policy.maxWorkers <= 1) {
+        TouchPages(buffer, 0, len, pageSize);
+        return;
+    }
+
+    EFFECT_TRACE_NAME("MemcpyHelper::PrefaultPages");
+    CopyWorkerPool &pool = CopyWorkerPool::Instance();
+    uint32_t taskCount = static_cast<uint32_t>(std::min<uint64_t>(std::min(policy.maxWorkers,
+        pool.GetThreadCount()), pageCount));
+    // tasks cover whole pages of a page aligned buffer, e.g. a huge page mapping.
+    std::function<void(uint32_t)> task = [buffer, len, pageSize, pageCount, taskCount](uint32_t idx) {
+        size_t begin = static_cast<size_t>(pageCount * idx / taskCount) * pageSize;
+        size_t end = std::min(static_cast<size_t>(pageCount * (idx + 1) / taskCount) * pageSize, len);
+        TouchPages(buffer, begin, end, pageSize);
+    };
+    if (taskCount <= 1 || !pool.Run(taskCount, task)) {
+        TouchPages(buffer, 0, len, pageSize);
+    }
+}
+
+ErrorCode MemcpyHelper::CopyPlanes(const std::vector<CopyPlane> &src, const std::vector<CopyPlane> &dst)
+{
+    CHECK_AND_RETURN_RET_LOG(!src.empty() && src.size() == dst.size(), ErrorCode::ERR_INVALID_PARAMETER_VALUE,
+        "CopyPlanes: plane count mismatch! srcCount=%{public}zu, dstCount=%{public}zu", src.size(), dst.size());
+    std::vector<RowCopyJob> jobs;
+    for (size_t idx = 0; idx < src.size(); idx++) {
+        const CopyPlane &srcPlane = src[idx];
+        const CopyPlane &dstPlane = dst[idx];
+        CHECK_AND_RETURN_RET_LOG(srcPlane.data != nullptr && dstPlane.data != nullptr, ErrorCode::ERR_INPUT_NULL,
+            "CopyPlanes: plane data is null! plane=%{public}zu", idx);
+        CHECK_AND_RETURN_RET_LOG(srcPlane.rowBytes <= srcPlane.rowStride && dstPlane.rowBytes <= dstPlane.rowStride,
+            ErrorCode::ERR_INVALID_PARAMETER_VALUE, "CopyPlanes: row bytes exceed stride! plane=%{public}zu, "
+            "srcRowBytes=%{public}d, srcStride=%{public}d, dstRowBytes=%{public}d, dstStride=%{public}d", idx,
+            srcPlane.rowBytes, srcPlane.rowStride, dstPlane.rowBytes, dstPlane.rowStride);
+        if (srcPlane.data == dstPlane.data) {
+            continue;
+        }
+        jobs.push_back({ srcPlane.data, dstPlane.data, srcPlane.rowStride, dstPlane.rowStride,
+            std::min(srcPlane.rowBytes, dstPlane.rowBytes), std::min(srcPlane.rows, dstPlane.rows) });
+    }
+    return RunCopyJobs(jobs);
+}
+
+void MemcpyHelper::SetCopyPolicy(const CopyPolicy &policy)
+{
+    std::unique_lock<std::mutex> lock(GetPolicyMutex());
+    GetPolicy() = policy;
+}
+
+CopyPolicy MemcpyHelper::GetCopyPolicy()
+{
+    std::unique_lock<std::mutex> lock(GetPolicyMutex());
+    return GetPolicy();
 }
 } // namespace Effect
 } // namespace Media
@@ -29,7 +29,8 @@ static const std::map<ErrorCode, const char*> g_ErrorTypeMap = {
     {ErrorCode::ERR_INVALID_OPERATION, "ERROR_INVALID_OPERATION"},
     {ErrorCode::ERR_TIMED_OUT, "ERROR_TIMED_OUT"},
     {ErrorCode::ERR_NO_MEMORY, "ERROR_NO_MEMORY"},
-    {ErrorCode::ERR_PERMISSION_DENIED, "ERROR_PERMISSION_DENIED"}
+    {ErrorCode::ERR_PERMISSION_DENIED, "ERROR_PERMISSION_DENIED"},
+    {ErrorCode::ERR_CANCELED, "ERROR_CANCELED"}
 };
 
 std::string GetErrorName(ErrorCode code)
@@ -15,10 +15,17 @@
 
 #include "format_helper.h"
 
+#include <algorithm>
+
 #include "effect_log.h"
 
+#if defined(__aarch64__)
+#include <arm_neon.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
 namespace {
-    const float YUV_BYTES_PER_PIXEL = 1.5f;
     const int32_t RGBA_BYTES_PER_PIXEL = 4;
     const int32_t P10_BYTES_PER_LUMA = 2;
     const int32_t R = 0;
@@ -26,18 +33,29 @@ namespace {
     const int32_t B = 2;
     const int32_t A = 3;
     const int32_t UV_SPLIT_FACTOR = 2;
+    const uint32_t SIMD_ROW_ALIGNMENT = 64; // widest simd register and one cache line
+    const uint32_t CACHE_ALIASING_STRIDE = 4096; // rows this far apart map to the same l1 cache sets
+    const uint32_t CHROMA_ROUNDING = 2;
+    const uint32_t CHROMA_AVERAGE_SHIFT = 2;
+    const uint32_t NV12_U_INDEX = 0;
+    const uint32_t NV21_U_INDEX = 1;
+    const uint32_t RGBA1010102_OPAQUE_ALPHA = 3;
 }
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
 
-void ConvertRGBAToNV12(FormatConverterInfo &src, FormatConverterInfo &dst);
-void ConvertRGBAToNV21(FormatConverterInfo &src, FormatConverterInfo &dst);
-void ConvertNV12ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst);
-void ConvertNV21ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst);
+void ConvertRGBAToNV12(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertRGBAToNV21(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertNV12ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertNV21ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertRGBA1010102ToYCBCRP010(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertRGBA1010102ToYCRCBP010(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertYCBCRP010ToRGBA1010102(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
+void ConvertYCRCBP010ToRGBA1010102(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level);
 
-using FormatConverterFunc = std::function<void(FormatConverterInfo &src, FormatConverterInfo &dst)>;
+using FormatConverterFunc = std::function<void(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)>;
 
 struct FormatConverter {
     IEffectFormat srcFormat;
@@ -50,6 +68,10 @@ static const std::vector<FormatConverter> FORMAT_CONVERTER = {
     FormatConverter{ IEffectFormat::RGBA8888, IEffectFormat::YUVNV21, ConvertRGBAToNV21 },
     FormatConverter{ IEffectFormat::YUVNV12, IEffectFormat::RGBA8888, ConvertNV12ToRGBA },
     FormatConverter{ IEffectFormat::YUVNV21, IEffectFormat::RGBA8888, ConvertNV21ToRGBA },
+    FormatConverter{ IEffectFormat::RGBA_1010102, IEffectFormat::YCBCR_P010, ConvertRGBA1010102ToYCBCRP010 },
+    FormatConverter{ IEffectFormat::RGBA_1010102, IEffectFormat::YCRCB_P010, ConvertRGBA1010102ToYCRCBP010 },
+    FormatConverter{ IEffectFormat::YCBCR_P010, IEffectFormat::RGBA_1010102, ConvertYCBCRP010ToRGBA1010102 },
+    FormatConverter{ IEffectFormat::YCRCB_P010, IEffectFormat::RGBA_1010102, ConvertYCRCBP010ToRGBA1010102 },
 };
 
 static const std::unordered_set<IEffectFormat> SUPPORTED_FORMATS = {
@@ -71,7 +93,8 @@ uint32_t FormatHelper::CalculateDataRowCount(uint32_t height, IEffectFormat form
         case IEffectFormat::YUVNV21:
         case IEffectFormat::YCBCR_P010:
         case IEffectFormat::YCRCB_P010:
-            return static_cast<uint32_t>(height * YUV_BYTES_PER_PIXEL);
+            // the chroma plane keeps a row for the last luma row when the height is odd.
+            return height + (height + 1) / UV_SPLIT_FACTOR;
         default:
             return height;
     }
@@ -88,12 +111,23 @@ uint32_t FormatHelper::CalculateRowStride(uint32_t width, IEffectFormat format)
             return (width + 1) & ~1u;
         case IEffectFormat::YCRCB_P010:
         case IEffectFormat::YCBCR_P010:
-            return width * P10_BYTES_PER_LUMA;
+            return ((width + 1) & ~1u) * P10_BYTES_PER_LUMA;
         default:
             return width;
     }
 }
 
+uint32_t FormatHelper::CalculatePaddedRowStride(uint32_t width, IEffectFormat format)
+{
+    uint32_t rowStride = CalculateRowStride(width, format);
+    rowStride = (rowStride + SIMD_ROW_ALIGNMENT - 1) / SIMD_ROW_ALIGNMENT * SIMD_ROW_ALIGNMENT;
+    // power of two widths would make every column walk hit the same few cache sets.
+    if (rowStride != 0 && rowStride % CACHE_ALIASING_STRIDE == 0) {
+        rowStride += SIMD_ROW_ALIGNMENT;
+    }
+    return rowStride;
+}
+
 uint32_t FormatHelper::CalculateSize(uint32_t width, uint32_t height, IEffectFormat format)
 {
     return static_cast<uint32_t>(static_cast<int64_t>(CalculateDataRowCount(height, format)) *
@@ -155,6 +189,11 @@ ErrorCode CheckConverterInfo(FormatConverterInfo &src, FormatConverterInfo &dst)
 }
 
 ErrorCode FormatHelper::ConvertFormat(FormatConverterInfo &src, FormatConverterInfo &dst)
+{
+    return ConvertFormat(src, dst, CpuFeatureHelper::GetSimdLevel());
+}
+
+ErrorCode FormatHelper::ConvertFormat(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
 {
     IEffectFormat srcFormat = src.bufferInfo.formatType_;
     IEffectFormat dstFormat = dst.bufferInfo.formatType_;
@@ -166,46 +205,333 @@ ErrorCode FormatHelper::ConvertFormat(FormatConverterInfo &src, FormatConverterI
     ErrorCode res = CheckConverterInfo(src, dst);
     CHECK_AND_RETURN_RET_LOG(res == ErrorCode::SUCCESS, res, "ConvertFormat: invalid para! res=%{public}d", res);
 
-    func(src, dst);
+    func(src, dst, level);
     return ErrorCode::SUCCESS;
 }
 
-void ConvertRGBAToNV12(FormatConverterInfo &src, FormatConverterInfo &dst)
+namespace {
+// Two rgba rows and the luma/chroma rows they produce. For the last row of an odd height both entries point to the
+// same row, which makes the chroma average of that block come from the single row.
+struct RgbaToYuvRowPair {
+    const uint8_t *rgba[UV_SPLIT_FACTOR];
+    uint8_t *y[UV_SPLIT_FACTOR];
+    uint8_t *uv;
+};
+
+struct YuvToRgbaRow {
+    const uint8_t *y;
+    const uint8_t *uv;
+    uint8_t *rgba;
+};
+
+using RgbaToYuvRowFunc = void (*)(const RgbaToYuvRowPair &rows, uint32_t width, uint32_t uIndex);
+using YuvToRgbaRowFunc = void (*)(const YuvToRgbaRow &row, uint32_t width, uint32_t uIndex);
+
+RgbaToYuvRowPair OffsetRowPair(const RgbaToYuvRowPair &rows, uint32_t x)
+{
+    return {
+        .rgba = { rows.rgba[0] + x * RGBA_BYTES_PER_PIXEL, rows.rgba[1] + x * RGBA_BYTES_PER_PIXEL },
+        .y = { rows.y[0] + x, rows.y[1] + x },
+        .uv = rows.uv + x,
+    };
+}
+
+YuvToRgbaRow OffsetRow(const YuvToRgbaRow &row, uint32_t x)
+{
+    return { .y = row.y + x, .uv = row.uv + x, .rgba = row.rgba + x * RGBA_BYTES_PER_PIXEL };
+}
+
+// Every 2x2 block gets the chroma of its averaged rgb, the right column is replicated when the width is odd.
+void RgbaToYuvRowScalar(const RgbaToYuvRowPair &rows, uint32_t width, uint32_t uIndex)
+{
+    for (uint32_t x = 0; x < width; x += UV_SPLIT_FACTOR) {
+        uint32_t cols[UV_SPLIT_FACTOR] = { x, std::min(x + 1, width - 1) };
+        uint32_t sumR = 0;
+        uint32_t sumG = 0;
+        uint32_t sumB = 0;
+        for (uint32_t row = 0; row < UV_SPLIT_FACTOR; ++row) {
+            for (uint32_t col : cols) {
+                const uint8_t *pixel = rows.rgba[row] + col * RGBA_BYTES_PER_PIXEL;
+                rows.y[row][col] = FormatHelper::RGBToY(pixel[R], pixel[G], pixel[B]);
+                sumR += pixel[R];
+                sumG += pixel[G];
+                sumB += pixel[B];
+            }
+        }
+        uint8_t r = static_cast<uint8_t>((sumR + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        uint8_t g = static_cast<uint8_t>((sumG + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        uint8_t b = static_cast<uint8_t>((sumB + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        rows.uv[x + uIndex] = FormatHelper::RGBToU(r, g, b);
+        rows.uv[x + 1 - uIndex] = FormatHelper::RGBToV(r, g, b);
+    }
+}
+
+void YuvToRgbaRowScalar(const YuvToRgbaRow &row, uint32_t width, uint32_t uIndex)
+{
+    for (uint32_t x = 0; x < width; ++x) {
+        uint32_t chroma = x & ~1u;
+        uint8_t y = row.y[x];
+        uint8_t u = row.uv[chroma + uIndex];
+        uint8_t v = row.uv[chroma + 1 - uIndex];
+        uint8_t *pixel = row.rgba + x * RGBA_BYTES_PER_PIXEL;
+        pixel[R] = FormatHelper::YuvToR(y, u, v);
+        pixel[G] = FormatHelper::YuvToG(y, u, v);
+        pixel[B] = FormatHelper::YuvToB(y, u, v);
+        pixel[A] = UNSIGHED_CHAR_MAX;
+    }
+}
+
+// Fixed-point coefficients of FormatHelper::RGBToY/U/V and YuvToR/G/B. The yuv to rgb multipliers above 256 are
+// split as (256 + k) * d >> 8 == d + (k * d >> 8) so that every product fits in a signed 16-bit lane.
+constexpr int16_t Y_R = 54;
+constexpr int16_t Y_G = 183;
+constexpr int16_t Y_B = 18;
+constexpr int16_t U_R = -29;
+constexpr int16_t U_G = -99;
+constexpr int16_t U_B = 128;
+constexpr int16_t V_R = 128;
+constexpr int16_t V_G = -116;
+constexpr int16_t V_B = -12;
+constexpr int16_t R_V_FRACTION = 147; // 403 - 256
+constexpr int16_t G_U = 48;
+constexpr int16_t G_V = 120;
+constexpr int16_t B_U_FRACTION = 219; // 475 - 256
+constexpr int16_t CHROMA_BIAS = 128;
+constexpr int COEFFICIENT_SHIFT = 8;
+constexpr uint32_t SIMD_PIXELS_PER_LOOP = 8;
+
+#if defined(__x86_64__) || defined(__i386__)
+struct RgbaChannelsSse4 {
+    __m128i r;
+    __m128i g;
+    __m128i b;
+};
+
+// Deinterleave 8 rgba pixels into 16-bit r, g and b lanes.
+__attribute__((target("sse4.1"))) inline RgbaChannelsSse4 LoadRgbaSse4(const uint8_t *src)
+{
+    const __m128i shuffle = _mm_setr_epi8(0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15);
+    __m128i low = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src)), shuffle);
+    __m128i high = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(src + 16)), shuffle);
+    __m128i rg = _mm_unpacklo_epi32(low, high);
+    __m128i ba = _mm_unpackhi_epi32(low, high);
+    return { _mm_cvtepu8_epi16(rg), _mm_unpackhi_epi8(rg, _mm_setzero_si128()), _mm_cvtepu8_epi16(ba) };
+}
+
+__attribute__((target("sse4.1"))) inline __m128i WeightedSumSse4(const RgbaChannelsSse4 &c, int16_t kr, int16_t kg,
+    int16_t kb)
+{
+    return _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(c.r, _mm_set1_epi16(kr)),
+        _mm_mullo_epi16(c.g, _mm_set1_epi16(kg))), _mm_mullo_epi16(c.b, _mm_set1_epi16(kb)));
+}
+
+// Pairwise sum of two rows and two columns, rounded to the block mean in the low 4 lanes.
+__attribute__((target("sse4.1"))) inline __m128i BlockMeanSse4(__m128i row0, __m128i row1)
+{
+    __m128i sum = _mm_add_epi16(row0, row1);
+    sum = _mm_hadd_epi16(sum, sum);
+    return _mm_srli_epi16(_mm_add_epi16(sum, _mm_set1_epi16(CHROMA_ROUNDING)), CHROMA_AVERAGE_SHIFT);
+}
+
+__attribute__((target("sse4.1"))) void RgbaToYuvRowSse4(const RgbaToYuvRowPair &rows, uint32_t width,
+    uint32_t uIndex)
+{
+    const __m128i bias = _mm_set1_epi16(CHROMA_BIAS);
+    uint32_t x = 0;
+    for (; x + SIMD_PIXELS_PER_LOOP <= width; x += SIMD_PIXELS_PER_LOOP) {
+        RgbaChannelsSse4 c0 = LoadRgbaSse4(rows.rgba[0] + x * RGBA_BYTES_PER_PIXEL);
+        RgbaChannelsSse4 c1 = LoadRgbaSse4(rows.rgba[1] + x * RGBA_BYTES_PER_PIXEL);
+        __m128i y0 = _mm_srli_epi16(WeightedSumSse4(c0, Y_R, Y_G, Y_B), COEFFICIENT_SHIFT);
+        __m128i y1 = _mm_srli_epi16(WeightedSumSse4(c1, Y_R, Y_G, Y_B), COEFFICIENT_SHIFT);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(rows.y[0] + x), _mm_packus_epi16(y0, y0));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(rows.y[1] + x), _mm_packus_epi16(y1, y1));
+
+        RgbaChannelsSse4 mean = { BlockMeanSse4(c0.r, c1.r), BlockMeanSse4(c0.g, c1.g), BlockMeanSse4(c0.b, c1.b) };
+        __m128i u = _mm_add_epi16(_mm_srai_epi16(WeightedSumSse4(mean, U_R, U_G, U_B), COEFFICIENT_SHIFT), bias);
+        __m128i v = _mm_add_epi16(_mm_srai_epi16(WeightedSumSse4(mean, V_R, V_G, V_B), COEFFICIENT_SHIFT), bias);
+        __m128i uv = uIndex == NV12_U_INDEX ? _mm_unpacklo_epi16(u, v) : _mm_unpacklo_epi16(v, u);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(rows.uv + x), _mm_packus_epi16(uv, uv));
+    }
+    RgbaToYuvRowScalar(OffsetRowPair(rows, x), width - x, uIndex);
+}
+
+__attribute__((target("sse4.1"))) void YuvToRgbaRowSse4(const YuvToRgbaRow &row, uint32_t width, uint32_t uIndex)
+{
+    // Spread the 4 interleaved chroma pairs so that each 16-bit lane holds the sample of its pixel.
+    const __m128i evenLanes = _mm_setr_epi8(0, 1, 0, 1, 4, 5, 4, 5, 8, 9, 8, 9, 12, 13, 12, 13);
+    const __m128i oddLanes = _mm_setr_epi8(2, 3, 2, 3, 6, 7, 6, 7, 10, 11, 10, 11, 14, 15, 14, 15);
+    const __m128i uLanes = uIndex == NV12_U_INDEX ? evenLanes : oddLanes;
+    const __m128i vLanes = uIndex == NV12_U_INDEX ? oddLanes : evenLanes;
+    const __m128i bias = _mm_set1_epi16(CHROMA_BIAS);
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(UNSIGHED_CHAR_MAX));
+    uint32_t x = 0;
+    for (; x + SIMD_PIXELS_PER_LOOP <= width; x += SIMD_PIXELS_PER_LOOP) {
+        __m128i y = _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(row.y + x)));
+        __m128i uv = _mm_sub_epi16(
+            _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(row.uv + x))), bias);
+        __m128i u = _mm_shuffle_epi8(uv, uLanes);
+        __m128i v = _mm_shuffle_epi8(uv, vLanes);
+
+        __m128i r = _mm_add_epi16(_mm_add_epi16(y, v),
+            _mm_srai_epi16(_mm_mullo_epi16(v, _mm_set1_epi16(R_V_FRACTION)), COEFFICIENT_SHIFT));
+        __m128i g = _mm_sub_epi16(y, _mm_srai_epi16(_mm_add_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(G_U)),
+            _mm_mullo_epi16(v, _mm_set1_epi16(G_V))), COEFFICIENT_SHIFT));
+        __m128i b = _mm_add_epi16(_mm_add_epi16(y, u),
+            _mm_srai_epi16(_mm_mullo_epi16(u, _mm_set1_epi16(B_U_FRACTION)), COEFFICIENT_SHIFT));
+
+        __m128i rg = _mm_unpacklo_epi8(_mm_packus_epi16(r, r), _mm_packus_epi16(g, g));
+        __m128i ba = _mm_unpacklo_epi8(_mm_packus_epi16(b, b), alpha);
+        uint8_t *dst = row.rgba + x * RGBA_BYTES_PER_PIXEL;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + 16), _mm_unpackhi_epi16(rg, ba));
+    }
+    YuvToRgbaRowScalar(OffsetRow(row, x), width - x, uIndex);
+}
+#endif
+
+#if defined(__aarch64__)
+inline int16x4_t BlockMeanNeon(uint8x8_t row0, uint8x8_t row1)
+{
+    uint16x8_t sum = vaddl_u8(row0, row1);
+    return vreinterpret_s16_u16(vrshr_n_u16(vpadd_u16(vget_low_u16(sum), vget_high_u16(sum)),
+        CHROMA_AVERAGE_SHIFT));
+}
+
+inline int16x4_t ChromaNeon(int16x4_t r, int16x4_t g, int16x4_t b, int16_t kr, int16_t kg, int16_t kb)
+{
+    int16x4_t sum = vmla_n_s16(vmla_n_s16(vmul_n_s16(r, kr), g, kg), b, kb);
+    return vadd_s16(vshr_n_s16(sum, COEFFICIENT_SHIFT), vdup_n_s16(CHROMA_BIAS));
+}
+
+inline uint8x8_t LumaNeon(const uint8x8x4_t &pixels)
+{
+    uint16x8_t sum = vmull_u8(pixels.val[R], vdup_n_u8(Y_R));
+    sum = vmlal_u8(sum, pixels.val[G], vdup_n_u8(Y_G));
+    sum = vmlal_u8(sum, pixels.val[B], vdup_n_u8(Y_B));
+    return vshrn_n_u16(sum, COEFFICIENT_SHIFT);
+}
+
+void RgbaToYuvRowNeon(const RgbaToYuvRowPair &rows, uint32_t width, uint32_t uIndex)
+{
+    uint32_t x = 0;
+    for (; x + SIMD_PIXELS_PER_LOOP <= width; x += SIMD_PIXELS_PER_LOOP) {
+        uint8x8x4_t p0 = vld4_u8(rows.rgba[0] + x * RGBA_BYTES_PER_PIXEL);
+        uint8x8x4_t p1 = vld4_u8(rows.rgba[1] + x * RGBA_BYTES_PER_PIXEL);
+        vst1_u8(rows.y[0] + x, LumaNeon(p0));
+        vst1_u8(rows.y[1] + x, LumaNeon(p1));
+
+        int16x4_t r = BlockMeanNeon(p0.val[R], p1.val[R]);
+        int16x4_t g = BlockMeanNeon(p0.val[G], p1.val[G]);
+        int16x4_t b = BlockMeanNeon(p0.val[B], p1.val[B]);
+        int16x4_t u = ChromaNeon(r, g, b, U_R, U_G, U_B);
+        int16x4_t v = ChromaNeon(r, g, b, V_R, V_G, V_B);
+        int16x4x2_t uv = uIndex == NV12_U_INDEX ? vzip_s16(u, v) : vzip_s16(v, u);
+        vst1_u8(rows.uv + x, vqmovun_s16(vcombine_s16(uv.val[0], uv.val[1])));
+    }
+    RgbaToYuvRowScalar(OffsetRowPair(rows, x), width - x, uIndex);
+}
+
+void YuvToRgbaRowNeon(const YuvToRgbaRow &row, uint32_t width, uint32_t uIndex)
+{
+    uint32_t x = 0;
+    for (; x + SIMD_PIXELS_PER_LOOP <= width; x += SIMD_PIXELS_PER_LOOP) {
+        int16x8_t y = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row.y + x)));
+        int16x8_t uv = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(row.uv + x))), vdupq_n_s16(CHROMA_BIAS));
+        int16x8x2_t planes = vuzpq_s16(uv, uv);
+        int16x8_t first = vzipq_s16(planes.val[0], planes.val[0]).val[0];
+        int16x8_t second = vzipq_s16(planes.val[1], planes.val[1]).val[0];
+        int16x8_t u = uIndex == NV12_U_INDEX ? first : second;
+        int16x8_t v = uIndex == NV12_U_INDEX ? second : first;
+
+        int16x8_t r = vaddq_s16(vaddq_s16(y, v), vshrq_n_s16(vmulq_n_s16(v, R_V_FRACTION), COEFFICIENT_SHIFT));
+        int16x8_t g = vsubq_s16(y, vshrq_n_s16(vmlaq_n_s16(vmulq_n_s16(u, G_U), v, G_V), COEFFICIENT_SHIFT));
+        int16x8_t b = vaddq_s16(vaddq_s16(y, u), vshrq_n_s16(vmulq_n_s16(u, B_U_FRACTION), COEFFICIENT_SHIFT));
+
+        uint8x8x4_t pixels;
+        pixels.val[R] = vqmovun_s16(r);
+        pixels.val[G] = vqmovun_s16(g);
+        pixels.val[B] = vqmovun_s16(b);
+        pixels.val[A] = vdup_n_u8(UNSIGHED_CHAR_MAX);
+        vst4_u8(row.rgba + x * RGBA_BYTES_PER_PIXEL, pixels);
+    }
+    YuvToRgbaRowScalar(OffsetRow(row, x), width - x, uIndex);
+}
+#endif
+
+RgbaToYuvRowFunc GetRgbaToYuvRowFunc(SimdLevel level)
+{
+    if (!CpuFeatureHelper::IsSupported(level)) {
+        return RgbaToYuvRowScalar;
+    }
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::AVX2:
+        case SimdLevel::SSE4:
+            return RgbaToYuvRowSse4;
+#endif
+#if defined(__aarch64__)
+        case SimdLevel::NEON:
+            return RgbaToYuvRowNeon;
+#endif
+        default:
+            return RgbaToYuvRowScalar;
+    }
+}
+
+YuvToRgbaRowFunc GetYuvToRgbaRowFunc(SimdLevel level)
+{
+    if (!CpuFeatureHelper::IsSupported(level)) {
+        return YuvToRgbaRowScalar;
+    }
+    switch (level) {
+#if defined(__x86_64__) || defined(__i386__)
+        case SimdLevel::AVX2:
+        case SimdLevel::SSE4:
+            return YuvToRgbaRowSse4;
+#endif
+#if defined(__aarch64__)
+        case SimdLevel::NEON:
+            return YuvToRgbaRowNeon;
+#endif
+        default:
+            return YuvToRgbaRowScalar;
+    }
+}
+
+void ConvertRGBAToYUV420SP(FormatConverterInfo &src, FormatConverterInfo &dst, uint32_t uIndex, SimdLevel level)
 {
-    EFFECT_LOGW("ConvertRGBAToNV12: ConvertRGBAToNV12 will loss alpha information!");
     BufferInfo &srcBuffInfo = src.bufferInfo;
     BufferInfo &dstBuffInfo = dst.bufferInfo;
     uint32_t width = std::min(srcBuffInfo.width_, dstBuffInfo.width_);
     uint32_t height = std::min(srcBuffInfo.height_, dstBuffInfo.height_);
     uint32_t srcRowStride = srcBuffInfo.rowStride_;
     uint32_t dstRowStride = dstBuffInfo.rowStride_;
+    if (width == 0 || height == 0) {
+        return;
+    }
 
-    uint8_t *srcRGBA = static_cast<uint8_t *>(src.buffer);
-    uint8_t *dstNV12 = static_cast<uint8_t *>(dst.buffer);
-    uint8_t *dstNV12UV = dstNV12 + dstBuffInfo.height_ * dstRowStride;
-
-#pragma omp parallel for default(none) shared(height, width, srcRGBA, dstNV12, dstNV12UV, srcRowStride, dstRowStride)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * dstRowStride + j;
-            uint32_t nv_index = i / UV_SPLIT_FACTOR * dstRowStride + j - j % UV_SPLIT_FACTOR;
-            uint32_t srcIndex = i * srcRowStride + j * RGBA_BYTES_PER_PIXEL;
-            uint8_t r = srcRGBA[srcIndex + R];
-            uint8_t g = srcRGBA[srcIndex + G];
-            uint8_t b = srcRGBA[srcIndex + B];
-
-            dstNV12[y_index] = FormatHelper::RGBToY(r, g, b);
-            if (i % UV_SPLIT_FACTOR == 0 && j % UV_SPLIT_FACTOR == 0) {
-                dstNV12UV[nv_index] = FormatHelper::RGBToU(r, g, b);
-                dstNV12UV[nv_index + 1] = FormatHelper::RGBToV(r, g, b);
-            }
-        }
+    const uint8_t *srcRGBA = static_cast<const uint8_t *>(src.buffer);
+    uint8_t *dstY = static_cast<uint8_t *>(dst.buffer);
+    uint8_t *dstUV = dstY + static_cast<size_t>(dstBuffInfo.height_) * dstRowStride;
+    RgbaToYuvRowFunc rowFunc = GetRgbaToYuvRowFunc(level);
+    uint32_t blockRows = (height + 1) / UV_SPLIT_FACTOR;
+
+#pragma omp parallel for default(none) shared(blockRows, height, width, srcRGBA, dstY, dstUV, srcRowStride, \
+    dstRowStride, uIndex, rowFunc)
+    for (uint32_t i = 0; i < blockRows; i++) {
+        size_t row0 = static_cast<size_t>(i) * UV_SPLIT_FACTOR;
+        size_t row1 = std::min(row0 + 1, static_cast<size_t>(height) - 1);
+        RgbaToYuvRowPair rows = {
+            .rgba = { srcRGBA + row0 * srcRowStride, srcRGBA + row1 * srcRowStride },
+            .y = { dstY + row0 * dstRowStride, dstY + row1 * dstRowStride },
+            .uv = dstUV + static_cast<size_t>(i) * dstRowStride,
+        };
+        rowFunc(rows, width, uIndex);
     }
 }
 
-void ConvertRGBAToNV21(FormatConverterInfo &src, FormatConverterInfo &dst)
+void ConvertYUV420SPToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst, uint32_t uIndex, SimdLevel level)
 {
-    EFFECT_LOGW("ConvertRGBAToNV21: ConvertRGBAToNV21 will loss alpha information!");
     BufferInfo &srcBuffInfo = src.bufferInfo;
     BufferInfo &dstBuffInfo = dst.bufferInfo;
     uint32_t width = std::min(srcBuffInfo.width_, dstBuffInfo.width_);
@@ -213,30 +539,66 @@ void ConvertRGBAToNV21(FormatConverterInfo &src, FormatConverterInfo &dst)
     uint32_t srcRowStride = srcBuffInfo.rowStride_;
     uint32_t dstRowStride = dstBuffInfo.rowStride_;
 
-    uint8_t *srcRGBA = static_cast<uint8_t *>(src.buffer);
-    uint8_t *dstNV21 = static_cast<uint8_t *>(dst.buffer);
-    uint8_t *dstNV21UV = dstNV21 + dstBuffInfo.height_ * dstRowStride;
+    const uint8_t *srcY = static_cast<const uint8_t *>(src.buffer);
+    const uint8_t *srcUV = srcY + static_cast<size_t>(srcBuffInfo.height_) * srcRowStride;
+    uint8_t *dstRGBA = static_cast<uint8_t *>(dst.buffer);
+    YuvToRgbaRowFunc rowFunc = GetYuvToRgbaRowFunc(level);
 
-#pragma omp parallel for default(none) shared(height, width, srcRGBA, dstNV21, dstNV21UV, srcRowStride, dstRowStride)
+#pragma omp parallel for default(none) shared(height, width, srcY, srcUV, dstRGBA, srcRowStride, dstRowStride, \
+    uIndex, rowFunc)
     for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * dstRowStride + j;
-            uint32_t nv_index = i / UV_SPLIT_FACTOR * dstRowStride + j - j % UV_SPLIT_FACTOR;
-            uint32_t srcIndex = i * srcRowStride + j * RGBA_BYTES_PER_PIXEL;
-            uint8_t r = srcRGBA[srcIndex + R];
-            uint8_t g = srcRGBA[srcIndex + G];
-            uint8_t b = srcRGBA[srcIndex + B];
-
-            dstNV21[y_index] = FormatHelper::RGBToY(r, g, b);
-            if (i % UV_SPLIT_FACTOR == 0 && j % UV_SPLIT_FACTOR == 0) {
-                dstNV21UV[nv_index] = FormatHelper::RGBToV(r, g, b);
-                dstNV21UV[nv_index + 1] = FormatHelper::RGBToU(r, g, b);
+        YuvToRgbaRow row = {
+            .y = srcY + static_cast<size_t>(i) * srcRowStride,
+            .uv = srcUV + static_cast<size_t>(i / UV_SPLIT_FACTOR) * srcRowStride,
+            .rgba = dstRGBA + static_cast<size_t>(i) * dstRowStride,
+        };
+        rowFunc(row, width, uIndex);
+    }
+}
+
+// 10-bit rows: RGBA_1010102 words on one side, P010 luma/chroma words on the other. Same 2x2 chroma averaging and
+// edge replication as the 8-bit kernels.
+void RGBA1010102ToP010BlockRow(const uint32_t *rgba[UV_SPLIT_FACTOR], uint16_t *y[UV_SPLIT_FACTOR], uint16_t *uv,
+    uint32_t width, uint32_t uIndex)
+{
+    for (uint32_t x = 0; x < width; x += UV_SPLIT_FACTOR) {
+        uint32_t cols[UV_SPLIT_FACTOR] = { x, std::min(x + 1, width - 1) };
+        uint32_t sumR = 0;
+        uint32_t sumG = 0;
+        uint32_t sumB = 0;
+        for (uint32_t row = 0; row < UV_SPLIT_FACTOR; ++row) {
+            for (uint32_t col : cols) {
+                uint32_t pixel = rgba[row][col];
+                uint16_t r = FormatHelper::GetRGBA1010102Channel(pixel, R);
+                uint16_t g = FormatHelper::GetRGBA1010102Channel(pixel, G);
+                uint16_t b = FormatHelper::GetRGBA1010102Channel(pixel, B);
+                y[row][col] = FormatHelper::ToP010Word(FormatHelper::RGB10ToY(r, g, b));
+                sumR += r;
+                sumG += g;
+                sumB += b;
             }
         }
+        uint16_t r = static_cast<uint16_t>((sumR + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        uint16_t g = static_cast<uint16_t>((sumG + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        uint16_t b = static_cast<uint16_t>((sumB + CHROMA_ROUNDING) >> CHROMA_AVERAGE_SHIFT);
+        uv[x + uIndex] = FormatHelper::ToP010Word(FormatHelper::RGB10ToU(r, g, b));
+        uv[x + 1 - uIndex] = FormatHelper::ToP010Word(FormatHelper::RGB10ToV(r, g, b));
+    }
+}
+
+void P010ToRGBA1010102Row(const uint16_t *y, const uint16_t *uv, uint32_t *rgba, uint32_t width, uint32_t uIndex)
+{
+    for (uint32_t x = 0; x < width; ++x) {
+        uint32_t chroma = x & ~1u;
+        uint16_t luma = FormatHelper::GetP010Sample(y[x]);
+        uint16_t u = FormatHelper::GetP010Sample(uv[chroma + uIndex]);
+        uint16_t v = FormatHelper::GetP010Sample(uv[chroma + 1 - uIndex]);
+        rgba[x] = FormatHelper::PackRGBA1010102(FormatHelper::Yuv10ToR(luma, u, v), FormatHelper::Yuv10ToG(luma, u, v),
+            FormatHelper::Yuv10ToB(luma, u, v), RGBA1010102_OPAQUE_ALPHA);
     }
 }
 
-void ConvertNV12ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst)
+void ConvertRGBA1010102ToP010(FormatConverterInfo &src, FormatConverterInfo &dst, uint32_t uIndex)
 {
     BufferInfo &srcBuffInfo = src.bufferInfo;
     BufferInfo &dstBuffInfo = dst.bufferInfo;
@@ -244,30 +606,34 @@ void ConvertNV12ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst)
     uint32_t height = std::min(srcBuffInfo.height_, dstBuffInfo.height_);
     uint32_t srcRowStride = srcBuffInfo.rowStride_;
     uint32_t dstRowStride = dstBuffInfo.rowStride_;
+    if (width == 0 || height == 0) {
+        return;
+    }
 
-    uint8_t *srcNV12 = static_cast<uint8_t *>(src.buffer);
-    uint8_t *srcNV12UV = srcNV12 + srcBuffInfo.height_ * srcRowStride;
-    uint8_t *dstRGBA = static_cast<uint8_t *>(dst.buffer);
-
-#pragma omp parallel for default(none) shared(height, width, srcNV12, srcNV12UV, dstRGBA, srcRowStride, dstRowStride)
-    for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * srcRowStride + j;
-            uint32_t nv_index = i / UV_SPLIT_FACTOR * srcRowStride + j - j % UV_SPLIT_FACTOR;
-            uint32_t dstIndex = i * dstRowStride + j *RGBA_BYTES_PER_PIXEL;
-            uint8_t y = srcNV12[y_index];
-            uint8_t u = srcNV12UV[nv_index];
-            uint8_t v = srcNV12UV[nv_index + 1];
-
-            dstRGBA[dstIndex + R] = FormatHelper::YuvToR(y, u, v);
-            dstRGBA[dstIndex + G] = FormatHelper::YuvToG(y, u, v);
-            dstRGBA[dstIndex + B] = FormatHelper::YuvToB(y, u, v);
-            dstRGBA[dstIndex + A] = UNSIGHED_CHAR_MAX;
-        }
+    const uint8_t *srcRGBA = static_cast<const uint8_t *>(src.buffer);
+    uint8_t *dstY = static_cast<uint8_t *>(dst.buffer);
+    uint8_t *dstUV = dstY + static_cast<size_t>(dstBuffInfo.height_) * dstRowStride;
+    uint32_t blockRows = (height + 1) / UV_SPLIT_FACTOR;
+
+#pragma omp parallel for default(none) shared(blockRows, height, width, srcRGBA, dstY, dstUV, srcRowStride, \
+    dstRowStride, uIndex)
+    for (uint32_t i = 0; i < blockRows; i++) {
+        size_t row0 = static_cast<size_t>(i) * UV_SPLIT_FACTOR;
+        size_t row1 = std::min(row0 + 1, static_cast<size_t>(height) - 1);
+        const uint32_t *rgba[UV_SPLIT_FACTOR] = {
+            reinterpret_cast<const uint32_t *>(srcRGBA + row0 * srcRowStride),
+            reinterpret_cast<const uint32_t *>(srcRGBA + row1 * srcRowStride),
+        };
+        uint16_t *y[UV_SPLIT_FACTOR] = {
+            reinterpret_cast<uint16_t *>(dstY + row0 * dstRowStride),
+            reinterpret_cast<uint16_t *>(dstY + row1 * dstRowStride),
+        };
+        uint16_t *uv = reinterpret_cast<uint16_t *>(dstUV + static_cast<size_t>(i) * dstRowStride);
+        RGBA1010102ToP010BlockRow(rgba, y, uv, width, uIndex);
     }
 }
 
-void ConvertNV21ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst)
+void ConvertP010ToRGBA1010102(FormatConverterInfo &src, FormatConverterInfo &dst, uint32_t uIndex)
 {
     BufferInfo &srcBuffInfo = src.bufferInfo;
     BufferInfo &dstBuffInfo = dst.bufferInfo;
@@ -276,29 +642,62 @@ void ConvertNV21ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst)
     uint32_t srcRowStride = srcBuffInfo.rowStride_;
     uint32_t dstRowStride = dstBuffInfo.rowStride_;
 
-    CHECK_AND_RETURN_LOG(src.buffer != nullptr && dst.buffer != nullptr,
-        "ConvertNV21ToRGBA: src buffer or dst buffer is null!");
-    uint8_t *srcNV21 = static_cast<uint8_t *>(src.buffer);
-    uint8_t *srcNV21UV = srcNV21 + srcBuffInfo.height_ * srcRowStride;
+    const uint8_t *srcY = static_cast<const uint8_t *>(src.buffer);
+    const uint8_t *srcUV = srcY + static_cast<size_t>(srcBuffInfo.height_) * srcRowStride;
     uint8_t *dstRGBA = static_cast<uint8_t *>(dst.buffer);
 
-#pragma omp parallel for default(none) shared(height, width, srcNV21, srcNV21UV, dstRGBA, srcRowStride, dstRowStride)
+#pragma omp parallel for default(none) shared(height, width, srcY, srcUV, dstRGBA, srcRowStride, dstRowStride, uIndex)
     for (uint32_t i = 0; i < height; i++) {
-        for (uint32_t j = 0; j < width; j++) {
-            uint32_t y_index = i * srcRowStride + j;
-            uint32_t nv_index = i / UV_SPLIT_FACTOR * srcRowStride + j - j % UV_SPLIT_FACTOR;
-            uint32_t dstIndex = i * dstRowStride + j *RGBA_BYTES_PER_PIXEL;
-            uint8_t y = srcNV21[y_index];
-            uint8_t v = srcNV21UV[nv_index];
-            uint8_t u = srcNV21UV[nv_index + 1];
-
-            dstRGBA[dstIndex + R] = FormatHelper::YuvToR(y, u, v);
-            dstRGBA[dstIndex + G] = FormatHelper::YuvToG(y, u, v);
-            dstRGBA[dstIndex + B] = FormatHelper::YuvToB(y, u, v);
-            dstRGBA[dstIndex + A] = UNSIGHED_CHAR_MAX;
-        }
+        P010ToRGBA1010102Row(reinterpret_cast<const uint16_t *>(srcY + static_cast<size_t>(i) * srcRowStride),
+            reinterpret_cast<const uint16_t *>(srcUV + static_cast<size_t>(i / UV_SPLIT_FACTOR) * srcRowStride),
+            reinterpret_cast<uint32_t *>(dstRGBA + static_cast<size_t>(i) * dstRowStride), width, uIndex);
     }
 }
+} // namespace
+
+void ConvertRGBAToNV12(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    EFFECT_LOGW("ConvertRGBAToNV12: ConvertRGBAToNV12 will loss alpha information!");
+    ConvertRGBAToYUV420SP(src, dst, NV12_U_INDEX, level);
+}
+
+void ConvertRGBAToNV21(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    EFFECT_LOGW("ConvertRGBAToNV21: ConvertRGBAToNV21 will loss alpha information!");
+    ConvertRGBAToYUV420SP(src, dst, NV21_U_INDEX, level);
+}
+
+void ConvertNV12ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    ConvertYUV420SPToRGBA(src, dst, NV12_U_INDEX, level);
+}
+
+void ConvertNV21ToRGBA(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    ConvertYUV420SPToRGBA(src, dst, NV21_U_INDEX, level);
+}
+
+void ConvertRGBA1010102ToYCBCRP010(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    EFFECT_LOGW("ConvertRGBA1010102ToYCBCRP010: ConvertRGBA1010102ToYCBCRP010 will loss alpha information!");
+    ConvertRGBA1010102ToP010(src, dst, NV12_U_INDEX);
+}
+
+void ConvertRGBA1010102ToYCRCBP010(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    EFFECT_LOGW("ConvertRGBA1010102ToYCRCBP010: ConvertRGBA1010102ToYCRCBP010 will loss alpha information!");
+    ConvertRGBA1010102ToP010(src, dst, NV21_U_INDEX);
+}
+
+void ConvertYCBCRP010ToRGBA1010102(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    ConvertP010ToRGBA1010102(src, dst, NV12_U_INDEX);
+}
+
+void ConvertYCRCBP010ToRGBA1010102(FormatConverterInfo &src, FormatConverterInfo &dst, SimdLevel level)
+{
+    ConvertP010ToRGBA1010102(src, dst, NV21_U_INDEX);
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
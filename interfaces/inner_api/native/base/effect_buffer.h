@@ -95,6 +95,7 @@ public:
     std::shared_ptr<ExtraInfo> extraInfo_ = nullptr;
     std::shared_ptr<std::unordered_map<EffectPixelmapType, std::shared_ptr<BufferInfo>>> auxiliaryBufferInfos = nullptr;
     int32_t quality_ = 100;
+    bool isView_ = false; // buffer_ points into another buffer and keeps its row stride, see CropEFilter
 };
 } // namespace Effect
 } // namespace Media
@@ -46,6 +46,7 @@ public:
     std::unordered_set<EffectColorSpace> filtersSupportedColorSpace_;
     std::unordered_set<HdrFormat> filtersSupportedHdrFormat_;
     LOG_STRATEGY logStrategy_ = LOG_STRATEGY::NORMAL;
+    bool isStripRenderEnabled_ = true;
 
     IMAGE_EFFECT_EXPORT std::shared_ptr<ExifMetadata> GetExifMetadata();
 
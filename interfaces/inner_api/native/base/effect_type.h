@@ -24,6 +24,12 @@ namespace Effect {
 enum class ConfigType : int32_t {
     DEFAULT = 0,
     IPTYPE = 1,
+    LUT_FUSION = 2,
+    STRIP_RENDER = 3,
+    HUGE_PAGE = 4,
+    PREFAULT = 5,
+    FRAMES_IN_FLIGHT = 6,
+    OVERLOAD_POLICY = 7,
 };
 
 enum class BufferType {
@@ -117,6 +117,7 @@ enum struct ErrorCode : int32_t {
     ERR_PERMISSION_DENIED = ERR_UNKNOWN + 106,
     ERR_IMAGE_EFFECT_RECEIVER_INIT_FAILED = ERR_UNKNOWN + 107,
     ERR_MACHINE_MODEL_VERIFY_FAILED = ERR_UNKNOWN + 108,
+    ERR_CANCELED = ERR_UNKNOWN + 109,
     ERR_GL_FRAMEBUFFER_NOT_COMPLETE = ERR_UNKNOWN + 200,
     ERR_GL_CREATE_TEXTURE_FAILED = ERR_UNKNOWN + 201,
     ERR_GL_CREATE_PROGRAM_FAILED = ERR_UNKNOWN + 202,
@@ -17,11 +17,13 @@
 #define IMAGE_EFFECT_IMAGE_EFFECT_H
 
 #include <vector>
+#include <chrono>
 #include <mutex>
 #include <unordered_set>
 #include <queue>
 #include <optional>
 #include <condition_variable>
+#include <functional>
 #include <utility>
 
 #include "any.h"
@@ -31,10 +33,15 @@
 #include "surface.h"
 #include "pixel_map.h"
 #include "image_effect_marco_define.h"
-#include "render_thread.h"
+#include "render_executor.h"
+#include "render_ring_queue.h"
 #include "picture.h"
 
 #define TIME_FOR_WAITING_BUFFER 2500
+#define DEFAULT_FRAMES_IN_FLIGHT 2
+#define PRESENT_QUEUE_CAPACITY 4
+#define MAX_BATCH_CONCURRENCY 8
+#define EXECUTION_CONTEXT_IDLE_TIMEOUT_MS 10000
 
 namespace OHOS {
 namespace Media {
@@ -75,6 +82,25 @@ struct BufferEntry {
     int64_t timestamp_;
 };
 
+// what happens to a surface frame that arrives while the buffer pool is full of frames waiting to be rendered.
+enum class SurfaceOverloadPolicy : int32_t {
+    BLOCK = 0, // waits for a free slot, the frame is dropped when none frees up in time
+    LATEST_FRAME_WINS = 1, // drops the queued frames that have not been rendered yet in favour of the new one
+    PASSTHROUGH = 2, // shows the frame without the filters applied
+};
+
+struct BatchRenderItem {
+    std::string inputPath;
+    std::string outputPath;
+};
+
+struct SurfaceStreamStats {
+    SurfaceOverloadPolicy policy = SurfaceOverloadPolicy::BLOCK;
+    uint64_t renderedCount = 0;
+    uint64_t droppedCount = 0;
+    uint64_t passedThroughCount = 0;
+};
+
 template <typename T>
 class ThreadSafeBufferQueue {
 public:
@@ -114,12 +140,37 @@ public:
         return CommitPop(lock);
     }
 
+    // pushes the element in place of every queued one, without waiting. Returns the replaced elements.
+    std::vector<T> ReplaceAll(T&& element)
+    {
+        std::unique_lock lock(mutex_);
+        std::vector<T> replaced;
+        while (!queue_.empty()) {
+            replaced.emplace_back(std::move(queue_.front()));
+            queue_.pop();
+        }
+        CommitPush(std::forward<T>(element), lock);
+        return replaced;
+    }
+
+    bool WaitNotFull(std::chrono::milliseconds timeout = std::chrono::milliseconds(TIME_FOR_WAITING_BUFFER))
+    {
+        std::unique_lock lock(mutex_);
+        return WaitForSpace(lock, timeout);
+    }
+
     size_t Size() const
     {
         std::lock_guard lock(mutex_);
         return queue_.size();
     }
 
+    bool IsFull() const
+    {
+        std::lock_guard lock(mutex_);
+        return queue_.size() >= max_capacity_;
+    }
+
 private:
     template<typename Rep = int, typename Period = std::milli>
     bool WaitForSpace(std::unique_lock<std::mutex>& lock, const std::chrono::duration<Rep, Period>& timeout)
@@ -198,6 +249,48 @@ public:
 
     IMAGE_EFFECT_EXPORT ErrorCode Start() override;
 
+    using RenderAsyncCallback = std::function<void(ErrorCode)>;
+
+    // Queues a render of the current input, output and filters on the render thread and returns at once. The
+    // callback runs on the render thread with the result once the output is written, or with ERR_CANCELED if
+    // CancelAsync dropped the render before it started. Setting the input, output, filters or configs waits until the
+    // queued renders are done, except from their callbacks, so a render never sees a later change.
+    IMAGE_EFFECT_EXPORT ErrorCode RenderAsync(const RenderAsyncCallback &callback);
+
+    // Cancels the asynchronous renders that have not started yet.
+    IMAGE_EFFECT_EXPORT void CancelAsync();
+
+    // Blocks until the asynchronous renders queued so far are done. Returns at once when called from one of their
+    // callbacks, the renders queued after it run once it returns.
+    IMAGE_EFFECT_EXPORT void WaitAsyncFinished();
+
+    // Whether asynchronous renders are queued or running, the one calling from its callback aside.
+    IMAGE_EFFECT_EXPORT bool IsAsyncPending();
+
+    using BatchRenderCallback = std::function<void(uint32_t index, ErrorCode result)>;
+
+    // Renders each input file into its output file with the filter chain of this effect and blocks until all are
+    // done. Up to maxConcurrency items are in flight, each on a copy of the chain with its own render thread, so the
+    // decode, render and encode of different items overlap. results holds the status of each item, the callback is
+    // called on a render thread as soon as an item is done. The input and output of this effect are not used, and it
+    // fails with ERR_INVALID_OPERATION when called on its render thread, e.g. from a RenderAsync callback.
+    IMAGE_EFFECT_EXPORT ErrorCode RenderBatch(const std::vector<BatchRenderItem> &items, uint32_t maxConcurrency,
+        std::vector<ErrorCode> &results, const BatchRenderCallback &callback = nullptr);
+
+    // Hands out an execution context for renders that run concurrently with the renders on this effect and on other
+    // execution contexts. It is a full ImageEffect restored from the configured filter chain, set its input and output
+    // and Start it like an effect. Only the saved filter configuration, LUTs and pooled buffers are shared, each
+    // context still owns its render thread, EGL environment with its GL programs, pipeline and format negotiation.
+    // Creating one therefore costs like creating an effect, which the pool amortizes: dropping the last reference
+    // hands it back, the next caller reuses it as long as the configuration is the same.
+    // The last reference must not be dropped from one of its own RenderAsync callbacks.
+    IMAGE_EFFECT_EXPORT std::shared_ptr<ImageEffect> AcquireExecutionContext();
+
+    // Tears down the idle execution contexts that have not been reused for idleTimeout, all of them by default. The
+    // ones idle for EXECUTION_CONTEXT_IDLE_TIMEOUT_MS are also dropped whenever a context is acquired or handed back.
+    IMAGE_EFFECT_EXPORT
+    void TrimExecutionContexts(std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(0));
+
     IMAGE_EFFECT_EXPORT ErrorCode Save(EffectJsonPtr &res) override;
 
     IMAGE_EFFECT_EXPORT ErrorCode Load(std::string &info);
@@ -245,6 +338,9 @@ public:
  	 
     IMAGE_EFFECT_EXPORT bool GetRenderPriorityFlag() const {return renderPriorityFlag_;}
 
+    // frame counters of the surface stream since the overload policy was last configured.
+    IMAGE_EFFECT_EXPORT SurfaceStreamStats GetSurfaceStreamStats() const;
+
 protected:
     IMAGE_EFFECT_EXPORT virtual ErrorCode Render();
 
@@ -275,6 +371,42 @@ private:
 
     void InitEGLEnv();
 
+    void BindEGLEnv();
+
+    bool IsAsyncCanceled(uint64_t asyncGeneration);
+    ErrorCode RenderSubmitted(const DataInfo &inDateInfo, const DataInfo &outDateInfo,
+        const std::vector<std::shared_ptr<EFilter>> &efilters);
+
+    struct BatchRenderState;
+    static void RunBatchLane(ImageEffect *lane, const std::shared_ptr<BatchRenderState> &state);
+
+    // the filter chain an execution context copies, saved once per configuration and shared by every copy of it.
+    struct ConfigSnapshot {
+        std::vector<uint32_t> generations; // configGeneration_, then the value generation of every filter
+        std::vector<std::pair<std::string, EffectJsonPtr>> efilters; // name and saved values of every filter
+    };
+
+    struct ExecutionContextPool {
+        using Clock = std::chrono::steady_clock;
+        struct IdleContext {
+            std::unique_ptr<ImageEffect> context;
+            Clock::time_point idleSince;
+        };
+
+        // moves the contexts idle for at least idleTimeout to evicted, they are torn down outside of the lock.
+        void TrimLocked(Clock::time_point now, std::chrono::milliseconds idleTimeout,
+            std::vector<IdleContext> &evicted);
+
+        std::mutex mutex;
+        std::shared_ptr<const ConfigSnapshot> snapshot = nullptr; // configuration the idle contexts were copied from
+        std::vector<IdleContext> idle; // oldest first
+    };
+
+    std::shared_ptr<const ConfigSnapshot> GetConfigSnapshot();
+    std::unique_ptr<ImageEffect> CreateExecutionContext(const ConfigSnapshot &snapshot);
+    static void RecycleExecutionContext(const std::weak_ptr<ExecutionContextPool> &pool,
+        const std::shared_ptr<const ConfigSnapshot> &snapshot, ImageEffect *context);
+
     void DestroyEGLEnv();
 
     IMAGE_EFFECT_EXPORT
@@ -290,10 +422,18 @@ private:
 
     void ConsumerBufferWithGPU(sptr<SurfaceBuffer>& buffer);
     void OnBufferAvailableWithCPU();
+    bool AdmitSurfaceFrame(BufferProcessInfo& bufferProcessInfo, bool& isNeedSwap);
     bool SubmitRenderTask(BufferEntry&& entry);
+    void DropBufferEntry(BufferEntry& entry);
     void RenderBuffer();
+    // the render strand is the only producer of the present thread, a bounded ring hands frames over lock free.
+    using PresentThread = RenderThread<RenderRingQueue<RenderTaskPtr<void>, PRESENT_QUEUE_CAPACITY>>;
+    std::shared_ptr<PresentThread> GetPresentThread();
+    void PresentBuffer(BufferEntry &entry, const sptr<Surface> &surface);
     GSError FlushBuffer(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence, bool isNeedAttach, bool sendFence,
         int64_t& timestamp);
+    GSError FlushBuffer(const sptr<Surface> &surface, sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence,
+        bool isNeedAttach, bool sendFence, int64_t& timestamp);
     GSError ReleaseBuffer(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence);
     void ProcessRender(BufferProcessInfo& bufferProcessInfo, bool& isNeedSwap, int64_t& timestamp);
     void ProcessSwapBuffers(BufferProcessInfo& bufferProcessInfo, int64_t& timestamp);
@@ -342,15 +482,33 @@ private:
     std::shared_ptr<Impl> impl_;
     std::mutex innerEffectMutex_;
     std::mutex consumerListenerMutex_;
-    RenderThread<> *m_renderThread{ nullptr };
+    std::shared_ptr<RenderStrand> m_renderThread = nullptr;
     std::atomic_ullong m_currentTaskId{0};
     bool needPreFlush_ = false;
     uint32_t failureCount_ = 0;
     std::shared_ptr<ThreadSafeBufferQueue<BufferEntry>> bufferPool_;
+    // with more than one frame in flight, the default, surface frames are flushed on the present thread, so that the
+    // flush of a frame overlaps the render of the next. With one they are flushed inline on the render strand.
+    std::shared_ptr<PresentThread> m_presentThread = nullptr;
+    int32_t framesInFlight_ = DEFAULT_FRAMES_IN_FLIGHT; // frames rendering or waiting to be presented
+    std::mutex presentMutex_;
+    std::condition_variable presentCond_;
+    int32_t presentingCount_ = 0;
+    std::atomic<SurfaceOverloadPolicy> overloadPolicy_ = SurfaceOverloadPolicy::BLOCK;
+    std::atomic<uint64_t> renderedFrameCount_ = 0;
+    std::atomic<uint64_t> droppedFrameCount_ = 0;
+    std::atomic<uint64_t> passedThroughFrameCount_ = 0;
     int32_t configIpType_ = 0;
     bool needsDecodeDfxData_  = false;
     bool needsPackDfxData_ = false;
     bool renderPriorityFlag_ = false;
+    std::mutex asyncMutex_;
+    std::condition_variable asyncCond_;
+    uint32_t pendingAsyncCount_ = 0;
+    uint64_t asyncGeneration_ = 0; // bumped by CancelAsync, queued renders of an older generation are dropped
+    std::atomic<uint32_t> configGeneration_ = 0; // bumped by every configuration the execution contexts copy
+    std::shared_ptr<ExecutionContextPool> executionContextPool_; // idle execution contexts, see AcquireExecutionContext
+    std::shared_ptr<const ConfigSnapshot> configSnapshot_ = nullptr; // last snapshot, guarded by innerEffectMutex_
 };
 } // namespace Effect
 } // namespace Media
@@ -16,8 +16,10 @@
 #ifndef IMAGE_EFFECT_EFILTER_H
 #define IMAGE_EFFECT_EFILTER_H
 
+#include <atomic>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "any.h"
 #include "effect_buffer.h"
@@ -27,12 +29,26 @@
 #include "effect_json_helper.h"
 #include "image_effect_marco_define.h"
 #include "efilter_cache_config.h"
+#include "lut_cache.h"
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
 
 struct DataInfo;
+class StripRenderer;
+
+struct StripRange {
+    uint32_t row = 0;
+    uint32_t rows = 0;
+};
+
+struct StripInfo {
+    StripRange output; // rows of the filter output covered by dst
+    StripRange input; // rows of the filter input covered by src
+    uint32_t inputWidth = 0; // size of the whole filter input
+    uint32_t inputHeight = 0;
+};
 
 class EFilter : public EFilterBase {
 public:
@@ -77,6 +93,12 @@ public:
 
     IMAGE_EFFECT_EXPORT ErrorCode PushData(EffectBuffer *buffer, std::shared_ptr<EffectContext> &context);
 
+    // Bumped by every SetValue, lets a copy of the filter tell whether its values are still the same.
+    uint32_t GetValueGeneration() const
+    {
+        return valueGeneration_.load();
+    }
+
     std::map<std::string, Any> &GetValues()
     {
         return values_;
@@ -113,6 +135,37 @@ public:
     IMAGE_EFFECT_EXPORT
     virtual ErrorCode GetFilterVersion(uint32_t &filterVersion);
 
+    /**
+     * Filters whose cpu rgba output is lut[in] per color channel return that 8bit lut here, which lets the pipeline
+     * fuse adjacent ones into a single pass. Returns nullptr for any other filter.
+     */
+    IMAGE_EFFECT_EXPORT
+    virtual LutTablePtr GetPointwiseLut();
+
+    IMAGE_EFFECT_EXPORT
+    CacheStatus GetCacheStatus() const;
+
+    /**
+     * Strip rendering runs a chain of cpu filters band by band so that intermediate rows stay in the l2 cache.
+     * Pointwise lut filters support it on rgba8888 without overriding anything. Other filters opt in here, with input
+     * being the buffer that enters the chain.
+     */
+    IMAGE_EFFECT_EXPORT
+    virtual bool IsStripSupported(EffectBuffer *input);
+
+    // Input rows that produce the given output rows. Strip filters read no rows around them.
+    IMAGE_EFFECT_EXPORT
+    virtual StripRange MapStripToInput(const StripRange &output, uint32_t inputWidth, uint32_t inputHeight);
+
+    // Renders one strip, src and dst are views on the strip rows. Strips of one frame may render concurrently.
+    IMAGE_EFFECT_EXPORT
+    virtual ErrorCode RenderStrip(EffectBuffer *src, EffectBuffer *dst, const StripInfo &strip,
+        std::shared_ptr<EffectContext> &context);
+
+    // Filters linked after this one in the pipeline, candidates for a strip chain headed by this filter.
+    IMAGE_EFFECT_EXPORT
+    void SetStripFollowers(const std::vector<std::shared_ptr<EFilter>> &followers);
+
 protected:
     ErrorCode CalculateEFilterIPType(IEffectFormat &formatType, IPType &ipType);
 
@@ -135,6 +188,8 @@ private:
 
     std::shared_ptr<Capability> outputCap_ = nullptr;
 
+    std::atomic<uint32_t> valueGeneration_ = 0;
+
     static std::shared_ptr<EffectBuffer> CreateEffectBufferFromTexture(const std::shared_ptr<EffectBuffer> &buffer,
         const std::shared_ptr<EffectContext> &context);
 
@@ -157,7 +212,14 @@ private:
         std::shared_ptr<EffectBuffer> &effectBuffer) const;
 
     ErrorCode UseTextureInput();
+
+    std::shared_ptr<StripRenderer> CreateStripRenderer(EffectBuffer *source, std::shared_ptr<EffectContext> &context);
+
+    ErrorCode RenderStripChain(const std::shared_ptr<StripRenderer> &renderer, std::shared_ptr<EffectBuffer> &source,
+        bool isIpTypeChanged, std::shared_ptr<EffectContext> &context);
     void InitContext(std::shared_ptr<EffectContext> &context, IPType &runningType, bool isCustomEnv);
+
+    std::vector<std::weak_ptr<EFilter>> stripFollowers_;
 };
 } // namespace Effect
 } // namespace Media
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_BUFFER_PLANNER_H
+#define IMAGE_EFFECT_EFFECT_BUFFER_PLANNER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "effect_info.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+struct BufferPlanStep {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    IEffectFormat format = IEffectFormat::DEFAULT;
+    bool isInPlace = false; // the step writes over its input and needs no buffer of its own
+    int32_t slot = -1; // buffer slot holding the step output, -1 while it is still the caller's buffer
+
+    bool operator == (const BufferPlanStep &other) const
+    {
+        return width == other.width && height == other.height && format == other.format &&
+            isInPlace == other.isInPlace && slot == other.slot;
+    }
+};
+
+struct BufferPlan {
+    std::vector<BufferPlanStep> steps;
+    std::vector<uint64_t> slotCapacities; // bytes of each slot, large enough for every output assigned to it
+
+    bool operator == (const BufferPlan &other) const
+    {
+        return steps == other.steps && slotCapacities == other.slotCapacities;
+    }
+
+    uint64_t GetPlannedBytes() const;
+};
+
+/**
+ * Plans the intermediate buffers of a filter chain from the negotiated output geometry of every step. An output is
+ * live from the step producing it until the next step that does not render in place has read it, outputs whose
+ * lifetimes do not overlap share a slot. A linear chain therefore never needs more than two slots, however long it is.
+ */
+class BufferPlanner {
+public:
+    IMAGE_EFFECT_EXPORT static BufferPlan Plan(const BufferPlanStep &source, const std::vector<BufferPlanStep> &steps);
+
+    // bytes a heap output of the given geometry takes with simd aligned rows.
+    IMAGE_EFFECT_EXPORT static uint64_t CalculateBytes(uint32_t width, uint32_t height, IEffectFormat format);
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_EFFECT_BUFFER_PLANNER_H
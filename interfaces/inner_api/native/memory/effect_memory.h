@@ -22,16 +22,31 @@
 #include "error_code.h"
 #include "surface_buffer.h"
 #include "effect_buffer.h"
+#include "effect_memory_accountant.h"
 #include "image_effect_marco_define.h"
 
 namespace OHOS {
 namespace Media {
 namespace Effect {
+enum class RowStridePolicy {
+    PACKED = 0, // rowStride is exactly the bytes of one row, required by pixel maps that take over the buffer.
+    SIMD_ALIGNED, // rowStride is padded to the simd width and away from 4KB multiples, heap memory only.
+};
+
+struct LargeHeapPolicy {
+    bool isHugePageEnabled = false; // back large buffers with an anonymous mapping using transparent huge pages
+    bool isPrefaultEnabled = false; // fault the pages of large buffers in on the copy workers at alloc time
+    size_t threshold = 32 * 1024 * 1024; // heap buffers from this size on follow the policy
+};
+
 struct MemoryInfo {
     bool isAutoRelease = true; // alloc memory is auto release or not.
     BufferInfo bufferInfo;
     void *extra = nullptr;
     BufferType bufferType = BufferType::DEFAULT;
+    RowStridePolicy rowStridePolicy = RowStridePolicy::PACKED;
+    LargeHeapPolicy largeHeapPolicy;
+    bool isMapped = false; // heap memory in a huge page mapping, it can not be taken over by a pixel map
 };
 
 struct MemoryData {
@@ -53,17 +68,22 @@ public:
 struct HeapMemoryData : public MemoryData {
     ~HeapMemoryData();
     void *heapData = nullptr;
+    size_t mappedSize = 0; // non zero when heapData is an anonymous mapping rather than a malloc block
+    MemoryReservation reservation;
 };
 
 class HeapMemory : public AbsMemory {
 public:
     ~HeapMemory() override = default;
+    // 64 byte aligned, rowStride and len follow memoryInfo.rowStridePolicy. Large buffers follow
+    // memoryInfo.largeHeapPolicy unless they are to be taken over by a pixel map, see isAutoRelease.
     std::shared_ptr<MemoryData> Alloc(MemoryInfo &memoryInfo) override;
     ErrorCode Release() override;
     BufferType GetBufferType() override
     {
         return BufferType::HEAP_MEMORY;
     }
+    IMAGE_EFFECT_EXPORT static uint32_t CalculateRowStride(const MemoryInfo &memoryInfo);
 private:
     std::shared_ptr<HeapMemoryData> memoryData_ = nullptr;
 };
@@ -71,6 +91,7 @@ private:
 struct DmaMemoryData : public MemoryData {
     ~DmaMemoryData();
     SurfaceBuffer *surfaceBuffer = nullptr;
+    MemoryReservation reservation;
 };
 
 class DmaMemory : public AbsMemory {
@@ -90,6 +111,7 @@ struct SharedMemoryData : public MemoryData {
     ~SharedMemoryData();
     int* fdPtr = nullptr;
     size_t len = 0;
+    MemoryReservation reservation;
 };
 
 class SharedMemory : public AbsMemory {
@@ -101,6 +123,8 @@ public:
     {
         return BufferType::SHARED_MEMORY;
     }
+    // regions mapped by Alloc since start up, a streaming pipeline served by the pool stops adding to it.
+    IMAGE_EFFECT_EXPORT static uint64_t GetMapCount();
 private:
     std::shared_ptr<SharedMemoryData> memoryData_ = nullptr;
 };
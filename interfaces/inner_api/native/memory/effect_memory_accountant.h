@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_MEMORY_ACCOUNTANT_H
+#define IMAGE_EFFECT_EFFECT_MEMORY_ACCOUNTANT_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+enum class MemoryBudgetPolicy {
+    BLOCK = 0, // wait up to waitTimeout for memory to be released before failing the allocation.
+    FAIL_FAST, // fail the allocation as soon as reclaiming could not make room.
+};
+
+struct MemoryBudgetConfig {
+    uint64_t budgetBytes = 1536ULL * 1024 * 1024; // cpu buffers and gpu textures of all effects in the process
+    MemoryBudgetPolicy policy = MemoryBudgetPolicy::BLOCK;
+    std::chrono::milliseconds waitTimeout = std::chrono::milliseconds(500);
+};
+
+struct MemoryBudgetStats {
+    uint64_t budgetBytes = 0;
+    uint64_t currentBytes = 0;
+    uint64_t peakBytes = 0;
+    uint64_t reclaimedBytes = 0; // released by reclaimers on behalf of a reservation
+    uint64_t waitCount = 0; // reservations that had to wait for memory
+    uint64_t rejectCount = 0; // reservations that failed
+};
+
+// Asked to release at least the given bytes of retained but unused memory, returns what it released right away.
+using MemoryReclaimer = std::function<uint64_t(uint64_t bytes)>;
+
+/**
+ * Process wide accountant of the memory held by image effect. Heap, dma and shared memories reserve their bytes
+ * before allocating and the render texture cache reports the textures it creates. Reservations beyond the budget
+ * first ask the registered reclaimers, i.e. the memory pool and the texture cache, to drop retained buffers, then
+ * wait or fail according to the configured policy. Thread safe.
+ */
+class EffectMemoryAccountant {
+public:
+    IMAGE_EFFECT_EXPORT static EffectMemoryAccountant &Instance();
+
+    // Accounts the bytes if they fit into the budget, after reclaiming and waiting if needed.
+    IMAGE_EFFECT_EXPORT bool Reserve(uint64_t bytes);
+
+    // Accounts the bytes unconditionally, for memory that can not be refused such as textures of a running render.
+    IMAGE_EFFECT_EXPORT void Charge(uint64_t bytes);
+
+    IMAGE_EFFECT_EXPORT void Release(uint64_t bytes);
+
+    IMAGE_EFFECT_EXPORT uint32_t AddReclaimer(MemoryReclaimer reclaimer);
+
+    // Returns once a reclaim that may be running the reclaimer has finished.
+    IMAGE_EFFECT_EXPORT void RemoveReclaimer(uint32_t id);
+
+    IMAGE_EFFECT_EXPORT void SetConfig(const MemoryBudgetConfig &config);
+
+    IMAGE_EFFECT_EXPORT MemoryBudgetConfig GetConfig();
+
+    IMAGE_EFFECT_EXPORT MemoryBudgetStats GetStats();
+
+    IMAGE_EFFECT_EXPORT void ResetPeak();
+
+private:
+    EffectMemoryAccountant() = default;
+    ~EffectMemoryAccountant() = default;
+    EffectMemoryAccountant(const EffectMemoryAccountant &) = delete;
+    EffectMemoryAccountant &operator = (const EffectMemoryAccountant &) = delete;
+
+    bool TryChargeLocked(uint64_t bytes);
+    void Reclaim(uint64_t bytes);
+
+    std::mutex mutex_;
+    std::condition_variable releaseCond_;
+    MemoryBudgetConfig config_;
+    MemoryBudgetStats stats_;
+
+    std::mutex reclaimMutex_; // held while reclaimers run, never taken under mutex_
+    std::map<uint32_t, MemoryReclaimer> reclaimers_;
+    uint32_t nextReclaimerId_ = 1;
+};
+
+/**
+ * Bytes reserved at the accountant, released when the reservation is reset or destroyed.
+ */
+class MemoryReservation {
+public:
+    MemoryReservation() = default;
+    ~MemoryReservation()
+    {
+        Reset();
+    }
+    MemoryReservation(const MemoryReservation &) = delete;
+    MemoryReservation &operator = (const MemoryReservation &) = delete;
+    MemoryReservation(MemoryReservation &&other) noexcept : bytes_(other.bytes_)
+    {
+        other.bytes_ = 0;
+    }
+    MemoryReservation &operator = (MemoryReservation &&other) noexcept
+    {
+        if (this != &other) {
+            Reset();
+            bytes_ = other.bytes_;
+            other.bytes_ = 0;
+        }
+        return *this;
+    }
+
+    bool Acquire(uint64_t bytes)
+    {
+        Reset();
+        if (!EffectMemoryAccountant::Instance().Reserve(bytes)) {
+            return false;
+        }
+        bytes_ = bytes;
+        return true;
+    }
+
+    void Reset()
+    {
+        if (bytes_ != 0) {
+            EffectMemoryAccountant::Instance().Release(bytes_);
+            bytes_ = 0;
+        }
+    }
+
+    uint64_t Bytes() const
+    {
+        return bytes_;
+    }
+
+private:
+    uint64_t bytes_ = 0;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_EFFECT_MEMORY_ACCOUNTANT_H
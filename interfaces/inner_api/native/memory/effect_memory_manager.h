@@ -16,6 +16,10 @@
 #ifndef IMAGE_EFFECT_EFFECT_MEMORY_MANAGER_H
 #define IMAGE_EFFECT_EFFECT_MEMORY_MANAGER_H
 
+#include <unordered_map>
+#include <vector>
+
+#include "effect_buffer_planner.h"
 #include "effect_memory.h"
 #include "error_code.h"
 #include "effect_buffer.h"
@@ -45,6 +49,8 @@ public:
     IMAGE_EFFECT_EXPORT ErrorCode Init(const std::shared_ptr<EffectBuffer> &srcEffectBuffer,
         const std::shared_ptr<EffectBuffer> &dstEffectBuffer);
     IMAGE_EFFECT_EXPORT void SetIPType(IPType ipType);
+    IMAGE_EFFECT_EXPORT void SetLargeHeapPolicy(const LargeHeapPolicy &policy);
+    IMAGE_EFFECT_EXPORT LargeHeapPolicy GetLargeHeapPolicy() const;
 
     IMAGE_EFFECT_EXPORT MemoryData *AllocMemory(void *srcAddr, MemoryInfo &allocMemInfo);
     IMAGE_EFFECT_EXPORT std::shared_ptr<Memory> GetAllocMemoryByAddr(void *addr);
@@ -53,15 +59,55 @@ public:
     IMAGE_EFFECT_EXPORT void AddMemory(std::shared_ptr<Memory> &memory);
     IMAGE_EFFECT_EXPORT void RemoveMemory(std::shared_ptr<Memory> &memory);
 
+    // heap allocations are served from the slots of the plan while one is set, the slots survive across renders
+    // until the plan changes.
+    IMAGE_EFFECT_EXPORT void SetBufferPlan(const BufferPlan &bufferPlan);
+    IMAGE_EFFECT_EXPORT const BufferPlan &GetBufferPlan() const;
+
     IMAGE_EFFECT_EXPORT void ClearMemory();
 
     IMAGE_EFFECT_EXPORT void Deinit();
 private:
+    struct MemoryKey {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        IEffectFormat formatType = IEffectFormat::DEFAULT;
+        EffectColorSpace colorSpace = EffectColorSpace::DEFAULT;
+
+        bool operator == (const MemoryKey &other) const
+        {
+            return width == other.width && height == other.height && formatType == other.formatType &&
+                colorSpace == other.colorSpace;
+        }
+    };
+
+    struct MemoryKeyHash {
+        size_t operator()(const MemoryKey &key) const;
+    };
+
+    static MemoryKey MakeKey(const BufferInfo &bufferInfo);
+    static bool IsMemoryMatched(const std::shared_ptr<Memory> &memory, const MemoryKey &key,
+        const MemoryInfo &allocMemInfo);
+
     void AddFilterMemory(const std::shared_ptr<EffectBuffer> &effectBuffer, MemDataType memDataType,
         bool isAllowModify);
+    MemoryData *ReleaseInUseMemory(void *srcAddr, const MemoryKey &key, const MemoryInfo &allocMemInfo);
+    MemoryData *AcquireFreeMemory(void *srcAddr, const MemoryKey &key, const MemoryInfo &allocMemInfo);
+    void UnindexMemory(const std::shared_ptr<Memory> &memory);
+    BufferType GetAllocBufferType(const MemoryInfo &allocMemInfo) const;
+    MemoryData *AllocPlannedMemory(void *srcAddr, const MemoryInfo &allocMemInfo);
+    void ClearSlotMemorys();
 
     std::vector<std::shared_ptr<Memory>> memorys_;
+    // modifiable memories that can be handed out by AllocMemory, bucketed by geometry, format and color space.
+    std::unordered_map<MemoryKey, std::vector<std::shared_ptr<Memory>>, MemoryKeyHash> freeMemorys_;
+    // memories handed out by AllocMemory, they go back to the free list once a later alloc no longer reads them.
+    std::vector<std::shared_ptr<Memory>> inUseMemorys_;
     IPType runningIPType_ = IPType::DEFAULT;
+    LargeHeapPolicy largeHeapPolicy_;
+    BufferPlan bufferPlan_;
+    // one memory per slot of bufferPlan_, allocated on first use and reshaped for every output assigned to it.
+    std::vector<std::shared_ptr<Memory>> slotMemorys_;
 };
 } // namespace Effect
 } // namespace Media
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_EFFECT_MEMORY_POOL_H
+#define IMAGE_EFFECT_EFFECT_MEMORY_POOL_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "effect_memory.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+struct MemoryPoolKey {
+    BufferType bufferType = BufferType::DEFAULT;
+    uint32_t size = 0; // requested byte size, the size class for shared memory
+    uint32_t rowStride = 0; // stride alignment the consumer expects
+    // dma buffers bake the geometry and usage into the surface buffer, they are only reused on an exact match.
+    IEffectFormat formatType = IEffectFormat::DEFAULT;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint64_t usage = 0;
+    int32_t colorGamut = 0;
+    int32_t transform = 0;
+    EffectColorSpace colorSpace = EffectColorSpace::DEFAULT;
+
+    bool operator == (const MemoryPoolKey &other) const;
+};
+
+struct MemoryPoolConfig {
+    uint64_t maxRetainedBytes = 256 * 1024 * 1024; // idle bytes kept across renders, 0 disables pooling
+    uint32_t maxBuffersPerKey = 4;
+    std::chrono::milliseconds idleTimeout = std::chrono::milliseconds(10000);
+};
+
+struct MemoryPoolStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint64_t retainedBytes = 0;
+    uint32_t retainedCount = 0;
+
+    double HitRate() const
+    {
+        uint64_t total = hitCount + missCount;
+        return total == 0 ? 0.0 : static_cast<double>(hitCount) / total;
+    }
+};
+
+/**
+ * Process wide pool of idle heap/dma/shared buffers that outlives a single render. Buffers handed out by Alloc go
+ * back to the pool when their last reference is dropped, unless ownership has been moved out by clearing
+ * isAutoRelease. Thread safe, shared by every ImageEffect instance in the process. Idle buffers are given up first
+ * when the EffectMemoryAccountant runs out of budget.
+ */
+class EffectMemoryPool {
+public:
+    IMAGE_EFFECT_EXPORT static EffectMemoryPool &Instance();
+
+    IMAGE_EFFECT_EXPORT std::shared_ptr<MemoryData> Alloc(MemoryInfo &memoryInfo, BufferType bufferType);
+
+    IMAGE_EFFECT_EXPORT void SetConfig(const MemoryPoolConfig &config);
+
+    IMAGE_EFFECT_EXPORT MemoryPoolConfig GetConfig();
+
+    IMAGE_EFFECT_EXPORT MemoryPoolStats GetStats();
+
+    // Releases buffers that have been idle longer than the configured timeout.
+    IMAGE_EFFECT_EXPORT void TrimIdle();
+
+    IMAGE_EFFECT_EXPORT void Clear();
+
+    IMAGE_EFFECT_EXPORT static MemoryPoolKey MakeKey(const MemoryInfo &memoryInfo, BufferType bufferType);
+
+    // shared memory regions are created in size classes, four per power of two, so that frames of slightly
+    // different sizes share idle regions instead of each mapping a new one.
+    IMAGE_EFFECT_EXPORT static uint32_t RoundToSizeClass(uint32_t size);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct IdleBuffer {
+        MemoryPoolKey key;
+        std::shared_ptr<MemoryData> memoryData;
+        uint64_t size = 0;
+        Clock::time_point idleSince;
+    };
+    using IdleList = std::list<IdleBuffer>;
+
+    EffectMemoryPool();
+    ~EffectMemoryPool() = default;
+    EffectMemoryPool(const EffectMemoryPool &) = delete;
+    EffectMemoryPool &operator = (const EffectMemoryPool &) = delete;
+
+    std::shared_ptr<MemoryData> Acquire(const MemoryPoolKey &key, MemoryInfo &memoryInfo);
+    std::shared_ptr<MemoryData> Track(const MemoryPoolKey &key, std::shared_ptr<MemoryData> &memoryData);
+    void Recycle(const MemoryPoolKey &key, std::shared_ptr<MemoryData> &memoryData);
+    void TrimLocked(Clock::time_point now, IdleList &evicted);
+    // drops the oldest idle buffers for the memory accountant, returns the bytes released.
+    uint64_t Reclaim(uint64_t bytes);
+
+    std::mutex mutex_;
+    IdleList idle_; // oldest first
+    MemoryPoolConfig config_;
+    uint64_t retainedBytes_ = 0;
+    std::atomic<uint64_t> hitCount_ = 0;
+    std::atomic<uint64_t> missCount_ = 0;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_EFFECT_MEMORY_POOL_H
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_CPU_FEATURE_HELPER_H
+#define IMAGE_EFFECT_CPU_FEATURE_HELPER_H
+
+#include <cstdint>
+
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+enum class SimdLevel : uint32_t {
+    SCALAR = 0,
+    SSE4,
+    AVX2,
+    NEON,
+};
+
+class CpuFeatureHelper {
+public:
+    /**
+     * Best instruction set usable on the running cpu. Detected once and cached.
+     */
+    IMAGE_EFFECT_EXPORT static SimdLevel GetSimdLevel();
+
+    /**
+     * Whether kernels compiled for the level can run on this cpu. SCALAR is always supported.
+     */
+    IMAGE_EFFECT_EXPORT static bool IsSupported(SimdLevel level);
+
+    IMAGE_EFFECT_EXPORT static const char *GetSimdLevelName(SimdLevel level);
+
+    /**
+     * Size in bytes of the data cache at the given level (1, 2, 3) of cpu0, read from sysfs once and cached.
+     * Falls back to a typical mobile soc size when the kernel does not expose it.
+     */
+    IMAGE_EFFECT_EXPORT static uint32_t GetCacheSize(uint32_t level);
+
+    /**
+     * Size in bytes of the largest cache level present, the point past which copies stream from dram.
+     */
+    IMAGE_EFFECT_EXPORT static uint32_t GetLastLevelCacheSize();
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_CPU_FEATURE_HELPER_H
@@ -18,12 +18,14 @@
 
 #include <unordered_set>
 
+#include "cpu_feature_helper.h"
 #include "effect_info.h"
 #include "image_effect_marco_define.h"
 #include "effect_buffer.h"
 #include "error_code.h"
 
 #define UNSIGHED_CHAR_MAX 255
+#define P10_MAX_VALUE 1023
 
 namespace OHOS {
 namespace Media {
@@ -37,11 +39,20 @@ class FormatHelper {
 public:
     IMAGE_EFFECT_EXPORT static uint32_t CalculateDataRowCount(uint32_t height, IEffectFormat format);
     IMAGE_EFFECT_EXPORT static uint32_t CalculateRowStride(uint32_t width, IEffectFormat format);
+    // row stride aligned to the simd width and kept off multiples of 4KB, at least CalculateRowStride.
+    IMAGE_EFFECT_EXPORT static uint32_t CalculatePaddedRowStride(uint32_t width, IEffectFormat format);
     IMAGE_EFFECT_EXPORT static uint32_t CalculateSize(uint32_t width, uint32_t height, IEffectFormat format);
     IMAGE_EFFECT_EXPORT static std::unordered_set<IEffectFormat> GetAllSupportedFormats();
     IMAGE_EFFECT_EXPORT static bool IsSupportConvert(IEffectFormat srcFormat, IEffectFormat dstFormat);
     IMAGE_EFFECT_EXPORT static ErrorCode ConvertFormat(FormatConverterInfo &src, FormatConverterInfo &dst);
 
+    /**
+     * Same as above but forces the kernel level. Falls back to SCALAR when the level is not supported.
+     * RGBA8888 to NV12/NV21 takes the chroma of every 2x2 block from the mean of its four pixels.
+     */
+    IMAGE_EFFECT_EXPORT static ErrorCode ConvertFormat(FormatConverterInfo &src, FormatConverterInfo &dst,
+        SimdLevel level);
+
     static inline int Clip(int a, int aMin, int aMax)
     {
         return a > aMax ? aMax : (a < aMin ? aMin : a);
@@ -82,6 +93,66 @@ public:
         int b = (y + ((475 * (u - 128)) >> 8));
         return Clip(b, 0, UNSIGHED_CHAR_MAX);
     }
+
+    // 10-bit counterparts of the helpers above, same coefficients with the chroma centered on 512.
+    static inline uint16_t RGB10ToY(uint16_t r, uint16_t g, uint16_t b)
+    {
+        int y = (54 * r + 183 * g + 18 * b) >> 8;
+        return Clip(y, 0, P10_MAX_VALUE);
+    }
+
+    static inline uint16_t RGB10ToU(uint16_t r, uint16_t g, uint16_t b)
+    {
+        int u = ((-29 * r - 99 * g + 128 * b) >> 8) + 512;
+        return Clip(u, 0, P10_MAX_VALUE);
+    }
+
+    static inline uint16_t RGB10ToV(uint16_t r, uint16_t g, uint16_t b)
+    {
+        int v = ((128 * r - 116 * g - 12 * b) >> 8) + 512;
+        return Clip(v, 0, P10_MAX_VALUE);
+    }
+
+    static inline uint16_t Yuv10ToR(uint16_t y, uint16_t u, uint16_t v)
+    {
+        int r = (y + ((403 * (v - 512)) >> 8));
+        return Clip(r, 0, P10_MAX_VALUE);
+    }
+
+    static inline uint16_t Yuv10ToG(uint16_t y, uint16_t u, uint16_t v)
+    {
+        int g = (y - ((48 * (u - 512) + 120 * (v - 512)) >> 8));
+        return Clip(g, 0, P10_MAX_VALUE);
+    }
+
+    static inline uint16_t Yuv10ToB(uint16_t y, uint16_t u, uint16_t v)
+    {
+        int b = (y + ((475 * (u - 512)) >> 8));
+        return Clip(b, 0, P10_MAX_VALUE);
+    }
+
+    // RGBA_1010102 packs r, g, b and a 2-bit alpha from the least significant bit up, the GL_RGB10_A2 layout.
+    static inline uint16_t GetRGBA1010102Channel(uint32_t pixel, uint32_t channel)
+    {
+        return static_cast<uint16_t>((pixel >> (channel * 10)) & P10_MAX_VALUE);
+    }
+
+    static inline uint32_t PackRGBA1010102(uint16_t r, uint16_t g, uint16_t b, uint32_t alpha)
+    {
+        return static_cast<uint32_t>(r) | (static_cast<uint32_t>(g) << 10) | (static_cast<uint32_t>(b) << 20) |
+            (alpha << 30);
+    }
+
+    // P010 keeps every 10-bit sample in the high bits of a little endian 16-bit word.
+    static inline uint16_t GetP010Sample(uint16_t word)
+    {
+        return word >> 6;
+    }
+
+    static inline uint16_t ToP010Word(uint16_t sample)
+    {
+        return static_cast<uint16_t>(sample << 6);
+    }
 };
 } // namespace Effect
 } // namespace Media
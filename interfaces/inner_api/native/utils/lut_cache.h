@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_LUT_CACHE_H
+#define IMAGE_EFFECT_LUT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+enum class LutType : uint32_t {
+    BRIGHTNESS = 0,
+    CONTRAST,
+    IDENTITY, // lut[i] = i, intensity is ignored
+};
+
+struct LutTable {
+    LutType type = LutType::BRIGHTNESS;
+    float intensity = 0.f;
+    uint32_t bitDepth = 0;
+    std::vector<uint8_t> lut8; // (1 << bitDepth) entries when bitDepth is 8
+    std::vector<uint16_t> lut16; // (1 << bitDepth) entries when bitDepth is above 8
+};
+using LutTablePtr = std::shared_ptr<const LutTable>;
+
+struct LutCacheStats {
+    uint64_t hitCount = 0;
+    uint64_t missCount = 0;
+    uint32_t size = 0;
+    uint32_t capacity = 0;
+};
+
+/**
+ * Process wide lru cache of filter luts keyed by (type, quantized intensity, bit depth), shared by cpu and gpu algos.
+ * Returned tables are immutable and stay valid after eviction.
+ */
+class LutCache {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 32;
+    static constexpr float INTENSITY_QUANTIZE_SCALE = 100.f; // intensities are quantized to 0.01
+    static constexpr uint32_t BIT_DEPTH_8 = 8;
+    static constexpr uint32_t BIT_DEPTH_10 = 10;
+
+    IMAGE_EFFECT_EXPORT static LutCache &Instance();
+
+    IMAGE_EFFECT_EXPORT LutTablePtr GetLut(LutType type, float intensity, uint32_t bitDepth);
+
+    IMAGE_EFFECT_EXPORT void SetCapacity(uint32_t capacity);
+
+    IMAGE_EFFECT_EXPORT LutCacheStats GetStats();
+
+    IMAGE_EFFECT_EXPORT void Clear();
+
+    IMAGE_EFFECT_EXPORT static float QuantizeIntensity(float intensity);
+
+    IMAGE_EFFECT_EXPORT static LutTablePtr CreateLut(LutType type, float intensity, uint32_t bitDepth);
+
+private:
+    LutCache() = default;
+    ~LutCache() = default;
+    LutCache(const LutCache &) = delete;
+    LutCache &operator = (const LutCache &) = delete;
+
+    void TrimLocked();
+
+    using LruList = std::list<std::pair<uint64_t, LutTablePtr>>;
+
+    std::mutex mutex_;
+    LruList lru_;
+    std::unordered_map<uint64_t, LruList::iterator> index_;
+    uint32_t capacity_ = DEFAULT_CAPACITY;
+    std::atomic<uint64_t> hitCount_ = 0;
+    std::atomic<uint64_t> missCount_ = 0;
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_LUT_CACHE_H
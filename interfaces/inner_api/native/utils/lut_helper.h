@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_LUT_HELPER_H
+#define IMAGE_EFFECT_LUT_HELPER_H
+
+#include <cstdint>
+
+#include "cpu_feature_helper.h"
+#include "effect_buffer.h"
+#include "effect_info.h"
+#include "error_code.h"
+#include "image_effect_marco_define.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+constexpr uint32_t LUT_8BIT_SIZE = 256;
+constexpr uint32_t LUT_10BIT_SIZE = 1024;
+
+struct LutPlaneInfo {
+    uint8_t *data = nullptr;
+    uint32_t rowStride = 0;
+};
+
+struct LutYuvPlaneInfo {
+    LutPlaneInfo y;
+    LutPlaneInfo uv;
+};
+
+class LutHelper {
+public:
+    /**
+     * Map the r/g/b channels of a RGBA8888 image through an 8-bit lut and keep alpha untouched.
+     * Rows are processed in parallel, src and dst may alias. The kernel is chosen from the cpu at runtime.
+     */
+    IMAGE_EFFECT_EXPORT static void ApplyRGBA8888(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width,
+        uint32_t height, const uint8_t *lut);
+
+    /**
+     * Same as above but forces the kernel level. Falls back to SCALAR when the level is not supported.
+     */
+    IMAGE_EFFECT_EXPORT static void ApplyRGBA8888(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width,
+        uint32_t height, const uint8_t *lut, SimdLevel level);
+
+    /**
+     * Apply a rgb lut to a NV12/NV21 image without leaving the yuv domain. Every 2x2 luma block shares its chroma
+     * sample: the chroma offsets are computed once per block and the block's new chroma is the mean of its four
+     * mapped pixels, written exactly once. Block rows are processed in parallel, src and dst may alias.
+     */
+    IMAGE_EFFECT_EXPORT static void ApplyYUV420SP(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst,
+        uint32_t width, uint32_t height, const uint8_t *lut, IEffectFormat format);
+
+    /**
+     * Check the planes of a NV12/NV21 buffer pair against their row stride and length, then apply the lut.
+     * A zero row stride means the rows are packed.
+     */
+    IMAGE_EFFECT_EXPORT static ErrorCode ApplyYUV420SP(EffectBuffer *src, EffectBuffer *dst, const uint8_t *lut,
+        IEffectFormat format);
+
+    /**
+     * Map the r/g/b channels of a RGBA_1010102 image through a 10-bit lut and keep the 2-bit alpha untouched.
+     * Rows are processed in parallel, src and dst may alias.
+     */
+    IMAGE_EFFECT_EXPORT static void ApplyRGBA1010102(const LutPlaneInfo &src, const LutPlaneInfo &dst, uint32_t width,
+        uint32_t height, const uint16_t *lut);
+
+    /**
+     * 10-bit version of ApplyYUV420SP for YCBCR_P010/YCRCB_P010, the row strides are in bytes.
+     */
+    IMAGE_EFFECT_EXPORT static void ApplyP010(const LutYuvPlaneInfo &src, const LutYuvPlaneInfo &dst, uint32_t width,
+        uint32_t height, const uint16_t *lut, IEffectFormat format);
+
+    IMAGE_EFFECT_EXPORT static ErrorCode ApplyP010(EffectBuffer *src, EffectBuffer *dst, const uint16_t *lut,
+        IEffectFormat format);
+
+    IMAGE_EFFECT_EXPORT static void ApplyRowRGBA8888(const uint8_t *src, uint8_t *dst, uint32_t width,
+        const uint8_t *lut, SimdLevel level);
+};
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+#endif // IMAGE_EFFECT_LUT_HELPER_H
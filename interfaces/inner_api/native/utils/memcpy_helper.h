@@ -16,11 +16,14 @@
 #ifndef IMAGE_EFFECT_MEMCPY_HELPER_H
 #define IMAGE_EFFECT_MEMCPY_HELPER_H
 
+#include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include "effect_info.h"
 #include "effect_buffer.h"
 #include "effect_memory.h"
+#include "error_code.h"
 #include "image_effect_marco_define.h"
 
 namespace OHOS {
@@ -31,14 +34,48 @@ struct CopyInfo {
     uint8_t *data = nullptr;
 };
 
+struct CopyPlane {
+    uint8_t *data = nullptr;
+    uint32_t rowStride = 0;
+    uint32_t rowBytes = 0; // bytes of valid data in each row
+    uint32_t rows = 0;
+};
+
+struct CopyPolicy {
+    size_t parallelThreshold = 2 * 1024 * 1024; // copies from this size on are split across the copy workers
+    size_t nonTemporalThreshold = 0; // copies from this size on bypass the cache, 0 means the last level cache size
+    uint32_t maxWorkers = 4; // memory bandwidth saturates with a few threads, the caller thread counts as one
+};
+
 class MemcpyHelper {
 public:
-    IMAGE_EFFECT_EXPORT static void CopyData(CopyInfo &src, CopyInfo &dst);
-    IMAGE_EFFECT_EXPORT static void CopyData(EffectBuffer *src, EffectBuffer *dst);
-    IMAGE_EFFECT_EXPORT static void CopyData(EffectBuffer *src, CopyInfo &dst);
-    IMAGE_EFFECT_EXPORT static void CopyData(CopyInfo &src, EffectBuffer *dst);
-    IMAGE_EFFECT_EXPORT static void CopyData(EffectBuffer *buffer, MemoryData *memoryData);
-    IMAGE_EFFECT_EXPORT static void CopyData(MemoryData *src, MemoryData *dst);
+    /**
+     * Copies are done row by row when the strides differ. Large copies are split across a small worker pool and
+     * copies larger than the last level cache use non-temporal stores, see CopyPolicy. Returns ERR_MEMCPY_FAIL when a
+     * row does not fit its buffer or a copy fails.
+     */
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(CopyInfo &src, CopyInfo &dst);
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(EffectBuffer *src, EffectBuffer *dst);
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(EffectBuffer *src, CopyInfo &dst);
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(CopyInfo &src, EffectBuffer *dst);
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(EffectBuffer *buffer, MemoryData *memoryData);
+    IMAGE_EFFECT_EXPORT static ErrorCode CopyData(MemoryData *src, MemoryData *dst);
+
+    /**
+     * Copy multi-plane layouts such as NV12/NV21/P010 surface buffers whose planes have their own offsets and
+     * strides. Plane i of src goes to plane i of dst, all planes are copied in one parallel pass.
+     */
+    IMAGE_EFFECT_EXPORT
+    static ErrorCode CopyPlanes(const std::vector<CopyPlane> &src, const std::vector<CopyPlane> &dst);
+
+    /**
+     * Faults in every page of a freshly allocated buffer by writing to it, split across the copy workers like a large
+     * copy, so that the first filter pass does not stall on page faults.
+     */
+    IMAGE_EFFECT_EXPORT static void PrefaultPages(void *data, size_t len);
+
+    IMAGE_EFFECT_EXPORT static void SetCopyPolicy(const CopyPolicy &policy);
+    IMAGE_EFFECT_EXPORT static CopyPolicy GetCopyPolicy();
 };
 } // namespace Effect
 } // namespace Media
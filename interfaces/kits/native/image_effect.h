@@ -373,6 +373,72 @@ ImageEffect_ErrorCode OH_ImageEffect_SetOutputTextureId(OH_ImageEffect *imageEff
  */
 ImageEffect_ErrorCode OH_ImageEffect_Start(OH_ImageEffect *imageEffect);
 
+/**
+ * @brief Called when a render started by {@link OH_ImageEffect_StartAsync} completes
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @param errorCode EFFECT_SUCCESS if the filter effects were rendered into the output, EFFECT_RENDER_CANCELED if the
+ * render was canceled by {@link OH_ImageEffect_CancelAsync} before it started, otherwise a specific error code, refer
+ * to {@link ImageEffect_ErrorCode}
+ * @param userData Indicates the user data passed to {@link OH_ImageEffect_StartAsync}
+ * @since 21
+ */
+typedef void (*OH_ImageEffect_StartAsyncCallback)(OH_ImageEffect *imageEffect, ImageEffect_ErrorCode errorCode,
+    void *userData);
+
+/**
+ * @brief Render the filter effects asynchronously. The render is queued on the render thread of the OH_ImageEffect
+ * and the function returns at once, the result is delivered through the callback on the render thread. The input and
+ * output must not be changed until the callback has been called. Renders of the surface or texture input are not
+ * supported, use {@link OH_ImageEffect_Start} for them. {@link OH_ImageEffect_Release} cancels the queued renders and
+ * waits for their callbacks, so it must not be called from a callback
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @param callback Indicates the callback function called once the render completes. See
+ * {@link OH_ImageEffect_StartAsyncCallback}
+ * @param userData Indicates the user data passed to the callback
+ * @return Returns EFFECT_SUCCESS if the render is queued, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_StartAsync(OH_ImageEffect *imageEffect, OH_ImageEffect_StartAsyncCallback callback,
+    void *userData);
+
+/**
+ * @brief Cancel the renders queued by {@link OH_ImageEffect_StartAsync} that have not started yet, their callbacks
+ * are called with EFFECT_RENDER_CANCELED
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @return Returns EFFECT_SUCCESS if the execution is successful, otherwise returns a specific error code, refer to
+ * {@link ImageEffect_ErrorCode}
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_CancelAsync(OH_ImageEffect *imageEffect);
+
+/**
+ * @brief Render the filter effects of the OH_ImageEffect into a list of image files, each input file is rendered into
+ * the output file at the same index. Up to maxConcurrency files are in flight at a time, each on a copy of the filter
+ * chain, so that decoding, rendering and encoding of different files overlap. The function returns once every file
+ * is done, the input and output set on the OH_ImageEffect are left unchanged
+ *
+ * @syscap SystemCapability.Multimedia.ImageEffect.Core
+ * @param imageEffect Encapsulate OH_ImageEffect structure instance pointer
+ * @param inputPaths Indicates the paths of the input image files, only jpg/jpeg and heif are supported
+ * @param outputPaths Indicates the paths of the output image files
+ * @param count Indicates the number of files, the length of inputPaths, outputPaths and results
+ * @param maxConcurrency Indicates the number of files in flight at a time, from 1 to 8
+ * @param results Indicates the result of each file, EFFECT_SUCCESS if the file is rendered, otherwise a specific error
+ * code, refer to {@link ImageEffect_ErrorCode}
+ * @return Returns EFFECT_SUCCESS if the files are rendered, the result of each file is in results, otherwise returns
+ * a specific error code, refer to {@link ImageEffect_ErrorCode}
+ * @since 21
+ */
+ImageEffect_ErrorCode OH_ImageEffect_StartBatch(OH_ImageEffect *imageEffect, const char **inputPaths,
+    const char **outputPaths, uint32_t count, uint32_t maxConcurrency, ImageEffect_ErrorCode *results);
+
 /**
  * @brief Stop rendering the filter effects for next image frame data
  *
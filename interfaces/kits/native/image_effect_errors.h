@@ -83,6 +83,12 @@ typedef enum ImageEffect_ErrorCode {
      * Allocate memory fail. For example, over sized image resource.
      */
     EFFECT_ALLOCATE_MEMORY_FAILED = 29000104,
+    /**
+     * The asynchronous render was canceled before it started.
+     *
+     * @since 21
+     */
+    EFFECT_RENDER_CANCELED = 29000105,
     /**
      * Parameter error. For example, the invalid value set for filter.
      */
@@ -18,6 +18,8 @@
 #include "effect_buffer.h"
 #include "any.h"
 #include "effect_context.h"
+#include "format_helper.h"
+#include "lut_cache.h"
 #include "securec.h"
 
 using namespace testing::ext;
@@ -30,6 +32,7 @@ namespace Test {
 constexpr uint32_t BYTES_PER_INT = 4;
 constexpr uint8_t DEFAULT_PIXEL_VALUE = 128;
 constexpr uint32_t MAX_BUFFER_SIZE = 100 * 1024 * 1024;
+constexpr uint32_t YUV_BLOCK_SIZE = 2;
 
 class TestCpuContrastAlgo : public testing::Test {
 public:
@@ -376,7 +379,168 @@ HWTEST_F(TestCpuContrastAlgo, OnApplyRGBA8888013, TestSize.Level1)
     ReleaseEffectBuffer(dst);
 }
 
+HWTEST_F(TestCpuContrastAlgo, OnApplyYUVNV21001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t rowStride = 128;
+    uint32_t len = rowStride * (height + height / 2);
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(dst, nullptr);
+    auto *srcData = static_cast<uint8_t *>(src->buffer_);
+    for (uint32_t i = 0; i < len; ++i) {
+        srcData[i] = static_cast<uint8_t>((i * 37 + i / rowStride * 11) & 0xFF); // 37, 11: arbitrary pattern steps
+    }
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+
+    std::shared_ptr<EffectContext> context = nullptr;
+
+    ErrorCode result = CpuContrastAlgo::OnApplyYUVNV21(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // Per 2x2 block reference: map each pixel through the lut, the block's mean gives its chroma sample.
+    LutTablePtr lut = LutCache::Instance().GetLut(LutType::CONTRAST, 50.0f, LutCache::BIT_DEPTH_8);
+    ASSERT_NE(lut, nullptr);
+    auto *dstData = static_cast<uint8_t *>(dst->buffer_);
+    uint32_t uvOffset = rowStride * height;
+    for (uint32_t by = 0; by < height; by += YUV_BLOCK_SIZE) {
+        for (uint32_t bx = 0; bx < width; bx += YUV_BLOCK_SIZE) {
+            uint32_t vuIndex = uvOffset + by / YUV_BLOCK_SIZE * rowStride + bx;
+            uint8_t v = srcData[vuIndex];
+            uint8_t u = srcData[vuIndex + 1];
+            uint32_t sumR = 0;
+            uint32_t sumG = 0;
+            uint32_t sumB = 0;
+            for (uint32_t y = by; y < by + YUV_BLOCK_SIZE; ++y) {
+                for (uint32_t x = bx; x < bx + YUV_BLOCK_SIZE; ++x) {
+                    uint8_t luma = srcData[y * rowStride + x];
+                    uint8_t r = lut->lut8[FormatHelper::YuvToR(luma, u, v)];
+                    uint8_t g = lut->lut8[FormatHelper::YuvToG(luma, u, v)];
+                    uint8_t b = lut->lut8[FormatHelper::YuvToB(luma, u, v)];
+                    ASSERT_EQ(dstData[y * rowStride + x], FormatHelper::RGBToY(r, g, b)) << "x=" << x << " y=" << y;
+                    sumR += r;
+                    sumG += g;
+                    sumB += b;
+                }
+            }
+            uint32_t count = YUV_BLOCK_SIZE * YUV_BLOCK_SIZE;
+            uint8_t r = static_cast<uint8_t>((sumR + count / YUV_BLOCK_SIZE) / count);
+            uint8_t g = static_cast<uint8_t>((sumG + count / YUV_BLOCK_SIZE) / count);
+            uint8_t b = static_cast<uint8_t>((sumB + count / YUV_BLOCK_SIZE) / count);
+            ASSERT_EQ(dstData[vuIndex], FormatHelper::RGBToV(r, g, b)) << "bx=" << bx << " by=" << by;
+            ASSERT_EQ(dstData[vuIndex + 1], FormatHelper::RGBToU(r, g, b)) << "bx=" << bx << " by=" << by;
+        }
+    }
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+HWTEST_F(TestCpuContrastAlgo, OnApplyYUVNV12001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t rowStride = 128;
+    uint32_t len = rowStride * (height + height / 2);
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len - 1, rowStride);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(dst, nullptr);
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+
+    std::shared_ptr<EffectContext> context = nullptr;
+
+    ErrorCode result = CpuContrastAlgo::OnApplyYUVNV12(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+HWTEST_F(TestCpuContrastAlgo, OnApplyRGBA1010102001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t rowStride = width * BYTES_PER_INT + BYTES_PER_INT;
+    uint32_t len = rowStride * height;
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(dst, nullptr);
+    uint32_t pixel = FormatHelper::PackRGBA1010102(100, 512, 900, 2); // 2 is a non opaque alpha
+    for (uint32_t y = 0; y < height; ++y) {
+        auto *row = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(src->buffer_) + y * rowStride);
+        for (uint32_t x = 0; x < width; ++x) {
+            row[x] = pixel;
+        }
+    }
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+    std::shared_ptr<EffectContext> context = nullptr;
+    ErrorCode result = CpuContrastAlgo::OnApplyRGBA1010102(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    LutTablePtr lut = LutCache::Instance().GetLut(LutType::CONTRAST, 50.0f, LutCache::BIT_DEPTH_10);
+    ASSERT_NE(lut, nullptr);
+    uint32_t expect = FormatHelper::PackRGBA1010102(lut->lut16[100], lut->lut16[512], lut->lut16[900], 2);
+    auto *lastRow = reinterpret_cast<uint32_t *>(static_cast<uint8_t *>(dst->buffer_) + (height - 1) * rowStride);
+    EXPECT_EQ(lastRow[width - 1], expect);
+    EXPECT_NE(lastRow[width - 1], pixel);
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+HWTEST_F(TestCpuContrastAlgo, OnApplyYCBCRP010001, TestSize.Level1)
+{
+    uint32_t width = 100;
+    uint32_t height = 100;
+    uint32_t rowStride = width * sizeof(uint16_t);
+    uint32_t len = rowStride * (height + height / 2);
+
+    EffectBuffer* src = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(src, nullptr);
+    EffectBuffer* dst = CreateEffectBuffer(width, height, len, rowStride);
+    ASSERT_NE(dst, nullptr);
+    // A neutral gray: luma goes through the lut, chroma stays centered.
+    auto *samples = static_cast<uint16_t *>(src->buffer_);
+    for (uint32_t i = 0; i < len / sizeof(uint16_t); ++i) {
+        samples[i] = FormatHelper::ToP010Word(i < width * height ? 200 : 512);
+    }
+
+    std::map<std::string, Any> value;
+    value["FilterIntensity"] = 50.0f;
+    std::shared_ptr<EffectContext> context = nullptr;
+    ErrorCode result = CpuContrastAlgo::OnApplyYCBCRP010(src, dst, value, context);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    LutTablePtr lut = LutCache::Instance().GetLut(LutType::CONTRAST, 50.0f, LutCache::BIT_DEPTH_10);
+    ASSERT_NE(lut, nullptr);
+    uint16_t mapped = lut->lut16[200];
+    auto *out = static_cast<uint16_t *>(dst->buffer_);
+    EXPECT_EQ(FormatHelper::GetP010Sample(out[0]), FormatHelper::RGB10ToY(mapped, mapped, mapped));
+    EXPECT_EQ(FormatHelper::GetP010Sample(out[width * height]), FormatHelper::RGB10ToU(mapped, mapped, mapped));
+    EXPECT_EQ(FormatHelper::GetP010Sample(out[width * height + 1]), FormatHelper::RGB10ToV(mapped, mapped, mapped));
+
+    src->bufferInfo_->len_ = len - 1;
+    result = CpuContrastAlgo::OnApplyYCBCRP010(src, dst, value, context);
+    EXPECT_EQ(result, ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+
+    ReleaseEffectBuffer(src);
+    ReleaseEffectBuffer(dst);
+}
+
+}
 }
 }
 }
-}
\ No newline at end of file
@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "crop_efilter.h"
+#include "effect_context.h"
+#include "efilter_factory.h"
+#include "test_common.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t P010_BYTES_PER_SAMPLE = 2;
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 48;
+constexpr uint32_t ROW_PADDING = 16;
+
+std::shared_ptr<EffectBuffer> CreateBuffer(std::vector<uint8_t> &data, uint32_t width, uint32_t height,
+    uint32_t rowStride, IEffectFormat format)
+{
+    auto bufferInfo = std::make_shared<BufferInfo>();
+    bufferInfo->width_ = width;
+    bufferInfo->height_ = height;
+    bufferInfo->rowStride_ = rowStride;
+    bufferInfo->len_ = static_cast<uint32_t>(data.size());
+    bufferInfo->formatType_ = format;
+    auto extraInfo = std::make_shared<ExtraInfo>();
+    extraInfo->dataType = DataType::PIXEL_MAP;
+    return std::make_shared<EffectBuffer>(bufferInfo, data.data(), extraInfo);
+}
+
+std::vector<uint8_t> CreatePixels(size_t size)
+{
+    std::vector<uint8_t> pixels(size);
+    for (size_t idx = 0; idx < pixels.size(); idx++) {
+        pixels[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+    return pixels;
+}
+
+std::shared_ptr<EFilter> CreateCropEFilter(uint32_t *areaInfo)
+{
+    std::shared_ptr<EFilter> crop = EFilterFactory::Instance()->Create(CROP_EFILTER);
+    if (crop != nullptr) {
+        Any region = static_cast<void *>(areaInfo);
+        crop->SetValue(KEY_FILTER_REGION, region);
+    }
+    return crop;
+}
+
+void ExpectSamePlane(const uint8_t *actual, uint32_t actualStride, const uint8_t *expected, uint32_t expectedStride,
+    uint32_t rowBytes, uint32_t rows)
+{
+    for (uint32_t row = 0; row < rows; row++) {
+        for (uint32_t col = 0; col < rowBytes; col++) {
+            ASSERT_EQ(actual[row * actualStride + col], expected[row * expectedStride + col]) << "row " << row <<
+                " col " << col;
+        }
+    }
+}
+
+void CheckYuvCrop(IEffectFormat format, uint32_t sampleBytes, std::shared_ptr<EffectContext> &context)
+{
+    uint32_t areaInfo[] = { 3, 5, 35, 27 }; // x0, y0, x1, y1: odd corner must move to the even one (2, 4)
+    std::shared_ptr<EFilter> crop = CreateCropEFilter(areaInfo);
+    ASSERT_NE(crop, nullptr);
+
+    std::shared_ptr<MemNegotiatedCap> input = std::make_shared<MemNegotiatedCap>();
+    input->width = WIDTH;
+    input->height = HEIGHT;
+    input->format = format;
+    std::shared_ptr<MemNegotiatedCap> output = crop->Negotiate(input, context);
+    ASSERT_NE(output, nullptr);
+    ASSERT_EQ(output->width, 32u); // 32: (35 - 2) aligned down to even
+    ASSERT_EQ(output->height, 22u); // 22: (27 - 4) aligned down to even
+
+    uint32_t srcStride = WIDTH * sampleBytes + ROW_PADDING;
+    std::vector<uint8_t> src = CreatePixels(srcStride * HEIGHT * 3 / 2); // 3 / 2: y plane and half height uv plane
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateBuffer(src, WIDTH, HEIGHT, srcStride, format);
+    uint32_t dstStride = output->width * sampleBytes;
+    std::vector<uint8_t> dst(dstStride * output->height * 3 / 2, 0);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateBuffer(dst, output->width, output->height, dstStride, format);
+    ASSERT_EQ(crop->Render(srcBuffer.get(), dstBuffer.get(), context), ErrorCode::SUCCESS);
+
+    const uint32_t left = 2;
+    const uint32_t top = 4;
+    ExpectSamePlane(dst.data(), dstStride, src.data() + top * srcStride + left * sampleBytes, srcStride, dstStride,
+        output->height);
+    ExpectSamePlane(dst.data() + dstStride * output->height, dstStride,
+        src.data() + srcStride * HEIGHT + top / 2 * srcStride + left * sampleBytes, srcStride, dstStride,
+        output->height / 2);
+}
+} // namespace
+
+class TestCropEFilter : public testing::Test {
+public:
+    TestCropEFilter() = default;
+
+    ~TestCropEFilter() override = default;
+
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        context_ = std::make_shared<EffectContext>();
+        context_->ipType_ = IPType::CPU;
+        context_->metaInfoNegotiate_ = std::make_shared<EfilterMetaInfoNegotiate>();
+        context_->renderStrategy_ = std::make_shared<RenderStrategy>();
+    }
+
+    void TearDown() override
+    {
+        context_ = nullptr;
+    }
+
+    std::shared_ptr<EffectContext> context_;
+};
+
+HWTEST_F(TestCropEFilter, CreateCropView001, TestSize.Level1)
+{
+    uint32_t areaInfo[] = { 10, 7, 42, 31 }; // x0, y0, x1, y1
+    std::shared_ptr<EFilter> efilter = CreateCropEFilter(areaInfo);
+    ASSERT_NE(efilter, nullptr);
+    auto *crop = static_cast<CropEFilter *>(efilter.get());
+
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint8_t> src = CreatePixels(rowStride * HEIGHT);
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateBuffer(src, WIDTH, HEIGHT, rowStride, IEffectFormat::RGBA8888);
+    std::shared_ptr<EffectBuffer> view = crop->CreateCropView(srcBuffer.get());
+    ASSERT_NE(view, nullptr);
+    EXPECT_TRUE(view->isView_);
+    EXPECT_EQ(view->buffer_, src.data() + 7 * rowStride + 10 * RGBA_BYTES_PER_PIXEL);
+    EXPECT_EQ(view->bufferInfo_->width_, 32u);
+    EXPECT_EQ(view->bufferInfo_->height_, 24u);
+    EXPECT_EQ(view->bufferInfo_->rowStride_, rowStride);
+    EXPECT_LE(static_cast<uint8_t *>(view->buffer_) + view->bufferInfo_->len_, src.data() + src.size());
+
+    // a view into the input must never be picked as the render target while an output is set.
+    std::vector<uint8_t> dst(WIDTH * RGBA_BYTES_PER_PIXEL * HEIGHT, 0);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateBuffer(dst, WIDTH, HEIGHT, WIDTH * RGBA_BYTES_PER_PIXEL,
+        IEffectFormat::RGBA8888);
+    context_->renderStrategy_->Init(srcBuffer, dstBuffer);
+    std::shared_ptr<MemNegotiatedCap> cap = std::make_shared<MemNegotiatedCap>();
+    cap->width = view->bufferInfo_->width_;
+    cap->height = view->bufferInfo_->height_;
+    EXPECT_EQ(context_->renderStrategy_->ChooseBestOutput(view.get(), cap), nullptr);
+}
+
+HWTEST_F(TestCropEFilter, CreateCropView002, TestSize.Level1)
+{
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src = CreatePixels(rowStride * HEIGHT);
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateBuffer(src, WIDTH, HEIGHT, rowStride, IEffectFormat::RGBA8888);
+
+    // the whole image passes through untouched.
+    uint32_t fullArea[] = { 0, 0, WIDTH, HEIGHT };
+    std::shared_ptr<EFilter> efilter = CreateCropEFilter(fullArea);
+    ASSERT_NE(efilter, nullptr);
+    std::shared_ptr<EffectBuffer> output = static_cast<CropEFilter *>(efilter.get())->CreateCropView(srcBuffer.get());
+    ASSERT_NE(output, nullptr);
+    EXPECT_FALSE(output->isView_);
+    EXPECT_EQ(output->buffer_, src.data());
+
+    // the last row of a bottom right view would run past the source, so it has to be copied.
+    uint32_t bottomRightArea[] = { 8, 8, WIDTH, HEIGHT };
+    efilter = CreateCropEFilter(bottomRightArea);
+    ASSERT_NE(efilter, nullptr);
+    EXPECT_EQ(static_cast<CropEFilter *>(efilter.get())->CreateCropView(srcBuffer.get()), nullptr);
+
+    // yuv keeps copying.
+    std::shared_ptr<EffectBuffer> yuvBuffer = CreateBuffer(src, WIDTH, HEIGHT, WIDTH, IEffectFormat::YUVNV12);
+    EXPECT_EQ(static_cast<CropEFilter *>(efilter.get())->CreateCropView(yuvBuffer.get()), nullptr);
+}
+
+HWTEST_F(TestCropEFilter, RenderYuv001, TestSize.Level1)
+{
+    CheckYuvCrop(IEffectFormat::YUVNV12, 1, context_);
+    CheckYuvCrop(IEffectFormat::YUVNV21, 1, context_);
+}
+
+HWTEST_F(TestCropEFilter, RenderYuv002, TestSize.Level1)
+{
+    CheckYuvCrop(IEffectFormat::YCBCR_P010, P010_BYTES_PER_SAMPLE, context_);
+    CheckYuvCrop(IEffectFormat::YCRCB_P010, P010_BYTES_PER_SAMPLE, context_);
+}
+
+HWTEST_F(TestCropEFilter, RenderYuv003, TestSize.Level1)
+{
+    uint32_t areaInfo[] = { 4, 4, 5, 20 }; // x0, y0, x1, y1: one column wide, aligned down to nothing
+    std::shared_ptr<EFilter> crop = CreateCropEFilter(areaInfo);
+    ASSERT_NE(crop, nullptr);
+
+    std::vector<uint8_t> src = CreatePixels(WIDTH * HEIGHT * 3 / 2); // 3 / 2: y plane and half height uv plane
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateBuffer(src, WIDTH, HEIGHT, WIDTH, IEffectFormat::YUVNV12);
+    std::vector<uint8_t> dst(src.size(), 0);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateBuffer(dst, WIDTH, HEIGHT, WIDTH, IEffectFormat::YUVNV12);
+    EXPECT_EQ(crop->Render(srcBuffer.get(), dstBuffer.get(), context_), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+    EXPECT_EQ(crop->Render(srcBuffer.get(), context_), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+
+#include "effect_memory.h"
+#include "effect_memory_accountant.h"
+#include "effect_memory_pool.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t LEN = WIDTH * HEIGHT * RGBA_BYTES_PER_PIXEL;
+constexpr std::chrono::milliseconds RELEASE_DELAY = std::chrono::milliseconds(50);
+constexpr std::chrono::milliseconds SHORT_TIMEOUT = std::chrono::milliseconds(10);
+constexpr std::chrono::milliseconds LONG_TIMEOUT = std::chrono::milliseconds(5000);
+
+MemoryInfo CreateMemoryInfo(uint32_t width, uint32_t height)
+{
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = width;
+    memoryInfo.bufferInfo.height_ = height;
+    memoryInfo.bufferInfo.len_ = width * height * RGBA_BYTES_PER_PIXEL;
+    memoryInfo.bufferInfo.formatType_ = IEffectFormat::RGBA8888;
+    return memoryInfo;
+}
+}
+
+class TestEffectMemoryAccountant : public testing::Test {
+public:
+    TestEffectMemoryAccountant() = default;
+    ~TestEffectMemoryAccountant() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        EffectMemoryPool::Instance().Clear();
+        baseBytes_ = EffectMemoryAccountant::Instance().GetStats().currentBytes;
+    }
+
+    void TearDown() override
+    {
+        EffectMemoryAccountant::Instance().SetConfig(MemoryBudgetConfig());
+        EffectMemoryPool::Instance().SetConfig(MemoryPoolConfig());
+        EffectMemoryPool::Instance().Clear();
+    }
+
+    // budget that leaves room for the given bytes on top of what the process already holds.
+    void SetBudget(uint64_t bytes, MemoryBudgetPolicy policy, std::chrono::milliseconds waitTimeout)
+    {
+        MemoryBudgetConfig config;
+        config.budgetBytes = baseBytes_ + bytes;
+        config.policy = policy;
+        config.waitTimeout = waitTimeout;
+        EffectMemoryAccountant::Instance().SetConfig(config);
+    }
+
+    uint64_t baseBytes_ = 0;
+};
+
+HWTEST_F(TestEffectMemoryAccountant, Reserve001, TestSize.Level1)
+{
+    EffectMemoryAccountant &accountant = EffectMemoryAccountant::Instance();
+    SetBudget(LEN * 2, MemoryBudgetPolicy::FAIL_FAST, SHORT_TIMEOUT);
+    accountant.ResetPeak();
+
+    HeapMemory heapMemory;
+    MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+    std::shared_ptr<MemoryData> memoryData = heapMemory.Alloc(memoryInfo);
+    ASSERT_NE(memoryData, nullptr);
+    EXPECT_EQ(accountant.GetStats().currentBytes, baseBytes_ + LEN);
+
+    MemoryReservation reservation;
+    EXPECT_TRUE(reservation.Acquire(LEN));
+    MemoryBudgetStats stats = accountant.GetStats();
+    EXPECT_EQ(stats.currentBytes, baseBytes_ + LEN * 2);
+    EXPECT_EQ(stats.peakBytes, baseBytes_ + LEN * 2);
+
+    // the budget is exhausted and nothing can be reclaimed.
+    HeapMemory otherMemory;
+    EXPECT_EQ(otherMemory.Alloc(memoryInfo), nullptr);
+    EXPECT_EQ(accountant.GetStats().rejectCount, stats.rejectCount + 1);
+
+    reservation.Reset();
+    EXPECT_EQ(heapMemory.Release(), ErrorCode::SUCCESS);
+    memoryData = nullptr;
+    stats = accountant.GetStats();
+    EXPECT_EQ(stats.currentBytes, baseBytes_);
+    EXPECT_EQ(stats.peakBytes, baseBytes_ + LEN * 2);
+}
+
+HWTEST_F(TestEffectMemoryAccountant, Reclaim001, TestSize.Level1)
+{
+    SetBudget(LEN * 2, MemoryBudgetPolicy::FAIL_FAST, SHORT_TIMEOUT);
+    MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+    std::shared_ptr<MemoryData> first = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::HEAP_MEMORY);
+    ASSERT_NE(first, nullptr);
+    first = nullptr;
+    EXPECT_EQ(EffectMemoryPool::Instance().GetStats().retainedCount, 1);
+
+    // a larger buffer only fits once the idle one of the pool has been dropped.
+    uint64_t reclaimedBytes = EffectMemoryAccountant::Instance().GetStats().reclaimedBytes;
+    MemoryInfo largeInfo = CreateMemoryInfo(WIDTH, HEIGHT * 2);
+    std::shared_ptr<MemoryData> large = EffectMemoryPool::Instance().Alloc(largeInfo, BufferType::HEAP_MEMORY);
+    ASSERT_NE(large, nullptr);
+    EXPECT_EQ(EffectMemoryPool::Instance().GetStats().retainedCount, 0);
+    EXPECT_EQ(EffectMemoryAccountant::Instance().GetStats().reclaimedBytes, reclaimedBytes + LEN);
+}
+
+HWTEST_F(TestEffectMemoryAccountant, Block001, TestSize.Level1)
+{
+    EffectMemoryAccountant &accountant = EffectMemoryAccountant::Instance();
+    SetBudget(LEN, MemoryBudgetPolicy::BLOCK, SHORT_TIMEOUT);
+    MemoryReservation holder;
+    ASSERT_TRUE(holder.Acquire(LEN));
+    MemoryReservation waiter;
+    EXPECT_FALSE(waiter.Acquire(LEN));
+
+    // a blocked reservation goes through as soon as another render releases its memory.
+    SetBudget(LEN, MemoryBudgetPolicy::BLOCK, LONG_TIMEOUT);
+    uint64_t waitCount = accountant.GetStats().waitCount;
+    std::thread releaser([&holder]() {
+        std::this_thread::sleep_for(RELEASE_DELAY);
+        holder.Reset();
+    });
+    EXPECT_TRUE(waiter.Acquire(LEN));
+    releaser.join();
+    EXPECT_EQ(accountant.GetStats().waitCount, waitCount + 1);
+    EXPECT_EQ(accountant.GetStats().currentBytes, baseBytes_ + LEN);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -15,7 +15,10 @@
 
 #include "gtest/gtest.h"
 
+#include "effect_buffer_planner.h"
 #include "effect_memory.h"
+#include "effect_memory_manager.h"
+#include "effect_memory_pool.h"
 
 using namespace testing::ext;
 
@@ -106,7 +109,221 @@ HWTEST_F(TestEffectMemoryManager, TestEffectMemoryManager001, TestSize.Level1) {
     delete effectMemory;
     effectMemory = nullptr;
 }
+
+HWTEST_F(TestEffectMemoryManager, TestEffectMemoryManager002, TestSize.Level1)
+{
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = WIDTH;
+    memoryInfo.bufferInfo.height_ = HEIGHT;
+    memoryInfo.bufferInfo.len_ = LEN;
+    memoryInfo.bufferInfo.formatType_ = FORMATE_TYPE;
+
+    // a filter chain ping-pongs between two memories, never writing into the one it reads from.
+    MemoryData *first = memoryManager.AllocMemory(nullptr, memoryInfo);
+    ASSERT_NE(first, nullptr);
+    MemoryData *second = memoryManager.AllocMemory(first->data, memoryInfo);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second, first);
+    EXPECT_EQ(memoryManager.AllocMemory(second->data, memoryInfo), first);
+    EXPECT_EQ(memoryManager.AllocMemory(first->data, memoryInfo), second);
+    auto *cropView = static_cast<uint8_t *>(second->data) + ROW_STRIDE;
+    EXPECT_EQ(memoryManager.AllocMemory(cropView, memoryInfo), first);
+    EXPECT_EQ(memoryManager.memorys_.size(), 2);
+
+    // other geometries and explicitly requested buffer types get their own memory.
+    MemoryInfo otherInfo = memoryInfo;
+    otherInfo.bufferInfo.height_ = HEIGHT / 2;
+    otherInfo.bufferInfo.len_ = LEN / 2;
+    MemoryData *other = memoryManager.AllocMemory(nullptr, otherInfo);
+    ASSERT_NE(other, nullptr);
+    EXPECT_NE(other, first);
+    EXPECT_NE(other, second);
+    MemoryInfo sharedInfo = memoryInfo;
+    sharedInfo.bufferType = BufferType::SHARED_MEMORY;
+    MemoryData *shared = memoryManager.AllocMemory(nullptr, sharedInfo);
+    if (shared != nullptr) {
+        EXPECT_EQ(shared->memoryInfo.bufferType, BufferType::SHARED_MEMORY);
+    }
+
+    // memories handed over to a pixel map are not reused.
+    first->memoryInfo.isAutoRelease = false;
+    second->memoryInfo.isAutoRelease = false;
+    MemoryData *third = memoryManager.AllocMemory(nullptr, memoryInfo);
+    ASSERT_NE(third, nullptr);
+    EXPECT_NE(third, first);
+    EXPECT_NE(third, second);
+    first->memoryInfo.isAutoRelease = true;
+    second->memoryInfo.isAutoRelease = true;
+
+    std::shared_ptr<Memory> memory = memoryManager.GetAllocMemoryByAddr(third->data);
+    ASSERT_NE(memory, nullptr);
+    memoryManager.RemoveMemory(memory);
+    EXPECT_EQ(memoryManager.GetMemoryByAddr(third->data), nullptr);
+    memoryManager.ClearMemory();
+    EXPECT_TRUE(memoryManager.memorys_.empty());
+    EXPECT_TRUE(memoryManager.freeMemorys_.empty());
+    EXPECT_TRUE(memoryManager.inUseMemorys_.empty());
+}
+
+HWTEST_F(TestEffectMemoryManager, TestEffectMemoryManager003, TestSize.Level1)
+{
+    constexpr uint32_t powerOfTwoWidth = 4096;
+    constexpr uint32_t cacheLine = 64;
+    constexpr uint32_t pageSize = 4096;
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = powerOfTwoWidth;
+    memoryInfo.bufferInfo.height_ = HEIGHT;
+    memoryInfo.bufferInfo.len_ = powerOfTwoWidth * 4 * HEIGHT;
+    memoryInfo.bufferInfo.formatType_ = FORMATE_TYPE;
+
+    HeapMemory packedMemory;
+    std::shared_ptr<MemoryData> packed = packedMemory.Alloc(memoryInfo);
+    ASSERT_NE(packed, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(packed->data) % cacheLine, 0);
+    EXPECT_EQ(packed->memoryInfo.bufferInfo.rowStride_, powerOfTwoWidth * 4);
+
+    // padded strides are cache line multiples that never land on a multiple of 4KB.
+    memoryInfo.rowStridePolicy = RowStridePolicy::SIMD_ALIGNED;
+    HeapMemory paddedMemory;
+    std::shared_ptr<MemoryData> padded = paddedMemory.Alloc(memoryInfo);
+    ASSERT_NE(padded, nullptr);
+    const BufferInfo &paddedInfo = padded->memoryInfo.bufferInfo;
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(padded->data) % cacheLine, 0);
+    EXPECT_GT(paddedInfo.rowStride_, powerOfTwoWidth * 4);
+    EXPECT_EQ(paddedInfo.rowStride_ % cacheLine, 0);
+    EXPECT_NE(paddedInfo.rowStride_ % pageSize, 0);
+    EXPECT_GE(paddedInfo.len_, paddedInfo.rowStride_ * HEIGHT);
+
+    // a packed request, which may end up in a pixel map, never gets a padded memory of the manager.
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    MemoryData *paddedData = memoryManager.AllocMemory(nullptr, memoryInfo);
+    ASSERT_NE(paddedData, nullptr);
+    EXPECT_EQ(paddedData->memoryInfo.bufferInfo.rowStride_, paddedInfo.rowStride_);
+    memoryInfo.rowStridePolicy = RowStridePolicy::PACKED;
+    MemoryData *packedData = memoryManager.AllocMemory(nullptr, memoryInfo);
+    ASSERT_NE(packedData, nullptr);
+    EXPECT_NE(packedData, paddedData);
+    EXPECT_EQ(packedData->memoryInfo.bufferInfo.rowStride_, powerOfTwoWidth * 4);
+    memoryManager.ClearMemory();
+}
+
+HWTEST_F(TestEffectMemoryManager, TestEffectMemoryManager004, TestSize.Level1)
+{
+    // ten filters alternating between two crops and in place adjustments.
+    constexpr uint32_t stepCount = 10;
+    constexpr uint32_t cropWidth = WIDTH / 2;
+    constexpr uint32_t cropHeight = HEIGHT / 2;
+    std::vector<BufferPlanStep> steps;
+    for (uint32_t idx = 0; idx < stepCount; idx++) {
+        bool isCropped = (idx / 2) % 2 == 0;
+        steps.push_back({ isCropped ? cropWidth : WIDTH, isCropped ? cropHeight : HEIGHT, FORMATE_TYPE });
+    }
+    BufferPlan plan = BufferPlanner::Plan({ WIDTH, HEIGHT, FORMATE_TYPE }, steps);
+    ASSERT_EQ(plan.steps.size(), stepCount);
+    EXPECT_EQ(plan.slotCapacities.size(), 2);
+    EXPECT_LE(plan.GetPlannedBytes(), 2 * BufferPlanner::CalculateBytes(WIDTH, HEIGHT, FORMATE_TYPE));
+    EXPECT_FALSE(plan.steps[0].isInPlace);
+    EXPECT_TRUE(plan.steps[1].isInPlace);
+    EXPECT_EQ(plan.steps[1].slot, plan.steps[0].slot);
+    EXPECT_NE(plan.steps[2].slot, plan.steps[0].slot);
+
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    memoryManager.SetBufferPlan(plan);
+    void *srcAddr = buffer;
+    std::vector<void *> frameAddrs;
+    for (const auto &step : plan.steps) {
+        if (step.isInPlace) {
+            continue;
+        }
+        MemoryInfo memoryInfo;
+        memoryInfo.bufferInfo.width_ = step.width;
+        memoryInfo.bufferInfo.height_ = step.height;
+        memoryInfo.bufferInfo.len_ = step.width * 4 * step.height;
+        memoryInfo.bufferInfo.formatType_ = step.format;
+        memoryInfo.rowStridePolicy = RowStridePolicy::SIMD_ALIGNED;
+        MemoryData *memoryData = memoryManager.AllocMemory(srcAddr, memoryInfo);
+        ASSERT_NE(memoryData, nullptr);
+        EXPECT_NE(memoryData->data, srcAddr);
+        EXPECT_EQ(memoryData->memoryInfo.bufferInfo.width_, step.width);
+        EXPECT_GE(memoryData->memoryInfo.bufferInfo.len_,
+            memoryData->memoryInfo.bufferInfo.rowStride_ * step.height);
+        srcAddr = memoryData->data;
+        frameAddrs.emplace_back(srcAddr);
+    }
+    EXPECT_EQ(memoryManager.memorys_.size(), 2);
+
+    // the same chain on the next frame keeps its slots.
+    memoryManager.SetBufferPlan(BufferPlanner::Plan({ WIDTH, HEIGHT, FORMATE_TYPE }, steps));
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = cropWidth;
+    memoryInfo.bufferInfo.height_ = cropHeight;
+    memoryInfo.bufferInfo.len_ = cropWidth * 4 * cropHeight;
+    memoryInfo.bufferInfo.formatType_ = FORMATE_TYPE;
+    MemoryData *memoryData = memoryManager.AllocMemory(buffer, memoryInfo);
+    ASSERT_NE(memoryData, nullptr);
+    EXPECT_NE(std::find(frameAddrs.begin(), frameAddrs.end(), memoryData->data), frameAddrs.end());
+    EXPECT_EQ(memoryManager.memorys_.size(), 2);
+
+    memoryManager.SetBufferPlan(BufferPlan());
+    EXPECT_TRUE(memoryManager.memorys_.empty());
+    memoryManager.ClearMemory();
+}
+
+HWTEST_F(TestEffectMemoryManager, TestEffectMemoryManager005, TestSize.Level1)
+{
+    constexpr size_t hugePageSize = 2 * 1024 * 1024;
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = WIDTH;
+    memoryInfo.bufferInfo.height_ = HEIGHT;
+    memoryInfo.bufferInfo.len_ = LEN;
+    memoryInfo.bufferInfo.formatType_ = FORMATE_TYPE;
+    memoryInfo.largeHeapPolicy.isHugePageEnabled = true;
+    memoryInfo.largeHeapPolicy.isPrefaultEnabled = true;
+    memoryInfo.largeHeapPolicy.threshold = LEN;
+
+    HeapMemory mappedMemory;
+    std::shared_ptr<MemoryData> mapped = mappedMemory.Alloc(memoryInfo);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_TRUE(mapped->memoryInfo.isMapped);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(mapped->data) % hugePageSize, 0);
+    EXPECT_EQ(static_cast<uint8_t *>(mapped->data)[LEN - 1], 0);
+    EXPECT_EQ(mappedMemory.Release(), ErrorCode::SUCCESS);
+
+    // a buffer that a pixel map takes over stays a malloc block.
+    memoryInfo.isAutoRelease = false;
+    HeapMemory ownedMemory;
+    std::shared_ptr<MemoryData> owned = ownedMemory.Alloc(memoryInfo);
+    ASSERT_NE(owned, nullptr);
+    EXPECT_FALSE(owned->memoryInfo.isMapped);
+    EXPECT_EQ(ownedMemory.Release(), ErrorCode::SUCCESS);
+
+    // below the threshold the policy does not apply.
+    memoryInfo.isAutoRelease = true;
+    memoryInfo.largeHeapPolicy.threshold = LEN + 1;
+    HeapMemory smallMemory;
+    std::shared_ptr<MemoryData> small = smallMemory.Alloc(memoryInfo);
+    ASSERT_NE(small, nullptr);
+    EXPECT_FALSE(small->memoryInfo.isMapped);
+    EXPECT_EQ(smallMemory.Release(), ErrorCode::SUCCESS);
+
+    // the pool would hand out an idle buffer of an earlier case instead of allocating one.
+    EffectMemoryPool::Instance().Clear();
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    memoryManager.SetLargeHeapPolicy(mapped->memoryInfo.largeHeapPolicy);
+    EXPECT_TRUE(memoryManager.GetLargeHeapPolicy().isHugePageEnabled);
+    MemoryInfo allocInfo = memoryInfo;
+    allocInfo.largeHeapPolicy = LargeHeapPolicy();
+    MemoryData *memoryData = memoryManager.AllocMemory(nullptr, allocInfo);
+    ASSERT_NE(memoryData, nullptr);
+    EXPECT_TRUE(memoryData->memoryInfo.isMapped);
+    memoryManager.ClearMemory();
+}
+}
 }
 }
 }
-}
\ No newline at end of file
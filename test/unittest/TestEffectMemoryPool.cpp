@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+
+#include "effect_memory_manager.h"
+#include "effect_memory_pool.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WIDTH = 64;
+constexpr uint32_t HEIGHT = 32;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t LEN = WIDTH * HEIGHT * RGBA_BYTES_PER_PIXEL;
+constexpr uint32_t THREAD_NUM = 8;
+constexpr uint32_t LOOP_NUM = 100;
+
+MemoryInfo CreateMemoryInfo(uint32_t width, uint32_t height)
+{
+    MemoryInfo memoryInfo;
+    memoryInfo.bufferInfo.width_ = width;
+    memoryInfo.bufferInfo.height_ = height;
+    memoryInfo.bufferInfo.len_ = width * height * RGBA_BYTES_PER_PIXEL;
+    memoryInfo.bufferInfo.formatType_ = IEffectFormat::RGBA8888;
+    return memoryInfo;
+}
+}
+
+class TestEffectMemoryPool : public testing::Test {
+public:
+    TestEffectMemoryPool() = default;
+    ~TestEffectMemoryPool() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        EffectMemoryPool::Instance().SetConfig(MemoryPoolConfig());
+        EffectMemoryPool::Instance().Clear();
+    }
+
+    void TearDown() override
+    {
+        EffectMemoryPool::Instance().SetConfig(MemoryPoolConfig());
+        EffectMemoryPool::Instance().Clear();
+    }
+};
+
+HWTEST_F(TestEffectMemoryPool, Alloc001, TestSize.Level1)
+{
+    MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+    std::shared_ptr<MemoryData> first = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::HEAP_MEMORY);
+    ASSERT_NE(first, nullptr);
+    void *addr = first->data;
+    EXPECT_EQ(first->memoryInfo.bufferInfo.rowStride_, WIDTH * RGBA_BYTES_PER_PIXEL);
+    first = nullptr;
+
+    MemoryPoolStats stats = EffectMemoryPool::Instance().GetStats();
+    EXPECT_EQ(stats.retainedCount, 1);
+    EXPECT_EQ(stats.retainedBytes, LEN);
+
+    // A different stride with the same byte size does not reuse the idle buffer, the same type, size and stride does.
+    MemoryInfo otherStride = CreateMemoryInfo(WIDTH * 2, HEIGHT / 2); // same byte size with twice the width
+    std::shared_ptr<MemoryData> second = EffectMemoryPool::Instance().Alloc(otherStride, BufferType::HEAP_MEMORY);
+    ASSERT_NE(second, nullptr);
+    EXPECT_NE(second->data, addr);
+    std::shared_ptr<MemoryData> third = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::HEAP_MEMORY);
+    ASSERT_NE(third, nullptr);
+    EXPECT_EQ(third->data, addr);
+
+    stats = EffectMemoryPool::Instance().GetStats();
+    EXPECT_EQ(stats.hitCount, 1);
+    EXPECT_EQ(stats.missCount, 2);
+    EXPECT_EQ(stats.retainedCount, 0);
+    EXPECT_DOUBLE_EQ(stats.HitRate(), 1.0 / 3);
+}
+
+HWTEST_F(TestEffectMemoryPool, Alloc002, TestSize.Level1)
+{
+    MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+    std::shared_ptr<MemoryData> memoryData = EffectMemoryPool::Instance().Alloc(memoryInfo,
+        BufferType::HEAP_MEMORY);
+    ASSERT_NE(memoryData, nullptr);
+
+    // Buffers whose ownership has been moved out are never handed out again.
+    memoryData->memoryInfo.isAutoRelease = false;
+    void *addr = memoryData->data;
+    memoryData = nullptr;
+    EXPECT_EQ(EffectMemoryPool::Instance().GetStats().retainedCount, 0);
+    free(addr);
+}
+
+HWTEST_F(TestEffectMemoryPool, SetConfig001, TestSize.Level1)
+{
+    MemoryPoolConfig config;
+    config.maxBuffersPerKey = 1;
+    config.maxRetainedBytes = LEN * 2;
+    EffectMemoryPool::Instance().SetConfig(config);
+
+    MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+    MemoryInfo largeInfo = CreateMemoryInfo(WIDTH, HEIGHT * 2);
+    std::shared_ptr<MemoryData> first = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::HEAP_MEMORY);
+    std::shared_ptr<MemoryData> second = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::HEAP_MEMORY);
+    std::shared_ptr<MemoryData> large = EffectMemoryPool::Instance().Alloc(largeInfo, BufferType::HEAP_MEMORY);
+    ASSERT_NE(first, nullptr);
+    ASSERT_NE(second, nullptr);
+    ASSERT_NE(large, nullptr);
+    first = nullptr;
+    second = nullptr;
+    EXPECT_EQ(EffectMemoryPool::Instance().GetStats().retainedCount, 1);
+
+    // The oldest idle buffer is evicted to stay within the byte limit.
+    large = nullptr;
+    MemoryPoolStats stats = EffectMemoryPool::Instance().GetStats();
+    EXPECT_EQ(stats.retainedCount, 1);
+    EXPECT_EQ(stats.retainedBytes, LEN * 2);
+
+    config.idleTimeout = std::chrono::milliseconds(0);
+    EffectMemoryPool::Instance().SetConfig(config);
+    EXPECT_EQ(EffectMemoryPool::Instance().GetStats().retainedCount, 0);
+}
+
+HWTEST_F(TestEffectMemoryPool, Alloc003, TestSize.Level1)
+{
+    // Several memory managers, one per ImageEffect instance, share the pool from different threads.
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < THREAD_NUM; ++i) {
+        threads.emplace_back([]() {
+            EffectMemoryManager memoryManager;
+            memoryManager.SetIPType(IPType::CPU);
+            for (uint32_t loop = 0; loop < LOOP_NUM; ++loop) {
+                MemoryInfo memoryInfo = CreateMemoryInfo(WIDTH, HEIGHT);
+                MemoryData *first = memoryManager.AllocMemory(nullptr, memoryInfo);
+                ASSERT_NE(first, nullptr);
+                MemoryData *second = memoryManager.AllocMemory(first->data, memoryInfo);
+                ASSERT_NE(second, nullptr);
+                ASSERT_NE(first->data, second->data);
+                memoryManager.ClearMemory();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    MemoryPoolStats stats = EffectMemoryPool::Instance().GetStats();
+    EXPECT_EQ(stats.hitCount + stats.missCount, THREAD_NUM * LOOP_NUM * 2);
+    EXPECT_GT(stats.hitCount, 0);
+    EXPECT_LE(stats.retainedCount, MemoryPoolConfig().maxBuffersPerKey);
+}
+HWTEST_F(TestEffectMemoryPool, Alloc004, TestSize.Level1)
+{
+    constexpr uint32_t sizeClass = 8 * 1024 * 1024;
+    constexpr uint32_t frameWidth = 1920;
+    constexpr uint32_t minHeight = 1000;
+    constexpr uint32_t maxHeight = 1080;
+    EXPECT_EQ(EffectMemoryPool::RoundToSizeClass(1), EffectMemoryPool::RoundToSizeClass(LEN));
+    EXPECT_EQ(EffectMemoryPool::RoundToSizeClass(frameWidth * minHeight * RGBA_BYTES_PER_PIXEL), sizeClass);
+    EXPECT_EQ(EffectMemoryPool::RoundToSizeClass(frameWidth * maxHeight * RGBA_BYTES_PER_PIXEL), sizeClass);
+    EXPECT_EQ(EffectMemoryPool::RoundToSizeClass(sizeClass + 1), sizeClass + sizeClass / 4); // 4: classes per 2^n
+
+    // two frames in flight, the first ones map their regions, every later frame of the stream reuses them even
+    // though the frame size changes.
+    MemoryInfo memoryInfo = CreateMemoryInfo(frameWidth, maxHeight);
+    std::shared_ptr<MemoryData> previous = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::SHARED_MEMORY);
+    ASSERT_NE(previous, nullptr);
+    std::shared_ptr<MemoryData> current = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::SHARED_MEMORY);
+    ASSERT_NE(current, nullptr);
+    EXPECT_EQ(current->memoryInfo.bufferInfo.len_, sizeClass);
+    uint64_t mapCount = SharedMemory::GetMapCount();
+    for (uint32_t height = minHeight; height <= maxHeight; height += HEIGHT) {
+        previous = std::move(current);
+        memoryInfo = CreateMemoryInfo(frameWidth, height);
+        current = EffectMemoryPool::Instance().Alloc(memoryInfo, BufferType::SHARED_MEMORY);
+        ASSERT_NE(current, nullptr);
+        EXPECT_NE(current->data, previous->data);
+        EXPECT_NE(current->memoryInfo.extra, nullptr);
+        EXPECT_EQ(current->memoryInfo.bufferInfo.height_, height);
+    }
+    EXPECT_EQ(SharedMemory::GetMapCount(), mapCount);
+}
+
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
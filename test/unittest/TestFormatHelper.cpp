@@ -0,0 +1,285 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "cpu_feature_helper.h"
+#include "format_helper.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Effect;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t RGBA_ALPHA_INDEX = 3;
+constexpr uint32_t ROW_PADDING = 12;
+constexpr uint32_t RANDOM_MULTIPLIER = 1103515245;
+constexpr uint32_t RANDOM_INCREMENT = 12345;
+constexpr uint32_t RANDOM_SHIFT = 16;
+constexpr uint32_t YUV_BLOCK_SIZE = 2;
+constexpr uint8_t PADDING_VALUE = 0x5A;
+const uint32_t TEST_SIZES[][2] = { { 1, 1 }, { 2, 2 }, { 5, 3 }, { 8, 2 }, { 16, 9 }, { 33, 17 }, { 64, 6 } };
+const SimdLevel TEST_LEVELS[] = { SimdLevel::SCALAR, SimdLevel::SSE4, SimdLevel::AVX2, SimdLevel::NEON };
+}
+
+class TestFormatHelper : public testing::Test {
+public:
+    TestFormatHelper() = default;
+    ~TestFormatHelper() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() override {}
+    void TearDown() override {}
+
+protected:
+    static std::vector<uint8_t> CreateImage(size_t size, uint32_t seed)
+    {
+        std::vector<uint8_t> image(size);
+        for (auto &value : image) {
+            seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+            value = static_cast<uint8_t>(seed >> RANDOM_SHIFT);
+        }
+        return image;
+    }
+
+    static FormatConverterInfo CreateConverterInfo(std::vector<uint8_t> &data, uint32_t width, uint32_t height,
+        uint32_t rowStride, IEffectFormat format)
+    {
+        return {
+            .bufferInfo = {
+                .width_ = width,
+                .height_ = height,
+                .len_ = static_cast<uint32_t>(data.size()),
+                .formatType_ = format,
+                .rowStride_ = rowStride,
+            },
+            .buffer = data.data(),
+        };
+    }
+
+    // Luma per pixel, chroma from the mean rgb of the valid pixels of every 2x2 block.
+    static void ReferenceRGBAToYUV(const std::vector<uint8_t> &src, uint32_t srcRowStride, std::vector<uint8_t> &dst,
+        uint32_t dstRowStride, uint32_t width, uint32_t height, uint32_t uIndex)
+    {
+        uint32_t uvOffset = dstRowStride * height;
+        for (uint32_t by = 0; by < height; by += YUV_BLOCK_SIZE) {
+            for (uint32_t bx = 0; bx < width; bx += YUV_BLOCK_SIZE) {
+                uint32_t sum[RGBA_ALPHA_INDEX] = { 0 };
+                uint32_t count = 0;
+                for (uint32_t y = by; y < by + YUV_BLOCK_SIZE && y < height; ++y) {
+                    for (uint32_t x = bx; x < bx + YUV_BLOCK_SIZE && x < width; ++x) {
+                        const uint8_t *pixel = src.data() + y * srcRowStride + x * RGBA_BYTES_PER_PIXEL;
+                        dst[y * dstRowStride + x] = FormatHelper::RGBToY(pixel[0], pixel[1], pixel[2]);
+                        for (uint32_t c = 0; c < RGBA_ALPHA_INDEX; ++c) {
+                            sum[c] += pixel[c];
+                        }
+                        count++;
+                    }
+                }
+                uint8_t r = static_cast<uint8_t>((sum[0] + count / YUV_BLOCK_SIZE) / count);
+                uint8_t g = static_cast<uint8_t>((sum[1] + count / YUV_BLOCK_SIZE) / count);
+                uint8_t b = static_cast<uint8_t>((sum[2] + count / YUV_BLOCK_SIZE) / count);
+                uint32_t uvIndex = uvOffset + by / YUV_BLOCK_SIZE * dstRowStride + bx;
+                dst[uvIndex + uIndex] = FormatHelper::RGBToU(r, g, b);
+                dst[uvIndex + 1 - uIndex] = FormatHelper::RGBToV(r, g, b);
+            }
+        }
+    }
+
+    static void ReferenceYUVToRGBA(const std::vector<uint8_t> &src, uint32_t srcRowStride, std::vector<uint8_t> &dst,
+        uint32_t dstRowStride, uint32_t width, uint32_t height, uint32_t uIndex)
+    {
+        uint32_t uvOffset = srcRowStride * height;
+        for (uint32_t y = 0; y < height; ++y) {
+            for (uint32_t x = 0; x < width; ++x) {
+                uint32_t uvIndex = uvOffset + y / YUV_BLOCK_SIZE * srcRowStride + x / YUV_BLOCK_SIZE * YUV_BLOCK_SIZE;
+                uint8_t luma = src[y * srcRowStride + x];
+                uint8_t u = src[uvIndex + uIndex];
+                uint8_t v = src[uvIndex + 1 - uIndex];
+                uint8_t *pixel = dst.data() + y * dstRowStride + x * RGBA_BYTES_PER_PIXEL;
+                pixel[0] = FormatHelper::YuvToR(luma, u, v);
+                pixel[1] = FormatHelper::YuvToG(luma, u, v);
+                pixel[2] = FormatHelper::YuvToB(luma, u, v);
+                pixel[RGBA_ALPHA_INDEX] = UNSIGHED_CHAR_MAX;
+            }
+        }
+    }
+};
+
+HWTEST_F(TestFormatHelper, ConvertRGBAToYUV001, TestSize.Level1)
+{
+    // Odd sizes and padded strides on both sides, every kernel level must match the reference bit for bit.
+    const IEffectFormat formats[] = { IEffectFormat::YUVNV12, IEffectFormat::YUVNV21 };
+    for (const auto &size : TEST_SIZES) {
+        uint32_t width = size[0];
+        uint32_t height = size[1];
+        uint32_t srcRowStride = width * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+        uint32_t dstRowStride = FormatHelper::CalculateRowStride(width, IEffectFormat::YUVNV12) + ROW_PADDING;
+        size_t dstSize = static_cast<size_t>(dstRowStride) * FormatHelper::CalculateDataRowCount(height,
+            IEffectFormat::YUVNV12);
+        std::vector<uint8_t> src = CreateImage(static_cast<size_t>(srcRowStride) * height, width * height);
+        for (IEffectFormat format : formats) {
+            uint32_t uIndex = format == IEffectFormat::YUVNV12 ? 0 : 1;
+            std::vector<uint8_t> expect(dstSize, PADDING_VALUE);
+            ReferenceRGBAToYUV(src, srcRowStride, expect, dstRowStride, width, height, uIndex);
+            for (SimdLevel level : TEST_LEVELS) {
+                std::vector<uint8_t> dst(dstSize, PADDING_VALUE);
+                FormatConverterInfo srcInfo = CreateConverterInfo(src, width, height, srcRowStride,
+                    IEffectFormat::RGBA8888);
+                FormatConverterInfo dstInfo = CreateConverterInfo(dst, width, height, dstRowStride, format);
+                ASSERT_EQ(FormatHelper::ConvertFormat(srcInfo, dstInfo, level), ErrorCode::SUCCESS);
+                EXPECT_EQ(dst, expect) << "width=" << width << " height=" << height << " format=" <<
+                    static_cast<int>(format) << " level=" << CpuFeatureHelper::GetSimdLevelName(level);
+            }
+        }
+    }
+}
+
+HWTEST_F(TestFormatHelper, ConvertYUVToRGBA001, TestSize.Level1)
+{
+    const IEffectFormat formats[] = { IEffectFormat::YUVNV12, IEffectFormat::YUVNV21 };
+    for (const auto &size : TEST_SIZES) {
+        uint32_t width = size[0];
+        uint32_t height = size[1];
+        uint32_t srcRowStride = FormatHelper::CalculateRowStride(width, IEffectFormat::YUVNV12) + ROW_PADDING;
+        uint32_t dstRowStride = width * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+        size_t dstSize = static_cast<size_t>(dstRowStride) * height;
+        std::vector<uint8_t> src = CreateImage(static_cast<size_t>(srcRowStride) *
+            FormatHelper::CalculateDataRowCount(height, IEffectFormat::YUVNV12), width + height);
+        for (IEffectFormat format : formats) {
+            uint32_t uIndex = format == IEffectFormat::YUVNV12 ? 0 : 1;
+            std::vector<uint8_t> expect(dstSize, PADDING_VALUE);
+            ReferenceYUVToRGBA(src, srcRowStride, expect, dstRowStride, width, height, uIndex);
+            for (SimdLevel level : TEST_LEVELS) {
+                std::vector<uint8_t> dst(dstSize, PADDING_VALUE);
+                FormatConverterInfo srcInfo = CreateConverterInfo(src, width, height, srcRowStride, format);
+                FormatConverterInfo dstInfo = CreateConverterInfo(dst, width, height, dstRowStride,
+                    IEffectFormat::RGBA8888);
+                ASSERT_EQ(FormatHelper::ConvertFormat(srcInfo, dstInfo, level), ErrorCode::SUCCESS);
+                EXPECT_EQ(dst, expect) << "width=" << width << " height=" << height << " format=" <<
+                    static_cast<int>(format) << " level=" << CpuFeatureHelper::GetSimdLevelName(level);
+            }
+        }
+    }
+}
+
+HWTEST_F(TestFormatHelper, ChromaAverage001, TestSize.Level1)
+{
+    // A red, green, blue and white block: the chroma comes from the block mean, not from the top-left pixel.
+    const uint8_t pixels[] = {
+        255, 0, 0, 255, 0, 255, 0, 255,
+        0, 0, 255, 255, 255, 255, 255, 255,
+    };
+    uint32_t rgbaRowStride = YUV_BLOCK_SIZE * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src(pixels, pixels + sizeof(pixels));
+    std::vector<uint8_t> dst(FormatHelper::CalculateSize(YUV_BLOCK_SIZE, YUV_BLOCK_SIZE, IEffectFormat::YUVNV12), 0);
+    FormatConverterInfo srcInfo = CreateConverterInfo(src, YUV_BLOCK_SIZE, YUV_BLOCK_SIZE, rgbaRowStride,
+        IEffectFormat::RGBA8888);
+    FormatConverterInfo dstInfo = CreateConverterInfo(dst, YUV_BLOCK_SIZE, YUV_BLOCK_SIZE, YUV_BLOCK_SIZE,
+        IEffectFormat::YUVNV12);
+    ASSERT_EQ(FormatHelper::ConvertFormat(srcInfo, dstInfo), ErrorCode::SUCCESS);
+
+    uint8_t mean = 128; // (255 + 0 + 0 + 255 + 2) / 4 for every channel
+    uint32_t uvIndex = YUV_BLOCK_SIZE * YUV_BLOCK_SIZE;
+    EXPECT_EQ(dst[uvIndex], FormatHelper::RGBToU(mean, mean, mean));
+    EXPECT_EQ(dst[uvIndex + 1], FormatHelper::RGBToV(mean, mean, mean));
+    EXPECT_NE(dst[uvIndex + 1], FormatHelper::RGBToV(UNSIGHED_CHAR_MAX, 0, 0));
+}
+
+HWTEST_F(TestFormatHelper, ConvertRGBA1010102ToP010001, TestSize.Level1)
+{
+    const IEffectFormat formats[] = { IEffectFormat::YCBCR_P010, IEffectFormat::YCRCB_P010 };
+    for (const auto &size : TEST_SIZES) {
+        uint32_t width = size[0];
+        uint32_t height = size[1];
+        uint32_t srcRowStride = width * RGBA_BYTES_PER_PIXEL + RGBA_BYTES_PER_PIXEL;
+        uint32_t dstRowStride = FormatHelper::CalculateRowStride(width, IEffectFormat::YCBCR_P010) + ROW_PADDING;
+        std::vector<uint8_t> src = CreateImage(static_cast<size_t>(srcRowStride) * height, width * height);
+        for (IEffectFormat format : formats) {
+            uint32_t uIndex = format == IEffectFormat::YCBCR_P010 ? 0 : 1;
+            std::vector<uint8_t> dst(static_cast<size_t>(dstRowStride) *
+                FormatHelper::CalculateDataRowCount(height, format), PADDING_VALUE);
+            FormatConverterInfo srcInfo = CreateConverterInfo(src, width, height, srcRowStride,
+                IEffectFormat::RGBA_1010102);
+            FormatConverterInfo dstInfo = CreateConverterInfo(dst, width, height, dstRowStride, format);
+            ASSERT_EQ(FormatHelper::ConvertFormat(srcInfo, dstInfo), ErrorCode::SUCCESS);
+
+            const uint16_t *uv = reinterpret_cast<const uint16_t *>(dst.data() + dstRowStride * height);
+            for (uint32_t by = 0; by < height; by += YUV_BLOCK_SIZE) {
+                for (uint32_t bx = 0; bx < width; bx += YUV_BLOCK_SIZE) {
+                    uint32_t sum[RGBA_ALPHA_INDEX] = { 0 };
+                    uint32_t count = 0;
+                    for (uint32_t y = by; y < by + YUV_BLOCK_SIZE && y < height; ++y) {
+                        const auto *rgba = reinterpret_cast<const uint32_t *>(src.data() + y * srcRowStride);
+                        const auto *luma = reinterpret_cast<const uint16_t *>(dst.data() + y * dstRowStride);
+                        for (uint32_t x = bx; x < bx + YUV_BLOCK_SIZE && x < width; ++x) {
+                            uint16_t channels[RGBA_ALPHA_INDEX];
+                            for (uint32_t c = 0; c < RGBA_ALPHA_INDEX; ++c) {
+                                channels[c] = FormatHelper::GetRGBA1010102Channel(rgba[x], c);
+                                sum[c] += channels[c];
+                            }
+                            EXPECT_EQ(luma[x], FormatHelper::ToP010Word(FormatHelper::RGB10ToY(channels[0],
+                                channels[1], channels[2])));
+                            count++;
+                        }
+                    }
+                    uint16_t r = static_cast<uint16_t>((sum[0] + count / YUV_BLOCK_SIZE) / count);
+                    uint16_t g = static_cast<uint16_t>((sum[1] + count / YUV_BLOCK_SIZE) / count);
+                    uint16_t b = static_cast<uint16_t>((sum[2] + count / YUV_BLOCK_SIZE) / count);
+                    const uint16_t *block = uv + by / YUV_BLOCK_SIZE * dstRowStride / sizeof(uint16_t) + bx;
+                    EXPECT_EQ(block[uIndex], FormatHelper::ToP010Word(FormatHelper::RGB10ToU(r, g, b)));
+                    EXPECT_EQ(block[1 - uIndex], FormatHelper::ToP010Word(FormatHelper::RGB10ToV(r, g, b)));
+                }
+            }
+        }
+    }
+}
+
+HWTEST_F(TestFormatHelper, ConvertP010ToRGBA1010102001, TestSize.Level1)
+{
+    // Gray in, gray out: centered chroma leaves r, g and b equal to the luma and alpha opaque.
+    uint32_t width = 5;
+    uint32_t height = 3;
+    uint32_t srcRowStride = FormatHelper::CalculateRowStride(width, IEffectFormat::YCRCB_P010);
+    uint32_t dstRowStride = width * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src(FormatHelper::CalculateSize(width, height, IEffectFormat::YCRCB_P010));
+    auto *samples = reinterpret_cast<uint16_t *>(src.data());
+    for (uint32_t i = 0; i < src.size() / sizeof(uint16_t); ++i) {
+        samples[i] = FormatHelper::ToP010Word(i < srcRowStride / sizeof(uint16_t) * height ? i : 512); // 512: gray
+    }
+    std::vector<uint8_t> dst(static_cast<size_t>(dstRowStride) * height, 0);
+    FormatConverterInfo srcInfo = CreateConverterInfo(src, width, height, srcRowStride, IEffectFormat::YCRCB_P010);
+    FormatConverterInfo dstInfo = CreateConverterInfo(dst, width, height, dstRowStride, IEffectFormat::RGBA_1010102);
+    ASSERT_EQ(FormatHelper::ConvertFormat(srcInfo, dstInfo), ErrorCode::SUCCESS);
+
+    for (uint32_t y = 0; y < height; ++y) {
+        const auto *rgba = reinterpret_cast<const uint32_t *>(dst.data() + y * dstRowStride);
+        for (uint32_t x = 0; x < width; ++x) {
+            uint16_t luma = FormatHelper::GetP010Sample(samples[y * srcRowStride / sizeof(uint16_t) + x]);
+            EXPECT_EQ(rgba[x], FormatHelper::PackRGBA1010102(luma, luma, luma, 3)); // 3: opaque 2-bit alpha
+        }
+    }
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,202 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "lut_cache.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Effect;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr float TEST_BRIGHTNESS = 50.f;
+constexpr float TEST_CONTRAST = -30.f;
+constexpr uint32_t LUT_8BIT_ENTRIES = 256;
+constexpr uint32_t LUT_10BIT_ENTRIES = 1024;
+constexpr uint32_t THREAD_NUM = 8;
+constexpr uint32_t LOOP_NUM = 200;
+constexpr uint32_t KEY_NUM = 4;
+constexpr float EPS = 1e-5;
+constexpr float SCALE_FACTOR = 100.f;
+constexpr float UCHAR_MAX_VALUE = 255.f;
+constexpr double PI = 3.14159265;
+// The cache quantizes the intensity to 0.01, a table may differ from the exact intensity by one code value.
+constexpr int32_t QUANTIZE_TOLERANCE = 1;
+
+float Clip(float a, float aMin, float aMax)
+{
+    return a > aMax ? aMax : (a < aMin ? aMin : a);
+}
+
+// The tables the cpu algos used to build inline on every call, from the unquantized intensity.
+uint8_t InlineLutValue(LutType type, float intensity, uint32_t idx)
+{
+    float scale = intensity / SCALE_FACTOR;
+    float current = 0.f;
+    if (type == LutType::BRIGHTNESS) {
+        scale = pow(2.4f, scale); // 2.4 is algorithm parameter.
+        current = Clip(1.f - static_cast<float>(idx) / UCHAR_MAX_VALUE, 0, 1) + EPS;
+        current = 1.f - pow(current, scale);
+    } else {
+        current = static_cast<float>(idx) / UCHAR_MAX_VALUE;
+        current = current - scale * 0.1f * sin(2 * PI * current); // 2: one full period over the range
+    }
+    return static_cast<uint8_t>(Clip(current, 0, 1) * UCHAR_MAX_VALUE);
+}
+}
+
+class TestLutCache : public testing::Test {
+public:
+    TestLutCache() = default;
+    ~TestLutCache() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        LutCache::Instance().SetCapacity(LutCache::DEFAULT_CAPACITY);
+        LutCache::Instance().Clear();
+    }
+
+    void TearDown() override
+    {
+        LutCache::Instance().SetCapacity(LutCache::DEFAULT_CAPACITY);
+        LutCache::Instance().Clear();
+    }
+};
+
+HWTEST_F(TestLutCache, GetLut001, TestSize.Level1)
+{
+    LutTablePtr first = LutCache::Instance().GetLut(LutType::BRIGHTNESS, TEST_BRIGHTNESS, LutCache::BIT_DEPTH_8);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(first->lut8.size(), LUT_8BIT_ENTRIES);
+
+    // Intensities within the quantization step share one table.
+    LutTablePtr second = LutCache::Instance().GetLut(LutType::BRIGHTNESS, TEST_BRIGHTNESS + 0.001f,
+        LutCache::BIT_DEPTH_8);
+    EXPECT_EQ(first, second);
+
+    LutCacheStats stats = LutCache::Instance().GetStats();
+    EXPECT_EQ(stats.missCount, 1);
+    EXPECT_EQ(stats.hitCount, 1);
+    EXPECT_EQ(stats.size, 1);
+
+    // Type and bit depth are part of the key.
+    LutTablePtr contrast = LutCache::Instance().GetLut(LutType::CONTRAST, TEST_BRIGHTNESS, LutCache::BIT_DEPTH_8);
+    LutTablePtr tenBit = LutCache::Instance().GetLut(LutType::BRIGHTNESS, TEST_BRIGHTNESS, LutCache::BIT_DEPTH_10);
+    ASSERT_NE(tenBit, nullptr);
+    EXPECT_NE(contrast, first);
+    EXPECT_EQ(tenBit->lut16.size(), LUT_10BIT_ENTRIES);
+    EXPECT_EQ(LutCache::Instance().GetStats().missCount, 3);
+}
+
+HWTEST_F(TestLutCache, GetLut002, TestSize.Level1)
+{
+    LutTablePtr brightness = LutCache::Instance().GetLut(LutType::BRIGHTNESS, TEST_BRIGHTNESS,
+        LutCache::BIT_DEPTH_8);
+    LutTablePtr contrast = LutCache::Instance().GetLut(LutType::CONTRAST, TEST_CONTRAST, LutCache::BIT_DEPTH_8);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+
+    float brightnessScale = std::pow(2.4f, TEST_BRIGHTNESS / 100); // 2.4 and 100 are algorithm parameters.
+    float contrastScale = TEST_CONTRAST / 100; // 100 is algorithm parameter.
+    for (uint32_t idx = 0; idx < LUT_8BIT_ENTRIES; ++idx) {
+        float value = static_cast<float>(idx) / 255; // 255 is the max 8-bit value
+        float current = 1.f - std::pow(std::min(std::max(1.f - value, 0.f), 1.f) + 1e-5f, brightnessScale);
+        EXPECT_NEAR(brightness->lut8[idx], std::min(std::max(current, 0.f), 1.f) * 255, 1.0); // 255 max value
+        current = value - contrastScale * 0.1f * std::sin(2 * 3.14159265 * value); // 2 pi, sin period is 1
+        EXPECT_NEAR(contrast->lut8[idx], std::min(std::max(current, 0.f), 1.f) * 255, 1.0); // 255 max value
+    }
+}
+
+HWTEST_F(TestLutCache, SetCapacity001, TestSize.Level1)
+{
+    LutCache::Instance().SetCapacity(2);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 10.f, LutCache::BIT_DEPTH_8);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 20.f, LutCache::BIT_DEPTH_8);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 10.f, LutCache::BIT_DEPTH_8);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 30.f, LutCache::BIT_DEPTH_8);
+
+    // 20 was the least recently used entry.
+    LutCacheStats stats = LutCache::Instance().GetStats();
+    EXPECT_EQ(stats.size, 2);
+    EXPECT_EQ(stats.hitCount, 1);
+    EXPECT_EQ(stats.missCount, 3);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 10.f, LutCache::BIT_DEPTH_8);
+    EXPECT_EQ(LutCache::Instance().GetStats().hitCount, 2);
+    LutCache::Instance().GetLut(LutType::CONTRAST, 20.f, LutCache::BIT_DEPTH_8);
+    EXPECT_EQ(LutCache::Instance().GetStats().missCount, 4);
+
+    EXPECT_EQ(LutCache::Instance().GetLut(LutType::CONTRAST, 10.f, 0), nullptr);
+}
+
+HWTEST_F(TestLutCache, GetLut003, TestSize.Level1)
+{
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < THREAD_NUM; ++i) {
+        threads.emplace_back([]() {
+            for (uint32_t loop = 0; loop < LOOP_NUM; ++loop) {
+                LutTablePtr lut = LutCache::Instance().GetLut(LutType::BRIGHTNESS,
+                    static_cast<float>(loop % KEY_NUM), LutCache::BIT_DEPTH_8);
+                ASSERT_NE(lut, nullptr);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    LutCacheStats stats = LutCache::Instance().GetStats();
+    EXPECT_EQ(stats.hitCount + stats.missCount, THREAD_NUM * LOOP_NUM);
+    EXPECT_EQ(stats.size, KEY_NUM);
+}
+
+HWTEST_F(TestLutCache, CreateLut001, TestSize.Level1)
+{
+    // Exactly quantized intensities are bit exact with the inline tables, others stay within the tolerance.
+    const float exactIntensities[] = { -100.f, -30.f, 0.5f, 50.f, 100.f };
+    const float otherIntensities[] = { -66.666f, -12.345f, 0.004f, 33.333f, 99.999f };
+    for (LutType type : { LutType::BRIGHTNESS, LutType::CONTRAST }) {
+        for (float intensity : exactIntensities) {
+            LutTablePtr lut = LutCache::Instance().GetLut(type, intensity, LutCache::BIT_DEPTH_8);
+            ASSERT_NE(lut, nullptr);
+            for (uint32_t idx = 0; idx < LUT_8BIT_ENTRIES; ++idx) {
+                EXPECT_EQ(lut->lut8[idx], InlineLutValue(type, intensity, idx)) << "intensity=" << intensity <<
+                    " idx=" << idx;
+            }
+        }
+        for (float intensity : otherIntensities) {
+            LutTablePtr lut = LutCache::Instance().GetLut(type, intensity, LutCache::BIT_DEPTH_8);
+            ASSERT_NE(lut, nullptr);
+            for (uint32_t idx = 0; idx < LUT_8BIT_ENTRIES; ++idx) {
+                int32_t diff = static_cast<int32_t>(lut->lut8[idx]) - InlineLutValue(type, intensity, idx);
+                EXPECT_LE(std::abs(diff), QUANTIZE_TOLERANCE) << "intensity=" << intensity << " idx=" << idx;
+            }
+        }
+    }
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "effect_context.h"
+#include "efilter_factory.h"
+#include "lut_fusion_efilter.h"
+#include "test_common.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t WIDTH = 67;
+constexpr uint32_t HEIGHT = 9;
+constexpr uint32_t ROW_PADDING = 12;
+constexpr const char *KEY_INTENSITY = "FilterIntensity";
+
+std::shared_ptr<EFilter> CreateEFilter(const char *name, float intensity)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(name);
+    if (efilter != nullptr) {
+        Any value = intensity;
+        efilter->SetValue(KEY_INTENSITY, value);
+    }
+    return efilter;
+}
+
+std::shared_ptr<EffectBuffer> CreateRGBABuffer(std::vector<uint8_t> &data, uint32_t rowStride)
+{
+    auto bufferInfo = std::make_shared<BufferInfo>();
+    bufferInfo->width_ = WIDTH;
+    bufferInfo->height_ = HEIGHT;
+    bufferInfo->rowStride_ = rowStride;
+    bufferInfo->len_ = static_cast<uint32_t>(data.size());
+    bufferInfo->formatType_ = IEffectFormat::RGBA8888;
+    return std::make_shared<EffectBuffer>(bufferInfo, data.data(), std::make_shared<ExtraInfo>());
+}
+
+std::vector<uint8_t> CreatePixels(uint32_t rowStride)
+{
+    std::vector<uint8_t> pixels(rowStride * HEIGHT);
+    for (size_t idx = 0; idx < pixels.size(); idx++) {
+        pixels[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+    return pixels;
+}
+} // namespace
+
+class TestLutFusionEFilter : public testing::Test {
+public:
+    TestLutFusionEFilter() = default;
+
+    ~TestLutFusionEFilter() override = default;
+
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        context_ = std::make_shared<EffectContext>();
+        context_->ipType_ = IPType::CPU;
+    }
+
+    void TearDown() override
+    {
+        context_ = nullptr;
+    }
+
+    std::shared_ptr<EffectContext> context_;
+};
+
+HWTEST_F(TestLutFusionEFilter, GetFusionPlan001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 30.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, -45.f);
+    std::shared_ptr<EFilter> crop = EFilterFactory::Instance()->Create(CROP_EFILTER);
+    std::shared_ptr<EFilter> tail = CreateEFilter(BRIGHTNESS_EFILTER, 10.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    ASSERT_NE(crop, nullptr);
+    ASSERT_NE(tail, nullptr);
+    EXPECT_EQ(crop->GetPointwiseLut(), nullptr);
+
+    std::vector<std::shared_ptr<EFilter>> efilters = { brightness, contrast, crop, tail };
+    std::vector<uint32_t> plan = LutFusionEFilter::GetFusionPlan(efilters);
+    EXPECT_EQ(plan, std::vector<uint32_t>({ 2, 1, 1 }));
+
+    std::vector<std::shared_ptr<EFilter>> fused = LutFusionEFilter::FuseEFilters(efilters, plan);
+    ASSERT_EQ(fused.size(), 3u);
+    auto fusion = std::static_pointer_cast<LutFusionEFilter>(fused[0]);
+    EXPECT_EQ(fusion->GetName(), BRIGHTNESS_EFILTER);
+    EXPECT_EQ(fusion->GetMembers().size(), 2u);
+    EXPECT_EQ(fused[1], crop);
+    EXPECT_EQ(fused[2], tail);
+
+    // A caching filter keeps its own slot in the pipeline.
+    contrast->StartCache();
+    EXPECT_EQ(LutFusionEFilter::GetFusionPlan(efilters), std::vector<uint32_t>({ 1, 1, 1, 1 }));
+    contrast->CancelCache();
+    EXPECT_EQ(LutFusionEFilter::GetFusionPlan(efilters), plan);
+}
+
+HWTEST_F(TestLutFusionEFilter, Render001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 30.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, -45.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    LutFusionEFilter fusion({ brightness, contrast });
+
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint8_t> expected = CreatePixels(rowStride);
+    std::shared_ptr<EffectBuffer> expectedBuffer = CreateRGBABuffer(expected, rowStride);
+    ASSERT_EQ(brightness->Render(expectedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+    ASSERT_EQ(contrast->Render(expectedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+
+    // In place.
+    std::vector<uint8_t> inPlace = CreatePixels(rowStride);
+    std::shared_ptr<EffectBuffer> inPlaceBuffer = CreateRGBABuffer(inPlace, rowStride);
+    ASSERT_EQ(fusion.Render(inPlaceBuffer.get(), inPlaceBuffer.get(), context_), ErrorCode::SUCCESS);
+    EXPECT_EQ(inPlace, expected);
+
+    // Separate output, the row padding of the output is left untouched.
+    std::vector<uint8_t> src = CreatePixels(rowStride);
+    std::vector<uint8_t> dst(src.size(), 0);
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateRGBABuffer(src, rowStride);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateRGBABuffer(dst, rowStride);
+    ASSERT_EQ(fusion.Render(srcBuffer.get(), dstBuffer.get(), context_), ErrorCode::SUCCESS);
+    for (uint32_t row = 0; row < HEIGHT; row++) {
+        for (uint32_t col = 0; col < WIDTH * RGBA_BYTES_PER_PIXEL; col++) {
+            ASSERT_EQ(dst[row * rowStride + col], expected[row * rowStride + col]) << "row " << row << " col " << col;
+        }
+    }
+}
+
+HWTEST_F(TestLutFusionEFilter, Render002, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 0.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, 0.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    LutFusionEFilter fusion({ brightness, contrast });
+
+    // Zero intensities leave the image untouched just like the unfused filters.
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> pixels = CreatePixels(rowStride);
+    std::vector<uint8_t> origin = pixels;
+    std::shared_ptr<EffectBuffer> buffer = CreateRGBABuffer(pixels, rowStride);
+    ASSERT_EQ(fusion.Render(buffer.get(), buffer.get(), context_), ErrorCode::SUCCESS);
+    EXPECT_EQ(pixels, origin);
+
+    // Buffers too short for the declared stride are rejected.
+    std::vector<uint8_t> shortPixels(rowStride * HEIGHT - 1);
+    std::shared_ptr<EffectBuffer> shortBuffer = CreateRGBABuffer(shortPixels, rowStride);
+    EXPECT_EQ(fusion.Render(shortBuffer.get(), shortBuffer.get(), context_), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+}
+
+HWTEST_F(TestLutFusionEFilter, GetPointwiseLut001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 30.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, -45.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    LutFusionEFilter fusion({ brightness, contrast });
+
+    // The composed table is reused while the member values stay the same.
+    LutTablePtr fused = fusion.GetPointwiseLut();
+    ASSERT_NE(fused, nullptr);
+    EXPECT_EQ(fusion.GetPointwiseLut(), fused);
+
+    // A changed member value composes a new table from the new member lut.
+    Any value = 0.f;
+    contrast->SetValue(KEY_INTENSITY, value);
+    LutTablePtr recomposed = fusion.GetPointwiseLut();
+    ASSERT_NE(recomposed, nullptr);
+    EXPECT_NE(recomposed, fused);
+    LutTablePtr brightnessLut = brightness->GetPointwiseLut();
+    ASSERT_NE(brightnessLut, nullptr);
+    EXPECT_EQ(recomposed->lut8, brightnessLut->lut8);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
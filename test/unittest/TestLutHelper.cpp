@@ -0,0 +1,223 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "cpu_feature_helper.h"
+#include "format_helper.h"
+#include "lut_helper.h"
+
+using namespace testing::ext;
+using namespace OHOS::Media::Effect;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t RGBA_ALPHA_INDEX = 3;
+constexpr uint32_t ROW_PADDING = 12;
+constexpr uint32_t TEST_HEIGHT = 7;
+constexpr uint32_t RANDOM_MULTIPLIER = 1103515245;
+constexpr uint32_t RANDOM_INCREMENT = 12345;
+constexpr uint32_t RANDOM_SHIFT = 16;
+constexpr uint32_t YUV_BLOCK_SIZE = 2;
+constexpr uint8_t PADDING_VALUE = 0x5A;
+}
+
+class TestLutHelper : public testing::Test {
+public:
+    TestLutHelper() = default;
+    ~TestLutHelper() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        for (uint32_t i = 0; i < LUT_8BIT_SIZE; ++i) {
+            lut_[i] = static_cast<uint8_t>(LUT_8BIT_SIZE - 1 - i);
+        }
+    }
+    void TearDown() override {}
+
+protected:
+    static std::vector<uint8_t> CreateImage(uint32_t rowStride, uint32_t height)
+    {
+        std::vector<uint8_t> image(rowStride * height);
+        uint32_t seed = rowStride;
+        for (auto &value : image) {
+            seed = seed * RANDOM_MULTIPLIER + RANDOM_INCREMENT;
+            value = static_cast<uint8_t>(seed >> RANDOM_SHIFT);
+        }
+        return image;
+    }
+
+    // Per block reference: map each pixel through the rgb lut and average the block for its chroma sample.
+    void ReferenceYUV420SP(const std::vector<uint8_t> &src, std::vector<uint8_t> &dst, uint32_t width,
+        uint32_t height, uint32_t rowStride)
+    {
+        uint32_t uvOffset = rowStride * height;
+        for (uint32_t by = 0; by < height; by += YUV_BLOCK_SIZE) {
+            for (uint32_t bx = 0; bx < width; bx += YUV_BLOCK_SIZE) {
+                uint32_t uvIndex = uvOffset + by / YUV_BLOCK_SIZE * rowStride + bx;
+                uint8_t u = src[uvIndex];
+                uint8_t v = src[uvIndex + 1];
+                uint32_t sumR = 0;
+                uint32_t sumG = 0;
+                uint32_t sumB = 0;
+                uint32_t count = 0;
+                for (uint32_t y = by; y < by + YUV_BLOCK_SIZE && y < height; ++y) {
+                    for (uint32_t x = bx; x < bx + YUV_BLOCK_SIZE && x < width; ++x) {
+                        uint8_t luma = src[y * rowStride + x];
+                        uint8_t r = lut_[FormatHelper::YuvToR(luma, u, v)];
+                        uint8_t g = lut_[FormatHelper::YuvToG(luma, u, v)];
+                        uint8_t b = lut_[FormatHelper::YuvToB(luma, u, v)];
+                        dst[y * rowStride + x] = FormatHelper::RGBToY(r, g, b);
+                        sumR += r;
+                        sumG += g;
+                        sumB += b;
+                        count++;
+                    }
+                }
+                uint8_t r = static_cast<uint8_t>((sumR + count / YUV_BLOCK_SIZE) / count);
+                uint8_t g = static_cast<uint8_t>((sumG + count / YUV_BLOCK_SIZE) / count);
+                uint8_t b = static_cast<uint8_t>((sumB + count / YUV_BLOCK_SIZE) / count);
+                dst[uvIndex] = FormatHelper::RGBToU(r, g, b);
+                dst[uvIndex + 1] = FormatHelper::RGBToV(r, g, b);
+            }
+        }
+    }
+
+    uint8_t lut_[LUT_8BIT_SIZE] = { 0 };
+};
+
+HWTEST_F(TestLutHelper, ApplyRGBA8888001, TestSize.Level1)
+{
+    uint32_t width = 9;
+    uint32_t rowStride = width * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint8_t> src = CreateImage(rowStride, TEST_HEIGHT);
+    std::vector<uint8_t> dst(src.size(), 0);
+    LutPlaneInfo srcPlane = { src.data(), rowStride };
+    LutPlaneInfo dstPlane = { dst.data(), rowStride };
+    LutHelper::ApplyRGBA8888(srcPlane, dstPlane, width, TEST_HEIGHT, lut_, SimdLevel::SCALAR);
+
+    for (uint32_t y = 0; y < TEST_HEIGHT; ++y) {
+        for (uint32_t x = 0; x < width * RGBA_BYTES_PER_PIXEL; ++x) {
+            uint32_t index = y * rowStride + x;
+            uint8_t expect = (x % RGBA_BYTES_PER_PIXEL == RGBA_ALPHA_INDEX) ? src[index] : lut_[src[index]];
+            EXPECT_EQ(dst[index], expect);
+        }
+        for (uint32_t x = width * RGBA_BYTES_PER_PIXEL; x < rowStride; ++x) {
+            EXPECT_EQ(dst[y * rowStride + x], 0);
+        }
+    }
+}
+
+HWTEST_F(TestLutHelper, ApplyRGBA8888002, TestSize.Level1)
+{
+    // Odd widths exercise the scalar tail of every simd kernel.
+    const uint32_t widths[] = { 1, 3, 4, 7, 8, 15, 16, 17, 33, 127 };
+    const SimdLevel levels[] = { SimdLevel::SSE4, SimdLevel::AVX2, SimdLevel::NEON };
+    for (uint32_t width : widths) {
+        uint32_t rowStride = width * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+        std::vector<uint8_t> src = CreateImage(rowStride, TEST_HEIGHT);
+        std::vector<uint8_t> expect(src.size(), 0);
+        LutPlaneInfo srcPlane = { src.data(), rowStride };
+        LutPlaneInfo expectPlane = { expect.data(), rowStride };
+        LutHelper::ApplyRGBA8888(srcPlane, expectPlane, width, TEST_HEIGHT, lut_, SimdLevel::SCALAR);
+
+        for (SimdLevel level : levels) {
+            std::vector<uint8_t> dst(src.size(), 0);
+            LutPlaneInfo dstPlane = { dst.data(), rowStride };
+            LutHelper::ApplyRGBA8888(srcPlane, dstPlane, width, TEST_HEIGHT, lut_, level);
+            EXPECT_EQ(dst, expect) << "width=" << width << " level=" << CpuFeatureHelper::GetSimdLevelName(level);
+        }
+    }
+}
+
+HWTEST_F(TestLutHelper, ApplyRGBA8888003, TestSize.Level1)
+{
+    uint32_t width = 21;
+    uint32_t rowStride = width * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src = CreateImage(rowStride, TEST_HEIGHT);
+    std::vector<uint8_t> expect(src.size(), 0);
+    LutPlaneInfo srcPlane = { src.data(), rowStride };
+    LutPlaneInfo expectPlane = { expect.data(), rowStride };
+    LutHelper::ApplyRGBA8888(srcPlane, expectPlane, width, TEST_HEIGHT, lut_, SimdLevel::SCALAR);
+
+    // In place processing with the kernel picked for the running cpu.
+    LutHelper::ApplyRGBA8888(srcPlane, srcPlane, width, TEST_HEIGHT, lut_);
+    EXPECT_EQ(src, expect);
+    EXPECT_TRUE(CpuFeatureHelper::IsSupported(CpuFeatureHelper::GetSimdLevel()));
+    EXPECT_TRUE(CpuFeatureHelper::IsSupported(SimdLevel::SCALAR));
+}
+HWTEST_F(TestLutHelper, ApplyYUV420SP001, TestSize.Level1)
+{
+    // Odd sizes and a padded stride: padding bytes must stay untouched and every sample matches the reference.
+    const uint32_t sizes[][2] = { { 1, 1 }, { 2, 2 }, { 5, 3 }, { 16, 9 }, { 33, 17 } };
+    for (const auto &size : sizes) {
+        uint32_t width = size[0];
+        uint32_t height = size[1];
+        uint32_t rowStride = (width + 1) / YUV_BLOCK_SIZE * YUV_BLOCK_SIZE + ROW_PADDING;
+        uint32_t uvHeight = (height + 1) / YUV_BLOCK_SIZE;
+        std::vector<uint8_t> src = CreateImage(rowStride, height + uvHeight);
+        std::vector<uint8_t> expect = src;
+        ReferenceYUV420SP(src, expect, width, height, rowStride);
+
+        std::vector<uint8_t> dst(src.size(), PADDING_VALUE);
+        LutYuvPlaneInfo srcPlanes = { { src.data(), rowStride }, { src.data() + rowStride * height, rowStride } };
+        LutYuvPlaneInfo dstPlanes = { { dst.data(), rowStride }, { dst.data() + rowStride * height, rowStride } };
+        LutHelper::ApplyYUV420SP(srcPlanes, dstPlanes, width, height, lut_, IEffectFormat::YUVNV12);
+
+        for (uint32_t row = 0; row < height + uvHeight; ++row) {
+            uint32_t validBytes = row < height ? width : (width + 1) / YUV_BLOCK_SIZE * YUV_BLOCK_SIZE;
+            for (uint32_t x = 0; x < rowStride; ++x) {
+                uint32_t index = row * rowStride + x;
+                EXPECT_EQ(dst[index], x < validBytes ? expect[index] : PADDING_VALUE) << "width=" << width <<
+                    " height=" << height << " row=" << row << " x=" << x;
+            }
+        }
+    }
+}
+
+HWTEST_F(TestLutHelper, ApplyYUV420SP002, TestSize.Level1)
+{
+    // NV21 stores v first, so swapping the chroma bytes of a NV12 image must give the swapped NV12 result.
+    uint32_t width = 24;
+    uint32_t height = 10;
+    uint32_t rowStride = width;
+    std::vector<uint8_t> nv12 = CreateImage(rowStride, height + height / YUV_BLOCK_SIZE);
+    std::vector<uint8_t> nv21 = nv12;
+    for (uint32_t i = rowStride * height; i + 1 < nv21.size(); i += YUV_BLOCK_SIZE) {
+        std::swap(nv21[i], nv21[i + 1]);
+    }
+
+    LutYuvPlaneInfo nv12Planes = { { nv12.data(), rowStride }, { nv12.data() + rowStride * height, rowStride } };
+    LutYuvPlaneInfo nv21Planes = { { nv21.data(), rowStride }, { nv21.data() + rowStride * height, rowStride } };
+    LutHelper::ApplyYUV420SP(nv12Planes, nv12Planes, width, height, lut_, IEffectFormat::YUVNV12);
+    LutHelper::ApplyYUV420SP(nv21Planes, nv21Planes, width, height, lut_, IEffectFormat::YUVNV21);
+    for (uint32_t i = rowStride * height; i + 1 < nv21.size(); i += YUV_BLOCK_SIZE) {
+        std::swap(nv21[i], nv21[i + 1]);
+    }
+    EXPECT_EQ(nv12, nv21);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "memcpy_helper.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t ROW_PADDING = 64;
+
+std::vector<uint8_t> CreatePixels(size_t size)
+{
+    std::vector<uint8_t> pixels(size);
+    for (size_t idx = 0; idx < pixels.size(); idx++) {
+        pixels[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+    return pixels;
+}
+
+CopyInfo CreateCopyInfo(std::vector<uint8_t> &data, uint32_t width, uint32_t height, uint32_t rowStride,
+    IEffectFormat format)
+{
+    CopyInfo info = {
+        .bufferInfo = {
+            .width_ = width,
+            .height_ = height,
+            .len_ = static_cast<uint32_t>(data.size()),
+            .formatType_ = format,
+            .rowStride_ = rowStride,
+        },
+        .data = data.data(),
+    };
+    return info;
+}
+} // namespace
+
+class TestMemcpyHelper : public testing::Test {
+public:
+    TestMemcpyHelper() = default;
+
+    ~TestMemcpyHelper() override = default;
+
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        policy_ = MemcpyHelper::GetCopyPolicy();
+    }
+
+    void TearDown() override
+    {
+        MemcpyHelper::SetCopyPolicy(policy_);
+    }
+
+    CopyPolicy policy_;
+};
+
+HWTEST_F(TestMemcpyHelper, CopyData001, TestSize.Level1)
+{
+    // Force the parallel and non-temporal paths on a small image.
+    CopyPolicy policy;
+    policy.parallelThreshold = 1;
+    policy.nonTemporalThreshold = 1;
+    MemcpyHelper::SetCopyPolicy(policy);
+    EXPECT_EQ(MemcpyHelper::GetCopyPolicy().parallelThreshold, 1u);
+
+    uint32_t width = 333;
+    uint32_t height = 77;
+    uint32_t rowStride = width * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src = CreatePixels(static_cast<size_t>(rowStride) * height);
+    std::vector<uint8_t> dst(src.size(), 0);
+    CopyInfo srcInfo = CreateCopyInfo(src, width, height, rowStride, IEffectFormat::RGBA8888);
+    CopyInfo dstInfo = CreateCopyInfo(dst, width, height, rowStride, IEffectFormat::RGBA8888);
+    ASSERT_EQ(MemcpyHelper::CopyData(srcInfo, dstInfo), ErrorCode::SUCCESS);
+    EXPECT_EQ(dst, src);
+
+    // Stride mismatch copies row by row and leaves the destination padding untouched.
+    uint32_t dstRowStride = rowStride + ROW_PADDING;
+    std::vector<uint8_t> padded(static_cast<size_t>(dstRowStride) * height, 0);
+    CopyInfo paddedInfo = CreateCopyInfo(padded, width, height, dstRowStride, IEffectFormat::RGBA8888);
+    ASSERT_EQ(MemcpyHelper::CopyData(srcInfo, paddedInfo), ErrorCode::SUCCESS);
+    for (uint32_t row = 0; row < height; row++) {
+        ASSERT_TRUE(std::equal(src.begin() + row * rowStride, src.begin() + (row + 1) * rowStride,
+            padded.begin() + row * dstRowStride)) << "row " << row;
+        ASSERT_EQ(padded[row * dstRowStride + rowStride], 0) << "row " << row;
+    }
+
+    // A failed copy is reported instead of being swallowed.
+    EXPECT_EQ(MemcpyHelper::CopyData(srcInfo, srcInfo), ErrorCode::SUCCESS);
+    paddedInfo.bufferInfo.len_ = dstRowStride;
+    EXPECT_EQ(MemcpyHelper::CopyData(srcInfo, paddedInfo), ErrorCode::ERR_MEMCPY_FAIL);
+    paddedInfo.data = nullptr;
+    EXPECT_EQ(MemcpyHelper::CopyData(srcInfo, paddedInfo), ErrorCode::ERR_INPUT_NULL);
+}
+
+HWTEST_F(TestMemcpyHelper, CopyPlanes001, TestSize.Level1)
+{
+    CopyPolicy policy;
+    policy.parallelThreshold = 1;
+    MemcpyHelper::SetCopyPolicy(policy);
+
+    // P010 with a chroma plane that does not follow the luma plane directly.
+    uint32_t width = 130;
+    uint32_t height = 35;
+    uint32_t rowBytes = width * 2; // 2: bytes per p010 sample
+    uint32_t uvHeight = (height + 1) / 2; // 2: chroma is subsampled vertically
+    uint32_t srcStride = rowBytes + ROW_PADDING;
+    uint32_t dstStride = rowBytes;
+    std::vector<uint8_t> src = CreatePixels(static_cast<size_t>(srcStride) * (height + uvHeight + 1));
+    std::vector<uint8_t> dst(static_cast<size_t>(dstStride) * (height + uvHeight), 0);
+    std::vector<CopyPlane> srcPlanes = {
+        { src.data(), srcStride, rowBytes, height },
+        { src.data() + static_cast<size_t>(srcStride) * (height + 1), srcStride, rowBytes, uvHeight },
+    };
+    std::vector<CopyPlane> dstPlanes = {
+        { dst.data(), dstStride, rowBytes, height },
+        { dst.data() + static_cast<size_t>(dstStride) * height, dstStride, rowBytes, uvHeight },
+    };
+    ASSERT_EQ(MemcpyHelper::CopyPlanes(srcPlanes, dstPlanes), ErrorCode::SUCCESS);
+    for (size_t plane = 0; plane < srcPlanes.size(); plane++) {
+        for (uint32_t row = 0; row < srcPlanes[plane].rows; row++) {
+            const uint8_t *expected = srcPlanes[plane].data + static_cast<size_t>(row) * srcStride;
+            const uint8_t *actual = dstPlanes[plane].data + static_cast<size_t>(row) * dstStride;
+            ASSERT_TRUE(std::equal(expected, expected + rowBytes, actual)) << "plane " << plane << " row " << row;
+        }
+    }
+
+    EXPECT_EQ(MemcpyHelper::CopyPlanes(srcPlanes, { dstPlanes[0] }), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+    dstPlanes[1].rowBytes = dstStride + 1;
+    EXPECT_EQ(MemcpyHelper::CopyPlanes(srcPlanes, dstPlanes), ErrorCode::ERR_INVALID_PARAMETER_VALUE);
+    dstPlanes[1].data = nullptr;
+    EXPECT_EQ(MemcpyHelper::CopyPlanes(srcPlanes, dstPlanes), ErrorCode::ERR_INPUT_NULL);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -15,8 +15,12 @@
 
 #include "gtest/gtest.h"
 
+#include <chrono>
+
 #include "render_environment.h"
 #include "effect_context.h"
+#include "effect_memory_accountant.h"
+#include "effect_memory_pool.h"
 #include "graphic/render_frame_buffer.h"
 #include "mock_producer_surface.h"
 
@@ -32,6 +36,7 @@ constexpr uint32_t HEIGHT = 1280;
 constexpr IEffectFormat FORMATE_TYPE = IEffectFormat::RGBA8888;
 constexpr uint32_t ROW_STRIDE = WIDTH * 4;
 constexpr uint32_t LEN = ROW_STRIDE * HEIGHT;
+constexpr std::chrono::milliseconds RECLAIM_WAIT_TIMEOUT = std::chrono::milliseconds(2000);
 
 class TestRenderEnvironment : public testing::Test {
 public:
@@ -332,6 +337,28 @@ HWTEST_F(TestRenderEnvironment, DrawSurfaceBufferFromSurfaceBuffer_001, TestSize
     MockProducerSurface::ReleaseDmaBuffer(inBuffer);
     MockProducerSurface::ReleaseDmaBuffer(outBuffer);
 }
+
+HWTEST_F(TestRenderEnvironment, ResourceCacheReclaim_001, TestSize.Level1) {
+    // a reservation on the gl thread trims the texture cache at once instead of waiting for the next request.
+    RenderTexturePtr texptr = renderEnvironment->RequestBuffer(WIDTH, HEIGHT);
+    ASSERT_NE(texptr, nullptr);
+    texptr = nullptr;
+    EffectMemoryPool::Instance().Clear();
+
+    MemoryBudgetConfig originConfig = EffectMemoryAccountant::Instance().GetConfig();
+    MemoryBudgetConfig config;
+    config.budgetBytes = EffectMemoryAccountant::Instance().GetStats().currentBytes;
+    config.policy = MemoryBudgetPolicy::BLOCK;
+    config.waitTimeout = RECLAIM_WAIT_TIMEOUT;
+    EffectMemoryAccountant::Instance().SetConfig(config);
+
+    MemoryReservation reservation;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(reservation.Acquire(LEN));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, RECLAIM_WAIT_TIMEOUT);
+    reservation.Reset();
+    EffectMemoryAccountant::Instance().SetConfig(originConfig);
+}
 }
 }
 }
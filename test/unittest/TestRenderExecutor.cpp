@@ -0,0 +1,197 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "render_executor.h"
+#include "render_task.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t WORKER_NUM = 2;
+constexpr uint32_t STRAND_NUM = 6;
+constexpr uint32_t LOOP_NUM = 50;
+constexpr uint64_t FRAME_TAG = 1;
+constexpr std::chrono::milliseconds FRAME_COST = std::chrono::milliseconds(1);
+constexpr std::chrono::milliseconds STARVATION_TIMEOUT = std::chrono::milliseconds(3000);
+}
+
+class TestRenderExecutor : public testing::Test {
+public:
+    TestRenderExecutor() = default;
+    ~TestRenderExecutor() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() override {}
+    void TearDown() override
+    {
+        RenderExecutor::Instance().SetWorkerCount(0);
+    }
+};
+
+HWTEST_F(TestRenderExecutor, DedicatedStrand001, TestSize.Level1)
+{
+    RenderExecutor::Instance().SetWorkerCount(0);
+    std::shared_ptr<RenderStrand> strand = RenderExecutor::Instance().CreateStrand();
+    ASSERT_NE(strand, nullptr);
+    EXPECT_FALSE(strand->IsShared());
+
+    uint32_t count = 0;
+    for (uint32_t idx = 0; idx < LOOP_NUM; idx++) {
+        strand->AddTask(std::make_shared<RenderTask<>>([&count]() { count++; }));
+    }
+    strand->WaitTaskFinished();
+    EXPECT_EQ(count, LOOP_NUM);
+}
+
+HWTEST_F(TestRenderExecutor, SharedStrand001, TestSize.Level1)
+{
+    RenderExecutor::Instance().SetWorkerCount(WORKER_NUM);
+    EXPECT_EQ(RenderExecutor::Instance().GetWorkerCount(), WORKER_NUM);
+
+    std::mutex mutex;
+    std::set<std::thread::id> threadIds;
+    std::vector<std::vector<uint32_t>> orders(STRAND_NUM);
+    std::vector<uint32_t> enterCounts(STRAND_NUM, 0);
+    std::vector<std::shared_ptr<RenderStrand>> strands;
+    for (uint32_t strandIdx = 0; strandIdx < STRAND_NUM; strandIdx++) {
+        strands.emplace_back(RenderExecutor::Instance().CreateStrand(
+            [&enterCounts, strandIdx]() { enterCounts[strandIdx]++; }));
+        EXPECT_TRUE(strands.back()->IsShared());
+    }
+
+    for (uint32_t idx = 0; idx < LOOP_NUM; idx++) {
+        for (uint32_t strandIdx = 0; strandIdx < STRAND_NUM; strandIdx++) {
+            strands[strandIdx]->AddTask(std::make_shared<RenderTask<>>([&, strandIdx, idx]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                threadIds.insert(std::this_thread::get_id());
+                orders[strandIdx].push_back(idx);
+            }));
+        }
+    }
+    for (auto &strand : strands) {
+        strand->WaitTaskFinished();
+    }
+
+    // bounded thread count, and every strand keeps the order its tasks were added in.
+    EXPECT_LE(threadIds.size(), WORKER_NUM);
+    for (uint32_t strandIdx = 0; strandIdx < STRAND_NUM; strandIdx++) {
+        ASSERT_EQ(orders[strandIdx].size(), LOOP_NUM);
+        for (uint32_t idx = 0; idx < LOOP_NUM; idx++) {
+            EXPECT_EQ(orders[strandIdx][idx], idx);
+        }
+        EXPECT_GE(enterCounts[strandIdx], 1);
+    }
+}
+
+HWTEST_F(TestRenderExecutor, SharedStrand002, TestSize.Level1)
+{
+    RenderExecutor::Instance().SetWorkerCount(1);
+    std::shared_ptr<RenderStrand> strandA = RenderExecutor::Instance().CreateStrand();
+    std::shared_ptr<RenderStrand> strandB = RenderExecutor::Instance().CreateStrand();
+
+    // hold the worker so that the tasks below stay queued.
+    std::promise<void> gate;
+    std::shared_future<void> gateFuture = gate.get_future().share();
+    strandA->AddTask(std::make_shared<RenderTask<>>([gateFuture]() { gateFuture.wait(); }));
+
+    uint32_t countA = 0;
+    uint32_t countB = 0;
+    auto taskA = std::make_shared<RenderTask<>>([&countA]() { countA++; }, FRAME_TAG);
+    strandA->AddTask(taskA);
+    strandB->AddTask(std::make_shared<RenderTask<>>([&countB]() { countB++; }, FRAME_TAG));
+    // overwriting and clearing only ever touch the tasks of the own strand.
+    strandB->AddTask(std::make_shared<RenderTask<>>([&countB]() { countB += LOOP_NUM; }, FRAME_TAG), true);
+    strandA->ClearTask();
+    taskA->Wait();
+
+    gate.set_value();
+    strandB->WaitTaskFinished();
+    EXPECT_EQ(countA, 0);
+    EXPECT_EQ(countB, LOOP_NUM);
+}
+
+HWTEST_F(TestRenderExecutor, SharedStrand003, TestSize.Level1)
+{
+    RenderExecutor::Instance().SetWorkerCount(1);
+    std::shared_ptr<RenderStrand> frameStrand = RenderExecutor::Instance().CreateStrand();
+    std::shared_ptr<RenderStrand> stillStrand = RenderExecutor::Instance().CreateStrand();
+
+    // one strand keeps the shared worker queue full of interactive frames.
+    std::atomic<bool> isFlooding = true;
+    std::thread flood([&frameStrand, &isFlooding]() {
+        while (isFlooding.load()) {
+            auto frame = std::make_shared<RenderTask<>>([]() { std::this_thread::sleep_for(FRAME_COST); });
+            frame->SetPriority(RenderTaskPriority::INTERACTIVE);
+            frameStrand->AddTask(frame);
+        }
+    });
+
+    // the other strand still gets its task run and its barrier through.
+    std::atomic<bool> isStillRun = false;
+    auto still = std::make_shared<RenderTask<>>([&isStillRun]() { isStillRun = true; });
+    still->SetPriority(RenderTaskPriority::BACKGROUND);
+    std::future<void> waiter = std::async(std::launch::async, [&stillStrand, &still]() {
+        stillStrand->AddTask(still);
+        stillStrand->WaitTaskFinished();
+    });
+    EXPECT_EQ(waiter.wait_for(STARVATION_TIMEOUT), std::future_status::ready);
+    EXPECT_TRUE(isStillRun.load());
+
+    isFlooding = false;
+    flood.join();
+    frameStrand->WaitTaskFinished();
+    waiter.wait();
+}
+
+HWTEST_F(TestRenderExecutor, ReentrantAdd001, TestSize.Level1)
+{
+    for (uint32_t workerCount : { 0u, 1u }) {
+        RenderExecutor::Instance().SetWorkerCount(workerCount);
+        std::shared_ptr<RenderStrand> strand = RenderExecutor::Instance().CreateStrand();
+
+        // a task queues more tasks on its own strand than the worker queue holds, it must not wait for itself.
+        std::atomic<uint32_t> count = 0;
+        auto producer = std::make_shared<RenderTask<>>([&strand, &count]() {
+            for (uint32_t idx = 0; idx < LOOP_NUM; idx++) {
+                strand->AddTask(std::make_shared<RenderTask<>>([&count]() { count++; }));
+            }
+        });
+        strand->AddTask(producer);
+        std::future<void> waiter = std::async(std::launch::async, [&strand, &producer]() {
+            producer->Wait();
+            strand->WaitTaskFinished();
+        });
+        EXPECT_EQ(waiter.wait_for(STARVATION_TIMEOUT), std::future_status::ready);
+        waiter.wait();
+        EXPECT_EQ(count.load(), LOOP_NUM);
+    }
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
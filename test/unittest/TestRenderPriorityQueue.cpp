@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "render_fifo_queue.h"
+#include "render_priority_queue.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr size_t QUEUE_SIZE = 32;
+constexpr uint32_t STILL_TASK_NUM = 4;
+constexpr uint32_t FRAME_TASK_NUM = 8;
+constexpr std::chrono::milliseconds STILL_TASK_COST(20);
+constexpr std::chrono::milliseconds FRAME_TASK_COST(1);
+constexpr std::chrono::milliseconds FRAME_DEADLINE(40);
+constexpr uint64_t STILL_LANE = 1;
+constexpr uint64_t FRAME_LANE = 2;
+constexpr int64_t AGED_STEPS = 4; // more than enough for BACKGROUND to overtake a fresh INTERACTIVE task
+
+RenderCommonTaskPtr CreateTask(std::vector<uint64_t> &order, uint64_t id, RenderTaskPriority priority,
+    uint64_t lane = 0)
+{
+    auto task = std::make_shared<RenderTask<>>([&order, id]() { order.push_back(id); }, 0, id);
+    task->SetPriority(priority);
+    task->SetLane(lane);
+    return task;
+}
+
+// Still renders of one lane queued ahead of a burst of frames of another, returns how many frames finished past
+// their deadline.
+template <typename QUEUE> uint32_t RunSyntheticLoad()
+{
+    RenderThread<QUEUE> thread(QUEUE_SIZE);
+    thread.Start();
+    std::promise<void> gate;
+    std::shared_future<void> gateFuture = gate.get_future().share();
+    thread.AddTask(std::make_shared<RenderTask<>>([gateFuture]() { gateFuture.wait(); }));
+
+    for (uint32_t idx = 0; idx < STILL_TASK_NUM; idx++) {
+        auto task = std::make_shared<RenderTask<>>([]() { std::this_thread::sleep_for(STILL_TASK_COST); });
+        task->SetPriority(RenderTaskPriority::STILL);
+        task->SetLane(STILL_LANE);
+        thread.AddTask(task);
+    }
+    std::atomic<uint32_t> missedCount = 0;
+    std::vector<RenderCommonTaskPtr> frames;
+    RenderTaskClock::time_point deadline = RenderTaskClock::now() + FRAME_DEADLINE;
+    for (uint32_t idx = 0; idx < FRAME_TASK_NUM; idx++) {
+        auto task = std::make_shared<RenderTask<>>([&missedCount, deadline]() {
+            std::this_thread::sleep_for(FRAME_TASK_COST);
+            missedCount += RenderTaskClock::now() > deadline ? 1 : 0;
+        });
+        task->SetPriority(RenderTaskPriority::INTERACTIVE);
+        task->SetLane(FRAME_LANE);
+        task->SetDeadline(deadline);
+        thread.AddTask(task);
+        frames.emplace_back(task);
+    }
+
+    gate.set_value();
+    for (auto &frame : frames) {
+        frame->Wait();
+    }
+    thread.WaitTaskFinished();
+    return missedCount.load();
+}
+}
+
+class TestRenderPriorityQueue : public testing::Test {
+public:
+    TestRenderPriorityQueue() = default;
+    ~TestRenderPriorityQueue() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+HWTEST_F(TestRenderPriorityQueue, PushPop001, TestSize.Level1)
+{
+    RenderPriorityQueue<RenderCommonTaskPtr> queue;
+    std::vector<uint64_t> order;
+    RenderTaskClock::time_point now = RenderTaskClock::now();
+    queue.Push(CreateTask(order, 1, RenderTaskPriority::BACKGROUND, 1));
+    queue.Push(CreateTask(order, 2, RenderTaskPriority::STILL, 2)); // 2: lane
+    queue.Push(CreateTask(order, 3, RenderTaskPriority::INTERACTIVE, 2)); // 2: lane
+    RenderCommonTaskPtr late = CreateTask(order, 4, RenderTaskPriority::INTERACTIVE, 3); // 3: lane
+    late->SetDeadline(now + std::chrono::seconds(2));
+    queue.Push(late);
+    RenderCommonTaskPtr early = CreateTask(order, 5, RenderTaskPriority::INTERACTIVE, 4); // 4: lane
+    early->SetDeadline(now + std::chrono::seconds(1));
+    queue.Push(early);
+    EXPECT_EQ(queue.GetSize(), 5);
+
+    RenderCommonTaskPtr task = nullptr;
+    EXPECT_TRUE(queue.Front(task));
+    EXPECT_EQ(task->GetId(), 5);
+    EXPECT_TRUE(queue.Back(task));
+    EXPECT_EQ(task->GetId(), 5);
+    while (queue.Pop(task)) {
+        task->Run();
+    }
+    // lanes by the class and deadline of their first task, the interactive task 3 still waits for task 2 of its lane.
+    std::vector<uint64_t> expected = { 5, 4, 2, 3, 1 };
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(queue.GetSize(), 0);
+}
+
+HWTEST_F(TestRenderPriorityQueue, Aging001, TestSize.Level1)
+{
+    RenderPriorityQueue<RenderCommonTaskPtr> queue;
+    std::vector<uint64_t> order;
+    queue.Push(CreateTask(order, 1, RenderTaskPriority::BACKGROUND, 1));
+    queue.Push(CreateTask(order, 2, RenderTaskPriority::INTERACTIVE, 2)); // 2: lane
+    RenderCommonTaskPtr task = nullptr;
+    EXPECT_TRUE(queue.Front(task));
+    EXPECT_EQ(task->GetId(), 2);
+
+    // the background task has waited long enough to overtake fresh interactive tasks.
+    queue.m_lanes[1].front().pushTime -= RenderPriorityQueue<RenderCommonTaskPtr>::AGING_STEP * AGED_STEPS;
+    RenderCommonTaskPtr frame = CreateTask(order, 3, RenderTaskPriority::INTERACTIVE, 3); // 3: lane
+    frame->SetDeadline(RenderTaskClock::now() + std::chrono::seconds(1));
+    queue.Push(frame);
+    while (queue.Pop(task)) {
+        task->Run();
+    }
+    std::vector<uint64_t> expected = { 1, 3, 2 };
+    EXPECT_EQ(order, expected);
+}
+
+HWTEST_F(TestRenderPriorityQueue, Deadline001, TestSize.Level1)
+{
+    RenderPriorityQueue<RenderCommonTaskPtr> queue;
+    std::vector<uint64_t> order;
+    RenderTaskClock::time_point past = RenderTaskClock::now() - std::chrono::milliseconds(1);
+    RenderCommonTaskPtr stale = CreateTask(order, 1, RenderTaskPriority::INTERACTIVE);
+    stale->SetDeadline(past, true);
+    queue.Push(stale);
+    RenderCommonTaskPtr late = CreateTask(order, 2, RenderTaskPriority::INTERACTIVE);
+    late->SetDeadline(past);
+    queue.Push(late);
+    queue.Push(CreateTask(order, 3, RenderTaskPriority::STILL));
+
+    RenderCommonTaskPtr task = nullptr;
+    while (queue.Pop(task)) {
+        task->Run();
+    }
+    // the stale droppable task is discarded but its waiters are released, the late one still runs.
+    stale->Wait();
+    std::vector<uint64_t> expected = { 2, 3 };
+    EXPECT_EQ(order, expected);
+    EXPECT_EQ(queue.GetStats().droppedCount, 1);
+    EXPECT_EQ(queue.GetStats().lateCount, 1);
+    EXPECT_EQ(queue.GetSize(), 0);
+}
+
+HWTEST_F(TestRenderPriorityQueue, SyntheticLoad001, TestSize.Level1)
+{
+    uint32_t fifoMissed = RunSyntheticLoad<RenderFifoQueue<RenderCommonTaskPtr>>();
+    uint32_t priorityMissed = RunSyntheticLoad<RenderPriorityQueue<RenderCommonTaskPtr>>();
+    // first in first out runs the frames after 80ms of still renders, far past their 40ms deadline. The priority
+    // queue serves the frame lane first.
+    EXPECT_EQ(fifoMissed, FRAME_TASK_NUM);
+    EXPECT_EQ(priorityMissed, 0);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "render_ring_queue.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr size_t CAPACITY = 8;
+constexpr uint32_t PRODUCER_NUM = 4;
+constexpr uint32_t LOOP_NUM = 1000;
+constexpr uint32_t TAG_SHIFT = 16; // tags live in the high bits of the test values
+constexpr size_t SMALL_QUEUE_SIZE = 2;
+constexpr uint64_t CLEARED_TAG = 1;
+constexpr uint64_t KEPT_TAG = 2;
+constexpr std::chrono::milliseconds BLOCKED_CHECK_TIME = std::chrono::milliseconds(50);
+constexpr std::chrono::milliseconds RELEASE_TIMEOUT = std::chrono::milliseconds(2000);
+}
+
+class TestRenderRingQueue : public testing::Test {
+public:
+    TestRenderRingQueue() = default;
+    ~TestRenderRingQueue() override = default;
+
+    static void SetUpTestCase() {}
+    static void TearDownTestCase() {}
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+HWTEST_F(TestRenderRingQueue, PushPop001, TestSize.Level1)
+{
+    RenderRingQueue<uint32_t, CAPACITY> queue;
+    uint32_t value = 0;
+    EXPECT_FALSE(queue.Pop(value));
+    for (uint32_t idx = 0; idx < CAPACITY; idx++) {
+        EXPECT_TRUE(queue.Push(idx));
+    }
+    EXPECT_FALSE(queue.Push(CAPACITY));
+    EXPECT_EQ(queue.GetSize(), CAPACITY);
+    EXPECT_TRUE(queue.Front(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(queue.Back(value));
+    EXPECT_EQ(value, CAPACITY - 1);
+
+    // entries are cancelled in place and skipped, the order of the others is kept.
+    queue.Remove([](uint32_t &item) { return item % 2 == 0; });
+    EXPECT_EQ(queue.GetSize(), CAPACITY / 2); // 2: the even half is cancelled
+    for (uint32_t idx = 1; idx < CAPACITY; idx += 2) {
+        ASSERT_TRUE(queue.Pop(value));
+        EXPECT_EQ(value, idx);
+    }
+    EXPECT_FALSE(queue.Pop(value));
+    EXPECT_EQ(queue.GetSize(), 0);
+}
+
+HWTEST_F(TestRenderRingQueue, ReplacePush001, TestSize.Level1)
+{
+    RenderRingQueue<uint32_t, CAPACITY> queue;
+    auto isSameTag = [](uint32_t tag) {
+        return [tag](uint32_t &item) { return (item >> TAG_SHIFT) == tag; };
+    };
+    EXPECT_TRUE(queue.ReplacePush(1u << TAG_SHIFT, isSameTag(1)));
+    EXPECT_TRUE(queue.ReplacePush(2u << TAG_SHIFT, isSameTag(2)));
+    EXPECT_TRUE(queue.ReplacePush((1u << TAG_SHIFT) + 1, isSameTag(1)));
+    EXPECT_EQ(queue.GetSize(), 2);
+
+    // the newer task of tag 1 takes the place of the older one.
+    uint32_t value = 0;
+    ASSERT_TRUE(queue.Pop(value));
+    EXPECT_EQ(value, (1u << TAG_SHIFT) + 1);
+    ASSERT_TRUE(queue.Pop(value));
+    EXPECT_EQ(value, 2u << TAG_SHIFT);
+    EXPECT_FALSE(queue.Pop(value));
+}
+
+HWTEST_F(TestRenderRingQueue, MultiProducer001, TestSize.Level1)
+{
+    RenderRingQueue<uint32_t, CAPACITY> queue;
+    std::vector<std::thread> producers;
+    for (uint32_t producer = 0; producer < PRODUCER_NUM; producer++) {
+        producers.emplace_back([&queue, producer]() {
+            for (uint32_t loop = 0; loop < LOOP_NUM; loop++) {
+                while (!queue.Push((producer << TAG_SHIFT) | loop)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // every value arrives exactly once and in order per producer.
+    std::vector<uint32_t> nextLoop(PRODUCER_NUM, 0);
+    uint32_t received = 0;
+    uint32_t value = 0;
+    while (received < PRODUCER_NUM * LOOP_NUM) {
+        if (!queue.Pop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t producer = value >> TAG_SHIFT;
+        ASSERT_LT(producer, PRODUCER_NUM);
+        EXPECT_EQ(value & ((1u << TAG_SHIFT) - 1), nextLoop[producer]);
+        nextLoop[producer]++;
+        received++;
+    }
+    for (auto &thread : producers) {
+        thread.join();
+    }
+    EXPECT_EQ(queue.GetSize(), 0);
+}
+
+HWTEST_F(TestRenderRingQueue, RenderThread001, TestSize.Level1)
+{
+    RenderThread<RenderRingQueue<RenderTaskPtr<void>>> thread(CAPACITY);
+    thread.Start();
+    std::atomic<uint32_t> runCount = 0;
+    std::vector<RenderTaskPtr<void>> tasks;
+    for (uint32_t loop = 0; loop < LOOP_NUM; loop++) {
+        auto task = std::make_shared<RenderTask<>>([&runCount]() { runCount++; }, loop);
+        thread.AddTask(task);
+        tasks.emplace_back(task);
+    }
+    for (auto &task : tasks) {
+        task->Wait();
+    }
+    EXPECT_EQ(runCount.load(), LOOP_NUM);
+    thread.Stop();
+}
+
+HWTEST_F(TestRenderRingQueue, RenderThread002, TestSize.Level1)
+{
+    RenderThread<RenderRingQueue<RenderTaskPtr<void>>> thread(SMALL_QUEUE_SIZE);
+    thread.Start();
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    auto blocker = std::make_shared<RenderTask<>>([released]() { released.wait(); });
+    thread.AddTask(blocker);
+    while (thread.m_localMsgQueue->GetSize() != 0) {
+        std::this_thread::yield();
+    }
+
+    // fill the queue while the worker is busy, the next producer has to wait.
+    std::atomic<uint32_t> clearedRunCount = 0;
+    for (size_t idx = 0; idx < SMALL_QUEUE_SIZE; idx++) {
+        thread.AddTask(std::make_shared<RenderTask<>>([&clearedRunCount]() { clearedRunCount++; }, CLEARED_TAG));
+    }
+    auto kept = std::make_shared<RenderTask<>>([]() {}, KEPT_TAG);
+    std::future<void> producer = std::async(std::launch::async, [&thread, &kept]() { thread.AddTask(kept); });
+    EXPECT_EQ(producer.wait_for(BLOCKED_CHECK_TIME), std::future_status::timeout);
+
+    // cancelled cells no longer count against the queue size, so clearing them lets the producer in.
+    thread.ClearTask([](RenderTaskPtr<void> &task) { return GetTag(task) == CLEARED_TAG; });
+    EXPECT_EQ(producer.wait_for(RELEASE_TIMEOUT), std::future_status::ready);
+    release.set_value();
+    kept->Wait();
+    thread.WaitTaskFinished();
+    EXPECT_EQ(clearedRunCount.load(), 0);
+    thread.Stop();
+}
+
+HWTEST_F(TestRenderRingQueue, RenderThread003, TestSize.Level1)
+{
+    RenderThread<RenderRingQueue<RenderTaskPtr<void>, CAPACITY>> thread(SMALL_QUEUE_SIZE);
+    thread.Start();
+
+    // the worker adds more tasks than the ring has cells, the ones without a cell fail instead of running inline.
+    std::vector<uint32_t> order;
+    std::vector<RenderTaskPtr<void>> tasks;
+    auto producer = std::make_shared<RenderTask<>>([&thread, &order, &tasks]() {
+        for (uint32_t loop = 0; loop < LOOP_NUM; loop++) {
+            auto task = std::make_shared<RenderTask<>>([&order, loop]() { order.push_back(loop); }, loop);
+            tasks.push_back(task);
+            thread.AddTask(task);
+        }
+        EXPECT_TRUE(order.empty());
+    });
+    thread.AddTask(producer);
+    std::future<void> waiter = std::async(std::launch::async, [&thread, &producer]() {
+        producer->Wait();
+        thread.WaitTaskFinished();
+    });
+    EXPECT_EQ(waiter.wait_for(RELEASE_TIMEOUT), std::future_status::ready);
+    waiter.wait();
+    ASSERT_EQ(order.size(), CAPACITY);
+    for (uint32_t loop = 0; loop < CAPACITY; loop++) {
+        EXPECT_EQ(order[loop], loop);
+    }
+    ASSERT_EQ(tasks.size(), LOOP_NUM);
+    for (auto &task : tasks) {
+        EXPECT_EQ(task->GetFuture().wait_for(std::chrono::milliseconds(0)), std::future_status::ready);
+    }
+    thread.Stop();
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "effect_context.h"
+#include "efilter_cache_negotiate.h"
+#include "efilter_factory.h"
+#include "strip_renderer.h"
+#include "test_common.h"
+
+using namespace testing::ext;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t WIDTH = 640;
+constexpr uint32_t HEIGHT = 517;
+constexpr uint32_t ROW_PADDING = 16;
+
+std::shared_ptr<EFilter> CreateEFilter(const char *name, float intensity)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(name);
+    if (efilter != nullptr) {
+        Any value = intensity;
+        efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    }
+    return efilter;
+}
+
+std::shared_ptr<EffectBuffer> CreateRGBABuffer(std::vector<uint8_t> &data, uint32_t width, uint32_t height,
+    uint32_t rowStride)
+{
+    auto bufferInfo = std::make_shared<BufferInfo>();
+    bufferInfo->width_ = width;
+    bufferInfo->height_ = height;
+    bufferInfo->rowStride_ = rowStride;
+    bufferInfo->len_ = static_cast<uint32_t>(data.size());
+    bufferInfo->formatType_ = IEffectFormat::RGBA8888;
+    return std::make_shared<EffectBuffer>(bufferInfo, data.data(), std::make_shared<ExtraInfo>());
+}
+
+std::vector<uint8_t> CreatePixels(uint32_t rowStride, uint32_t height)
+{
+    std::vector<uint8_t> pixels(rowStride * height);
+    for (size_t idx = 0; idx < pixels.size(); idx++) {
+        pixels[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+    return pixels;
+}
+
+void SetOutputCap(const std::shared_ptr<EFilter> &efilter, uint32_t width, uint32_t height)
+{
+    std::string name = efilter->GetName();
+    efilter->outputCap_ = std::make_shared<Capability>(name);
+    efilter->outputCap_->memNegotiatedCap_ = std::make_shared<MemNegotiatedCap>();
+    efilter->outputCap_->memNegotiatedCap_->format = IEffectFormat::RGBA8888;
+    efilter->outputCap_->memNegotiatedCap_->width = width;
+    efilter->outputCap_->memNegotiatedCap_->height = height;
+}
+
+void ExpectSamePixels(const std::vector<uint8_t> &actual, const std::vector<uint8_t> &expected, uint32_t width,
+    uint32_t height, uint32_t rowStride)
+{
+    for (uint32_t row = 0; row < height; row++) {
+        for (uint32_t col = 0; col < width * RGBA_BYTES_PER_PIXEL; col++) {
+            ASSERT_EQ(actual[row * rowStride + col], expected[row * rowStride + col]) << "row " << row << " col " <<
+                col;
+        }
+    }
+}
+} // namespace
+
+class TestStripRenderer : public testing::Test {
+public:
+    TestStripRenderer() = default;
+
+    ~TestStripRenderer() override = default;
+
+    static void SetUpTestCase() {}
+
+    static void TearDownTestCase() {}
+
+    void SetUp() override
+    {
+        context_ = std::make_shared<EffectContext>();
+        context_->ipType_ = IPType::CPU;
+    }
+
+    void TearDown() override
+    {
+        context_ = nullptr;
+    }
+
+    std::shared_ptr<EffectContext> context_;
+};
+
+HWTEST_F(TestStripRenderer, CalculateStripRows001, TestSize.Level1)
+{
+    uint32_t rows = StripRenderer::CalculateStripRows(WIDTH * RGBA_BYTES_PER_PIXEL, HEIGHT);
+    EXPECT_GT(rows, 0u);
+    EXPECT_LE(rows, HEIGHT);
+    EXPECT_EQ(StripRenderer::CalculateStripRows(WIDTH * RGBA_BYTES_PER_PIXEL, 1), 1u);
+    EXPECT_EQ(StripRenderer::CalculateStripRows(UINT32_MAX, HEIGHT), StripRenderer::CalculateStripRows(UINT32_MAX,
+        HEIGHT + 1));
+
+    StripRenderer renderer({}, IEffectFormat::RGBA8888);
+    EXPECT_NE(renderer.Plan(WIDTH, HEIGHT), ErrorCode::SUCCESS);
+}
+
+HWTEST_F(TestStripRenderer, Render001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 30.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, -45.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint8_t> expected = CreatePixels(rowStride, HEIGHT);
+    std::shared_ptr<EffectBuffer> expectedBuffer = CreateRGBABuffer(expected, WIDTH, HEIGHT, rowStride);
+    ASSERT_EQ(brightness->Render(expectedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+    ASSERT_EQ(contrast->Render(expectedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+
+    StripRenderer renderer({ { brightness.get(), WIDTH, HEIGHT }, { contrast.get(), WIDTH, HEIGHT } },
+        IEffectFormat::RGBA8888);
+    ASSERT_EQ(renderer.Plan(WIDTH, HEIGHT), ErrorCode::SUCCESS);
+    EXPECT_TRUE(renderer.IsInPlaceSafe());
+    EXPECT_GE(renderer.GetStripCount(), 1u);
+    EXPECT_EQ(renderer.GetTail(), contrast.get());
+
+    // In place.
+    std::vector<uint8_t> inPlace = CreatePixels(rowStride, HEIGHT);
+    std::shared_ptr<EffectBuffer> inPlaceBuffer = CreateRGBABuffer(inPlace, WIDTH, HEIGHT, rowStride);
+    ASSERT_EQ(renderer.Render(inPlaceBuffer.get(), inPlaceBuffer.get(), context_), ErrorCode::SUCCESS);
+    EXPECT_EQ(inPlace, expected);
+
+    // Separate output with a different stride.
+    uint32_t dstRowStride = WIDTH * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src = CreatePixels(rowStride, HEIGHT);
+    std::vector<uint8_t> dst(dstRowStride * HEIGHT, 0);
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateRGBABuffer(src, WIDTH, HEIGHT, rowStride);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateRGBABuffer(dst, WIDTH, HEIGHT, dstRowStride);
+    ASSERT_EQ(renderer.Render(srcBuffer.get(), dstBuffer.get(), context_), ErrorCode::SUCCESS);
+    for (uint32_t row = 0; row < HEIGHT; row++) {
+        ASSERT_TRUE(std::equal(expected.begin() + row * rowStride, expected.begin() + row * rowStride + dstRowStride,
+            dst.begin() + row * dstRowStride)) << "row " << row;
+    }
+}
+
+HWTEST_F(TestStripRenderer, Render002, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, -20.f);
+    std::shared_ptr<EFilter> crop = EFilterFactory::Instance()->Create(CROP_EFILTER);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, 60.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(crop, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    uint32_t areaInfo[] = { 13, 29, 613, 500 }; // x0, y0, x1, y1
+    Any region = static_cast<void *>(areaInfo);
+    crop->SetValue(KEY_FILTER_REGION, region);
+    uint32_t cropWidth = areaInfo[2] - areaInfo[0];
+    uint32_t cropHeight = areaInfo[3] - areaInfo[1];
+
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL + ROW_PADDING;
+    std::vector<uint8_t> src = CreatePixels(rowStride, HEIGHT);
+    std::vector<uint8_t> origin = src;
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateRGBABuffer(src, WIDTH, HEIGHT, rowStride);
+
+    uint32_t dstRowStride = cropWidth * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> expected(dstRowStride * cropHeight, 0);
+    std::shared_ptr<EffectBuffer> expectedBuffer = CreateRGBABuffer(expected, cropWidth, cropHeight, dstRowStride);
+    std::vector<uint8_t> brightened = src;
+    std::shared_ptr<EffectBuffer> brightenedBuffer = CreateRGBABuffer(brightened, WIDTH, HEIGHT, rowStride);
+    ASSERT_EQ(brightness->Render(srcBuffer.get(), brightenedBuffer.get(), context_), ErrorCode::SUCCESS);
+    ASSERT_EQ(crop->Render(brightenedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+    ASSERT_EQ(contrast->Render(expectedBuffer.get(), expectedBuffer.get(), context_), ErrorCode::SUCCESS);
+
+    StripRenderer renderer({ { brightness.get(), WIDTH, HEIGHT }, { crop.get(), cropWidth, cropHeight },
+        { contrast.get(), cropWidth, cropHeight } }, IEffectFormat::RGBA8888);
+    ASSERT_EQ(renderer.Plan(WIDTH, HEIGHT), ErrorCode::SUCCESS);
+    EXPECT_FALSE(renderer.IsInPlaceSafe());
+
+    std::vector<uint8_t> dst(expected.size(), 0);
+    std::shared_ptr<EffectBuffer> dstBuffer = CreateRGBABuffer(dst, cropWidth, cropHeight, dstRowStride);
+    ASSERT_EQ(renderer.Render(srcBuffer.get(), dstBuffer.get(), context_), ErrorCode::SUCCESS);
+    ExpectSamePixels(dst, expected, cropWidth, cropHeight, dstRowStride);
+    EXPECT_EQ(src, origin);
+}
+
+HWTEST_F(TestStripRenderer, CreateStripRenderer001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, 30.f);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, -45.f);
+    ASSERT_NE(brightness, nullptr);
+    ASSERT_NE(contrast, nullptr);
+    SetOutputCap(brightness, WIDTH, HEIGHT);
+    SetOutputCap(contrast, WIDTH, HEIGHT);
+    brightness->SetStripFollowers({ contrast });
+    context_->cacheNegotiate_ = std::make_shared<EFilterCacheNegotiate>();
+    context_->isStripRenderEnabled_ = true;
+
+    uint32_t rowStride = WIDTH * RGBA_BYTES_PER_PIXEL;
+    std::vector<uint8_t> src = CreatePixels(rowStride, HEIGHT);
+    std::shared_ptr<EffectBuffer> srcBuffer = CreateRGBABuffer(src, WIDTH, HEIGHT, rowStride);
+    std::shared_ptr<StripRenderer> renderer = brightness->CreateStripRenderer(srcBuffer.get(), context_);
+    ASSERT_NE(renderer, nullptr);
+    EXPECT_EQ(renderer->GetTail(), contrast.get());
+
+    // A follower that takes part in caching needs HandleCacheStart from its own PushData.
+    contrast->cacheConfig_->SetStatus(CacheStatus::CACHE_START);
+    EXPECT_EQ(brightness->CreateStripRenderer(srcBuffer.get(), context_), nullptr);
+    contrast->cacheConfig_->SetStatus(CacheStatus::NO_CACHE);
+    EXPECT_NE(brightness->CreateStripRenderer(srcBuffer.get(), context_), nullptr);
+
+    // Strips only run on the cpu, the gpu path converts the buffer in PushData.
+    context_->ipType_ = IPType::GPU;
+    EXPECT_EQ(brightness->CreateStripRenderer(srcBuffer.get(), context_), nullptr);
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
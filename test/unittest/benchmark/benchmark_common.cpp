@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "benchmark_common.h"
+
+#include <algorithm>
+
+#include "format_helper.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr double NS_PER_SECOND = 1e9;
+constexpr double P50 = 0.5;
+constexpr double P99 = 0.99;
+constexpr int64_t RESOLUTIONS[][2] = {
+    { 1920, 1080 },
+    { 3840, 2160 },
+    { 7680, 4320 },
+};
+} // namespace
+
+void BenchmarkCommon::ApplyResolutions(benchmark::internal::Benchmark *bench)
+{
+    bench->ArgNames({ "width", "height" });
+    for (const auto &resolution : RESOLUTIONS) {
+        bench->Args({ resolution[0], resolution[1] });
+    }
+    bench->Unit(benchmark::kMillisecond)->UseRealTime();
+}
+
+std::unique_ptr<BenchmarkImage> BenchmarkCommon::CreateImage(uint32_t width, uint32_t height, IEffectFormat format,
+    uint32_t rowPadding)
+{
+    uint32_t rowStride = FormatHelper::CalculateRowStride(width, format) + rowPadding;
+    uint32_t rowCount = FormatHelper::CalculateDataRowCount(height, format);
+    std::unique_ptr<BenchmarkImage> image = std::make_unique<BenchmarkImage>();
+    image->data.resize(static_cast<size_t>(rowStride) * rowCount);
+    for (size_t idx = 0; idx < image->data.size(); idx++) {
+        image->data[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>();
+    bufferInfo->width_ = width;
+    bufferInfo->height_ = height;
+    bufferInfo->rowStride_ = rowStride;
+    bufferInfo->len_ = static_cast<uint32_t>(image->data.size());
+    bufferInfo->formatType_ = format;
+    bufferInfo->bufferType_ = BufferType::HEAP_MEMORY;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    extraInfo->dataType = DataType::PIXEL_MAP;
+    extraInfo->bufferType = BufferType::HEAP_MEMORY;
+    image->buffer = std::make_shared<EffectBuffer>(bufferInfo, image->data.data(), extraInfo);
+    return image;
+}
+
+void BenchmarkCommon::SetPixelCounters(benchmark::State &state, uint64_t pixels, uint64_t bytes)
+{
+    // kInvert turns pixels per second into seconds per pixel, scaled so that the result reads as ns.
+    state.counters["ns/pixel"] = benchmark::Counter(static_cast<double>(pixels) / NS_PER_SECOND,
+        benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    state.SetBytesProcessed(static_cast<int64_t>(bytes) * static_cast<int64_t>(state.iterations()));
+}
+
+void BenchmarkCommon::SetLatencyCounters(benchmark::State &state, std::vector<double> &latenciesUs)
+{
+    if (latenciesUs.empty()) {
+        return;
+    }
+    std::sort(latenciesUs.begin(), latenciesUs.end());
+    size_t last = latenciesUs.size() - 1;
+    state.counters["p50_us"] = latenciesUs[static_cast<size_t>(last * P50)];
+    state.counters["p99_us"] = latenciesUs[static_cast<size_t>(last * P99)];
+}
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef IMAGE_EFFECT_BENCHMARK_COMMON_H
+#define IMAGE_EFFECT_BENCHMARK_COMMON_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "effect_buffer.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+struct BenchmarkImage {
+    std::vector<uint8_t> data;
+    std::shared_ptr<EffectBuffer> buffer;
+};
+
+class BenchmarkCommon {
+public:
+    // 1080p, 4K and 8K as (width, height) argument pairs.
+    static void ApplyResolutions(benchmark::internal::Benchmark *bench);
+
+    static std::unique_ptr<BenchmarkImage> CreateImage(uint32_t width, uint32_t height, IEffectFormat format,
+        uint32_t rowPadding = 0);
+
+    // reports ns/pixel and bytes per second of the work done by one iteration.
+    static void SetPixelCounters(benchmark::State &state, uint64_t pixels, uint64_t bytes);
+
+    // reports the p50 and p99 of latencies sampled once per iteration, in microseconds.
+    static void SetLatencyCounters(benchmark::State &state, std::vector<double> &latenciesUs);
+};
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+#endif // IMAGE_EFFECT_BENCHMARK_COMMON_H
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <map>
+#include <string>
+
+#include "benchmark_common.h"
+#include "cpu_brightness_algo.h"
+#include "cpu_contrast_algo.h"
+#include "effect_context.h"
+#include "effect_memory.h"
+#include "format_helper.h"
+#include "memcpy_helper.h"
+#include "test_common.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr float BRIGHTNESS_INTENSITY = 50.f;
+constexpr float CONTRAST_INTENSITY = -30.f;
+constexpr uint32_t ROW_PADDING = 64;
+constexpr uint32_t READ_AND_WRITE = 2;
+constexpr int64_t POWER_OF_TWO_WIDTH = 4096;
+constexpr int64_t UHD_HEIGHT = 2160;
+
+using CpuAlgoFunc = ErrorCode (*)(EffectBuffer *src, EffectBuffer *dst, std::map<std::string, Any> &value,
+    std::shared_ptr<EffectContext> &context);
+
+void BM_CpuAlgo(benchmark::State &state, CpuAlgoFunc func, IEffectFormat format, float intensity)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    std::unique_ptr<BenchmarkImage> src = BenchmarkCommon::CreateImage(width, height, format);
+    std::unique_ptr<BenchmarkImage> dst = BenchmarkCommon::CreateImage(width, height, format);
+    std::map<std::string, Any> values = { { KEY_FILTER_INTENSITY, intensity } };
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    context->ipType_ = IPType::CPU;
+
+    for (auto _ : state) {
+        ErrorCode res = func(src->buffer.get(), dst->buffer.get(), values, context);
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("cpu algo render fail!");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height,
+        static_cast<uint64_t>(src->data.size()) * READ_AND_WRITE);
+}
+
+BENCHMARK_CAPTURE(BM_CpuAlgo, Brightness_RGBA8888, CpuBrightnessAlgo::OnApplyRGBA8888, IEffectFormat::RGBA8888,
+    BRIGHTNESS_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CpuAlgo, Brightness_NV21, CpuBrightnessAlgo::OnApplyYUVNV21, IEffectFormat::YUVNV21,
+    BRIGHTNESS_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CpuAlgo, Brightness_NV12, CpuBrightnessAlgo::OnApplyYUVNV12, IEffectFormat::YUVNV12,
+    BRIGHTNESS_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CpuAlgo, Contrast_RGBA8888, CpuContrastAlgo::OnApplyRGBA8888, IEffectFormat::RGBA8888,
+    CONTRAST_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CpuAlgo, Contrast_NV21, CpuContrastAlgo::OnApplyYUVNV21, IEffectFormat::YUVNV21,
+    CONTRAST_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CpuAlgo, Contrast_NV12, CpuContrastAlgo::OnApplyYUVNV12, IEffectFormat::YUVNV12,
+    CONTRAST_INTENSITY)->Apply(BenchmarkCommon::ApplyResolutions);
+
+void BM_ConvertFormat(benchmark::State &state, IEffectFormat srcFormat, IEffectFormat dstFormat)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    std::unique_ptr<BenchmarkImage> src = BenchmarkCommon::CreateImage(width, height, srcFormat);
+    std::unique_ptr<BenchmarkImage> dst = BenchmarkCommon::CreateImage(width, height, dstFormat);
+    FormatConverterInfo srcInfo = { .bufferInfo = *src->buffer->bufferInfo_, .buffer = src->buffer->buffer_ };
+    FormatConverterInfo dstInfo = { .bufferInfo = *dst->buffer->bufferInfo_, .buffer = dst->buffer->buffer_ };
+
+    for (auto _ : state) {
+        ErrorCode res = FormatHelper::ConvertFormat(srcInfo, dstInfo);
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("convert format fail!");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height,
+        static_cast<uint64_t>(src->data.size()) + dst->data.size());
+}
+
+BENCHMARK_CAPTURE(BM_ConvertFormat, RGBA8888_To_NV12, IEffectFormat::RGBA8888, IEffectFormat::YUVNV12)
+    ->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_ConvertFormat, RGBA8888_To_NV21, IEffectFormat::RGBA8888, IEffectFormat::YUVNV21)
+    ->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_ConvertFormat, NV12_To_RGBA8888, IEffectFormat::YUVNV12, IEffectFormat::RGBA8888)
+    ->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_ConvertFormat, NV21_To_RGBA8888, IEffectFormat::YUVNV21, IEffectFormat::RGBA8888)
+    ->Apply(BenchmarkCommon::ApplyResolutions);
+
+// isSerial copies on the caller thread with regular stores, as a baseline for the pooled default policy.
+void BM_CopyData(benchmark::State &state, uint32_t srcRowPadding, bool isSerial)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    std::unique_ptr<BenchmarkImage> src =
+        BenchmarkCommon::CreateImage(width, height, IEffectFormat::RGBA8888, srcRowPadding);
+    std::unique_ptr<BenchmarkImage> dst = BenchmarkCommon::CreateImage(width, height, IEffectFormat::RGBA8888);
+    CopyPolicy policy = MemcpyHelper::GetCopyPolicy();
+    if (isSerial) {
+        CopyPolicy serialPolicy;
+        serialPolicy.maxWorkers = 1;
+        serialPolicy.nonTemporalThreshold = SIZE_MAX;
+        MemcpyHelper::SetCopyPolicy(serialPolicy);
+    }
+
+    for (auto _ : state) {
+        MemcpyHelper::CopyData(src->buffer.get(), dst->buffer.get());
+        benchmark::ClobberMemory();
+    }
+    MemcpyHelper::SetCopyPolicy(policy);
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height,
+        static_cast<uint64_t>(dst->data.size()) * READ_AND_WRITE);
+}
+
+BENCHMARK_CAPTURE(BM_CopyData, Contiguous, 0, false)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CopyData, Contiguous_Serial, 0, true)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CopyData, RowByRow, ROW_PADDING, false)->Apply(BenchmarkCommon::ApplyResolutions);
+BENCHMARK_CAPTURE(BM_CopyData, RowByRow_Serial, ROW_PADDING, true)->Apply(BenchmarkCommon::ApplyResolutions);
+
+struct HeapImage {
+    std::shared_ptr<MemoryData> memoryData;
+    std::shared_ptr<EffectBuffer> buffer;
+};
+
+// the image lives in a HeapMemory, so that its alignment and row stride are the ones filters actually get.
+std::unique_ptr<HeapImage> CreateHeapImage(uint32_t width, uint32_t height, IEffectFormat format,
+    RowStridePolicy policy)
+{
+    MemoryInfo memInfo = {
+        .bufferInfo = {
+            .width_ = width,
+            .height_ = height,
+            .len_ = FormatHelper::CalculateSize(width, height, format),
+            .formatType_ = format,
+        },
+        .bufferType = BufferType::HEAP_MEMORY,
+        .rowStridePolicy = policy,
+    };
+    std::unique_ptr<HeapImage> image = std::make_unique<HeapImage>();
+    image->memoryData = HeapMemory().Alloc(memInfo);
+    if (image->memoryData == nullptr) {
+        return nullptr;
+    }
+    auto *data = static_cast<uint8_t *>(image->memoryData->data);
+    for (uint32_t idx = 0; idx < image->memoryData->memoryInfo.bufferInfo.len_; idx++) {
+        data[idx] = static_cast<uint8_t>(idx * 37 + 11); // 37, 11: arbitrary pattern covering all values
+    }
+
+    std::shared_ptr<BufferInfo> bufferInfo = std::make_shared<BufferInfo>(image->memoryData->memoryInfo.bufferInfo);
+    bufferInfo->bufferType_ = BufferType::HEAP_MEMORY;
+    std::shared_ptr<ExtraInfo> extraInfo = std::make_shared<ExtraInfo>();
+    extraInfo->dataType = DataType::PIXEL_MAP;
+    extraInfo->bufferType = BufferType::HEAP_MEMORY;
+    image->buffer = std::make_shared<EffectBuffer>(bufferInfo, data, extraInfo);
+    return image;
+}
+
+// 4096 wide rows are a multiple of 4KB apart when packed, padded strides move them off the aliasing cache sets.
+void BM_HeapStrideBrightness(benchmark::State &state, RowStridePolicy policy)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    std::unique_ptr<HeapImage> src = CreateHeapImage(width, height, IEffectFormat::RGBA8888, policy);
+    std::unique_ptr<HeapImage> dst = CreateHeapImage(width, height, IEffectFormat::RGBA8888, policy);
+    if (src == nullptr || dst == nullptr) {
+        state.SkipWithError("alloc heap memory fail!");
+        return;
+    }
+    std::map<std::string, Any> values = { { KEY_FILTER_INTENSITY, BRIGHTNESS_INTENSITY } };
+    std::shared_ptr<EffectContext> context = std::make_shared<EffectContext>();
+    context->ipType_ = IPType::CPU;
+
+    for (auto _ : state) {
+        ErrorCode res = CpuBrightnessAlgo::OnApplyRGBA8888(src->buffer.get(), dst->buffer.get(), values, context);
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("cpu algo render fail!");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height,
+        static_cast<uint64_t>(FormatHelper::CalculateSize(width, height, IEffectFormat::RGBA8888)) * READ_AND_WRITE);
+}
+
+BENCHMARK_CAPTURE(BM_HeapStrideBrightness, Packed, RowStridePolicy::PACKED)
+    ->Args({ POWER_OF_TWO_WIDTH, UHD_HEIGHT })->Args({ POWER_OF_TWO_WIDTH, POWER_OF_TWO_WIDTH });
+BENCHMARK_CAPTURE(BM_HeapStrideBrightness, SimdAligned, RowStridePolicy::SIMD_ALIGNED)
+    ->Args({ POWER_OF_TWO_WIDTH, UHD_HEIGHT })->Args({ POWER_OF_TWO_WIDTH, POWER_OF_TWO_WIDTH });
+
+void BM_HeapStrideConvert(benchmark::State &state, RowStridePolicy policy)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    std::unique_ptr<HeapImage> src = CreateHeapImage(width, height, IEffectFormat::YUVNV12, policy);
+    std::unique_ptr<HeapImage> dst = CreateHeapImage(width, height, IEffectFormat::RGBA8888, policy);
+    if (src == nullptr || dst == nullptr) {
+        state.SkipWithError("alloc heap memory fail!");
+        return;
+    }
+    FormatConverterInfo srcInfo = { .bufferInfo = *src->buffer->bufferInfo_, .buffer = src->buffer->buffer_ };
+    FormatConverterInfo dstInfo = { .bufferInfo = *dst->buffer->bufferInfo_, .buffer = dst->buffer->buffer_ };
+
+    for (auto _ : state) {
+        ErrorCode res = FormatHelper::ConvertFormat(srcInfo, dstInfo);
+        if (res != ErrorCode::SUCCESS) {
+            state.SkipWithError("convert format fail!");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height,
+        static_cast<uint64_t>(FormatHelper::CalculateSize(width, height, IEffectFormat::YUVNV12)) +
+        FormatHelper::CalculateSize(width, height, IEffectFormat::RGBA8888));
+}
+
+BENCHMARK_CAPTURE(BM_HeapStrideConvert, NV12_To_RGBA8888_Packed, RowStridePolicy::PACKED)
+    ->Args({ POWER_OF_TWO_WIDTH, UHD_HEIGHT })->Args({ POWER_OF_TWO_WIDTH, POWER_OF_TWO_WIDTH });
+BENCHMARK_CAPTURE(BM_HeapStrideConvert, NV12_To_RGBA8888_SimdAligned, RowStridePolicy::SIMD_ALIGNED)
+    ->Args({ POWER_OF_TWO_WIDTH, UHD_HEIGHT })->Args({ POWER_OF_TWO_WIDTH, POWER_OF_TWO_WIDTH });
+} // namespace
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
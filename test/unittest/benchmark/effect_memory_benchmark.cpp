@@ -0,0 +1,189 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <sys/resource.h>
+
+#include "benchmark_common.h"
+#include "effect_memory_manager.h"
+#include "effect_memory_pool.h"
+#include "format_helper.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+MemoryInfo CreateMemoryInfo(uint32_t width, uint32_t height)
+{
+    MemoryInfo memInfo = {
+        .bufferInfo = {
+            .width_ = width,
+            .height_ = height,
+            .len_ = FormatHelper::CalculateSize(width, height, IEffectFormat::RGBA8888),
+            .formatType_ = IEffectFormat::RGBA8888,
+            .colorSpace_ = EffectColorSpace::SRGB,
+        },
+        .bufferType = BufferType::HEAP_MEMORY,
+    };
+    return memInfo;
+}
+
+// a fresh heap allocation and its release, as seen by the first filter of every render.
+void BM_AllocMemoryNew(benchmark::State &state)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    MemoryInfo memInfo = CreateMemoryInfo(width, height);
+    // keep the cross render pool out of the way, it would turn every iteration into a reuse.
+    MemoryPoolConfig poolConfig = EffectMemoryPool::Instance().GetConfig();
+    MemoryPoolConfig noPoolConfig = poolConfig;
+    noPoolConfig.maxRetainedBytes = 0;
+    EffectMemoryPool::Instance().SetConfig(noPoolConfig);
+
+    for (auto _ : state) {
+        MemoryData *memData = memoryManager.AllocMemory(nullptr, memInfo);
+        if (memData == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            break;
+        }
+        benchmark::DoNotOptimize(memData->data);
+        memoryManager.ClearMemory();
+    }
+    EffectMemoryPool::Instance().SetConfig(poolConfig);
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height, memInfo.bufferInfo.len_);
+}
+
+BENCHMARK(BM_AllocMemoryNew)->Apply(BenchmarkCommon::ApplyResolutions);
+
+// a lookup that reuses a cached memory among range(2) others of different sizes.
+void BM_AllocMemoryReuse(benchmark::State &state)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    uint32_t cachedCount = static_cast<uint32_t>(state.range(2));
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    for (uint32_t idx = 1; idx <= cachedCount; idx++) {
+        MemoryInfo other = CreateMemoryInfo(width / (idx + 1), height / (idx + 1));
+        if (memoryManager.AllocMemory(nullptr, other) == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            return;
+        }
+    }
+    MemoryInfo memInfo = CreateMemoryInfo(width, height);
+    memoryManager.AllocMemory(nullptr, memInfo);
+
+    for (auto _ : state) {
+        MemoryData *memData = memoryManager.AllocMemory(nullptr, memInfo);
+        if (memData == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            break;
+        }
+        benchmark::DoNotOptimize(memData->data);
+    }
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height, memInfo.bufferInfo.len_);
+}
+
+BENCHMARK(BM_AllocMemoryReuse)->ArgNames({ "width", "height", "cached" })->Args({ 1920, 1080, 2 })
+    ->Args({ 1920, 1080, 10 })->Args({ 1920, 1080, 50 });
+
+// a filter chain ping-ponging between two memories while range(0) memories in total are live in the manager.
+void BM_AllocMemoryPingPong(benchmark::State &state)
+{
+    uint32_t liveCount = static_cast<uint32_t>(state.range(0));
+    constexpr uint32_t width = 1920;
+    constexpr uint32_t height = 1080;
+    constexpr uint32_t pingPongCount = 2;
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    for (uint32_t idx = 1; idx + pingPongCount <= liveCount; idx++) {
+        MemoryInfo other = CreateMemoryInfo(width / (idx + 1), height / (idx + 1));
+        if (memoryManager.AllocMemory(nullptr, other) == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            return;
+        }
+    }
+    MemoryInfo memInfo = CreateMemoryInfo(width, height);
+    void *srcAddr = nullptr;
+
+    for (auto _ : state) {
+        MemoryData *memData = memoryManager.AllocMemory(srcAddr, memInfo);
+        if (memData == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            break;
+        }
+        srcAddr = memData->data;
+        benchmark::DoNotOptimize(srcAddr);
+    }
+}
+
+BENCHMARK(BM_AllocMemoryPingPong)->ArgName("live")->Arg(2)->Arg(10)->Arg(50);
+
+long GetMinorFaults()
+{
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_minflt;
+}
+
+// a fresh large buffer and the first full pass over it, range(2) selects plain malloc (0), huge pages (1), pre-faulted
+// malloc (2) or pre-faulted huge pages (3). The faults counter is the page faults taken per iteration.
+void BM_LargeHeapFirstTouch(benchmark::State &state)
+{
+    uint32_t width = static_cast<uint32_t>(state.range(0));
+    uint32_t height = static_cast<uint32_t>(state.range(1));
+    uint32_t mode = static_cast<uint32_t>(state.range(2));
+    LargeHeapPolicy policy;
+    policy.isHugePageEnabled = (mode & 1) != 0;
+    policy.isPrefaultEnabled = (mode & 2) != 0;
+    EffectMemoryManager memoryManager;
+    memoryManager.SetIPType(IPType::CPU);
+    memoryManager.SetLargeHeapPolicy(policy);
+    MemoryInfo memInfo = CreateMemoryInfo(width, height);
+    MemoryPoolConfig poolConfig = EffectMemoryPool::Instance().GetConfig();
+    MemoryPoolConfig noPoolConfig = poolConfig;
+    noPoolConfig.maxRetainedBytes = 0;
+    EffectMemoryPool::Instance().SetConfig(noPoolConfig);
+
+    long faults = 0;
+    for (auto _ : state) {
+        long faultsBegin = GetMinorFaults();
+        MemoryData *memData = memoryManager.AllocMemory(nullptr, memInfo);
+        if (memData == nullptr) {
+            state.SkipWithError("alloc memory fail!");
+            break;
+        }
+        uint32_t len = memData->memoryInfo.bufferInfo.len_;
+        memset_s(memData->data, len, 0, len);
+        benchmark::ClobberMemory();
+        faults += GetMinorFaults() - faultsBegin;
+        memoryManager.ClearMemory();
+    }
+    EffectMemoryPool::Instance().SetConfig(poolConfig);
+    state.counters["faults"] = benchmark::Counter(static_cast<double>(faults), benchmark::Counter::kAvgIterations);
+    BenchmarkCommon::SetPixelCounters(state, static_cast<uint64_t>(width) * height, memInfo.bufferInfo.len_);
+}
+
+// 50MP, the size the policy is meant for.
+BENCHMARK(BM_LargeHeapFirstTouch)->ArgNames({ "width", "height", "mode" })->Args({ 8192, 6144, 0 })
+    ->Args({ 8192, 6144, 1 })->Args({ 8192, 6144, 2 })->Args({ 8192, 6144, 3 })->Unit(benchmark::kMillisecond);
+} // namespace
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
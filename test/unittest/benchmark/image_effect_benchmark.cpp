@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <string>
+
+#include "benchmark_common.h"
+#include "efilter_factory.h"
+#include "image_effect_inner.h"
+#include "mock_picture.h"
+#include "mock_pixel_map.h"
+#include "test_common.h"
+#include "test_pixel_map_utils.h"
+
+using ::testing::NiceMock;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+constexpr char TEST_IMAGE_PATH[] = "/data/test/resource/image_effect_1k_test1.jpg";
+constexpr char BATCH_OUTPUT_PATH_PREFIX[] = "/data/test/resource/image_effect_benchmark_batch_";
+constexpr uint32_t BATCH_ITEM_COUNT = 8;
+constexpr char RUNNING_TYPE[] = "runningType";
+constexpr int32_t RUNNING_TYPE_CPU = 2; // background running type only renders with cpu
+constexpr float BRIGHTNESS_INTENSITY = 50.f;
+constexpr float CONTRAST_INTENSITY = -30.f;
+constexpr uint32_t RGBA_BYTES_PER_PIXEL = 4;
+constexpr uint32_t READ_AND_WRITE = 2;
+
+std::shared_ptr<EFilter> CreateEFilter(const char *name, float intensity)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(name);
+    if (efilter != nullptr) {
+        Any value = intensity;
+        efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    }
+    return efilter;
+}
+
+// brightness followed by contrast, running on cpu with heap buffers.
+std::unique_ptr<ImageEffect> CreateImageEffect()
+{
+    std::shared_ptr<EFilter> brightness = CreateEFilter(BRIGHTNESS_EFILTER, BRIGHTNESS_INTENSITY);
+    std::shared_ptr<EFilter> contrast = CreateEFilter(CONTRAST_EFILTER, CONTRAST_INTENSITY);
+    if (brightness == nullptr || contrast == nullptr) {
+        return nullptr;
+    }
+    std::unique_ptr<ImageEffect> imageEffect = std::make_unique<ImageEffect>(IMAGE_EFFECT_NAME);
+    imageEffect->AddEFilter(brightness);
+    imageEffect->AddEFilter(contrast);
+    Any runningType = RUNNING_TYPE_CPU;
+    if (imageEffect->Configure(RUNNING_TYPE, runningType) != ErrorCode::SUCCESS) {
+        return nullptr;
+    }
+    return imageEffect;
+}
+
+void RunImageEffect(benchmark::State &state, ImageEffect *imageEffect, uint64_t pixels)
+{
+    for (auto _ : state) {
+        if (imageEffect->Start() != ErrorCode::SUCCESS) {
+            state.SkipWithError("image effect render fail!");
+            break;
+        }
+    }
+    BenchmarkCommon::SetPixelCounters(state, pixels, pixels * RGBA_BYTES_PER_PIXEL * READ_AND_WRITE);
+}
+
+void BM_RenderPixelMap(benchmark::State &state)
+{
+    int32_t width = static_cast<int32_t>(state.range(0));
+    int32_t height = static_cast<int32_t>(state.range(1));
+    NiceMock<MockPixelMap> pixelMap(width, height);
+    std::unique_ptr<ImageEffect> imageEffect = CreateImageEffect();
+    if (imageEffect == nullptr || imageEffect->SetInputPixelMap(&pixelMap) != ErrorCode::SUCCESS) {
+        state.SkipWithError("create image effect fail!");
+        return;
+    }
+    RunImageEffect(state, imageEffect.get(), static_cast<uint64_t>(width) * static_cast<uint64_t>(height));
+}
+
+BENCHMARK(BM_RenderPixelMap)->Apply(BenchmarkCommon::ApplyResolutions);
+
+void BM_RenderPicture(benchmark::State &state)
+{
+    std::shared_ptr<Picture> picture = std::make_shared<MockPicture>();
+    std::shared_ptr<PixelMap> mainPixelMap = picture->GetMainPixel();
+    std::unique_ptr<ImageEffect> imageEffect = CreateImageEffect();
+    if (mainPixelMap == nullptr || imageEffect == nullptr ||
+        imageEffect->SetInputPicture(picture.get()) != ErrorCode::SUCCESS) {
+        state.SkipWithError("create image effect fail!");
+        return;
+    }
+    RunImageEffect(state, imageEffect.get(),
+        static_cast<uint64_t>(mainPixelMap->GetWidth()) * static_cast<uint64_t>(mainPixelMap->GetHeight()));
+}
+
+BENCHMARK(BM_RenderPicture)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_RenderResourceImage(benchmark::State &state)
+{
+    std::unique_ptr<PixelMap> pixelMap = TestPixelMapUtils::ParsePixelMapByPath(TEST_IMAGE_PATH);
+    std::unique_ptr<ImageEffect> imageEffect = CreateImageEffect();
+    if (pixelMap == nullptr || imageEffect == nullptr ||
+        imageEffect->SetInputPixelMap(pixelMap.get()) != ErrorCode::SUCCESS) {
+        state.SkipWithError("decode test resource fail!");
+        return;
+    }
+    RunImageEffect(state, imageEffect.get(),
+        static_cast<uint64_t>(pixelMap->GetWidth()) * static_cast<uint64_t>(pixelMap->GetHeight()));
+}
+
+BENCHMARK(BM_RenderResourceImage)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+std::vector<BatchRenderItem> CreateBatchItems()
+{
+    std::vector<BatchRenderItem> items;
+    for (uint32_t i = 0; i < BATCH_ITEM_COUNT; ++i) {
+        items.push_back({ TEST_IMAGE_PATH, BATCH_OUTPUT_PATH_PREFIX + std::to_string(i) + ".jpg" });
+    }
+    return items;
+}
+
+// an album with one preset the way it is done without the batch api: set the paths and start for each file.
+void BM_RenderPathLoop(benchmark::State &state)
+{
+    std::unique_ptr<ImageEffect> imageEffect = CreateImageEffect();
+    if (imageEffect == nullptr) {
+        state.SkipWithError("create image effect fail!");
+        return;
+    }
+    std::vector<BatchRenderItem> items = CreateBatchItems();
+    for (auto _ : state) {
+        for (const auto &item : items) {
+            if (imageEffect->SetInputPath(item.inputPath) != ErrorCode::SUCCESS ||
+                imageEffect->SetOutputPath(item.outputPath) != ErrorCode::SUCCESS ||
+                imageEffect->Start() != ErrorCode::SUCCESS) {
+                state.SkipWithError("image effect render fail!");
+                return;
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_RenderPathLoop)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// the same album through the batch api, overlapping decode, render and encode of up to range(0) files.
+void BM_RenderPathBatch(benchmark::State &state)
+{
+    std::unique_ptr<ImageEffect> imageEffect = CreateImageEffect();
+    if (imageEffect == nullptr) {
+        state.SkipWithError("create image effect fail!");
+        return;
+    }
+    std::vector<BatchRenderItem> items = CreateBatchItems();
+    std::vector<ErrorCode> results;
+    for (auto _ : state) {
+        ErrorCode res = imageEffect->RenderBatch(items, static_cast<uint32_t>(state.range(0)), results);
+        if (res != ErrorCode::SUCCESS || std::any_of(results.begin(), results.end(),
+            [](ErrorCode result) { return result != ErrorCode::SUCCESS; })) {
+            state.SkipWithError("image effect render fail!");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * items.size());
+}
+
+BENCHMARK(BM_RenderPathBatch)->RangeMultiplier(2)->Range(1, 4)->Unit(benchmark::kMillisecond)->UseRealTime();
+} // namespace
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
+
+BENCHMARK_MAIN();
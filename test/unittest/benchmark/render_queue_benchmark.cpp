@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include "benchmark_common.h"
+#include "render_fifo_queue.h"
+#include "render_ring_queue.h"
+#include "render_task.h"
+#include "render_thread.h"
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr size_t RENDER_QUEUE_SIZE = 8; // as used by ImageEffect
+constexpr double NS_PER_US = 1e3;
+
+double ElapsedUs(Clock::time_point begin, Clock::time_point end)
+{
+    return std::chrono::duration<double, std::nano>(end - begin).count() / NS_PER_US;
+}
+
+// the current queue is not thread safe, RenderThread guards it with a mutex.
+class LockedFifoQueue {
+public:
+    bool Push(const int64_t &data)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.Push(data);
+    }
+
+    bool Pop(int64_t &data)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return queue_.Pop(data);
+    }
+
+private:
+    std::mutex mutex_;
+    RenderFifoQueue<int64_t> queue_;
+};
+
+// enqueue to dequeue latency of the bare queue, with a consumer polling it like a busy render thread.
+template <typename QUEUE> void BM_QueueHandoff(benchmark::State &state)
+{
+    QUEUE queue;
+    std::atomic<bool> isRunning = true;
+    std::atomic<int64_t> lastLatencyNs = -1;
+    std::thread consumer([&queue, &isRunning, &lastLatencyNs]() {
+        int64_t pushNs = 0;
+        while (isRunning.load(std::memory_order_relaxed)) {
+            if (queue.Pop(pushNs)) {
+                lastLatencyNs.store(Clock::now().time_since_epoch().count() - pushNs, std::memory_order_release);
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    std::vector<double> latenciesUs;
+    for (auto _ : state) {
+        lastLatencyNs.store(-1, std::memory_order_relaxed);
+        queue.Push(Clock::now().time_since_epoch().count());
+        int64_t latencyNs = -1;
+        while ((latencyNs = lastLatencyNs.load(std::memory_order_acquire)) < 0) {
+            std::this_thread::yield();
+        }
+        latenciesUs.emplace_back(static_cast<double>(latencyNs) / NS_PER_US);
+    }
+    isRunning = false;
+    consumer.join();
+    BenchmarkCommon::SetLatencyCounters(state, latenciesUs);
+}
+
+BENCHMARK_TEMPLATE(BM_QueueHandoff, LockedFifoQueue)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueHandoff, RenderRingQueue<int64_t>)->UseRealTime();
+
+// AddTask to the start of the task on a RenderThread, overwriting by tag like ImageEffect does for surface frames.
+template <typename QUEUE> void BM_RenderThreadHandoff(benchmark::State &state)
+{
+    RenderThread<QUEUE> thread(RENDER_QUEUE_SIZE);
+    thread.Start();
+    std::vector<double> latenciesUs;
+    for (auto _ : state) {
+        Clock::time_point runAt;
+        auto task = std::make_shared<RenderTask<>>([&runAt]() { runAt = Clock::now(); });
+        Clock::time_point addAt = Clock::now();
+        thread.AddTask(task, true);
+        task->Wait();
+        latenciesUs.emplace_back(ElapsedUs(addAt, runAt));
+    }
+    thread.Stop();
+    BenchmarkCommon::SetLatencyCounters(state, latenciesUs);
+}
+
+BENCHMARK_TEMPLATE(BM_RenderThreadHandoff, RenderFifoQueue<RenderTaskPtr<void>>)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_RenderThreadHandoff, RenderRingQueue<RenderTaskPtr<void>>)->UseRealTime();
+} // namespace
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "benchmark_common.h"
+#include "efilter_factory.h"
+#include "image_effect_inner.h"
+#include "mock_producer_surface.h"
+#include "test_common.h"
+
+using ::testing::_;
+using ::testing::NiceMock;
+
+namespace OHOS {
+namespace Media {
+namespace Effect {
+namespace Test {
+namespace {
+using Clock = std::chrono::steady_clock;
+constexpr int32_t SOURCE_FPS = 120;
+constexpr int32_t FRAMES_PER_ITERATION = 120; // one second of the synthetic source
+constexpr size_t BUFFER_POOL_SIZE = 8; // RENDER_QUEUE_SIZE of ImageEffect
+constexpr int32_t MAX_FRAMES_IN_FLIGHT = 3;
+// more than the frames the pool, the render strand and the present stage can hold, so a buffer is never reused early.
+constexpr size_t SOURCE_BUFFER_COUNT = BUFFER_POOL_SIZE + MAX_FRAMES_IN_FLIGHT + 1;
+// the attach and flush to the compositor, modelled as a wait in the output surface.
+constexpr std::chrono::microseconds PRESENT_COST(3000);
+constexpr char RUNNING_TYPE[] = "runningType";
+constexpr int32_t RUNNING_TYPE_CPU = 2;
+constexpr float BRIGHTNESS_INTENSITY = 50.f;
+constexpr double NS_PER_US = 1e3;
+constexpr double NS_PER_S = 1e9;
+
+int64_t NowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// the flush timestamp carries the acquire time of the frame, its latency ends with the flush.
+sptr<MockProducerSurface> CreateOutputSurface(std::vector<double> &latenciesUs)
+{
+    sptr<Surface> consumerSurface = Surface::CreateSurfaceAsConsumer("SurfacePipelineBenchmark");
+    if (consumerSurface == nullptr) {
+        return nullptr;
+    }
+    sptr<IBufferProducer> producer = consumerSurface->GetProducer();
+    sptr<MockProducerSurface> surface = new(std::nothrow) NiceMock<MockProducerSurface>(producer);
+    if (surface == nullptr) {
+        return nullptr;
+    }
+    surface->Init();
+    ON_CALL(*surface, AttachAndFlushBuffer(_, _, _, _))
+        .WillByDefault([&latenciesUs](sptr<SurfaceBuffer> &, const sptr<SyncFence> &, BufferFlushConfig &config,
+            bool) {
+            std::this_thread::sleep_for(PRESENT_COST);
+            latenciesUs.emplace_back(static_cast<double>(NowNs() - config.timestamp) / NS_PER_US);
+            return GSError::GSERROR_OK;
+        }
+    );
+    return surface;
+}
+
+// brightness on cpu over a surface input, frames that find the buffer pool full are passed through.
+std::shared_ptr<ImageEffect> CreateSurfaceImageEffect(const sptr<MockProducerSurface> &outputSurface,
+    int32_t framesInFlight)
+{
+    std::shared_ptr<EFilter> brightness = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    if (brightness == nullptr) {
+        return nullptr;
+    }
+    Any intensity = BRIGHTNESS_INTENSITY;
+    brightness->SetValue(KEY_FILTER_INTENSITY, intensity);
+    std::shared_ptr<ImageEffect> imageEffect = std::make_shared<ImageEffect>(IMAGE_EFFECT_NAME);
+    imageEffect->AddEFilter(brightness);
+    sptr<Surface> surface = outputSurface;
+    Any runningType = RUNNING_TYPE_CPU;
+    Any framesInFlightValue = framesInFlight;
+    Any policy = static_cast<int32_t>(SurfaceOverloadPolicy::PASSTHROUGH);
+    if (imageEffect->Configure(RUNNING_TYPE, runningType) != ErrorCode::SUCCESS ||
+        imageEffect->Configure("framesInFlight", framesInFlightValue) != ErrorCode::SUCCESS ||
+        imageEffect->Configure("overloadPolicy", policy) != ErrorCode::SUCCESS ||
+        imageEffect->SetOutputSurface(surface) != ErrorCode::SUCCESS || imageEffect->GetInputSurface() == nullptr) {
+        return nullptr;
+    }
+    // the pool is sized from the queue sizes of the surfaces, pin it so that every run has the same depth.
+    imageEffect->bufferPool_ = std::make_shared<ThreadSafeBufferQueue<BufferEntry>>(BUFFER_POOL_SIZE);
+    return imageEffect->Start() == ErrorCode::SUCCESS ? imageEffect : nullptr;
+}
+
+// the consumer listener of the input surface after it acquired a frame: admit it, then hand it to the render strand.
+void AcquireFrame(ImageEffect *imageEffect, uint32_t seqNum, sptr<SurfaceBuffer> &buffer)
+{
+    BufferProcessInfo bufferProcessInfo = {
+        .inBuffer_ = buffer,
+        .outBuffer_ = nullptr,
+        .inBufferSyncFence_ = SyncFence::INVALID_FENCE,
+        .outBufferSyncFence_ = SyncFence::INVALID_FENCE,
+        .isSrcHebcData_ = false,
+    };
+    bool isNeedSwap = true;
+    if (imageEffect->AdmitSurfaceFrame(bufferProcessInfo, isNeedSwap)) {
+        imageEffect->SubmitRenderTask({ seqNum, buffer, SyncFence::INVALID_FENCE, NowNs() });
+    }
+}
+
+void WaitFramesPresented(ImageEffect *imageEffect)
+{
+    imageEffect->m_renderThread->WaitTaskFinished();
+    if (imageEffect->m_presentThread != nullptr) {
+        imageEffect->m_presentThread->WaitTaskFinished();
+    }
+}
+
+// a 120fps source feeding the render and present stages of ImageEffect, end to end latency is from acquire to the end
+// of the flush.
+void BM_SurfacePipeline(benchmark::State &state)
+{
+    std::vector<double> latenciesUs;
+    sptr<MockProducerSurface> outputSurface = CreateOutputSurface(latenciesUs);
+    std::shared_ptr<ImageEffect> imageEffect = outputSurface == nullptr ? nullptr :
+        CreateSurfaceImageEffect(outputSurface, static_cast<int32_t>(state.range(0)));
+    if (imageEffect == nullptr) {
+        state.SkipWithError("create surface image effect fail!");
+        return;
+    }
+    std::vector<sptr<SurfaceBuffer>> buffers(SOURCE_BUFFER_COUNT);
+    for (auto &buffer : buffers) {
+        MockProducerSurface::AllocDmaMemory(buffer);
+    }
+
+    Clock::duration period = std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / SOURCE_FPS;
+    uint32_t seqNum = 0;
+    Clock::duration elapsed = Clock::duration::zero();
+    for (auto _ : state) {
+        Clock::time_point begin = Clock::now();
+        for (int32_t i = 0; i < FRAMES_PER_ITERATION; ++i) {
+            std::this_thread::sleep_until(begin + period * i);
+            AcquireFrame(imageEffect.get(), seqNum, buffers[seqNum % SOURCE_BUFFER_COUNT]);
+            seqNum++;
+        }
+        WaitFramesPresented(imageEffect.get());
+        elapsed += Clock::now() - begin;
+    }
+    SurfaceStreamStats stats = imageEffect->GetSurfaceStreamStats();
+    uint64_t presentedCount = latenciesUs.size();
+    BenchmarkCommon::SetLatencyCounters(state, latenciesUs);
+    double elapsedS = std::chrono::duration<double, std::nano>(elapsed).count() / NS_PER_S;
+    state.counters["fps"] = elapsedS > 0 ? static_cast<double>(presentedCount) / elapsedS : 0;
+    state.counters["dropped"] = static_cast<double>(stats.passedThroughCount);
+
+    imageEffect = nullptr;
+    for (auto &buffer : buffers) {
+        MockProducerSurface::ReleaseDmaBuffer(buffer);
+    }
+}
+
+// frames in flight: 1 presents inline on the render strand, 2 and 3 overlap the present with the next render.
+BENCHMARK(BM_SurfacePipeline)->DenseRange(1, MAX_FRAMES_IN_FLIGHT)->Iterations(3)->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+} // namespace
+} // namespace Test
+} // namespace Effect
+} // namespace Media
+} // namespace OHOS
@@ -26,6 +26,12 @@
 #include "external_loader.h"
 #include "color_space.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <thread>
+
 using namespace testing::ext;
 using ::testing::_;
 using ::testing::A;
@@ -36,6 +42,9 @@ using namespace OHOS::Media::Effect::Test;
 
 namespace {
     constexpr uint32_t CROP_FACTOR = 2;
+    constexpr uint32_t SURFACE_FRAME_NUM = 6;
+    constexpr std::chrono::milliseconds PRESENT_COST = std::chrono::milliseconds(20);
+    constexpr std::chrono::milliseconds BLOCKED_CHECK_TIME = std::chrono::milliseconds(50);
 }
 
 namespace OHOS {
@@ -68,6 +77,67 @@ public:
     ~FakeImageEffect() {}
 };
 
+static sptr<MockProducerSurface> CreateMockProducerSurface()
+{
+    sptr<Surface> consumerSurface = Surface::CreateSurfaceAsConsumer("UnitTest");
+    sptr<IBufferProducer> producer = consumerSurface->GetProducer();
+    sptr<MockProducerSurface> surface = new(std::nothrow) MockProducerSurface(producer);
+    surface->Init();
+    return surface;
+}
+
+// an effect rendering a surface input into outputSurface, with room for poolSize frames in its buffer pool.
+static std::shared_ptr<ImageEffect> CreateSurfaceImageEffect(const sptr<MockProducerSurface> &outputSurface,
+    size_t poolSize)
+{
+    std::shared_ptr<ImageEffect> imageEffect = std::make_shared<ImageEffect>(IMAGE_EFFECT_NAME);
+    imageEffect->AddEFilter(EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER));
+    sptr<Surface> surface = outputSurface;
+    if (imageEffect->SetOutputSurface(surface) != ErrorCode::SUCCESS || imageEffect->GetInputSurface() == nullptr) {
+        return nullptr;
+    }
+    imageEffect->bufferPool_ = std::make_shared<ThreadSafeBufferQueue<BufferEntry>>(poolSize);
+    return imageEffect;
+}
+
+static BufferProcessInfo CreateBufferProcessInfo(const sptr<SurfaceBuffer> &buffer)
+{
+    return {
+        .inBuffer_ = buffer,
+        .outBuffer_ = nullptr,
+        .inBufferSyncFence_ = SyncFence::INVALID_FENCE,
+        .outBufferSyncFence_ = SyncFence::INVALID_FENCE,
+        .isSrcHebcData_ = false,
+    };
+}
+
+// the consumer listener after it acquired a frame, returns whether the frame was admitted. isNeedSwap tells whether
+// the frame would be swapped through to the output unrendered.
+static bool AcquireSurfaceFrame(ImageEffect *imageEffect, const sptr<SurfaceBuffer> &buffer, int64_t timestamp,
+    bool &isNeedSwap)
+{
+    BufferProcessInfo bufferProcessInfo = CreateBufferProcessInfo(buffer);
+    isNeedSwap = true;
+    if (!imageEffect->AdmitSurfaceFrame(bufferProcessInfo, isNeedSwap)) {
+        return false;
+    }
+    isNeedSwap = imageEffect->SubmitRenderTask({ buffer->GetSeqNum(), buffer, SyncFence::INVALID_FENCE, timestamp });
+    return true;
+}
+
+static void HoldRenderStrand(ImageEffect *imageEffect, const std::shared_future<void> &gateFuture)
+{
+    imageEffect->m_renderThread->AddTask(std::make_shared<RenderTask<>>([gateFuture]() { gateFuture.wait(); }));
+}
+
+static void WaitSurfaceFramesPresented(ImageEffect *imageEffect)
+{
+    imageEffect->m_renderThread->WaitTaskFinished();
+    if (imageEffect->m_presentThread != nullptr) {
+        imageEffect->m_presentThread->WaitTaskFinished();
+    }
+}
+
 void ImageEffectInnerUnittest::SetUpTestCase() {}
 
 void ImageEffectInnerUnittest::TearDownTestCase() {}
@@ -720,6 +790,552 @@ HWTEST_F(ImageEffectInnerUnittest, Quality_HEIC_Fallback_001, TestSize.Level1)
     ErrorCode res = imageEffect_->Start();
     EXPECT_EQ(res, ErrorCode::SUCCESS);
 }
+
+HWTEST_F(ImageEffectInnerUnittest, RenderAsync_001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    ErrorCode result = imageEffect_->RenderAsync([](ErrorCode) {});
+    EXPECT_EQ(result, ErrorCode::ERR_NOT_SET_INPUT_DATA);
+    result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    result = imageEffect_->RenderAsync(nullptr);
+    EXPECT_EQ(result, ErrorCode::ERR_INPUT_NULL);
+
+    std::promise<ErrorCode> prom;
+    std::future<ErrorCode> fut = prom.get_future();
+    result = imageEffect_->RenderAsync([&prom](ErrorCode res) { prom.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    EXPECT_EQ(fut.get(), ErrorCode::SUCCESS);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, CancelAsync_001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    ErrorCode result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // hold the render thread so that the renders below are still queued when they are canceled.
+    std::promise<void> gate;
+    std::shared_future<void> gateFuture = gate.get_future().share();
+    imageEffect_->m_renderThread->AddTask(std::make_shared<RenderTask<>>([gateFuture]() { gateFuture.wait(); }));
+    std::promise<ErrorCode> canceledProm;
+    std::future<ErrorCode> canceledFut = canceledProm.get_future();
+    result = imageEffect_->RenderAsync([&canceledProm](ErrorCode res) { canceledProm.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    imageEffect_->CancelAsync();
+
+    std::promise<ErrorCode> renderedProm;
+    std::future<ErrorCode> renderedFut = renderedProm.get_future();
+    result = imageEffect_->RenderAsync([&renderedProm](ErrorCode res) { renderedProm.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    gate.set_value();
+    EXPECT_EQ(canceledFut.get(), ErrorCode::ERR_CANCELED);
+    EXPECT_EQ(renderedFut.get(), ErrorCode::SUCCESS);
+
+    // a synchronous start waits for the asynchronous renders in flight.
+    result = imageEffect_->Start();
+    EXPECT_EQ(result, ErrorCode::SUCCESS);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderAsync_002, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    ErrorCode result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // a callback queues more renders than the render queue holds, it must not wait for its own render thread.
+    constexpr uint32_t renderNum = 32;
+    std::atomic<uint32_t> renderedCount = 0;
+    std::promise<void> prom;
+    std::future<void> fut = prom.get_future();
+    auto onRendered = [&renderedCount, &prom](ErrorCode) {
+        if (++renderedCount == renderNum) {
+            prom.set_value();
+        }
+    };
+    result = imageEffect_->RenderAsync([this, &onRendered](ErrorCode) {
+        for (uint32_t idx = 0; idx < renderNum; idx++) {
+            EXPECT_EQ(imageEffect_->RenderAsync(onRendered), ErrorCode::SUCCESS);
+        }
+    });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    EXPECT_EQ(fut.wait_for(std::chrono::milliseconds(3000)), std::future_status::ready);
+    imageEffect_->WaitAsyncFinished();
+    EXPECT_EQ(renderedCount.load(), renderNum);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderAsync_003, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    ErrorCode result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // a new input waits for the render queued before it, which renders the input it was queued with.
+    std::promise<void> gate;
+    HoldRenderStrand(imageEffect_, gate.get_future().share());
+    std::promise<ErrorCode> firstProm;
+    std::future<ErrorCode> firstFut = firstProm.get_future();
+    result = imageEffect_->RenderAsync([&firstProm](ErrorCode res) { firstProm.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    std::future<ErrorCode> setInput = std::async(std::launch::async, [this]() {
+        return imageEffect_->SetInputPath("/data/test/resource/image_effect_not_exist.jpg");
+    });
+    EXPECT_EQ(setInput.wait_for(BLOCKED_CHECK_TIME), std::future_status::timeout);
+    gate.set_value();
+    EXPECT_EQ(firstFut.get(), ErrorCode::SUCCESS);
+    ASSERT_EQ(setInput.get(), ErrorCode::SUCCESS);
+
+    std::promise<ErrorCode> secondProm;
+    std::future<ErrorCode> secondFut = secondProm.get_future();
+    result = imageEffect_->RenderAsync([&secondProm](ErrorCode res) { secondProm.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    EXPECT_NE(secondFut.get(), ErrorCode::SUCCESS);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderAsync_004, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    ErrorCode result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // an input set from a callback does not retarget the render queued before it, only the ones queued after.
+    std::promise<void> gate;
+    HoldRenderStrand(imageEffect_, gate.get_future().share());
+    result = imageEffect_->RenderAsync([this](ErrorCode res) {
+        EXPECT_EQ(res, ErrorCode::SUCCESS);
+        EXPECT_EQ(imageEffect_->SetInputPath("/data/test/resource/image_effect_not_exist.jpg"), ErrorCode::SUCCESS);
+    });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    std::promise<ErrorCode> queuedProm;
+    std::future<ErrorCode> queuedFut = queuedProm.get_future();
+    result = imageEffect_->RenderAsync([&queuedProm](ErrorCode res) { queuedProm.set_value(res); });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    gate.set_value();
+    EXPECT_EQ(queuedFut.get(), ErrorCode::SUCCESS);
+    imageEffect_->WaitAsyncFinished();
+    EXPECT_EQ(imageEffect_->inDateInfo_.dataType_, DataType::PATH);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, ConfigureFramesInFlight_001, TestSize.Level1)
+{
+    EXPECT_EQ(imageEffect_->framesInFlight_, DEFAULT_FRAMES_IN_FLIGHT);
+    Any value = 3;
+    EXPECT_EQ(imageEffect_->Configure("framesInFlight", value), ErrorCode::SUCCESS);
+    EXPECT_EQ(imageEffect_->framesInFlight_, 3);
+    value = 0;
+    EXPECT_EQ(imageEffect_->Configure("framesInFlight", value), ErrorCode::ERR_VALUE_OUT_OF_RANGE);
+    value = 4;
+    EXPECT_EQ(imageEffect_->Configure("framesInFlight", value), ErrorCode::ERR_VALUE_OUT_OF_RANGE);
+    value = 1.f;
+    EXPECT_NE(imageEffect_->Configure("framesInFlight", value), ErrorCode::SUCCESS);
+    EXPECT_EQ(imageEffect_->framesInFlight_, 3);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, PresentStage_001, TestSize.Level1)
+{
+    for (int32_t framesInFlight = 1; framesInFlight <= 3; framesInFlight++) {
+        sptr<MockProducerSurface> outputSurface = CreateMockProducerSurface();
+        std::shared_ptr<ImageEffect> imageEffect = CreateSurfaceImageEffect(outputSurface, SURFACE_FRAME_NUM);
+        ASSERT_NE(imageEffect, nullptr);
+        Any value = framesInFlight;
+        ASSERT_EQ(imageEffect->Configure("framesInFlight", value), ErrorCode::SUCCESS);
+        ASSERT_EQ(imageEffect->Start(), ErrorCode::SUCCESS);
+
+        // frames taken from the buffer pool but not flushed yet are the one flushed and those held back.
+        std::vector<int64_t> flushedTimestamps;
+        size_t maxUnflushedCount = 0;
+        EXPECT_CALL(*outputSurface, AttachAndFlushBuffer(_, _, _, _)).Times(SURFACE_FRAME_NUM)
+            .WillRepeatedly([&imageEffect, &flushedTimestamps, &maxUnflushedCount](sptr<SurfaceBuffer> &,
+                const sptr<SyncFence> &, BufferFlushConfig &config, bool) {
+                size_t takenCount = SURFACE_FRAME_NUM - imageEffect->bufferPool_->Size();
+                maxUnflushedCount = std::max(maxUnflushedCount, takenCount - flushedTimestamps.size());
+                flushedTimestamps.push_back(config.timestamp);
+                std::this_thread::sleep_for(PRESENT_COST);
+                return GSError::GSERROR_OK;
+            });
+
+        // hold the render strand until every frame is queued, the renders then outpace the flushes.
+        std::promise<void> gate;
+        HoldRenderStrand(imageEffect.get(), gate.get_future().share());
+        std::vector<sptr<SurfaceBuffer>> buffers(SURFACE_FRAME_NUM);
+        for (uint32_t idx = 0; idx < SURFACE_FRAME_NUM; idx++) {
+            MockProducerSurface::AllocDmaMemory(buffers[idx]);
+            imageEffect->SubmitRenderTask({ idx, buffers[idx], SyncFence::INVALID_FENCE, static_cast<int64_t>(idx) });
+        }
+        gate.set_value();
+        WaitSurfaceFramesPresented(imageEffect.get());
+
+        // frames are flushed in order and a full present stage holds the render strand back.
+        ASSERT_EQ(flushedTimestamps.size(), SURFACE_FRAME_NUM);
+        for (uint32_t idx = 0; idx < SURFACE_FRAME_NUM; idx++) {
+            EXPECT_EQ(flushedTimestamps[idx], static_cast<int64_t>(idx));
+        }
+        EXPECT_LE(maxUnflushedCount, static_cast<size_t>(framesInFlight));
+        EXPECT_EQ(imageEffect->m_presentThread != nullptr, framesInFlight > 1);
+        Mock::VerifyAndClearExpectations(outputSurface.GetRefPtr());
+        for (auto &buffer : buffers) {
+            MockProducerSurface::ReleaseDmaBuffer(buffer);
+        }
+    }
+}
+
+HWTEST_F(ImageEffectInnerUnittest, BufferQueueReplaceAll_001, TestSize.Level1)
+{
+    ThreadSafeBufferQueue<int32_t> queue(2);
+    EXPECT_TRUE(queue.TryPush(1, false));
+    EXPECT_TRUE(queue.TryPush(2, false));
+    EXPECT_TRUE(queue.IsFull());
+    EXPECT_FALSE(queue.WaitNotFull(std::chrono::milliseconds(1)));
+
+    std::vector<int32_t> replaced = queue.ReplaceAll(3);
+    ASSERT_EQ(replaced.size(), 2);
+    EXPECT_EQ(replaced[0], 1);
+    EXPECT_EQ(replaced[1], 2);
+    EXPECT_FALSE(queue.IsFull());
+    EXPECT_TRUE(queue.WaitNotFull(std::chrono::milliseconds(1)));
+    std::optional<int32_t> element = queue.TryPop(false);
+    ASSERT_TRUE(element.has_value());
+    EXPECT_EQ(element.value(), 3);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, ConfigureOverloadPolicy_001, TestSize.Level1)
+{
+    imageEffect_->droppedFrameCount_ = 1;
+    Any value = static_cast<int32_t>(SurfaceOverloadPolicy::LATEST_FRAME_WINS);
+    EXPECT_EQ(imageEffect_->Configure("overloadPolicy", value), ErrorCode::SUCCESS);
+    SurfaceStreamStats stats = imageEffect_->GetSurfaceStreamStats();
+    EXPECT_EQ(stats.policy, SurfaceOverloadPolicy::LATEST_FRAME_WINS);
+    EXPECT_EQ(stats.droppedCount, 0);
+    value = 3;
+    EXPECT_EQ(imageEffect_->Configure("overloadPolicy", value), ErrorCode::ERR_VALUE_OUT_OF_RANGE);
+    EXPECT_EQ(imageEffect_->GetSurfaceStreamStats().policy, SurfaceOverloadPolicy::LATEST_FRAME_WINS);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, OverloadPolicyBlock_001, TestSize.Level1)
+{
+    sptr<MockProducerSurface> outputSurface = CreateMockProducerSurface();
+    std::shared_ptr<ImageEffect> imageEffect = CreateSurfaceImageEffect(outputSurface, 1);
+    ASSERT_NE(imageEffect, nullptr);
+    ASSERT_EQ(imageEffect->Start(), ErrorCode::SUCCESS);
+    EXPECT_CALL(*outputSurface, AttachAndFlushBuffer(_, _, _, _)).Times(2).WillRepeatedly(Return(GSERROR_OK));
+    EXPECT_CALL(*outputSurface, AttachBufferToQueue(_)).Times(0);
+    std::vector<sptr<SurfaceBuffer>> buffers(3);
+    for (auto &buffer : buffers) {
+        MockProducerSurface::AllocDmaMemory(buffer);
+    }
+
+    // a frame arriving while the pool is full waits for the render strand to take a frame out.
+    std::promise<void> gate;
+    HoldRenderStrand(imageEffect.get(), gate.get_future().share());
+    bool isNeedSwap = true;
+    EXPECT_TRUE(AcquireSurfaceFrame(imageEffect.get(), buffers[0], 0, isNeedSwap));
+    std::future<bool> blocked = std::async(std::launch::async, [&imageEffect, &buffers]() {
+        bool isBlockedFrameSwapped = true;
+        return AcquireSurfaceFrame(imageEffect.get(), buffers[1], 1, isBlockedFrameSwapped) && !isBlockedFrameSwapped;
+    });
+    EXPECT_EQ(blocked.wait_for(BLOCKED_CHECK_TIME), std::future_status::timeout);
+    gate.set_value();
+    EXPECT_TRUE(blocked.get());
+    WaitSurfaceFramesPresented(imageEffect.get());
+
+    // when no slot frees up in time the frame is dropped and handed back to the input surface, not swapped.
+    std::promise<void> dropGate;
+    HoldRenderStrand(imageEffect.get(), dropGate.get_future().share());
+    ASSERT_TRUE(imageEffect->bufferPool_->TryPush({ 0, buffers[0], SyncFence::INVALID_FENCE, 0 }, false));
+    EXPECT_FALSE(AcquireSurfaceFrame(imageEffect.get(), buffers[2], 2, isNeedSwap));
+    EXPECT_FALSE(isNeedSwap);
+    imageEffect->bufferPool_->TryPop(false);
+    dropGate.set_value();
+    WaitSurfaceFramesPresented(imageEffect.get());
+
+    SurfaceStreamStats stats = imageEffect->GetSurfaceStreamStats();
+    EXPECT_EQ(stats.renderedCount, 2);
+    EXPECT_EQ(stats.droppedCount, 1);
+    EXPECT_EQ(stats.passedThroughCount, 0);
+    Mock::VerifyAndClearExpectations(outputSurface.GetRefPtr());
+    for (auto &buffer : buffers) {
+        MockProducerSurface::ReleaseDmaBuffer(buffer);
+    }
+}
+
+HWTEST_F(ImageEffectInnerUnittest, OverloadPolicyLatestFrameWins_001, TestSize.Level1)
+{
+    sptr<MockProducerSurface> outputSurface = CreateMockProducerSurface();
+    std::shared_ptr<ImageEffect> imageEffect = CreateSurfaceImageEffect(outputSurface, 2);
+    ASSERT_NE(imageEffect, nullptr);
+    Any value = static_cast<int32_t>(SurfaceOverloadPolicy::LATEST_FRAME_WINS);
+    ASSERT_EQ(imageEffect->Configure("overloadPolicy", value), ErrorCode::SUCCESS);
+    ASSERT_EQ(imageEffect->Start(), ErrorCode::SUCCESS);
+    std::vector<sptr<SurfaceBuffer>> buffers(3);
+    for (auto &buffer : buffers) {
+        MockProducerSurface::AllocDmaMemory(buffer);
+    }
+
+    // the frames replaced before their render go back to the output queue unshown, only the latest is flushed.
+    std::vector<int64_t> flushedTimestamps;
+    EXPECT_CALL(*outputSurface, AttachAndFlushBuffer(_, _, _, _)).WillRepeatedly([&flushedTimestamps](
+        sptr<SurfaceBuffer> &, const sptr<SyncFence> &, BufferFlushConfig &config, bool) {
+        flushedTimestamps.push_back(config.timestamp);
+        return GSERROR_OK;
+    });
+    for (size_t idx = 0; idx < buffers.size() - 1; idx++) {
+        EXPECT_CALL(*outputSurface, AttachBufferToQueue(buffers[idx])).WillOnce(Return(GSERROR_OK));
+        EXPECT_CALL(*outputSurface, CancelBuffer(buffers[idx])).WillOnce(Return(GSERROR_OK));
+    }
+
+    std::promise<void> gate;
+    HoldRenderStrand(imageEffect.get(), gate.get_future().share());
+    for (size_t idx = 0; idx < buffers.size(); idx++) {
+        bool isNeedSwap = true;
+        EXPECT_TRUE(AcquireSurfaceFrame(imageEffect.get(), buffers[idx], static_cast<int64_t>(idx), isNeedSwap));
+        EXPECT_FALSE(isNeedSwap);
+    }
+    EXPECT_EQ(imageEffect->bufferPool_->Size(), 1);
+    gate.set_value();
+    WaitSurfaceFramesPresented(imageEffect.get());
+
+    ASSERT_EQ(flushedTimestamps.size(), 1);
+    EXPECT_EQ(flushedTimestamps[0], static_cast<int64_t>(buffers.size() - 1));
+    SurfaceStreamStats stats = imageEffect->GetSurfaceStreamStats();
+    EXPECT_EQ(stats.renderedCount, 1);
+    EXPECT_EQ(stats.droppedCount, buffers.size() - 1);
+    EXPECT_EQ(stats.passedThroughCount, 0);
+    Mock::VerifyAndClearExpectations(outputSurface.GetRefPtr());
+    for (auto &buffer : buffers) {
+        MockProducerSurface::ReleaseDmaBuffer(buffer);
+    }
+}
+
+HWTEST_F(ImageEffectInnerUnittest, OverloadPolicyPassthrough_001, TestSize.Level1)
+{
+    sptr<MockProducerSurface> outputSurface = CreateMockProducerSurface();
+    std::shared_ptr<ImageEffect> imageEffect = CreateSurfaceImageEffect(outputSurface, 1);
+    ASSERT_NE(imageEffect, nullptr);
+    Any value = static_cast<int32_t>(SurfaceOverloadPolicy::PASSTHROUGH);
+    ASSERT_EQ(imageEffect->Configure("overloadPolicy", value), ErrorCode::SUCCESS);
+    ASSERT_EQ(imageEffect->Start(), ErrorCode::SUCCESS);
+    EXPECT_CALL(*outputSurface, AttachAndFlushBuffer(_, _, _, _)).Times(1).WillOnce(Return(GSERROR_OK));
+    EXPECT_CALL(*outputSurface, AttachBufferToQueue(_)).Times(0);
+    EXPECT_CALL(*outputSurface, CancelBuffer(_)).Times(0);
+    std::vector<sptr<SurfaceBuffer>> buffers(2);
+    for (auto &buffer : buffers) {
+        MockProducerSurface::AllocDmaMemory(buffer);
+    }
+
+    // a frame finding the pool full is not rendered, it is swapped through to the output as it is.
+    std::promise<void> gate;
+    HoldRenderStrand(imageEffect.get(), gate.get_future().share());
+    bool isNeedSwap = true;
+    EXPECT_TRUE(AcquireSurfaceFrame(imageEffect.get(), buffers[0], 0, isNeedSwap));
+    EXPECT_FALSE(AcquireSurfaceFrame(imageEffect.get(), buffers[1], 1, isNeedSwap));
+    EXPECT_TRUE(isNeedSwap);
+    gate.set_value();
+    WaitSurfaceFramesPresented(imageEffect.get());
+
+    SurfaceStreamStats stats = imageEffect->GetSurfaceStreamStats();
+    EXPECT_EQ(stats.renderedCount, 1);
+    EXPECT_EQ(stats.droppedCount, 0);
+    EXPECT_EQ(stats.passedThroughCount, 1);
+    Mock::VerifyAndClearExpectations(outputSurface.GetRefPtr());
+    for (auto &buffer : buffers) {
+        MockProducerSurface::ReleaseDmaBuffer(buffer);
+    }
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderedFrameCount_001, TestSize.Level1)
+{
+    sptr<MockProducerSurface> outputSurface = CreateMockProducerSurface();
+    std::shared_ptr<ImageEffect> imageEffect = CreateSurfaceImageEffect(outputSurface, 1);
+    ASSERT_NE(imageEffect, nullptr);
+    ASSERT_EQ(imageEffect->RemoveEFilter(0), ErrorCode::SUCCESS);
+    ASSERT_EQ(imageEffect->Start(), ErrorCode::SUCCESS);
+    sptr<SurfaceBuffer> buffer;
+    MockProducerSurface::AllocDmaMemory(buffer);
+    EXPECT_CALL(*outputSurface, AttachAndFlushBuffer(_, _, _, _)).Times(0);
+    EXPECT_CALL(*outputSurface, AttachBufferToQueue(buffer)).WillOnce(Return(GSERROR_OK));
+    EXPECT_CALL(*outputSurface, CancelBuffer(buffer)).WillOnce(Return(GSERROR_OK));
+
+    // without filters the render fails, the unfiltered frame is dropped instead of flushed.
+    bool isNeedSwap = true;
+    EXPECT_TRUE(AcquireSurfaceFrame(imageEffect.get(), buffer, 0, isNeedSwap));
+    WaitSurfaceFramesPresented(imageEffect.get());
+    EXPECT_EQ(imageEffect->GetSurfaceStreamStats().renderedCount, 0);
+    EXPECT_EQ(imageEffect->GetSurfaceStreamStats().droppedCount, 1);
+    Mock::VerifyAndClearExpectations(outputSurface.GetRefPtr());
+    MockProducerSurface::ReleaseDmaBuffer(buffer);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderBatch_001, TestSize.Level1)
+{
+    std::string jpgPath = std::string("/data/test/resource/image_effect_1k_test1.jpg");
+    std::string notJpgPath = std::string("/data/test/resource/image_effect_1k_test1.png");
+    std::vector<BatchRenderItem> items = {
+        { jpgPath, "/data/test/resource/image_effect_batch_test1.jpg" },
+        { notJpgPath, "/data/test/resource/image_effect_batch_test2.jpg" },
+        { jpgPath, "/data/test/resource/image_effect_batch_test3.jpg" },
+    };
+    std::vector<ErrorCode> results;
+    ErrorCode result = imageEffect_->RenderBatch(items, 2, results);
+    EXPECT_EQ(result, ErrorCode::ERR_NOT_FILTERS_WITH_RENDER);
+
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    imageEffect_->AddEFilter(efilter);
+    EXPECT_EQ(imageEffect_->RenderBatch({}, 2, results), ErrorCode::ERR_INPUT_NULL);
+    EXPECT_EQ(imageEffect_->RenderBatch(items, 0, results), ErrorCode::ERR_VALUE_OUT_OF_RANGE);
+    EXPECT_EQ(imageEffect_->RenderBatch(items, MAX_BATCH_CONCURRENCY + 1, results),
+        ErrorCode::ERR_VALUE_OUT_OF_RANGE);
+
+    result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    std::atomic<uint32_t> callbackCount = 0;
+    result = imageEffect_->RenderBatch(items, 2, results, [&callbackCount](uint32_t, ErrorCode) { callbackCount++; });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    ASSERT_EQ(results.size(), items.size());
+    EXPECT_EQ(results[0], ErrorCode::SUCCESS);
+    EXPECT_EQ(results[1], ErrorCode::ERR_FILE_TYPE_NOT_SUPPORT);
+    EXPECT_EQ(results[2], ErrorCode::SUCCESS);
+    EXPECT_EQ(callbackCount.load(), items.size());
+
+    // the input set before the batch is left as it was.
+    EXPECT_EQ(imageEffect_->inDateInfo_.dataType_, DataType::PIXEL_MAP);
+    EXPECT_EQ(imageEffect_->inDateInfo_.pixelMap_, mockPixelMap_);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, RenderBatch_002, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    imageEffect_->AddEFilter(efilter);
+    ErrorCode result = imageEffect_->SetInputPixelMap(mockPixelMap_);
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+
+    // a batch started from an asynchronous render callback fails instead of waiting on the render thread.
+    std::vector<BatchRenderItem> items = {
+        { "/data/test/resource/image_effect_1k_test1.jpg", "/data/test/resource/image_effect_batch_test4.jpg" },
+    };
+    std::promise<ErrorCode> prom;
+    std::future<ErrorCode> fut = prom.get_future();
+    result = imageEffect_->RenderAsync([this, &items, &prom](ErrorCode) {
+        std::vector<ErrorCode> results;
+        prom.set_value(imageEffect_->RenderBatch(items, 1, results));
+    });
+    ASSERT_EQ(result, ErrorCode::SUCCESS);
+    ASSERT_EQ(fut.wait_for(std::chrono::milliseconds(3000)), std::future_status::ready);
+    EXPECT_EQ(fut.get(), ErrorCode::ERR_INVALID_OPERATION);
+    imageEffect_->WaitAsyncFinished();
+}
+
+HWTEST_F(ImageEffectInnerUnittest, AcquireExecutionContext_001, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    imageEffect_->AddEFilter(efilter);
+
+    std::shared_ptr<ImageEffect> context1 = imageEffect_->AcquireExecutionContext();
+    std::shared_ptr<ImageEffect> context2 = imageEffect_->AcquireExecutionContext();
+    ASSERT_NE(context1, nullptr);
+    ASSERT_NE(context2, nullptr);
+    EXPECT_NE(context1, context2);
+    ASSERT_EQ(context1->efilters_.size(), 1);
+    EXPECT_NE(context1->efilters_[0], efilter);
+
+    // both render at the same time, each with its own context and input.
+    std::shared_ptr<PixelMap> pixelMap = std::make_shared<MockPixelMap>();
+    ErrorCode result1 = ErrorCode::ERR_UNKNOWN;
+    ErrorCode result2 = ErrorCode::ERR_UNKNOWN;
+    std::thread thread([&context1, &result1, this]() {
+        result1 = context1->SetInputPixelMap(mockPixelMap_);
+        if (result1 == ErrorCode::SUCCESS) {
+            result1 = context1->Start();
+        }
+    });
+    result2 = context2->SetInputPixelMap(pixelMap.get());
+    if (result2 == ErrorCode::SUCCESS) {
+        result2 = context2->Start();
+    }
+    thread.join();
+    EXPECT_EQ(result1, ErrorCode::SUCCESS);
+    EXPECT_EQ(result2, ErrorCode::SUCCESS);
+
+    // a context handed back is reused while the configuration is the same.
+    ImageEffect *recycled = context2.get();
+    context2 = nullptr;
+    std::shared_ptr<ImageEffect> context3 = imageEffect_->AcquireExecutionContext();
+    ASSERT_NE(context3, nullptr);
+    EXPECT_EQ(context3.get(), recycled);
+    EXPECT_EQ(context3->inDateInfo_.dataType_, DataType::UNKNOWN);
+    context3 = nullptr;
+
+    // a changed filter value is picked up by the contexts handed out after it.
+    value = 50.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    std::shared_ptr<ImageEffect> context4 = imageEffect_->AcquireExecutionContext();
+    ASSERT_NE(context4, nullptr);
+    ASSERT_EQ(context4->efilters_.size(), 1);
+    Any copyValue;
+    ASSERT_EQ(context4->efilters_[0]->GetValue(KEY_FILTER_INTENSITY, copyValue), ErrorCode::SUCCESS);
+    auto intensity = AnyCast<float>(&copyValue);
+    ASSERT_NE(intensity, nullptr);
+    EXPECT_FLOAT_EQ(*intensity, 50.f);
+}
+
+HWTEST_F(ImageEffectInnerUnittest, AcquireExecutionContext_002, TestSize.Level1)
+{
+    std::shared_ptr<EFilter> efilter = EFilterFactory::Instance()->Create(BRIGHTNESS_EFILTER);
+    Any value = 100.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    imageEffect_->AddEFilter(efilter);
+
+    // the snapshot is saved once and reused until the configuration or a filter value changes.
+    auto snapshot1 = imageEffect_->GetConfigSnapshot();
+    ASSERT_NE(snapshot1, nullptr);
+    EXPECT_EQ(imageEffect_->GetConfigSnapshot(), snapshot1);
+    value = 50.f;
+    efilter->SetValue(KEY_FILTER_INTENSITY, value);
+    auto snapshot2 = imageEffect_->GetConfigSnapshot();
+    ASSERT_NE(snapshot2, nullptr);
+    EXPECT_NE(snapshot2, snapshot1);
+    imageEffect_->AddEFilter(EFilterFactory::Instance()->Create(CONTRAST_EFILTER));
+    auto snapshot3 = imageEffect_->GetConfigSnapshot();
+    ASSERT_NE(snapshot3, nullptr);
+    EXPECT_NE(snapshot3, snapshot2);
+    EXPECT_EQ(snapshot3->efilters.size(), 2);
+
+    // idle contexts are kept until they have been idle for the timeout.
+    std::shared_ptr<ImageEffect> context1 = imageEffect_->AcquireExecutionContext();
+    std::shared_ptr<ImageEffect> context2 = imageEffect_->AcquireExecutionContext();
+    ASSERT_NE(context1, nullptr);
+    ASSERT_NE(context2, nullptr);
+    context1 = nullptr;
+    context2 = nullptr;
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 2);
+    imageEffect_->TrimExecutionContexts(std::chrono::milliseconds(EXECUTION_CONTEXT_IDLE_TIMEOUT_MS));
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    imageEffect_->TrimExecutionContexts(std::chrono::milliseconds(10));
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 0);
+
+    // Stop runs on the render path and keeps them, an explicit trim drops them all.
+    context1 = imageEffect_->AcquireExecutionContext();
+    ASSERT_NE(context1, nullptr);
+    context1 = nullptr;
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 1);
+    imageEffect_->Stop();
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 1);
+    imageEffect_->TrimExecutionContexts();
+    EXPECT_EQ(imageEffect_->executionContextPool_->idle.size(), 0);
+}
 } // namespace Effect
 } // namespace Media
 } // namespace OHOS
\ No newline at end of file
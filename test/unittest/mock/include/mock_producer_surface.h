@@ -30,6 +30,10 @@ public:
     MOCK_METHOD3(RequestBuffer, GSError(sptr<SurfaceBuffer>& buffer, sptr<SyncFence>& fence,
         BufferRequestConfig &config));
     MOCK_METHOD3(FlushBuffer, GSError(sptr<SurfaceBuffer>& buffer, int32_t fence, BufferFlushConfig &config));
+    MOCK_METHOD4(AttachAndFlushBuffer, GSError(sptr<SurfaceBuffer>& buffer, const sptr<SyncFence>& fence,
+        BufferFlushConfig& config, bool needMap));
+    MOCK_METHOD1(AttachBufferToQueue, GSError(sptr<SurfaceBuffer> buffer));
+    MOCK_METHOD1(CancelBuffer, GSError(sptr<SurfaceBuffer>& buffer));
 
     static void AllocDmaMemory(sptr<SurfaceBuffer> &buffer);
     static void ReleaseDmaBuffer(sptr<SurfaceBuffer> &buffer);
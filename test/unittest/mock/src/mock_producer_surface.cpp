@@ -64,6 +64,20 @@ MockProducerSurface::MockProducerSurface(sptr<IBufferProducer>& producer) : Prod
         }
     );
     ON_CALL(*this, FlushBuffer(_, _, _)).WillByDefault(Return(GSError::GSERROR_OK));
+    ON_CALL(*this, AttachAndFlushBuffer(_, _, _, _))
+        .WillByDefault([this](sptr<SurfaceBuffer> &buffer, const sptr<SyncFence> &fence, BufferFlushConfig &config,
+            bool needMap) {
+            return ProducerSurface::AttachAndFlushBuffer(buffer, fence, config, needMap);
+        }
+    );
+    ON_CALL(*this, AttachBufferToQueue(_)).WillByDefault([this](sptr<SurfaceBuffer> buffer) {
+            return ProducerSurface::AttachBufferToQueue(buffer);
+        }
+    );
+    ON_CALL(*this, CancelBuffer(_)).WillByDefault([this](sptr<SurfaceBuffer> &buffer) {
+            return ProducerSurface::CancelBuffer(buffer);
+        }
+    );
 }
 
 MockProducerSurface::~MockProducerSurface()
@@ -13,6 +13,7 @@
  * limitations under the License.
  */
 
+#include <future>
 #include <vector>
 #include "gtest/gtest.h"
 
@@ -1847,6 +1848,106 @@ HWTEST_F(NativeImageEffectUnittest, OHEffectFilterRenderWithTexture001, TestSize
     renderEnv = nullptr;
 }
 
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_ImageEffect_Start while an asynchronous render calls back into the api
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_ImageEffect_Start waits for the StartAsync callback without blocking it
+ */
+HWTEST_F(NativeImageEffectUnittest, OHImageEffectStartAsync001, TestSize.Level1)
+{
+    OH_ImageEffect *imageEffect = OH_ImageEffect_Create(IMAGE_EFFECT_NAME);
+    ASSERT_NE(imageEffect, nullptr);
+    OH_EffectFilter *filter = OH_ImageEffect_AddFilter(imageEffect, BRIGHTNESS_EFILTER);
+    ASSERT_NE(filter, nullptr);
+    ImageEffect_Any value;
+    value.dataType = ImageEffect_DataType::EFFECT_DATA_TYPE_FLOAT;
+    value.dataValue.floatValue = 100.f;
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_SetValue(filter, KEY_FILTER_INTENSITY, &value);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    errorCode = OH_ImageEffect_SetInputPixelmap(imageEffect, pixelmapNative_);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    struct AsyncContext {
+        std::shared_future<void> gate;
+        int32_t filterCount = 0;
+    };
+    std::promise<void> gate;
+    AsyncContext context = { gate.get_future().share() };
+    OH_ImageEffect_StartAsyncCallback callback = [](OH_ImageEffect *effect, ImageEffect_ErrorCode, void *userData) {
+        auto asyncContext = static_cast<AsyncContext *>(userData);
+        asyncContext->gate.wait();
+        asyncContext->filterCount = OH_ImageEffect_GetFilterCount(effect);
+    };
+    errorCode = OH_ImageEffect_StartAsync(imageEffect, callback, &context);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    // the synchronous start waits for the callback, which takes the api lock.
+    std::future<ImageEffect_ErrorCode> start = std::async(std::launch::async, [imageEffect]() {
+        return OH_ImageEffect_Start(imageEffect);
+    });
+    EXPECT_EQ(start.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    gate.set_value();
+    ASSERT_EQ(start.wait_for(std::chrono::milliseconds(3000)), std::future_status::ready);
+    EXPECT_EQ(start.get(), ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(context.filterCount, 1);
+
+    errorCode = OH_ImageEffect_Release(imageEffect);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+}
+
+/**
+ * Feature: ImageEffect
+ * Function: Test OH_ImageEffect_StartBatch while an asynchronous render calls back into the api
+ * SubFunction: NA
+ * FunctionPoints: NA
+ * EnvConditions: NA
+ * CaseDescription: Test OH_ImageEffect_StartBatch does not hold the api lock while it waits for the renders
+ */
+HWTEST_F(NativeImageEffectUnittest, OHImageEffectStartBatch001, TestSize.Level1)
+{
+    OH_ImageEffect *imageEffect = OH_ImageEffect_Create(IMAGE_EFFECT_NAME);
+    ASSERT_NE(imageEffect, nullptr);
+    OH_EffectFilter *filter = OH_ImageEffect_AddFilter(imageEffect, BRIGHTNESS_EFILTER);
+    ASSERT_NE(filter, nullptr);
+    ImageEffect_Any value;
+    value.dataType = ImageEffect_DataType::EFFECT_DATA_TYPE_FLOAT;
+    value.dataValue.floatValue = 100.f;
+    ImageEffect_ErrorCode errorCode = OH_EffectFilter_SetValue(filter, KEY_FILTER_INTENSITY, &value);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    errorCode = OH_ImageEffect_SetInputPixelmap(imageEffect, pixelmapNative_);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    std::promise<void> gate;
+    std::shared_future<void> gateFuture = gate.get_future().share();
+    OH_ImageEffect_StartAsyncCallback callback = [](OH_ImageEffect *effect, ImageEffect_ErrorCode, void *userData) {
+        static_cast<std::shared_future<void> *>(userData)->wait();
+        (void)OH_ImageEffect_GetFilterCount(effect);
+    };
+    errorCode = OH_ImageEffect_StartAsync(imageEffect, callback, &gateFuture);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    // the batch waits for the callback, which takes the api lock, and other calls go on meanwhile.
+    const char *inputPaths[] = { g_jpgPath.c_str() };
+    const char *outputPaths[] = { "/data/test/resource/image_effect_batch_capi.jpg" };
+    ImageEffect_ErrorCode results[1] = { ImageEffect_ErrorCode::EFFECT_UNKNOWN };
+    std::future<ImageEffect_ErrorCode> batch = std::async(std::launch::async, [imageEffect, &inputPaths,
+        &outputPaths, &results]() {
+        return OH_ImageEffect_StartBatch(imageEffect, inputPaths, outputPaths, 1, 1, results);
+    });
+    EXPECT_EQ(batch.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+    EXPECT_EQ(OH_ImageEffect_GetFilterCount(imageEffect), 1);
+    gate.set_value();
+    ASSERT_EQ(batch.wait_for(std::chrono::milliseconds(3000)), std::future_status::ready);
+    EXPECT_EQ(batch.get(), ImageEffect_ErrorCode::EFFECT_SUCCESS);
+    EXPECT_EQ(results[0], ImageEffect_ErrorCode::EFFECT_SUCCESS);
+
+    errorCode = OH_ImageEffect_Release(imageEffect);
+    ASSERT_EQ(errorCode, ImageEffect_ErrorCode::EFFECT_SUCCESS);
+}
+
 } // namespace Test
 } // namespace Effect
 } // namespace Media